@@ -19,23 +19,18 @@ that can be fed directly into post-processing pipelines (e.g. movie rendering).
 from __future__ import annotations
 
 # ---------------------------------------------------------------------------
-# Thread environment setup for parallel execution (must be before numpy/numba)
+# Thread environment setup for parallel execution (must be before numba)
 # ---------------------------------------------------------------------------
 # When using ProcessPoolExecutor, each worker spawns its own process. If BLAS
 # or Numba also spawn multiple threads, the total thread count can explode.
-# Setting these to "1" ensures "process parallelism only" mode. Set
-# MARSDISK_THREAD_GUARD=0 to retain default threading behaviour.
-import os as _os
+# The shared thread budget pins BLAS to one thread and sizes the Numba pool to
+# the whole budget; each case then leases its share (tail cases get more).
+# Set MARSDISK_THREAD_GUARD=0 to retain default threading behaviour.
+from ..runtime import thread_budget
 
 
 def _apply_thread_guard() -> None:
-    guard = _os.environ.get("MARSDISK_THREAD_GUARD", "1").lower()
-    if guard in {"0", "false", "off", "no"}:
-        return
-    _os.environ.setdefault("OMP_NUM_THREADS", "1")
-    _os.environ.setdefault("MKL_NUM_THREADS", "1")
-    _os.environ.setdefault("OPENBLAS_NUM_THREADS", "1")
-    _os.environ.setdefault("NUMBA_NUM_THREADS", "1")
+    thread_budget.apply_thread_guard()
 
 
 _apply_thread_guard()
@@ -51,9 +46,10 @@ import tempfile
 import numpy as np
 import pandas as pd
 
-from .. import config_utils, constants
+from .. import config_utils, constants, provenance
 from ..schema import Config, Radiation
 from ..physics import radiation
+from ..runtime import placement
 from ..run import run_zero_d
 
 
@@ -190,7 +186,7 @@ def _run_single_case(args: Mapping[str, Any]) -> Dict[str, Any]:
     # Ensure the requested Q_pr table is active inside the worker.
     radiation.load_qpr_table(qpr_table_path)
 
-    with tempfile.TemporaryDirectory(prefix="beta_sampler_") as tmp:
+    with tempfile.TemporaryDirectory(prefix="beta_sampler_") as tmp, thread_budget.lease():
         outdir = Path(tmp)
         case_cfg.io.outdir = outdir
         run_zero_d(case_cfg, enforce_mass_budget=enforce_mass_budget)
@@ -278,14 +274,22 @@ def sample_beta_over_orbit(cfg: BetaSamplingConfig) -> Tuple[np.ndarray, np.ndar
             counter += 1
 
     results: List[Dict[str, Any]] = []
-    if cfg.jobs == 1:
-        for task in tasks:
-            results.append(_run_single_case(task))
-    else:
-        with concurrent.futures.ProcessPoolExecutor(max_workers=cfg.jobs) as pool:
-            futures = [pool.submit(_run_single_case, task) for task in tasks]
-            for future in concurrent.futures.as_completed(futures):
-                results.append(future.result())
+    # Hash the shared Q_pr table and resolve git once; workers reuse it.
+    with provenance.shared_snapshot(external_files=[cfg.qpr_table_path]):
+        if cfg.jobs == 1:
+            for task in tasks:
+                results.append(_run_single_case(task))
+        else:
+            placement_kwargs, placement_report = placement.process_pool_options(cfg.jobs)
+            cfg.diagnostics["placement"] = placement_report
+            pool_kwargs, budget_report = thread_budget.pool_options(
+                cfg.jobs, len(tasks), extra=placement_kwargs
+            )
+            cfg.diagnostics["thread_budget"] = budget_report
+            with concurrent.futures.ProcessPoolExecutor(max_workers=cfg.jobs, **pool_kwargs) as pool:
+                futures = [pool.submit(_run_single_case, task) for task in tasks]
+                for future in concurrent.futures.as_completed(futures):
+                    results.append(future.result())
 
     if not results:
         raise RuntimeError("No β samples were produced")
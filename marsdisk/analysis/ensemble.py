@@ -0,0 +1,345 @@
+"""材料・Q_D* パラメータの不確かさを1プロセス内のアンサンブルで評価する.
+
+``N`` 個のパラメータサンプルを同じプロセスで順に :func:`marsdisk.run.run_zero_d`
+に通す。``numerics.collision_cache.persist`` を有効にして実行するため、サイズ格子
+だけに依存するキャッシュ（断片分配の重み表、供給注入の重み、断片ワークスペース）
+はサンプル間で共有され、ρ や Q_D* 係数に依存する行列だけがサンプルごとに作り直される
+（:func:`marsdisk.run_zero_d._reset_collision_runtime_state` の ``size_only``）。
+
+結果は ``ensemble.parquet``（1サンプル1行: サンプル値 + summary の数値項目 +
+質量収支誤差）と ``ensemble.json``（分布指定・乱数種・分位点統計）にまとめて書き出す。
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import logging
+import math
+import shutil
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Any, Callable, Dict, List, Mapping, Optional, Sequence
+
+import numpy as np
+import pandas as pd
+
+from marsdisk import config_utils
+from marsdisk import run_zero_d as run_zero_d_module
+from marsdisk.errors import ConfigurationError
+from marsdisk.physics import qstar
+from marsdisk.run import load_config, run_zero_d
+
+logger = logging.getLogger(__name__)
+
+__all__ = [
+    "EnsembleResult",
+    "ParameterSpec",
+    "draw_samples",
+    "parse_parameter_spec",
+    "run_ensemble",
+    "summarise_ensemble",
+    "main",
+]
+
+_DISTRIBUTIONS = ("uniform", "loguniform", "normal", "lognormal", "choice")
+_QUANTILES = (0.05, 0.16, 0.5, 0.84, 0.95)
+
+
+@dataclass(frozen=True)
+class ParameterSpec:
+    """One sampled configuration path.
+
+    ``uniform``/``loguniform`` take ``(low, high)``, ``normal`` takes
+    ``(mean, std)``, ``lognormal`` takes ``(median, sigma_ln)`` and ``choice``
+    a tuple of discrete values.
+    """
+
+    path: str
+    dist: str
+    args: tuple
+
+    def __post_init__(self) -> None:
+        if self.dist not in _DISTRIBUTIONS:
+            raise ConfigurationError(f"Unknown distribution {self.dist!r} for {self.path}")
+        if self.dist == "choice":
+            if not self.args:
+                raise ConfigurationError(f"choice for {self.path} needs at least one value")
+            return
+        if len(self.args) != 2:
+            raise ConfigurationError(f"{self.dist} for {self.path} expects two parameters")
+        a, b = (float(v) for v in self.args)
+        if self.dist in {"uniform", "loguniform"} and not b > a:
+            raise ConfigurationError(f"{self.path}: upper bound must exceed lower bound")
+        if self.dist == "loguniform" and a <= 0.0:
+            raise ConfigurationError(f"{self.path}: loguniform bounds must be positive")
+        if self.dist in {"normal", "lognormal"} and b <= 0.0:
+            raise ConfigurationError(f"{self.path}: spread must be positive")
+        if self.dist == "lognormal" and a <= 0.0:
+            raise ConfigurationError(f"{self.path}: lognormal median must be positive")
+
+    def from_unit(self, u: np.ndarray) -> List[Any]:
+        """Map unit-interval draws ``u`` onto the distribution."""
+
+        u = np.clip(np.asarray(u, dtype=float), 1.0e-12, 1.0 - 1.0e-12)
+        if self.dist == "choice":
+            idx = np.minimum((u * len(self.args)).astype(int), len(self.args) - 1)
+            return [self.args[i] for i in idx]
+        a, b = (float(v) for v in self.args)
+        if self.dist == "uniform":
+            values = a + (b - a) * u
+        elif self.dist == "loguniform":
+            values = np.exp(math.log(a) + (math.log(b) - math.log(a)) * u)
+        else:
+            from scipy.stats import norm
+
+            z = norm.ppf(u)
+            values = a + b * z if self.dist == "normal" else a * np.exp(b * z)
+        return [float(v) for v in values]
+
+    def to_dict(self) -> Dict[str, Any]:
+        return {"path": self.path, "dist": self.dist, "args": list(self.args)}
+
+
+def parse_parameter_spec(text: str) -> ParameterSpec:
+    """``path=dist:a:b`` または ``path=choice:v1,v2,...`` を解釈する."""
+
+    path, sep, rhs = text.partition("=")
+    path = path.strip()
+    if not sep or not path:
+        raise ConfigurationError(f"Invalid parameter spec {text!r}; expected path=dist:a:b")
+    dist, _, params = rhs.strip().partition(":")
+    dist = dist.strip().lower()
+    if dist == "choice":
+        values = tuple(config_utils.parse_override_value(item.strip()) for item in params.split(",") if item.strip())
+        return ParameterSpec(path=path, dist=dist, args=values)
+    try:
+        args = tuple(float(item) for item in params.split(":"))
+    except ValueError as exc:
+        raise ConfigurationError(f"Invalid parameter spec {text!r}: {exc}") from exc
+    return ParameterSpec(path=path, dist=dist, args=args)
+
+
+def draw_samples(
+    specs: Sequence[ParameterSpec],
+    n_samples: int,
+    *,
+    seed: Optional[int] = None,
+    method: str = "lhs",
+) -> pd.DataFrame:
+    """Draw ``n_samples`` parameter sets; columns are the configuration paths.
+
+    ``method="lhs"`` uses a Latin hypercube in the unit cube (stratified per
+    parameter), ``"random"`` plain independent draws.
+    """
+
+    if n_samples < 1:
+        raise ValueError("n_samples must be at least 1")
+    if not specs:
+        raise ValueError("at least one parameter spec is required")
+    dim = len(specs)
+    if method == "lhs":
+        from scipy.stats import qmc
+
+        unit = qmc.LatinHypercube(d=dim, seed=seed).random(n_samples)
+    elif method == "random":
+        unit = np.random.default_rng(seed).random((n_samples, dim))
+    else:
+        raise ValueError(f"Unknown sampling method: {method!r}")
+    columns = {spec.path: spec.from_unit(unit[:, k]) for k, spec in enumerate(specs)}
+    return pd.DataFrame(columns)
+
+
+@dataclass
+class EnsembleResult:
+    table: pd.DataFrame
+    metadata: Dict[str, Any] = field(default_factory=dict)
+    table_path: Optional[Path] = None
+    metadata_path: Optional[Path] = None
+
+
+def _flatten_summary(summary: Mapping[str, Any], prefix: str = "summary.") -> Dict[str, float]:
+    record: Dict[str, float] = {}
+    for key, value in summary.items():
+        if isinstance(value, bool):
+            record[f"{prefix}{key}"] = float(value)
+        elif isinstance(value, (int, float, np.integer, np.floating)):
+            record[f"{prefix}{key}"] = float(value)
+    return record
+
+
+def _sample_record(
+    sample_id: int,
+    params: Mapping[str, Any],
+    result: Any,
+) -> Dict[str, Any]:
+    record: Dict[str, Any] = {"sample_id": sample_id, **params}
+    record["sample_status"] = "ok"
+    record["sample_error"] = None
+    record["collision_cache"] = result.collision_cache
+    record["outdir"] = str(result.outdir)
+    record.update(_flatten_summary(result.summary or {}))
+    budget_last = result.mass_budget_last or {}
+    record["budget.error_percent.last"] = float(budget_last.get("error_percent", float("nan")))
+    return record
+
+
+def summarise_ensemble(table: pd.DataFrame, *, quantiles: Sequence[float] = _QUANTILES) -> Dict[str, Dict[str, float]]:
+    """Mean/std/quantiles of every ``summary.*`` column over successful samples."""
+
+    ok = table[table["sample_status"] == "ok"] if "sample_status" in table else table
+    stats: Dict[str, Dict[str, float]] = {}
+    for column in ok.columns:
+        if not (column.startswith("summary.") or column.startswith("budget.")):
+            continue
+        values = pd.to_numeric(ok[column], errors="coerce").to_numpy(dtype=float)
+        values = values[np.isfinite(values)]
+        if values.size == 0:
+            continue
+        entry = {
+            "count": float(values.size),
+            "mean": float(values.mean()),
+            "std": float(values.std(ddof=1)) if values.size > 1 else 0.0,
+        }
+        for q in quantiles:
+            entry[f"q{q:g}"] = float(np.quantile(values, q))
+        stats[column] = entry
+    return stats
+
+
+def _to_builtin(value: Any) -> Any:
+    if isinstance(value, np.generic):
+        return value.item()
+    return value
+
+
+def run_ensemble(
+    config_path: Path | str,
+    samples: pd.DataFrame,
+    *,
+    outdir: Path | str,
+    overrides: Optional[Sequence[str]] = None,
+    specs: Optional[Sequence[ParameterSpec]] = None,
+    seed: Optional[int] = None,
+    keep_sample_outputs: bool = True,
+    on_sample: Optional[Callable[[Dict[str, Any]], None]] = None,
+) -> EnsembleResult:
+    """サンプル表の各行を1プロセス内で順に実行し、アンサンブル表を書き出す.
+
+    ``samples`` の列名は上書きする設定パス（``material.rho`` など）。各サンプルは
+    ``outdir/samples/sample_XXXX`` に通常どおり出力したあと、
+    ``keep_sample_outputs=False`` なら削除する。設定検証や実行で失敗したサンプルは
+    ``sample_status="failed"`` として残し、アンサンブル全体は止めない。
+    """
+
+    config_path = Path(config_path)
+    outdir = Path(outdir)
+    sample_root = outdir / "samples"
+    sample_root.mkdir(parents=True, exist_ok=True)
+    base_deltas = config_utils.parse_overrides(list(overrides or []))
+
+    records: List[Dict[str, Any]] = []
+    try:
+        for sample_id, row in enumerate(samples.to_dict(orient="records")):
+            params = {str(key): _to_builtin(value) for key, value in row.items()}
+            sample_dir = sample_root / f"sample_{sample_id:04d}"
+            try:
+                cfg = load_config(config_path, overrides=base_deltas + config_utils.parse_overrides(params))
+                cfg.io.outdir = sample_dir
+                cfg.numerics.collision_cache.persist = True
+                result = run_zero_d(cfg)
+                record = _sample_record(sample_id, params, result)
+            except Exception as exc:
+                logger.warning("ensemble sample %d failed: %s", sample_id, exc)
+                record = {
+                    "sample_id": sample_id,
+                    **params,
+                    "sample_status": "failed",
+                    "sample_error": f"{type(exc).__name__}: {exc}",
+                    "collision_cache": None,
+                    "outdir": str(sample_dir),
+                }
+            if not keep_sample_outputs:
+                shutil.rmtree(sample_dir, ignore_errors=True)
+            records.append(record)
+            if on_sample is not None:
+                on_sample(record)
+    finally:
+        # Leave no sample's Q_D* table or collision-cache signature behind in the process.
+        qstar.reset_coefficient_table()
+        run_zero_d_module._reset_collision_runtime_state(persist=False, signature=None)
+    if not keep_sample_outputs:
+        shutil.rmtree(sample_root, ignore_errors=True)
+
+    table = pd.DataFrame(records)
+    cache_counts = table["collision_cache"].value_counts(dropna=True).to_dict() if not table.empty else {}
+    metadata: Dict[str, Any] = {
+        "config": str(config_path),
+        "overrides": list(overrides or []),
+        "parameters": [spec.to_dict() for spec in specs] if specs else list(samples.columns),
+        "seed": seed,
+        "n_samples": int(len(table)),
+        "n_failed": int((table["sample_status"] == "failed").sum()) if not table.empty else 0,
+        "collision_cache": {str(k): int(v) for k, v in cache_counts.items()},
+        "sample_outputs_kept": bool(keep_sample_outputs),
+        "statistics": summarise_ensemble(table) if not table.empty else {},
+    }
+    table_path = outdir / "ensemble.parquet"
+    metadata_path = outdir / "ensemble.json"
+    table.to_parquet(table_path, index=False)
+    metadata_path.write_text(json.dumps(metadata, indent=2, ensure_ascii=False), encoding="utf-8")
+    return EnsembleResult(table=table, metadata=metadata, table_path=table_path, metadata_path=metadata_path)
+
+
+def _parse_args(argv: Optional[Sequence[str]] = None) -> argparse.Namespace:
+    parser = argparse.ArgumentParser(description="Run a material/Q_D* uncertainty ensemble in one process.")
+    parser.add_argument("--config", type=Path, required=True, help="基準となるYAML設定ファイル。")
+    parser.add_argument("--outdir", type=Path, required=True, help="ensemble.parquet / ensemble.json の出力先。")
+    parser.add_argument(
+        "--param",
+        action="append",
+        default=[],
+        required=True,
+        help="path=dist:a:b（uniform/loguniform/normal/lognormal）または path=choice:v1,v2（複数指定可）。",
+    )
+    parser.add_argument("--samples", type=int, required=True, help="サンプル数。")
+    parser.add_argument("--seed", type=int, default=None, help="乱数種。")
+    parser.add_argument(
+        "--method",
+        choices=("lhs", "random"),
+        default="lhs",
+        help="サンプリング方法（既定: ラテン超方格）。",
+    )
+    parser.add_argument(
+        "--override",
+        action="append",
+        default=[],
+        help="全サンプル共通の path=value 上書き（複数指定可）。",
+    )
+    parser.add_argument(
+        "--drop-sample-outputs",
+        action="store_true",
+        help="各サンプルの出力ディレクトリを集計後に削除する。",
+    )
+    return parser.parse_args(argv)
+
+
+def main(argv: Optional[Sequence[str]] = None) -> None:
+    args = _parse_args(argv)
+    specs = [parse_parameter_spec(item) for item in args.param]
+    samples = draw_samples(specs, int(args.samples), seed=args.seed, method=args.method)
+    result = run_ensemble(
+        args.config,
+        samples,
+        outdir=args.outdir,
+        overrides=args.override or None,
+        specs=specs,
+        seed=args.seed,
+        keep_sample_outputs=not bool(args.drop_sample_outputs),
+        on_sample=lambda rec: print(f"sample {rec['sample_id']}: {rec['sample_status']}"),
+    )
+    print(f"wrote {result.table_path} ({result.metadata['n_samples']} samples, {result.metadata['n_failed']} failed)")
+
+
+if __name__ == "__main__":  # pragma: no cover - CLI entrypoint
+    main()
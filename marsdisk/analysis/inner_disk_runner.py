@@ -3,22 +3,27 @@
 from __future__ import annotations
 
 import argparse
-import json
+import concurrent.futures
 import math
+import multiprocessing
 import re
+from dataclasses import dataclass
 from pathlib import Path
 from typing import Any, Dict, Iterable, List, Mapping, Optional, Sequence
 
-import numpy as np
 import pandas as pd
 
 from marsdisk import config_utils, constants
 from marsdisk.run import load_config, run_zero_d
+from marsdisk.runtime import ZeroDRunResult, placement, thread_budget
 from marsdisk.schema import Config
 
 DEFAULT_T_END_YEARS = 2.0
 
 __all__ = [
+    "InnerDiskCase",
+    "execute_inner_disk_case",
+    "prepare_inner_disk_case",
     "run_inner_disk_case",
     "run_inner_disk_sweep",
     "save_massloss_table",
@@ -33,71 +38,27 @@ def _safe_float(value: Any) -> float:
         return float("nan")
 
 
-def _read_json(path: Path) -> Dict[str, Any]:
-    with path.open("r", encoding="utf-8") as fh:
-        return json.load(fh)
+def _row_value(row: Optional[Mapping[str, Any]], key: str) -> float:
+    if row is None:
+        return float("nan")
+    return _safe_float(row.get(key))
 
 
-def _read_mass_budget(outdir: Path) -> Optional[pd.DataFrame]:
-    path = outdir / "checks" / "mass_budget.csv"
-    parquet_path = path.with_suffix(".parquet")
-    if parquet_path.exists():
-        if not path.exists() or parquet_path.stat().st_mtime >= path.stat().st_mtime:
-            path = parquet_path
-    if not path.exists():
-        return None
-    if path.suffix == ".parquet":
-        df = pd.read_parquet(path)
-    else:
-        df = pd.read_csv(path)
-    if df.empty:
-        return None
-    return df
-
-
-def _read_step_diagnostics(outdir: Path, format_hint: Optional[str]) -> Optional[pd.DataFrame]:
-    candidates: List[Path] = []
-    if format_hint:
-        ext = "jsonl" if str(format_hint).lower() == "jsonl" else "csv"
-        candidates.append(outdir / "series" / f"step_diagnostics.{ext}")
-    candidates.extend(
-        [
-            outdir / "series" / "step_diagnostics.parquet",
-            outdir / "series" / "step_diagnostics.csv",
-            outdir / "series" / "step_diagnostics.jsonl",
-        ]
-    )
-    seen: set[Path] = set()
-    for path in candidates:
-        if path in seen:
-            continue
-        seen.add(path)
-        if not path.exists():
-            continue
-        if path.suffix == ".parquet":
-            df = pd.read_parquet(path)
-        elif path.suffix == ".csv":
-            df = pd.read_csv(path)
-        else:
-            df = pd.read_json(path, lines=True)
-        if not df.empty:
-            return df
-    return None
-
-
-def _infer_initial_mass(cfg: Config, budget: Optional[pd.DataFrame], step_df: Optional[pd.DataFrame]) -> float:
-    if budget is not None and "mass_initial" in budget.columns:
-        first = budget.iloc[0]["mass_initial"]
-        if math.isfinite(first):
-            return float(first)
-    if step_df is not None and {"mass_total_bins", "mass_lost_by_blowout", "mass_lost_by_sinks"}.issubset(
-        set(step_df.columns)
+def _infer_initial_mass(
+    cfg: Config,
+    budget_first: Optional[Mapping[str, Any]],
+    step_first: Optional[Mapping[str, Any]],
+) -> float:
+    first = _row_value(budget_first, "mass_initial")
+    if math.isfinite(first):
+        return first
+    if step_first is not None and {"mass_total_bins", "mass_lost_by_blowout", "mass_lost_by_sinks"}.issubset(
+        set(step_first)
     ):
-        row0 = step_df.iloc[0]
         total = (
-            _safe_float(row0.get("mass_total_bins"))
-            + _safe_float(row0.get("mass_lost_by_blowout"))
-            + _safe_float(row0.get("mass_lost_by_sinks"))
+            _row_value(step_first, "mass_total_bins")
+            + _row_value(step_first, "mass_lost_by_blowout")
+            + _row_value(step_first, "mass_lost_by_sinks")
         )
         if math.isfinite(total):
             return float(total)
@@ -107,33 +68,26 @@ def _infer_initial_mass(cfg: Config, budget: Optional[pd.DataFrame], step_df: Op
 def _infer_remaining_mass(
     m_init: float,
     m_loss_total: float,
-    budget: Optional[pd.DataFrame],
-    step_df: Optional[pd.DataFrame],
+    budget_last: Optional[Mapping[str, Any]],
+    step_last: Optional[Mapping[str, Any]],
 ) -> float:
-    if budget is not None and "mass_remaining" in budget.columns and not budget.empty:
-        last = budget.iloc[-1]["mass_remaining"]
-        if math.isfinite(last):
-            return float(last)
-    if step_df is not None and "mass_total_bins" in step_df.columns and not step_df.empty:
-        last = step_df.iloc[-1]["mass_total_bins"]
-        if math.isfinite(last):
-            return float(last)
+    last = _row_value(budget_last, "mass_remaining")
+    if math.isfinite(last):
+        return last
+    last = _row_value(step_last, "mass_total_bins")
+    if math.isfinite(last):
+        return last
     if math.isfinite(m_init) and math.isfinite(m_loss_total):
         remain = m_init - m_loss_total
         return max(remain, 0.0)
     return float("nan")
 
 
-def _max_budget_error(summary: Mapping[str, Any], budget: Optional[pd.DataFrame]) -> float:
+def _max_budget_error(summary: Mapping[str, Any], budget_last: Optional[Mapping[str, Any]]) -> float:
     summary_val = _safe_float(summary.get("mass_budget_max_error_percent"))
     if math.isfinite(summary_val):
         return summary_val
-    if budget is None or "error_percent" not in budget.columns or budget.empty:
-        return float("nan")
-    errors = np.abs(budget["error_percent"].to_numpy(dtype=float))
-    if errors.size == 0:
-        return float("nan")
-    return float(np.nanmax(errors))
+    return abs(_row_value(budget_last, "error_percent"))
 
 
 def _sanitize_label(label: Optional[str], config_path: Path) -> str:
@@ -143,77 +97,82 @@ def _sanitize_label(label: Optional[str], config_path: Path) -> str:
     return re.sub(r"[^0-9A-Za-z._-]+", "-", label).strip("-")
 
 
-def _extract_inputs(cfg: Config, summary: Mapping[str, Any]) -> Dict[str, Any]:
-    r_m_summary = _safe_float(summary.get("r_m_used"))
-    r_rm_summary = _safe_float(summary.get("r_RM_used"))
-    if not math.isfinite(r_m_summary) or not math.isfinite(r_rm_summary):
-        try:
-            r_m_calc, r_rm_calc, _ = config_utils.resolve_reference_radius(cfg)
-            if not math.isfinite(r_m_summary):
-                r_m_summary = r_m_calc
-            if not math.isfinite(r_rm_summary):
-                r_rm_summary = r_rm_calc
-        except Exception:
-            pass
-
-    T_M = _safe_float(summary.get("T_M_used"))
-    if not math.isfinite(T_M):
-        try:
-            T_M, _ = config_utils.resolve_temperature_field(cfg)
-        except Exception:
-            T_M = float("nan")
-
-    s_min_effective = _safe_float(summary.get("s_min_effective"))
-    if not math.isfinite(s_min_effective):
-        s_min_effective = _safe_float(getattr(cfg.sizes, "s_min", None))
-
-    supply_mode = getattr(cfg.supply, "mode", None)
+def _config_inputs(cfg: Config) -> Dict[str, Any]:
+    """Config-derived inputs, resolved once per case before it is dispatched."""
+
+    try:
+        r_m, r_rm, _ = config_utils.resolve_reference_radius(cfg)
+    except Exception:
+        r_m, r_rm = float("nan"), float("nan")
+    try:
+        T_M, _ = config_utils.resolve_temperature_field(cfg)
+    except Exception:
+        T_M = float("nan")
+
     supply_const_rate = None
     if getattr(cfg.supply, "const", None) is not None:
         supply_const_rate = _safe_float(cfg.supply.const.prod_area_rate_kg_m2_s)
 
     return {
-        "r_m": r_m_summary,
-        "r_RM": r_rm_summary,
+        "r_m": r_m,
+        "r_RM": r_rm,
         "T_M": T_M,
-        "s_min": s_min_effective,
+        "s_min": _safe_float(getattr(cfg.sizes, "s_min", None)),
         "sinks_mode": getattr(cfg.sinks, "mode", None),
         "enable_sublimation": bool(getattr(cfg.sinks, "enable_sublimation", False)),
         "enable_gas_drag": bool(getattr(cfg.sinks, "enable_gas_drag", False)),
-        "supply_mode": supply_mode,
+        "supply_mode": getattr(cfg.supply, "mode", None),
         "supply_const_prod_area_rate_kg_m2_s": supply_const_rate,
-        "case_status": summary.get("case_status"),
     }
 
 
+def _extract_inputs(static: Mapping[str, Any], summary: Mapping[str, Any]) -> Dict[str, Any]:
+    """Overlay the values the run actually used on the precomputed inputs."""
+
+    inputs = dict(static)
+    for key, summary_key in (
+        ("r_m", "r_m_used"),
+        ("r_RM", "r_RM_used"),
+        ("T_M", "T_M_used"),
+        ("s_min", "s_min_effective"),
+    ):
+        value = _safe_float(summary.get(summary_key))
+        if math.isfinite(value):
+            inputs[key] = value
+    inputs["case_status"] = summary.get("case_status")
+    return inputs
+
+
 def _build_record(
     *,
     label: str,
     config_path: Path,
     cfg: Config,
     outdir: Path,
-    summary: Mapping[str, Any],
-    budget: Optional[pd.DataFrame],
-    step_df: Optional[pd.DataFrame],
+    result: ZeroDRunResult,
+    inputs: Mapping[str, Any],
     t_end_years: float,
 ) -> Dict[str, Any]:
+    summary = result.summary
+    step_last = result.step_diag_last
+
     m_blow = _safe_float(summary.get("M_loss_rp_mars"))
     if not math.isfinite(m_blow):
         m_blow = _safe_float(summary.get("M_out_cum"))
-    if not math.isfinite(m_blow) and step_df is not None and "mass_lost_by_blowout" in step_df.columns:
-        m_blow = _safe_float(step_df.iloc[-1].get("mass_lost_by_blowout"))
+    if not math.isfinite(m_blow):
+        m_blow = _row_value(step_last, "mass_lost_by_blowout")
 
     m_sink = _safe_float(summary.get("M_loss_from_sinks"))
     if not math.isfinite(m_sink):
         m_sink = _safe_float(summary.get("M_sink_cum"))
-    if not math.isfinite(m_sink) and step_df is not None and "mass_lost_by_sinks" in step_df.columns:
-        m_sink = _safe_float(step_df.iloc[-1].get("mass_lost_by_sinks"))
+    if not math.isfinite(m_sink):
+        m_sink = _row_value(step_last, "mass_lost_by_sinks")
 
     m_subl = _safe_float(summary.get("M_loss_from_sublimation"))
     m_loss_total = float(m_blow + m_sink)
 
-    m_init = _infer_initial_mass(cfg, budget, step_df)
-    m_remain = _infer_remaining_mass(m_init, m_loss_total, budget, step_df)
+    m_init = _infer_initial_mass(cfg, result.mass_budget_first, result.step_diag_first)
+    m_remain = _infer_remaining_mass(m_init, m_loss_total, result.mass_budget_last, step_last)
     f_loss = m_loss_total / m_init if m_init > 0.0 else 0.0
 
     if m_sink > 0.0:
@@ -227,8 +186,6 @@ def _build_record(
     if m_init > 0.0 and math.isfinite(m_remain):
         closure_error_percent = abs((m_init - (m_remain + m_loss_total)) / m_init) * 100.0
 
-    inputs = _extract_inputs(cfg, summary)
-
     record: Dict[str, Any] = {
         "label": label,
         "config_path": str(config_path),
@@ -243,15 +200,26 @@ def _build_record(
         "f_loss": f_loss,
         "f_subl": f_subl,
         "mass_closure_error_percent": closure_error_percent,
-        "mass_budget_max_error_percent": _max_budget_error(summary, budget),
+        "mass_budget_max_error_percent": _max_budget_error(summary, result.mass_budget_last),
         "dt_over_t_blow_median": _safe_float(summary.get("dt_over_t_blow_median")),
         "dt_over_t_blow_p90": _safe_float(summary.get("dt_over_t_blow_p90")),
     }
-    record.update(inputs)
+    record.update(_extract_inputs(inputs, summary))
     return record
 
 
-def run_inner_disk_case(
+@dataclass
+class InnerDiskCase:
+    """A fully resolved sweep case; picklable so it can be sent to workers."""
+
+    label: str
+    config_path: Path
+    cfg: Config
+    inputs: Dict[str, Any]
+    t_end_years: float
+
+
+def prepare_inner_disk_case(
     config_path: Path | str,
     *,
     label: Optional[str] = None,
@@ -259,8 +227,8 @@ def run_inner_disk_case(
     t_end_years: float = DEFAULT_T_END_YEARS,
     enable_step_diagnostics: bool = False,
     append_label_to_outdir: bool = True,
-) -> Dict[str, Any]:
-    """単一設定を2年（既定）まで回して質量損失指標を返す."""
+) -> InnerDiskCase:
+    """設定を読み込み、実行用の設定と入力パラメータを1度だけ確定する."""
 
     path = Path(config_path)
     cfg = load_config(path, overrides=overrides)
@@ -277,25 +245,58 @@ def run_inner_disk_case(
     if enable_step_diagnostics:
         case_cfg.io.step_diagnostics.enable = True
 
-    run_zero_d(case_cfg)
-
-    summary_path = outdir / "summary.json"
-    if not summary_path.exists():
-        raise FileNotFoundError(f"summary.json not found under {outdir}")
-    summary = _read_json(summary_path)
-    budget = _read_mass_budget(outdir)
-    step_df = _read_step_diagnostics(outdir, getattr(case_cfg.io.step_diagnostics, "format", None))
-
-    return _build_record(
+    return InnerDiskCase(
         label=label_resolved,
         config_path=path,
         cfg=case_cfg,
-        outdir=outdir,
-        summary=summary,
-        budget=budget,
-        step_df=step_df,
+        inputs=_config_inputs(case_cfg),
+        t_end_years=float(t_end_years),
+    )
+
+
+def execute_inner_disk_case(case: InnerDiskCase) -> Dict[str, Any]:
+    """準備済みケースを実行し、メモリ上の結果から集計行を作る."""
+
+    result = run_zero_d(case.cfg)
+    if not result.summary:
+        raise RuntimeError(f"run_zero_d returned no summary for {case.cfg.io.outdir}")
+    return _build_record(
+        label=case.label,
+        config_path=case.config_path,
+        cfg=case.cfg,
+        outdir=Path(case.cfg.io.outdir),
+        result=result,
+        inputs=case.inputs,
+        t_end_years=case.t_end_years,
+    )
+
+
+def run_inner_disk_case(
+    config_path: Path | str,
+    *,
+    label: Optional[str] = None,
+    overrides: Optional[Sequence[str]] = None,
+    t_end_years: float = DEFAULT_T_END_YEARS,
+    enable_step_diagnostics: bool = False,
+    append_label_to_outdir: bool = True,
+) -> Dict[str, Any]:
+    """単一設定を2年（既定）まで回して質量損失指標を返す."""
+
+    case = prepare_inner_disk_case(
+        config_path,
+        label=label,
+        overrides=overrides,
         t_end_years=t_end_years,
+        enable_step_diagnostics=enable_step_diagnostics,
+        append_label_to_outdir=append_label_to_outdir,
     )
+    return execute_inner_disk_case(case)
+
+
+def _worker_context() -> multiprocessing.context.BaseContext:
+    # Configs may already have touched Arrow/BLAS thread pools in the parent.
+    methods = multiprocessing.get_all_start_methods()
+    return multiprocessing.get_context("forkserver" if "forkserver" in methods else "spawn")
 
 
 def run_inner_disk_sweep(
@@ -306,22 +307,44 @@ def run_inner_disk_sweep(
     t_end_years: float = DEFAULT_T_END_YEARS,
     enable_step_diagnostics: bool = False,
     append_label_to_outdir: bool = True,
+    jobs: int = 1,
+    pool_info: Optional[Dict[str, Any]] = None,
 ) -> pd.DataFrame:
-    """複数設定をまとめて実行し、1行ずつのDataFrameを返す."""
+    """複数設定をまとめて実行し、1行ずつのDataFrameを返す.
+
+    設定の読み込みと入力パラメータの解決はスイープ開始時に1度だけ行う。
+    ``jobs > 1`` ではスイープ全体で使い回すワーカープールにケースを配り、
+    行の順序は ``config_paths`` と同じに保つ。ワーカーは他のスイープと同じく
+    CPU 配置とスレッド予算（Numba/BLAS のスレッド数）を受け取り、その報告は
+    ``pool_info`` に記録される。
+    """
 
-    records: List[Dict[str, Any]] = []
     label_list: List[str] = list(labels or [])
-    for idx, cfg_path in enumerate(config_paths):
-        label = label_list[idx] if idx < len(label_list) else None
-        record = run_inner_disk_case(
+    cases = [
+        prepare_inner_disk_case(
             cfg_path,
-            label=label,
+            label=label_list[idx] if idx < len(label_list) else None,
             overrides=overrides,
             t_end_years=t_end_years,
             enable_step_diagnostics=enable_step_diagnostics,
             append_label_to_outdir=append_label_to_outdir,
         )
-        records.append(record)
+        for idx, cfg_path in enumerate(config_paths)
+    ]
+    jobs = max(min(int(jobs), len(cases)), 1)
+    if jobs == 1:
+        records = [execute_inner_disk_case(case) for case in cases]
+    else:
+        mp_context = _worker_context()
+        placement_kwargs, placement_report = placement.process_pool_options(jobs, mp_context=mp_context)
+        pool_kwargs, budget_report = thread_budget.pool_options(
+            jobs, len(cases), extra=placement_kwargs, mp_context=mp_context
+        )
+        if pool_info is not None:
+            pool_info["placement"] = placement_report
+            pool_info["thread_budget"] = budget_report
+        with concurrent.futures.ProcessPoolExecutor(max_workers=jobs, **pool_kwargs) as pool:
+            records = list(pool.map(execute_inner_disk_case, cases))
     return pd.DataFrame(records)
 
 
@@ -372,6 +395,12 @@ def _parse_args(argv: Optional[Sequence[str]] = None) -> argparse.Namespace:
         action="store_true",
         help="outdir へのラベル付与を無効化し、YAML指定をそのまま使う。",
     )
+    parser.add_argument(
+        "--jobs",
+        type=int,
+        default=1,
+        help="ケースを並列実行するワーカープロセス数（既定: 1）。",
+    )
     return parser.parse_args(argv)
 
 
@@ -387,6 +416,7 @@ def main(argv: Optional[Sequence[str]] = None) -> None:
         t_end_years=float(args.t_end_years),
         enable_step_diagnostics=bool(args.step_diagnostics),
         append_label_to_outdir=not bool(args.no_append_label_outdir),
+        jobs=int(args.jobs),
     )
     if args.out:
         save_massloss_table(df, args.out)
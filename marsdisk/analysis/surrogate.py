@@ -0,0 +1,633 @@
+"""Offline surrogate models for mass-loss maps and an active-learning driver.
+
+Every point of a ``(r/R_M, T_M, supply, …)`` mass-loss map normally costs a
+full :func:`marsdisk.run.run_zero_d` integration.  This module fits a cheap
+emulator on sweep results that already exist (``map.csv``, Parquet tables or
+the Arrow cache written by :mod:`marsdisk.io.sweep_collect`) and uses it to
+
+* predict the mass-loss target and its uncertainty at new points,
+* predict ``case_status`` with a class probability, and
+* pick the next batch of simulator runs where the emulator is least certain.
+
+Two back-ends are available, both CPU-only scikit-learn estimators:
+
+``gp``
+    Gaussian-process regression (Matern ν=5/2 + white noise) on standardised
+    features; the predictive standard deviation is the uncertainty.  Cost
+    grows as ``O(n^3)``, so it is the default only for small training sets.
+``gbt``
+    Histogram gradient-boosted trees.  A median model gives the prediction
+    and the 16/84 % quantile models give a ±1σ-equivalent band.
+
+Targets spanning many decades (the usual case for ``M_loss``) are fitted in
+``log10`` space; uncertainties are reported in that space as
+``<target>_log10_std`` together with the back-transformed 1σ band.
+"""
+from __future__ import annotations
+
+import argparse
+import json
+import logging
+import math
+import pickle
+import warnings
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Any, Callable, Dict, List, Mapping, Optional, Sequence
+
+import numpy as np
+import pandas as pd
+
+from .massloss_sampler import _resolve_table_path
+
+logger = logging.getLogger(__name__)
+
+__all__ = [
+    "ActiveLearningResult",
+    "MassLossSurrogate",
+    "candidate_grid",
+    "load_training_table",
+    "propose_points",
+    "run_active_learning",
+    "main",
+]
+
+SURROGATE_FORMAT_VERSION = 1
+GP_MAX_SAMPLES = 1500
+DEFAULT_FEATURES = ("r_RM", "T_M")
+DEFAULT_TARGET = "loss_frac"
+STATUS_COLUMN = "case_status"
+
+
+def load_training_table(paths: Sequence[Path | str]) -> pd.DataFrame:
+    """Concatenate sweep result tables (CSV, Parquet or Arrow IPC)."""
+
+    frames: List[pd.DataFrame] = []
+    for raw in paths:
+        path = _resolve_table_path(Path(raw))
+        if not path.exists():
+            raise FileNotFoundError(f"Sweep result table not found: {path}")
+        suffix = path.suffix.lower()
+        if suffix in {".parquet", ".pq"}:
+            frames.append(pd.read_parquet(path))
+        elif suffix in {".arrow", ".feather", ".ipc"}:
+            frames.append(pd.read_feather(path))
+        else:
+            frames.append(pd.read_csv(path))
+    if not frames:
+        raise ValueError("No sweep result tables given")
+    return pd.concat(frames, ignore_index=True, sort=False)
+
+
+def _quiet_fit(estimator: Any, X: np.ndarray, y: np.ndarray) -> Any:
+    from sklearn.exceptions import ConvergenceWarning
+
+    with warnings.catch_warnings():
+        warnings.simplefilter("ignore", ConvergenceWarning)
+        return estimator.fit(X, y)
+
+
+@dataclass
+class MassLossSurrogate:
+    """Emulator for one mass-loss target plus ``case_status``.
+
+    ``log_features`` lists features that are standardised in ``log10``
+    space (e.g. supply rates); ``log_target`` fits the target as
+    ``log10(max(y, target_floor))``.
+    """
+
+    features: Sequence[str] = DEFAULT_FEATURES
+    target: str = DEFAULT_TARGET
+    method: str = "auto"
+    log_target: bool = True
+    target_floor: float = 1.0e-12
+    log_features: Sequence[str] = ()
+    status_column: str = STATUS_COLUMN
+    random_state: int = 0
+    method_used: Optional[str] = field(default=None, init=False)
+    n_train: int = field(default=0, init=False)
+    _center: Optional[np.ndarray] = field(default=None, init=False, repr=False)
+    _scale: Optional[np.ndarray] = field(default=None, init=False, repr=False)
+    _regressors: Dict[str, Any] = field(default_factory=dict, init=False, repr=False)
+    _classifier: Any = field(default=None, init=False, repr=False)
+    _constant_status: Optional[str] = field(default=None, init=False, repr=False)
+
+    def __post_init__(self) -> None:
+        if self.method not in {"auto", "gp", "gbt"}:
+            raise ValueError(f"Unknown surrogate method: {self.method!r}")
+        self.features = tuple(self.features)
+        self.log_features = tuple(self.log_features)
+        unknown = sorted(set(self.log_features) - set(self.features))
+        if unknown:
+            raise ValueError(f"log_features not in features: {', '.join(unknown)}")
+
+    # ------------------------------------------------------------------ features
+    def _raw_features(self, frame: pd.DataFrame) -> np.ndarray:
+        missing = [name for name in self.features if name not in frame.columns]
+        if missing:
+            raise KeyError(f"Missing feature columns: {', '.join(missing)}")
+        X = frame.loc[:, list(self.features)].to_numpy(dtype=float, copy=True)
+        for idx, name in enumerate(self.features):
+            if name in self.log_features:
+                X[:, idx] = np.log10(np.maximum(X[:, idx], np.finfo(float).tiny))
+        return X
+
+    def transform(self, frame: pd.DataFrame) -> np.ndarray:
+        """Return standardised feature rows for ``frame``."""
+
+        if self._center is None or self._scale is None:
+            raise RuntimeError("Surrogate is not fitted")
+        return (self._raw_features(frame) - self._center) / self._scale
+
+    def _target_values(self, frame: pd.DataFrame) -> np.ndarray:
+        y = pd.to_numeric(frame[self.target], errors="coerce").to_numpy(dtype=float)
+        if self.log_target:
+            with np.errstate(invalid="ignore"):
+                y = np.log10(np.maximum(y, self.target_floor))
+        return y
+
+    # ----------------------------------------------------------------------- fit
+    def fit(self, frame: pd.DataFrame) -> "MassLossSurrogate":
+        """Fit the regressor on rows with a finite target and the status classifier on all rows."""
+
+        if self.target not in frame.columns:
+            raise KeyError(f"Target column {self.target!r} not in training table")
+        X_raw = self._raw_features(frame)
+        finite_X = np.isfinite(X_raw).all(axis=1)
+        y = self._target_values(frame)
+        train = finite_X & np.isfinite(y)
+        if int(train.sum()) < 2:
+            raise ValueError(f"Need at least two finite samples of {self.target!r} to fit a surrogate")
+
+        self._center = X_raw[train].mean(axis=0)
+        scale = X_raw[train].std(axis=0)
+        self._scale = np.where(scale > 0.0, scale, 1.0)
+        X = (X_raw - self._center) / self._scale
+
+        self.n_train = int(train.sum())
+        method = self.method
+        if method == "auto":
+            method = "gp" if self.n_train <= GP_MAX_SAMPLES else "gbt"
+        self.method_used = method
+        self._regressors = self._fit_regressors(method, X[train], y[train])
+        self._fit_classifier(method, frame, X, finite_X)
+        return self
+
+    def _fit_regressors(self, method: str, X: np.ndarray, y: np.ndarray) -> Dict[str, Any]:
+        if method == "gp":
+            from sklearn.gaussian_process import GaussianProcessRegressor
+            from sklearn.gaussian_process.kernels import ConstantKernel, Matern, WhiteKernel
+
+            kernel = ConstantKernel(1.0, (1e-3, 1e3)) * Matern(
+                length_scale=np.ones(X.shape[1]), length_scale_bounds=(1e-2, 1e2), nu=2.5
+            ) + WhiteKernel(1e-4, (1e-10, 1e-1))
+            gp = GaussianProcessRegressor(
+                kernel=kernel,
+                normalize_y=True,
+                n_restarts_optimizer=2,
+                random_state=self.random_state,
+            )
+            return {"gp": _quiet_fit(gp, X, y)}
+
+        from sklearn.ensemble import HistGradientBoostingRegressor
+
+        models: Dict[str, Any] = {}
+        for name, quantile in (("q16", 0.16), ("q50", 0.5), ("q84", 0.84)):
+            model = HistGradientBoostingRegressor(
+                loss="quantile",
+                quantile=quantile,
+                max_iter=300,
+                learning_rate=0.05,
+                min_samples_leaf=max(2, min(20, X.shape[0] // 10)),
+                random_state=self.random_state,
+            )
+            models[name] = _quiet_fit(model, X, y)
+        return models
+
+    def _fit_classifier(self, method: str, frame: pd.DataFrame, X: np.ndarray, finite_X: np.ndarray) -> None:
+        self._classifier = None
+        self._constant_status = None
+        if self.status_column not in frame.columns:
+            return
+        status = frame[self.status_column]
+        mask = finite_X & status.notna().to_numpy()
+        labels = status[mask].astype(str).to_numpy()
+        classes = np.unique(labels)
+        if classes.size == 0:
+            return
+        if classes.size == 1:
+            self._constant_status = str(classes[0])
+            return
+        if method == "gp":
+            from sklearn.gaussian_process import GaussianProcessClassifier
+            from sklearn.gaussian_process.kernels import RBF, ConstantKernel
+
+            classifier = GaussianProcessClassifier(
+                kernel=ConstantKernel(1.0) * RBF(np.ones(X.shape[1])),
+                random_state=self.random_state,
+            )
+        else:
+            from sklearn.ensemble import HistGradientBoostingClassifier
+
+            classifier = HistGradientBoostingClassifier(max_iter=200, random_state=self.random_state)
+        self._classifier = _quiet_fit(classifier, X[mask], labels)
+
+    # ------------------------------------------------------------------- predict
+    def predict(self, frame: pd.DataFrame) -> pd.DataFrame:
+        """Return ``frame``'s features with prediction, uncertainty and status columns."""
+
+        if not self._regressors:
+            raise RuntimeError("Surrogate is not fitted")
+        X = self.transform(frame)
+        if self.method_used == "gp":
+            mean, std = self._regressors["gp"].predict(X, return_std=True)
+        else:
+            mean = self._regressors["q50"].predict(X)
+            lo = self._regressors["q16"].predict(X)
+            hi = self._regressors["q84"].predict(X)
+            std = 0.5 * np.abs(hi - lo)
+        std = np.asarray(std, dtype=float)
+
+        out = frame.loc[:, list(self.features)].reset_index(drop=True).copy()
+        name = self.target
+        if self.log_target:
+            out[f"{name}_pred"] = np.power(10.0, mean)
+            out[f"{name}_lo"] = np.power(10.0, mean - std)
+            out[f"{name}_hi"] = np.power(10.0, mean + std)
+            out[f"{name}_log10_std"] = std
+        else:
+            out[f"{name}_pred"] = mean
+            out[f"{name}_lo"] = mean - std
+            out[f"{name}_hi"] = mean + std
+            out[f"{name}_std"] = std
+
+        status_col = self.status_column
+        if self._classifier is not None:
+            proba = self._classifier.predict_proba(X)
+            classes = np.asarray(self._classifier.classes_)
+            best = np.argmax(proba, axis=1)
+            out[f"{status_col}_pred"] = classes[best]
+            out[f"{status_col}_prob"] = proba[np.arange(proba.shape[0]), best]
+        elif self._constant_status is not None:
+            out[f"{status_col}_pred"] = self._constant_status
+            out[f"{status_col}_prob"] = 1.0
+        return out
+
+    def uncertainty(self, predictions: pd.DataFrame) -> np.ndarray:
+        """Regression standard deviation in the fitted (possibly log10) space."""
+
+        column = f"{self.target}_log10_std" if self.log_target else f"{self.target}_std"
+        return predictions[column].to_numpy(dtype=float)
+
+    # --------------------------------------------------------------------- store
+    def save(self, path: Path | str) -> Path:
+        import sklearn
+
+        path = Path(path)
+        path.parent.mkdir(parents=True, exist_ok=True)
+        payload = {
+            "version": SURROGATE_FORMAT_VERSION,
+            "sklearn_version": sklearn.__version__,
+            "model": self,
+        }
+        tmp_path = path.with_suffix(path.suffix + ".tmp")
+        with tmp_path.open("wb") as fh:
+            pickle.dump(payload, fh, protocol=pickle.HIGHEST_PROTOCOL)
+        tmp_path.replace(path)
+        return path
+
+    @classmethod
+    def load(cls, path: Path | str) -> "MassLossSurrogate":
+        with Path(path).open("rb") as fh:
+            payload = pickle.load(fh)
+        if not isinstance(payload, dict) or payload.get("version") != SURROGATE_FORMAT_VERSION:
+            raise ValueError(f"Unsupported surrogate file: {path}")
+        model = payload["model"]
+        if not isinstance(model, cls):
+            raise TypeError(f"{path} does not contain a {cls.__name__}")
+        return model
+
+
+def candidate_grid(axes: Mapping[str, Sequence[float]]) -> pd.DataFrame:
+    """Cartesian product of per-feature values as a DataFrame."""
+
+    names = list(axes)
+    mesh = np.meshgrid(*[np.asarray(axes[name], dtype=float) for name in names], indexing="ij")
+    return pd.DataFrame({name: grid.ravel() for name, grid in zip(names, mesh)})
+
+
+def propose_points(
+    surrogate: MassLossSurrogate,
+    candidates: pd.DataFrame,
+    n_points: int,
+    *,
+    evaluated: Optional[pd.DataFrame] = None,
+    status_weight: float = 0.5,
+    min_separation: float = 0.25,
+) -> pd.DataFrame:
+    """Pick up to ``n_points`` candidates where the surrogate is least certain.
+
+    The score is the regression σ (normalised by its maximum) plus
+    ``status_weight × (1 − p_status)``.  Candidates are taken greedily and a
+    candidate closer than ``min_separation`` (standardised units) to a point
+    already chosen or evaluated is skipped, so one batch spreads out instead
+    of sampling a single uncertain corner.
+    """
+
+    if candidates.empty or n_points <= 0:
+        return candidates.iloc[0:0].copy()
+    predictions = surrogate.predict(candidates)
+    sigma = surrogate.uncertainty(predictions)
+    sigma_max = float(np.nanmax(sigma)) if np.isfinite(sigma).any() else 0.0
+    score = np.nan_to_num(sigma / sigma_max if sigma_max > 0.0 else np.zeros_like(sigma))
+    prob_col = f"{surrogate.status_column}_prob"
+    if prob_col in predictions.columns:
+        score = score + status_weight * (1.0 - predictions[prob_col].to_numpy(dtype=float))
+
+    X = surrogate.transform(candidates)
+    taken: List[np.ndarray] = []
+    if evaluated is not None and not evaluated.empty:
+        taken.extend(surrogate.transform(evaluated))
+    chosen: List[int] = []
+    for idx in np.argsort(-score, kind="stable"):
+        if taken:
+            dist = np.linalg.norm(np.asarray(taken) - X[idx], axis=1)
+            if float(dist.min()) < min_separation:
+                continue
+        chosen.append(int(idx))
+        taken.append(X[idx])
+        if len(chosen) >= n_points:
+            break
+    out = candidates.iloc[chosen].copy()
+    out["acquisition_score"] = score[chosen]
+    return out
+
+
+def _space_filling(candidates: pd.DataFrame, features: Sequence[str], n_points: int) -> pd.DataFrame:
+    """Greedy maximin subset of ``candidates`` starting from the centre."""
+
+    X = candidates.loc[:, list(features)].to_numpy(dtype=float)
+    span = X.max(axis=0) - X.min(axis=0)
+    Xn = (X - X.min(axis=0)) / np.where(span > 0.0, span, 1.0)
+    first = int(np.argmin(np.linalg.norm(Xn - 0.5, axis=1)))
+    chosen = [first]
+    dist = np.linalg.norm(Xn - Xn[first], axis=1)
+    while len(chosen) < min(n_points, len(candidates)):
+        nxt = int(np.argmax(dist))
+        chosen.append(nxt)
+        dist = np.minimum(dist, np.linalg.norm(Xn - Xn[nxt], axis=1))
+    return candidates.iloc[chosen].copy()
+
+
+@dataclass
+class ActiveLearningResult:
+    samples: pd.DataFrame
+    surrogate: MassLossSurrogate
+    history: List[Dict[str, Any]]
+    converged: bool
+
+
+def run_active_learning(
+    evaluate: Callable[[pd.DataFrame], pd.DataFrame],
+    candidates: pd.DataFrame,
+    *,
+    surrogate_factory: Callable[[], MassLossSurrogate] = MassLossSurrogate,
+    initial: Optional[pd.DataFrame] = None,
+    n_initial: int = 8,
+    batch_size: int = 4,
+    max_iterations: int = 10,
+    sigma_tol: float = 0.05,
+    status_prob_tol: float = 0.9,
+    on_iteration: Optional[Callable[[Dict[str, Any]], None]] = None,
+) -> ActiveLearningResult:
+    """Alternate surrogate fits and simulator batches until the map is certain.
+
+    ``evaluate`` receives a DataFrame of feature rows and must return the same
+    rows with the target (and, if available, status) columns.  ``initial``
+    seeds the loop with results that already exist; otherwise ``n_initial``
+    space-filling candidates are evaluated first.  The loop stops when the
+    largest σ over ``candidates`` is below ``sigma_tol`` and every status
+    probability is at least ``status_prob_tol``, or after ``max_iterations``
+    batches.
+    """
+
+    surrogate = surrogate_factory()
+    features = list(surrogate.features)
+    if initial is not None and not initial.empty:
+        samples = initial.reset_index(drop=True).copy()
+    else:
+        samples = evaluate(_space_filling(candidates, features, n_initial)).reset_index(drop=True)
+
+    history: List[Dict[str, Any]] = []
+    converged = False
+    for iteration in range(max_iterations + 1):
+        surrogate = surrogate_factory().fit(samples)
+        predictions = surrogate.predict(candidates)
+        sigma = surrogate.uncertainty(predictions)
+        prob_col = f"{surrogate.status_column}_prob"
+        min_prob = float(predictions[prob_col].min()) if prob_col in predictions.columns else 1.0
+        entry = {
+            "iteration": iteration,
+            "n_samples": int(len(samples)),
+            "sigma_max": float(np.nanmax(sigma)),
+            "sigma_mean": float(np.nanmean(sigma)),
+            "status_prob_min": min_prob,
+            "method": surrogate.method_used,
+        }
+        history.append(entry)
+        if on_iteration is not None:
+            on_iteration(entry)
+        if entry["sigma_max"] <= sigma_tol and min_prob >= status_prob_tol:
+            converged = True
+            break
+        if iteration == max_iterations:
+            break
+        batch = propose_points(surrogate, candidates, batch_size, evaluated=samples)
+        if batch.empty:
+            break
+        results = evaluate(batch.loc[:, features])
+        samples = pd.concat([samples, results], ignore_index=True, sort=False)
+    return ActiveLearningResult(samples=samples, surrogate=surrogate, history=history, converged=converged)
+
+
+# --------------------------------------------------------------------------- CLI
+def _parse_axis(spec: str) -> tuple[str, np.ndarray]:
+    """``name=start:stop:count[:log]`` → (name, values)."""
+
+    try:
+        name, rng = spec.split("=", 1)
+        parts = rng.split(":")
+        start, stop, count = float(parts[0]), float(parts[1]), int(parts[2])
+    except (ValueError, IndexError) as exc:
+        raise argparse.ArgumentTypeError(f"axis must look like name=start:stop:count[:log], got {spec!r}") from exc
+    if count < 1:
+        raise argparse.ArgumentTypeError(f"axis {name!r} needs at least one point")
+    if len(parts) > 3 and parts[3] == "log":
+        if start <= 0.0 or stop <= 0.0:
+            raise argparse.ArgumentTypeError(f"log axis {name!r} must be positive")
+        return name, np.logspace(math.log10(start), math.log10(stop), count)
+    return name, np.linspace(start, stop, count)
+
+
+def _parse_axis_path(spec: str) -> tuple[str, str]:
+    """``name=config.path`` → (name, path)."""
+
+    name, sep, path = spec.partition("=")
+    if not sep or not name.strip() or not path.strip():
+        raise argparse.ArgumentTypeError(f"axis path must look like name=config.path, got {spec!r}")
+    return name.strip(), path.strip()
+
+
+def _massloss_evaluator(args: argparse.Namespace) -> Callable[[pd.DataFrame], pd.DataFrame]:
+    """Simulator callback for ``active``: one single-orbit 0D run per point.
+
+    ``r_RM`` and ``T_M`` are sampler arguments; every other feature is applied
+    as a ``--override`` through its ``--axis-path name=config.path`` mapping.
+    """
+
+    from .massloss_sampler import sample_mass_loss_one_orbit
+
+    axis_paths = dict(args.axis_path)
+    axis_names = {name for name, _ in args.axis}
+    features = list(args.features)
+    for name in ("r_RM", "T_M"):
+        if name not in features:
+            raise ValueError(f"active learning needs {name!r} among --features")
+    for name in features:
+        if name not in axis_names:
+            raise ValueError(f"feature {name!r} has no --axis candidate values")
+        if name not in {"r_RM", "T_M"} and name not in axis_paths:
+            raise ValueError(f"feature {name!r} needs --axis-path {name}=<config.path> to reach the simulator")
+    extra = [name for name in features if name not in {"r_RM", "T_M"}]
+
+    def evaluate(points: pd.DataFrame) -> pd.DataFrame:
+        rows = []
+        for point in points.to_dict("records"):
+            overrides = list(args.override) + [f"{axis_paths[name]}={float(point[name])!r}" for name in extra]
+            record = sample_mass_loss_one_orbit(
+                float(point["r_RM"]),
+                float(point["T_M"]),
+                args.base_config,
+                args.qpr_table,
+                overrides=overrides or None,
+            )
+            record.update({name: float(point[name]) for name in extra})
+            record["loss_frac"] = record["mass_loss_frac_per_orbit"]
+            rows.append(record)
+            logger.info(
+                "active sample r=%.3f R_M, T=%.0f K%s -> loss_frac=%.3e",
+                float(point["r_RM"]),
+                float(point["T_M"]),
+                "".join(f", {name}={float(point[name]):.3g}" for name in extra),
+                record["loss_frac"],
+            )
+        return pd.DataFrame(rows)
+
+    return evaluate
+
+
+def _parse_args(argv: Optional[Sequence[str]] = None) -> argparse.Namespace:
+    parser = argparse.ArgumentParser(description="Fit and query offline surrogates of mass-loss sweeps.")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    def _model_options(p: argparse.ArgumentParser) -> None:
+        p.add_argument("--features", nargs="+", default=list(DEFAULT_FEATURES), help="特徴量の列名。")
+        p.add_argument("--target", default=DEFAULT_TARGET, help="回帰対象の列名（既定: loss_frac）。")
+        p.add_argument("--method", choices=["auto", "gp", "gbt"], default="auto", help="回帰モデル。")
+        p.add_argument("--linear-target", action="store_true", help="目的変数を log10 変換せずに学習する。")
+        p.add_argument("--log-features", nargs="*", default=[], help="log10 空間で標準化する特徴量。")
+
+    fit = sub.add_parser("fit", help="既存のスイープ結果から学習してモデルを保存する。")
+    fit.add_argument("--data", nargs="+", type=Path, required=True, help="map.csv / Parquet / Arrow のパス。")
+    fit.add_argument("--out", type=Path, required=True, help="保存先 (.pkl)。")
+    _model_options(fit)
+
+    predict = sub.add_parser("predict", help="保存済みモデルで格子点を予測する。")
+    predict.add_argument("--model", type=Path, required=True)
+    predict.add_argument("--axis", action="append", type=_parse_axis, required=True, help="name=start:stop:count[:log]")
+    predict.add_argument("--out", type=Path, required=True, help="予測結果の CSV。")
+
+    active = sub.add_parser("active", help="不確かな点だけシミュレータを回す能動学習ループ。")
+    active.add_argument("--base-config", type=Path, required=True)
+    active.add_argument("--qpr-table", type=Path, required=True)
+    active.add_argument("--override", action="append", default=[], help="path=value 形式の上書き。")
+    active.add_argument("--axis", action="append", type=_parse_axis, required=True, help="r_RM / T_M の候補格子。")
+    active.add_argument(
+        "--axis-path",
+        action="append",
+        type=_parse_axis_path,
+        default=[],
+        help="r_RM / T_M 以外の特徴量を設定パスへ対応付ける (name=config.path)。",
+    )
+    active.add_argument("--seed-data", nargs="*", type=Path, default=[], help="初期学習に使う既存結果。")
+    active.add_argument("--n-initial", type=int, default=8)
+    active.add_argument("--batch-size", type=int, default=4)
+    active.add_argument("--max-iterations", type=int, default=10)
+    active.add_argument("--sigma-tol", type=float, default=0.05, help="log10 空間での σ の許容値。")
+    active.add_argument("--outdir", type=Path, required=True)
+    _model_options(active)
+    return parser.parse_args(argv)
+
+
+def _factory(args: argparse.Namespace) -> Callable[[], MassLossSurrogate]:
+    def build() -> MassLossSurrogate:
+        return MassLossSurrogate(
+            features=tuple(args.features),
+            target=args.target,
+            method=args.method,
+            log_target=not args.linear_target,
+            log_features=tuple(args.log_features),
+        )
+
+    return build
+
+
+def main(argv: Optional[Sequence[str]] = None) -> None:
+    args = _parse_args(argv)
+    if args.command == "fit":
+        surrogate = _factory(args)().fit(load_training_table(args.data))
+        surrogate.save(args.out)
+        print(f"Fitted {surrogate.method_used} surrogate on {surrogate.n_train} samples -> {args.out}")
+        return
+
+    if args.command == "predict":
+        surrogate = MassLossSurrogate.load(args.model)
+        predictions = surrogate.predict(candidate_grid(dict(args.axis)))
+        args.out.parent.mkdir(parents=True, exist_ok=True)
+        predictions.to_csv(args.out, index=False)
+        print(f"Wrote {len(predictions)} predictions to {args.out}")
+        return
+
+    evaluator = _massloss_evaluator(args)
+    candidates = candidate_grid(dict(args.axis))
+    seed = load_training_table(args.seed_data) if args.seed_data else None
+    result = run_active_learning(
+        evaluator,
+        candidates,
+        surrogate_factory=_factory(args),
+        initial=seed,
+        n_initial=int(args.n_initial),
+        batch_size=int(args.batch_size),
+        max_iterations=int(args.max_iterations),
+        sigma_tol=float(args.sigma_tol),
+        on_iteration=lambda entry: print(f"[active] {json.dumps(entry)}", flush=True),
+    )
+    outdir = args.outdir
+    outdir.mkdir(parents=True, exist_ok=True)
+    result.samples.to_csv(outdir / "samples.csv", index=False)
+    result.surrogate.predict(candidates).to_csv(outdir / "surrogate_map.csv", index=False)
+    result.surrogate.save(outdir / "surrogate.pkl")
+    with (outdir / "active_learning.json").open("w", encoding="utf-8") as fh:
+        json.dump(
+            {"converged": result.converged, "candidates": int(len(candidates)), "history": result.history},
+            fh,
+            indent=2,
+        )
+    print(
+        f"{'Converged' if result.converged else 'Stopped'} after {len(result.samples)} simulator samples "
+        f"out of {len(candidates)} candidates; wrote {outdir}"
+    )
+
+
+if __name__ == "__main__":  # pragma: no cover - CLI entrypoint
+    main()
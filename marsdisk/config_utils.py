@@ -1,12 +1,17 @@
 """Helper utilities for normalising configuration inputs."""
 from __future__ import annotations
 
+import copy
+import functools
 import logging
 import math
+import os
 import subprocess
+import threading
 import warnings
+from dataclasses import dataclass
 from pathlib import Path
-from typing import Any, Dict, List, Sequence, Tuple
+from typing import Any, Dict, List, Mapping, Optional, Sequence, Tuple, Union
 
 from ruamel.yaml import YAML
 
@@ -72,6 +77,12 @@ def resolve_temperature_field(cfg: Config) -> Tuple[float, str]:
 def parse_override_value(raw: str) -> Any:
     """Parse a CLI override value into a Python object."""
 
+    value = _parse_override_value_cached(raw)
+    return copy.deepcopy(value) if isinstance(value, (dict, list)) else value
+
+
+@functools.lru_cache(maxsize=4096)
+def _parse_override_value_cached(raw: str) -> Any:
     text = raw.strip()
     if text and text[0] in "[{":
         try:
@@ -125,27 +136,81 @@ def read_overrides_file(path: Path) -> List[str]:
     return overrides
 
 
-def apply_overrides_dict(payload: Dict[str, Any], overrides: Sequence[str]) -> Dict[str, Any]:
-    """Apply dotted-path overrides to a configuration dictionary."""
+@dataclass(frozen=True)
+class OverrideDelta:
+    """One parsed override: a dotted path split into segments plus its value.
+
+    Sweeps that vary a few parameters can build deltas directly (or pass a
+    ``{path: value}`` mapping to :func:`parse_overrides`) instead of
+    formatting and re-parsing ``PATH=VALUE`` strings for every case.
+    """
+
+    path: Tuple[str, ...]
+    value: Any
+    source: str = ""
+
+    @property
+    def dotted(self) -> str:
+        return ".".join(self.path)
+
+
+OverrideSpec = Union[Sequence[Union[str, OverrideDelta]], Mapping[str, Any], None]
+
+
+def _split_override_path(path: str, item: str) -> Tuple[str, ...]:
+    path = path.strip()
+    if not path:
+        raise ConfigurationError(f"Invalid override '{item}'; empty path")
+    if path.startswith("physics."):
+        path = path[len("physics.") :]
+    parts = tuple(segment for segment in path.split(".") if segment)
+    if not parts:
+        raise ConfigurationError(f"Invalid override '{item}'; empty path")
+    return parts
+
+
+@functools.lru_cache(maxsize=4096)
+def _parse_override_string(item: str) -> OverrideDelta:
+    key, sep, value_str = item.partition("=")
+    if not sep:
+        raise ConfigurationError(f"Invalid override '{item}'; expected path=value")
+    return OverrideDelta(
+        path=_split_override_path(key, item),
+        value=_parse_override_value_cached(value_str),
+        source=item,
+    )
+
+
+def parse_overrides(overrides: OverrideSpec) -> List[OverrideDelta]:
+    """Normalise ``PATH=VALUE`` strings, deltas or a ``{path: value}`` mapping.
+
+    String parsing is memoised, so sweeps repeating the same override strings
+    only pay for it once per process.
+    """
 
     if not overrides:
-        return payload
+        return []
+    if isinstance(overrides, Mapping):
+        return [
+            OverrideDelta(path=_split_override_path(str(key), str(key)), value=value, source=str(key))
+            for key, value in overrides.items()
+        ]
+    deltas: List[OverrideDelta] = []
     for item in overrides:
-        if not isinstance(item, str):  # pragma: no cover - defensive
-            continue
-        key, sep, value_str = item.partition("=")
-        if not sep:
-            raise ConfigurationError(f"Invalid override '{item}'; expected path=value")
-        path = key.strip()
-        if not path:
-            raise ConfigurationError(f"Invalid override '{item}'; empty path")
-        if path.startswith("physics."):
-            path = path[len("physics.") :]
-        parts = [segment for segment in path.split(".") if segment]
-        if not parts:
-            raise ConfigurationError(f"Invalid override '{item}'; empty path")
+        if isinstance(item, OverrideDelta):
+            deltas.append(item)
+        elif isinstance(item, str):
+            deltas.append(_parse_override_string(item))
+    return deltas
+
+
+def apply_override_deltas(payload: Dict[str, Any], deltas: Sequence[OverrideDelta]) -> Dict[str, Any]:
+    """Apply parsed overrides in order; values are copied into ``payload``."""
+
+    for delta in deltas:
+        item = delta.source or delta.dotted
         target: Any = payload
-        for segment in parts[:-1]:
+        for segment in delta.path[:-1]:
             if isinstance(target, dict):
                 if segment not in target or target[segment] is None:
                     target[segment] = {}
@@ -154,15 +219,72 @@ def apply_overrides_dict(payload: Dict[str, Any], overrides: Sequence[str]) -> D
                 raise TypeError(
                     f"Cannot traverse into non-mapping for override '{item}' at '{segment}'"
                 )
-        final_key = parts[-1]
-        value = parse_override_value(value_str)
+        value = delta.value
+        if isinstance(value, (dict, list)):
+            value = copy.deepcopy(value)
         if isinstance(target, dict):
-            target[final_key] = value
+            target[delta.path[-1]] = value
         else:
             raise TypeError(f"Cannot set override '{item}'; target is not a mapping")
     return payload
 
 
+def apply_overrides_dict(payload: Dict[str, Any], overrides: OverrideSpec) -> Dict[str, Any]:
+    """Apply dotted-path overrides to a configuration dictionary."""
+
+    if not overrides:
+        return payload
+    return apply_override_deltas(payload, parse_overrides(overrides))
+
+
+_PAYLOAD_CACHE: Dict[Path, Tuple[Tuple[int, int, int], Any]] = {}
+_PAYLOAD_CACHE_LOCK = threading.Lock()
+_PAYLOAD_CACHE_MAX = 64
+CONFIG_CACHE_ENV = "MARSDISK_CONFIG_CACHE"
+
+
+def _config_cache_enabled() -> bool:
+    return os.environ.get(CONFIG_CACHE_ENV, "1").strip().lower() not in {"0", "false", "off", "no"}
+
+
+def load_yaml_payload(path: Path) -> Any:
+    """Return a private copy of the parsed YAML at ``path``.
+
+    YAML parsing dominates ``load_config`` (tens of ms against well under a
+    millisecond for the pydantic build), so parsed payloads are cached per
+    resolved path and invalidated when ``(mtime_ns, size, inode)`` changes.
+    Set ``MARSDISK_CONFIG_CACHE=0`` to always re-read.
+    """
+
+    source_path = Path(path).resolve()
+    stat = source_path.stat()
+    stamp = (int(stat.st_mtime_ns), int(stat.st_size), int(stat.st_ino))
+    use_cache = _config_cache_enabled()
+    if use_cache:
+        with _PAYLOAD_CACHE_LOCK:
+            cached = _PAYLOAD_CACHE.get(source_path)
+        if cached is not None and cached[0] == stamp:
+            return copy.deepcopy(cached[1])
+    yaml = YAML(typ="safe")
+    with source_path.open("r", encoding="utf-8") as fh:
+        data = yaml.load(fh)
+    if use_cache:
+        with _PAYLOAD_CACHE_LOCK:
+            if len(_PAYLOAD_CACHE) >= _PAYLOAD_CACHE_MAX:
+                _PAYLOAD_CACHE.pop(next(iter(_PAYLOAD_CACHE)))
+            _PAYLOAD_CACHE[source_path] = (stamp, copy.deepcopy(data))
+    return data
+
+
+def clear_config_cache() -> None:
+    """Drop cached YAML payloads and parsed override strings."""
+
+    with _PAYLOAD_CACHE_LOCK:
+        _PAYLOAD_CACHE.clear()
+    _parse_override_string.cache_clear()
+    _parse_override_value_cached.cache_clear()
+
+
 def merge_physics_section(payload: Dict[str, Any]) -> Dict[str, Any]:
     """Inline an optional ``physics`` mapping into the root config tree."""
 
@@ -199,30 +321,16 @@ def normalise_physics_mode(value: Any) -> str:
 
 
 def gather_git_info() -> Dict[str, Any]:
-    """Return basic git metadata for provenance recording."""
+    """Return basic git metadata for provenance recording (memoised per process)."""
 
-    repo_root = Path(__file__).resolve().parents[1]
-    info: Dict[str, Any] = {}
-    try:
-        info["commit"] = subprocess.check_output(
-            ["git", "rev-parse", "HEAD"], cwd=repo_root, text=True
-        ).strip()
-    except Exception:
-        info["commit"] = "unknown"
-    try:
-        info["branch"] = subprocess.check_output(
-            ["git", "rev-parse", "--abbrev-ref", "HEAD"], cwd=repo_root, text=True
-        ).strip()
-    except Exception:
-        info["branch"] = "unknown"
-    try:
-        status = subprocess.check_output(
-            ["git", "status", "--short"], cwd=repo_root, text=True
-        )
-        info["dirty"] = bool(status.strip())
-    except Exception:
-        info["dirty"] = None
-    return info
+    from . import provenance
+
+    info = provenance.git_info()
+    return {
+        "commit": info.get("commit") or "unknown",
+        "branch": info.get("branch") or "unknown",
+        "dirty": info.get("dirty"),
+    }
 
 
 def configure_logging(level: int, suppress_warnings: bool = False) -> None:
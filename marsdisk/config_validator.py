@@ -428,13 +428,10 @@ def _check_external_supply_defaults(config: "Config") -> List[ValidationMessage]
 
 def load_and_validate(config_path: str | Path) -> tuple["Config", ValidationResult]:
     """設定ファイルを読み込んで検証"""
-    from ruamel.yaml import YAML
-
+    from marsdisk.config_utils import load_yaml_payload
     from marsdisk.schema import Config
 
-    yaml = YAML()
-    with open(config_path) as f:
-        data = yaml.load(f)
+    data = load_yaml_payload(Path(config_path))
 
     # メタデータを除去
     data.pop("_scenario", None)
@@ -7,7 +7,7 @@ radial grid class is provided as a skeleton for future extensions.
 from __future__ import annotations
 
 from dataclasses import dataclass
-from typing import Iterable
+from typing import Iterable, Optional, Sequence, Tuple
 
 import numpy as np
 
@@ -91,6 +91,133 @@ class RadialGrid:
         edges = np.linspace(r_min, r_max, n + 1)
         return cls.from_edges(edges)
 
+    @classmethod
+    def logarithmic(cls, r_min: float, r_max: float, n: int) -> "RadialGrid":
+        """Generate a grid with logarithmically spaced edges (finer inside)."""
+        if r_min <= 0.0 or r_max <= r_min:
+            raise ValueError("logarithmic grid requires 0 < r_min < r_max")
+        edges = np.geomspace(r_min, r_max, n + 1)
+        edges[0] = r_min
+        edges[-1] = r_max
+        return cls.from_edges(edges)
+
+
+def annulus_overlap(src_edges: np.ndarray, dst_edges: np.ndarray) -> np.ndarray:
+    """Return the annulus area shared by each ``(dst, src)`` cell pair (m²)."""
+
+    src = np.asarray(src_edges, dtype=float)
+    dst = np.asarray(dst_edges, dtype=float)
+    lo = np.maximum(dst[:-1, None], src[None, :-1])
+    hi = np.minimum(dst[1:, None], src[None, 1:])
+    hi = np.maximum(hi, lo)
+    return np.pi * (hi**2 - lo**2)
+
+
+def remap_conservative(
+    src_edges: np.ndarray,
+    dst_edges: np.ndarray,
+    values: np.ndarray,
+) -> np.ndarray:
+    """Remap per-area cell values (Σ, τ, PSD number per area) between grids.
+
+    ``values`` has the source cells on its first axis; trailing axes (for
+    example the size bins of a PSD) are carried along.  The integral
+    ``sum(values * area)`` over the overlapping radial range is conserved.
+    """
+
+    values = np.asarray(values, dtype=float)
+    overlap = annulus_overlap(src_edges, dst_edges)
+    dst = np.asarray(dst_edges, dtype=float)
+    dst_area = np.pi * (dst[1:] ** 2 - dst[:-1] ** 2)
+    flat = values.reshape(values.shape[0], -1)
+    remapped = (overlap @ flat) / np.where(dst_area > 0.0, dst_area, 1.0)[:, None]
+    return remapped.reshape((overlap.shape[0],) + values.shape[1:])
+
+
+def _edge_jumps(field: np.ndarray) -> np.ndarray:
+    """Jump of ``field`` across each interior edge (log ratio when positive)."""
+
+    field = np.asarray(field, dtype=float)
+    left = field[:-1]
+    right = field[1:]
+    jumps = np.zeros(left.shape, dtype=float)
+    positive = (left > 0.0) & (right > 0.0)
+    jumps[positive] = np.abs(np.log(right[positive] / left[positive]))
+    other = ~positive
+    scale = np.maximum(np.abs(left[other]), np.abs(right[other]))
+    jumps[other] = np.where(scale > 0.0, np.abs(right[other] - left[other]) / np.where(scale > 0.0, scale, 1.0), 0.0)
+    return np.where(np.isfinite(jumps), jumps, 0.0)
+
+
+def adapt_edges(
+    edges: np.ndarray,
+    fields: Sequence[np.ndarray],
+    *,
+    split_tol: float = 0.2,
+    merge_tol: float = 0.02,
+    n_min: int = 1,
+    n_max: Optional[int] = None,
+    max_passes: int = 4,
+) -> Tuple[np.ndarray, dict]:
+    """Split and merge cells from the jumps of per-area ``fields``.
+
+    A cell is halved when the jump to either neighbour in any field exceeds
+    ``split_tol``; an interior edge is removed when the jumps across it and
+    across both neighbouring edges stay below ``merge_tol``.  The fields are
+    remapped conservatively onto the new cells between passes, and the pass
+    loop stops as soon as the edges no longer change.
+    """
+
+    edges = np.asarray(edges, dtype=float)
+    fields = [np.asarray(field, dtype=float) for field in fields]
+    n_max = int(n_max) if n_max is not None else 4 * (edges.size - 1)
+    n_min = max(int(n_min), 1)
+    splits = merges = passes = 0
+    for _ in range(max(int(max_passes), 1)):
+        n = edges.size - 1
+        if n < 2 or not fields:
+            break
+        jumps = np.max(np.vstack([_edge_jumps(field) for field in fields]), axis=0)
+        padded = np.concatenate(([0.0], jumps, [0.0]))
+        cell_jump = np.maximum(padded[:-1], padded[1:])
+
+        split_cells = np.flatnonzero(cell_jump > split_tol)
+        budget = max(n_max - n, 0)
+        if split_cells.size > budget:
+            split_cells = split_cells[np.argsort(cell_jump[split_cells])[::-1][:budget]]
+        split_mask = np.zeros(n, dtype=bool)
+        split_mask[split_cells] = True
+
+        keep_edge = np.ones(edges.size, dtype=bool)
+        removable = 0
+        for j in range(1, n):
+            if n - removable <= n_min:
+                break
+            lo = jumps[j - 2] if j >= 2 else 0.0
+            hi = jumps[j] if j < n - 1 else 0.0
+            if (
+                jumps[j - 1] < merge_tol
+                and lo < merge_tol
+                and hi < merge_tol
+                and not split_mask[j - 1]
+                and not split_mask[j]
+                and keep_edge[j - 1]
+            ):
+                keep_edge[j] = False
+                removable += 1
+
+        mids = 0.5 * (edges[:-1] + edges[1:])[split_mask]
+        new_edges = np.sort(np.concatenate((edges[keep_edge], mids)))
+        if new_edges.size == edges.size and np.array_equal(new_edges, edges):
+            break
+        fields = [remap_conservative(edges, new_edges, field) for field in fields]
+        splits += int(split_mask.sum())
+        merges += removable
+        passes += 1
+        edges = new_edges
+    return edges, {"passes": passes, "splits": splits, "merges": merges, "n_cells": int(edges.size - 1)}
+
+
 def omega(r: float) -> float:      # alias
     return omega_kepler(r)
 
@@ -1,4 +1,4 @@
 """I/O helper subpackage."""
-from . import tables, writer, streaming, archive
+from . import tables, writer, mass_budget, streaming, archive, recovery
 
-__all__ = ["tables", "writer", "streaming", "archive"]
+__all__ = ["tables", "writer", "mass_budget", "streaming", "archive", "recovery"]
@@ -18,6 +18,8 @@ import pyarrow as pa
 import pyarrow.ipc as ipc
 import pyarrow.parquet as pq
 
+from . import writer
+
 logger = logging.getLogger(__name__)
 
 CHUNK_GLOBS = (
@@ -94,8 +96,8 @@ def _hash_schema(schema: pa.Schema) -> str:
 
 def _hash_arrow_table(table: pa.Table) -> str:
     sink = pa.BufferOutputStream()
-    with ipc.new_stream(sink, table.schema) as writer:
-        writer.write_table(table)
+    with ipc.new_stream(sink, table.schema) as stream_writer:
+        stream_writer.write_table(table)
     return hashlib.sha256(sink.getvalue().to_pybytes()).hexdigest()
 
 
@@ -249,7 +251,7 @@ def _update_run_card(
             lines.append(f"- archive_volume_device: {device}")
         if mount_point:
             lines.append(f"- archive_volume_mount: {mount_point}")
-    run_card.write_text("\n".join(lines), encoding="utf-8")
+    writer.write_text_atomic("\n".join(lines), run_card)
 
 
 def _check_writable(path: Path) -> bool:
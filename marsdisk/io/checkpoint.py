@@ -2,6 +2,7 @@ from __future__ import annotations
 
 import base64
 import json
+import os
 import pickle
 from dataclasses import dataclass, asdict
 from pathlib import Path
@@ -67,9 +68,13 @@ def save_checkpoint(path: Path, state: CheckpointState, fmt: CheckpointFormat =
 
     fmt_normalized = "pickle" if fmt in (None, "") else str(fmt).lower()
     _ensure_parent(path)
+    # Write next to the target and rename so a killed run never leaves a
+    # truncated checkpoint behind as the "latest" one.
+    tmp_path = path.with_name(f".{path.name}.tmp")
     if fmt_normalized == "pickle":
-        with path.open("wb") as fh:
+        with tmp_path.open("wb") as fh:
             pickle.dump(state, fh)
+        os.replace(tmp_path, path)
         return path
 
     if fmt_normalized != "json":
@@ -80,9 +85,9 @@ def save_checkpoint(path: Path, state: CheckpointState, fmt: CheckpointFormat =
     payload["rng_state_numpy"] = _b64_pack(state.rng_state_numpy)
     payload["rng_state_generator"] = _b64_pack(state.rng_state_generator)
     payload["rng_state_python"] = _b64_pack(state.rng_state_python)
-    _ensure_parent(path)
-    with path.open("w", encoding="utf-8") as fh:
+    with tmp_path.open("w", encoding="utf-8") as fh:
         json.dump(payload, fh)
+    os.replace(tmp_path, path)
     return path
 
 
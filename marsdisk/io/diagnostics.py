@@ -34,10 +34,13 @@ def write_zero_d_history(
     step_diag_format: str,
     step_diag_path_cfg: Optional[Path],
     step_diag_path: Optional[Path],
+    step_diag_compression: str = "zstd",
     orbit_rollup_enabled: bool,
     extended_diag_enabled: bool,
     series_columns: Optional[list[str]] = None,
     diagnostic_columns: Optional[list[str]] = None,
+    drop_extra_columns: bool = False,
+    float32_columns: Optional[list[str]] = None,
 ) -> None:
     """Persist time series, diagnostics, and rollups for a zero-D run."""
 
@@ -49,12 +52,13 @@ def write_zero_d_history(
             if not resolved_step_diag_path.is_absolute():
                 resolved_step_diag_path = outdir / resolved_step_diag_path
         else:
-            ext = "jsonl" if step_diag_format == "jsonl" else "csv"
-            resolved_step_diag_path = outdir / "series" / f"step_diagnostics.{ext}"
+            resolved_step_diag_path = outdir / "series" / f"step_diagnostics.{step_diag_format}"
     writer.write_parquet(
         df,
         outdir / "series" / "run.parquet",
         ensure_columns=series_columns,
+        drop_extra_columns=drop_extra_columns,
+        float32_columns=float32_columns,
     )
     if history.psd_hist_records:
         psd_hist_df = pd.DataFrame(history.psd_hist_records)
@@ -62,17 +66,28 @@ def write_zero_d_history(
     if history.diagnostics:
         if isinstance(history.diagnostics, ColumnarBuffer):
             diag_table = history.diagnostics.to_table(ensure_columns=diagnostic_columns)
-            writer.write_parquet_table(diag_table, outdir / "series" / "diagnostics.parquet")
+            writer.write_parquet_table(
+                diag_table,
+                outdir / "series" / "diagnostics.parquet",
+                ensure_columns=diagnostic_columns,
+                drop_extra_columns=drop_extra_columns,
+                float32_columns=float32_columns,
+            )
         else:
             diag_df = pd.DataFrame(history.diagnostics)
             writer.write_parquet(
                 diag_df,
                 outdir / "series" / "diagnostics.parquet",
                 ensure_columns=diagnostic_columns,
+                drop_extra_columns=drop_extra_columns,
+                float32_columns=float32_columns,
             )
     if step_diag_enabled and resolved_step_diag_path is not None:
         writer.write_step_diagnostics(
-            history.step_diag_records, resolved_step_diag_path, fmt=step_diag_format
+            history.step_diag_records,
+            resolved_step_diag_path,
+            fmt=step_diag_format,
+            compression=step_diag_compression,
         )
     if orbit_rollup_enabled:
         rows_for_rollup = history.orbit_rollup_rows
@@ -0,0 +1,255 @@
+"""Incremental mass-budget log writers.
+
+``checks/mass_budget.csv`` (and the per-cell ``mass_budget_cells.csv``) are
+appended on every streaming flush.  For long 1D runs the CSV formatting of
+``Nr`` rows per step dominates the flush cost, so the log can alternatively
+be written as a single Parquet file whose row groups are appended flush by
+flush.  Violation tracking is done on the in-memory rows as they are appended
+so callers never have to re-read the log to find the worst error.
+"""
+from __future__ import annotations
+
+import logging
+import math
+from pathlib import Path
+from typing import Any, Dict, Iterable, List, Mapping, Optional, Sequence
+
+import pandas as pd
+import pyarrow as pa
+import pyarrow.parquet as pq
+
+from . import writer
+
+logger = logging.getLogger(__name__)
+
+MASS_BUDGET_FORMATS = ("csv", "parquet")
+ERROR_COLUMN = "error_percent"
+
+
+def normalise_format(fmt: Optional[str]) -> str:
+    """Return a supported mass-budget format label (defaults to CSV)."""
+
+    text = str(fmt or "csv").strip().lower()
+    if text not in MASS_BUDGET_FORMATS:
+        raise ValueError(f"Unsupported mass budget format: {fmt}")
+    return text
+
+
+def mass_budget_path(checks_dir: Path, stem: str, fmt: Optional[str]) -> Path:
+    """Return ``checks_dir/<stem>.<ext>`` for the requested format."""
+
+    return Path(checks_dir) / f"{stem}.{normalise_format(fmt)}"
+
+
+class MassBudgetLog:
+    """Append-only mass-budget log with incremental violation tracking.
+
+    CSV logs are appended with :func:`writer.append_csv`.  Parquet logs keep a
+    :class:`writer.ParquetAppender` open and add one row group per
+    :meth:`append` call; :meth:`close` must be called to write the footer.
+    """
+
+    def __init__(
+        self,
+        path: Path,
+        *,
+        fmt: str = "csv",
+        compression: str = "snappy",
+        tolerance_percent: Optional[float] = None,
+    ) -> None:
+        self.fmt = normalise_format(fmt)
+        self.path = Path(path)
+        self.compression = None if compression == "none" else compression
+        self.tolerance_percent = tolerance_percent
+        self.header_written = False
+        self.rows_written = 0
+        self.max_error_percent = 0.0
+        self.first_violation: Optional[Dict[str, Any]] = None
+        self._appender: Optional[writer.ParquetAppender] = None
+
+    def _track(self, rows: Sequence[Mapping[str, Any]]) -> None:
+        for row in rows:
+            value = row.get(ERROR_COLUMN)
+            try:
+                err = abs(float(value))
+            except (TypeError, ValueError):
+                continue
+            if not math.isfinite(err):
+                continue
+            if err > self.max_error_percent:
+                self.max_error_percent = err
+            tol = self.tolerance_percent
+            if tol is None:
+                tol = row.get("tolerance_percent")
+            if self.first_violation is None and tol is not None and err > float(tol):
+                self.first_violation = dict(row)
+
+    def append(self, records: Iterable[Mapping[str, Any]]) -> bool:
+        """Append records to the log; returns True when rows were written."""
+
+        rows = list(records)
+        if not rows:
+            return False
+        self._track(rows)
+        if self.fmt == "csv":
+            if not self.header_written and self.path.exists():
+                # Stale log from an earlier run in the same outdir.
+                self.path.unlink()
+            wrote = writer.append_csv(rows, self.path, header=not self.header_written)
+        else:
+            if self._appender is None:
+                # Resumed run: carry the rows of the previous segment over so
+                # the rewritten file stays complete.
+                self._appender = writer.ParquetAppender(
+                    self.path,
+                    compression=self.compression,
+                    carry_existing=self.header_written,
+                )
+            wrote = self._appender.append_rows(rows)
+        self.header_written = self.header_written or wrote
+        self.rows_written += len(rows)
+        return wrote
+
+    def trim_after(self, cutoff_time: float) -> int:
+        """Drop logged rows with ``time >= cutoff_time`` before a resumed run appends.
+
+        The surviving rows are re-tracked and the log is marked as started, so
+        the resumed segment continues it instead of replacing it.  Returns the
+        number of rows removed.
+        """
+
+        if self._appender is not None or not self.path.exists():
+            return 0
+        try:
+            frame = read_mass_budget(self.path)
+        except Exception as exc:
+            logger.warning("Failed to read %s for resume trimming: %s", self.path, exc)
+            return 0
+        if "time" not in frame.columns:
+            self.header_written = True
+            return 0
+        keep = pd.to_numeric(frame["time"], errors="coerce") < float(cutoff_time)
+        removed = int((~keep).sum())
+        frame = frame.loc[keep]
+        if removed:
+            if self.fmt == "csv":
+                frame.to_csv(self.path, index=False)
+            else:
+                pq.write_table(
+                    pa.Table.from_pandas(frame, preserve_index=False),
+                    self.path,
+                    compression=self.compression,
+                )
+        self._track(frame.to_dict(orient="records"))
+        self.rows_written = len(frame)
+        self.header_written = True
+        return removed
+
+    def ensure_exists(self, columns: Sequence[str]) -> None:
+        """Create an empty log with ``columns`` when nothing was written."""
+
+        if (self._appender is not None and self._appender.is_open) or self.path.exists():
+            return
+        writer._ensure_parent(self.path)
+        empty = pd.DataFrame(columns=list(columns))
+        if self.fmt == "csv":
+            empty.to_csv(self.path, index=False)
+        else:
+            schema = pa.schema([(name, pa.float64()) for name in columns])
+            pq.write_table(schema.empty_table(), self.path, compression=self.compression)
+        self.header_written = True
+
+    def close(self) -> None:
+        """Finalise the Parquet footer; CSV logs need no explicit close."""
+
+        if self._appender is not None:
+            self._appender.close()
+            self._appender = None
+
+
+def resolve_existing_path(checks_dir: Path, stem: str = "mass_budget") -> Optional[Path]:
+    """Return the freshest of ``<stem>.parquet`` / ``<stem>.csv`` if any exists."""
+
+    csv_path = Path(checks_dir) / f"{stem}.csv"
+    parquet_path = csv_path.with_suffix(".parquet")
+    if parquet_path.exists():
+        if not csv_path.exists() or parquet_path.stat().st_mtime >= csv_path.stat().st_mtime:
+            return parquet_path
+    if csv_path.exists():
+        return csv_path
+    return None
+
+
+def read_mass_budget(path: Path, columns: Optional[List[str]] = None) -> pd.DataFrame:
+    """Read a mass-budget log in either format, optionally projecting columns."""
+
+    path = Path(path)
+    if path.suffix == ".parquet":
+        return pq.read_table(path, columns=columns).to_pandas()
+    return pd.read_csv(path, usecols=columns)
+
+
+def max_error_percent(path: Path, column: str = ERROR_COLUMN) -> Optional[float]:
+    """Return max |error| from a log without materialising the other columns.
+
+    Parquet logs are answered from row-group statistics when every row group
+    carries them, so no data pages are decoded.
+    """
+
+    path = Path(path)
+    if path.suffix == ".parquet":
+        pf = pq.ParquetFile(path)
+        try:
+            col_idx = pf.schema_arrow.get_field_index(column)
+        except KeyError:
+            col_idx = -1
+        if col_idx < 0:
+            return None
+        meta = pf.metadata
+        extrema: Optional[List[float]] = []
+        for rg in range(meta.num_row_groups):
+            stats = meta.row_group(rg).column(col_idx).statistics
+            if stats is None or not stats.has_min_max:
+                extrema = None
+                break
+            extrema.append(max(abs(float(stats.min)), abs(float(stats.max))))
+        if extrema is not None:
+            return max(extrema) if extrema else None
+        values = pf.read(columns=[column]).column(0).to_pandas()
+    else:
+        values = pd.read_csv(path, usecols=[column])[column]
+    if values.empty:
+        return None
+    result = values.abs().max()
+    return float(result) if pd.notna(result) else None
+
+
+def export_csv(source: Path, destination: Optional[Path] = None) -> Path:
+    """Convert a Parquet mass-budget log into the legacy CSV layout."""
+
+    source = Path(source)
+    dest = Path(destination) if destination is not None else source.with_suffix(".csv")
+    writer._ensure_parent(dest)
+    pf = pq.ParquetFile(source)
+    header = True
+    if dest.exists():
+        dest.unlink()
+    for rg in range(pf.metadata.num_row_groups):
+        frame = pf.read_row_group(rg).to_pandas()
+        frame.to_csv(dest, mode="a", header=header, index=False)
+        header = False
+    if header:
+        pd.DataFrame(columns=pf.schema_arrow.names).to_csv(dest, index=False)
+    return dest
+
+
+__all__ = [
+    "MASS_BUDGET_FORMATS",
+    "MassBudgetLog",
+    "export_csv",
+    "mass_budget_path",
+    "max_error_percent",
+    "normalise_format",
+    "read_mass_budget",
+    "resolve_existing_path",
+]
@@ -0,0 +1,227 @@
+"""Inspect and salvage runs that stopped before writing their final summary.
+
+Streaming runs refresh ``summary.partial.json`` (``summary_status="partial"``)
+after every chunk flush (see :meth:`StreamingState.write_partial_summary`);
+``summary.json`` only appears once a run has finished.  When a run is killed,
+the partial file records how far the integration got, the chunks that
+were already on disk and the most recent checkpoint.  The helpers here turn it
+into a resume plan and can merge the surviving chunks into the usual
+``series/*.parquet`` files so the partial run can still be analysed.
+"""
+from __future__ import annotations
+
+import json
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Any, Dict, List, Optional
+
+from . import checkpoint as checkpoint_io
+from .streaming import CHUNK_PATTERN, PARTIAL_SUMMARY_NAME, StreamingState
+
+SUMMARY_PARTIAL = "partial"
+SUMMARY_COMPLETE = "complete"
+SUMMARY_MISSING = "missing"
+
+
+@dataclass
+class RecoveryInfo:
+    """What is known about a run directory and how it can be resumed."""
+
+    run_dir: Path
+    status: str
+    time_s: Optional[float] = None
+    step_no: Optional[int] = None
+    n_steps: Optional[int] = None
+    t_end: Optional[float] = None
+    M_loss: Optional[float] = None
+    rng_seed: Optional[int] = None
+    latest_chunk: Optional[Path] = None
+    latest_chunk_step_end: Optional[int] = None
+    latest_checkpoint: Optional[Path] = None
+    summary: Dict[str, Any] = field(default_factory=dict)
+
+    @property
+    def resumable(self) -> bool:
+        return self.status == SUMMARY_PARTIAL and self.latest_checkpoint is not None
+
+    @property
+    def remaining_fraction(self) -> float:
+        """Fraction of the integration still to run (1 for a fresh or unresumable case)."""
+
+        if self.status == SUMMARY_COMPLETE:
+            return 0.0
+        if not self.resumable:
+            return 1.0
+        if self.time_s is not None and self.t_end:
+            done = float(self.time_s) / float(self.t_end)
+        elif self.step_no is not None and self.n_steps:
+            done = (float(self.step_no) + 1.0) / float(self.n_steps)
+        else:
+            return 1.0
+        return min(max(1.0 - done, 0.0), 1.0)
+
+    @property
+    def sweep_action(self) -> str:
+        """``"skip"`` (finished), ``"resume"`` (checkpoint available) or ``"fresh"``."""
+
+        if self.status == SUMMARY_COMPLETE:
+            return "skip"
+        if self.resumable:
+            return "resume"
+        return "fresh"
+
+    def resume_overrides(self) -> List[str]:
+        """``--override`` entries that restart the run from the checkpoint."""
+
+        if self.latest_checkpoint is None:
+            return []
+        return [
+            "numerics.checkpoint.enabled=true",
+            "numerics.resume.enabled=true",
+            f"numerics.resume.from_path={self.latest_checkpoint}",
+        ]
+
+    def as_dict(self) -> Dict[str, Any]:
+        return {
+            "run_dir": str(self.run_dir),
+            "status": self.status,
+            "time_s": self.time_s,
+            "step_no": self.step_no,
+            "n_steps": self.n_steps,
+            "t_end": self.t_end,
+            "M_loss": self.M_loss,
+            "rng_seed": self.rng_seed,
+            "latest_chunk": str(self.latest_chunk) if self.latest_chunk else None,
+            "latest_chunk_step_end": self.latest_chunk_step_end,
+            "latest_checkpoint": str(self.latest_checkpoint) if self.latest_checkpoint else None,
+            "resumable": self.resumable,
+            "remaining_fraction": self.remaining_fraction,
+            "resume_overrides": self.resume_overrides(),
+        }
+
+
+def load_summary(run_dir: Path) -> Optional[Dict[str, Any]]:
+    """Return the final summary, else the partial one, else ``None``."""
+
+    for name in ("summary.json", PARTIAL_SUMMARY_NAME):
+        path = Path(run_dir) / name
+        if path.exists():
+            with path.open("r", encoding="utf-8") as fh:
+                return json.load(fh)
+    return None
+
+
+def _summary_status(summary: Optional[Dict[str, Any]]) -> str:
+    if summary is None:
+        return SUMMARY_MISSING
+    # Summaries written before incremental updates carry no status and are final.
+    return str(summary.get("summary_status") or SUMMARY_COMPLETE)
+
+
+def _latest_run_chunk(run_dir: Path, summary: Dict[str, Any]) -> Optional[Path]:
+    streaming = summary.get("streaming") or {}
+    candidates = [Path(p) for p in streaming.get("run_chunks") or []]
+    candidates.extend(sorted((Path(run_dir) / "series").glob("run_chunk_*.parquet")))
+    existing = [p for p in candidates if p.exists() and CHUNK_PATTERN.match(p.name)]
+    if not existing:
+        return None
+    return max(existing, key=_chunk_steps)
+
+
+def _chunk_steps(path: Path) -> tuple[int, int]:
+    match = CHUNK_PATTERN.match(path.name)
+    if match is None:
+        return (-1, -1)
+    return int(match.group(1)), int(match.group(2))
+
+
+def inspect_run(run_dir: Path, *, checkpoint_dir: Optional[Path] = None) -> RecoveryInfo:
+    """Summarise the recovery state of ``run_dir``."""
+
+    run_dir = Path(run_dir)
+    summary = load_summary(run_dir)
+    info = RecoveryInfo(run_dir=run_dir, status=_summary_status(summary), summary=summary or {})
+    if summary is None:
+        return info
+    info.time_s = summary.get("time")
+    info.step_no = summary.get("step_no")
+    info.n_steps = summary.get("n_steps")
+    info.t_end = summary.get("t_end")
+    info.M_loss = summary.get("M_loss")
+    if summary.get("rng_seed") is not None:
+        info.rng_seed = int(summary["rng_seed"])
+    info.latest_chunk = _latest_run_chunk(run_dir, summary)
+    if info.latest_chunk is not None:
+        info.latest_chunk_step_end = _chunk_steps(info.latest_chunk)[1]
+    ckpt: Optional[Path] = None
+    recorded = summary.get("latest_checkpoint")
+    if recorded and Path(recorded).exists():
+        ckpt = Path(recorded)
+    search_dir = Path(checkpoint_dir) if checkpoint_dir is not None else run_dir / "checkpoints"
+    found = checkpoint_io.find_latest_checkpoint(search_dir)
+    if found is not None and (ckpt is None or found.name > ckpt.name):
+        ckpt = found
+    info.latest_checkpoint = ckpt
+    return info
+
+
+def clear_partial_outputs(run_dir: Path, *, checkpoint_dir: Optional[Path] = None) -> List[Path]:
+    """Remove chunks, checkpoints and the partial summary before a fresh restart.
+
+    A run that died before its first checkpoint cannot be resumed; starting it
+    again must not leave stale chunks to be merged or stale checkpoints to be
+    picked up as "latest" by a later resume.
+    """
+
+    run_dir = Path(run_dir)
+    targets: List[Path] = sorted((run_dir / "series").glob("*_chunk_*.parquet"))
+    ckpt_dir = Path(checkpoint_dir) if checkpoint_dir is not None else run_dir / "checkpoints"
+    if ckpt_dir.is_dir():
+        targets.extend(sorted(ckpt_dir.glob("ckpt_step_*")))
+    if (run_dir / PARTIAL_SUMMARY_NAME).exists():
+        targets.append(run_dir / PARTIAL_SUMMARY_NAME)
+    summary_path = run_dir / "summary.json"
+    if summary_path.exists() and _summary_status(load_summary(run_dir)) == SUMMARY_PARTIAL:
+        # Runs from before summary.partial.json refreshed summary.json itself.
+        targets.append(summary_path)
+    removed: List[Path] = []
+    for path in targets:
+        try:
+            path.unlink()
+            removed.append(path)
+        except OSError:
+            continue
+    return removed
+
+
+def merge_partial_outputs(run_dir: Path) -> List[Path]:
+    """Merge surviving chunks into ``series/*.parquet`` without deleting them."""
+
+    run_dir = Path(run_dir)
+    state = StreamingState(
+        enabled=True,
+        outdir=run_dir,
+        merge_at_end=True,
+        cleanup_chunks=False,
+    )
+    state.discover_existing_chunks()
+    state.merge_chunks()
+    written = []
+    for name in ("run.parquet", "diagnostics.parquet", "psd_hist.parquet"):
+        path = run_dir / "series" / name
+        if path.exists():
+            written.append(path)
+    return written
+
+
+__all__ = [
+    "PARTIAL_SUMMARY_NAME",
+    "RecoveryInfo",
+    "SUMMARY_COMPLETE",
+    "SUMMARY_MISSING",
+    "SUMMARY_PARTIAL",
+    "clear_partial_outputs",
+    "inspect_run",
+    "load_summary",
+    "merge_partial_outputs",
+]
@@ -7,14 +7,18 @@ import logging
 import os
 import re
 import shutil
+import time
 from pathlib import Path
-from typing import Dict, List, Optional, Tuple
+from typing import Any, Dict, List, Mapping, Optional, Tuple
 
+import pandas as pd
 import pyarrow as pa
+import pyarrow.compute as pc
 import pyarrow.parquet as pq
 
 from marsdisk.runtime.history import ColumnarBuffer, ZeroDHistory
 from . import writer
+from . import mass_budget as mass_budget_io
 
 logger = logging.getLogger(__name__)
 
@@ -24,6 +28,8 @@ MEMORY_PSD_ROW_BYTES = 320.0
 MEMORY_DIAG_ROW_BYTES = 1400.0
 
 CHUNK_PATTERN = re.compile(r".*_chunk_(\d+)_(\d+)\.parquet$")
+# Progress of a running (or killed) streaming run; summary.json is only written at the end.
+PARTIAL_SUMMARY_NAME = "summary.partial.json"
 
 
 class StreamingState:
@@ -43,14 +49,19 @@ class StreamingState:
         step_diag_enabled: bool = False,
         step_diag_path: Optional[Path] = None,
         step_diag_format: str = "csv",
+        step_diag_compression: str = "zstd",
         series_columns: Optional[List[str]] = None,
         diagnostic_columns: Optional[List[str]] = None,
+        drop_extra_columns: bool = False,
+        float32_columns: Optional[List[str]] = None,
         offload_enabled: bool = False,
         offload_dir: Optional[Path] = None,
         offload_keep_last_n: int = 2,
         offload_mode: str = "move",
         offload_verify: str = "size",
         offload_skip_if_same_device: bool = True,
+        mass_budget_format: str = "csv",
+        partial_summary: bool = False,
     ) -> None:
         self.enabled = bool(enabled)
         self.outdir = Path(outdir)
@@ -63,18 +74,34 @@ class StreamingState:
         self.step_diag_enabled = bool(step_diag_enabled)
         self.step_diag_path = step_diag_path if step_diag_enabled else None
         self.step_diag_format = step_diag_format
+        self.step_diag_compression = step_diag_compression
+        self._step_diag_appender: Optional[writer.ParquetAppender] = None
         self.chunk_index = 0
         self.chunk_start_step = 0
         self.run_chunks: List[Path] = []
         self.psd_chunks: List[Path] = []
         self.diag_chunks: List[Path] = []
-        self.mass_budget_path: Path = self.outdir / "checks" / "mass_budget.csv"
-        self.mass_budget_header_written = False
-        self.mass_budget_cells_path: Path = self.outdir / "checks" / "mass_budget_cells.csv"
-        self.mass_budget_cells_header_written = False
+        checks_dir = self.outdir / "checks"
+        self.mass_budget_log = mass_budget_io.MassBudgetLog(
+            mass_budget_io.mass_budget_path(checks_dir, "mass_budget", mass_budget_format),
+            fmt=mass_budget_format,
+            compression=compression,
+        )
+        self.mass_budget_cells_log = mass_budget_io.MassBudgetLog(
+            mass_budget_io.mass_budget_path(checks_dir, "mass_budget_cells", mass_budget_format),
+            fmt=mass_budget_format,
+            compression=compression,
+        )
         self.step_diag_header_written = False
+        self.partial_summary_enabled = bool(partial_summary) and self.enabled
+        self.flush_count = 0
+        self.flush_seconds = 0.0
+        self.rows_flushed = 0
+        self.last_flush_step: Optional[int] = None
         self.series_columns = series_columns
         self.diagnostic_columns = diagnostic_columns
+        self.drop_extra_columns = bool(drop_extra_columns)
+        self.float32_columns = list(float32_columns) if float32_columns else None
         self.offload_enabled = bool(offload_enabled) and self.enabled
         self.offload_dir = Path(offload_dir) if offload_dir is not None else None
         self.offload_keep_last_n = max(int(offload_keep_last_n), 0)
@@ -87,6 +114,51 @@ class StreamingState:
         except OSError:
             self._outdir_device = None
 
+    @property
+    def mass_budget_path(self) -> Path:
+        return self.mass_budget_log.path
+
+    @property
+    def mass_budget_cells_path(self) -> Path:
+        return self.mass_budget_cells_log.path
+
+    @property
+    def mass_budget_header_written(self) -> bool:
+        return self.mass_budget_log.header_written
+
+    @mass_budget_header_written.setter
+    def mass_budget_header_written(self, value: bool) -> None:
+        self.mass_budget_log.header_written = bool(value)
+
+    @property
+    def mass_budget_cells_header_written(self) -> bool:
+        return self.mass_budget_cells_log.header_written
+
+    @mass_budget_cells_header_written.setter
+    def mass_budget_cells_header_written(self, value: bool) -> None:
+        self.mass_budget_cells_log.header_written = bool(value)
+
+    def flush_mass_budget(self, history: ZeroDHistory) -> None:
+        """Append buffered mass-budget rows to the logs (streaming or not)."""
+
+        if history.mass_budget:
+            self.mass_budget_log.append(history.mass_budget)
+            history.mass_budget.clear()
+        if history.mass_budget_cells:
+            self.mass_budget_cells_log.append(history.mass_budget_cells)
+            history.mass_budget_cells.clear()
+
+    def close_step_diagnostics(self) -> None:
+        """Write the Parquet footer of the step diagnostics log, if any."""
+
+        if self._step_diag_appender is not None:
+            self._step_diag_appender.close()
+            self._step_diag_appender = None
+
+    def close_mass_budget(self) -> None:
+        self.mass_budget_log.close()
+        self.mass_budget_cells_log.close()
+
     def _estimate_bytes(self, history: ZeroDHistory) -> float:
         run_bytes = len(history.records) * MEMORY_RUN_ROW_BYTES
         psd_bytes = len(history.psd_hist_records) * MEMORY_PSD_ROW_BYTES
@@ -285,6 +357,153 @@ class StreamingState:
         self.diag_chunks = self._merge_discovered_chunks(local_diag, offload_diag)
         self.psd_chunks = self._merge_discovered_chunks(local_psd, offload_psd)
 
+    def resume_from_checkpoint(self, step_no: int, time_s: float, dt_s: float) -> Dict[str, int]:
+        """Pick up the outputs of an interrupted run resumed after ``step_no``.
+
+        Rows are stamped with the end time of their step, so rows later than
+        ``time_s`` (the end of the checkpointed step) belong to steps the
+        resumed run integrates again.  Chunks starting after the checkpoint are
+        removed, a chunk straddling it is cut back to ``step_no`` and the
+        mass-budget / step-diagnostics logs are trimmed the same way.  A gap is
+        reported when the chunks on disk end before the checkpoint.
+
+        An interrupted run whose shutdown hook still ran has already merged its
+        chunks into ``series/run.parquet`` (and friends) and removed them; such
+        merged files are taken back as the leading chunk so the resumed run
+        appends to them instead of replacing them.
+        """
+
+        report = {
+            "chunks_kept": 0,
+            "chunks_removed": 0,
+            "chunks_trimmed": 0,
+            "merged_adopted": 0,
+            "rows_trimmed": 0,
+            "gap_steps": 0,
+        }
+        if not self.enabled:
+            return report
+        step_no = int(step_no)
+        cutoff = float(time_s) + 0.5 * abs(float(dt_s))
+        self.discover_existing_chunks()
+        report["merged_adopted"] = self._adopt_merged_outputs(step_no)
+        last_end = -1
+        for chunks in (self.run_chunks, self.diag_chunks, self.psd_chunks):
+            kept: List[Path] = []
+            for path in chunks:
+                start, end, _ = self._chunk_sort_key(path)
+                if start > step_no:
+                    self._cleanup_chunk_files([path])
+                    report["chunks_removed"] += 1
+                    continue
+                if end > step_no:
+                    trimmed = self._trim_chunk(path, start, step_no, cutoff)
+                    report["chunks_trimmed"] += 1
+                    if trimmed is None:
+                        continue
+                    path, end = trimmed, step_no
+                if chunks is self.run_chunks:
+                    last_end = max(last_end, end)
+                kept.append(path)
+            chunks[:] = kept
+        report["chunks_kept"] = len(self.run_chunks) + len(self.diag_chunks) + len(self.psd_chunks)
+        if self.run_chunks and last_end < step_no:
+            report["gap_steps"] = step_no - last_end
+            logger.warning(
+                "Resumed run: chunks end at step %d but the checkpoint is at step %d; "
+                "series rows in between are missing",
+                last_end,
+                step_no,
+            )
+        report["rows_trimmed"] += self.mass_budget_log.trim_after(cutoff)
+        report["rows_trimmed"] += self.mass_budget_cells_log.trim_after(cutoff)
+        if self.step_diag_enabled and self.step_diag_path is not None and self.step_diag_path.exists():
+            report["rows_trimmed"] += self._trim_step_diagnostics(cutoff)
+            self.step_diag_header_written = True
+        self.chunk_index = len(self.run_chunks)
+        self.chunk_start_step = step_no + 1
+        return report
+
+    def _adopt_merged_outputs(self, step_no: int) -> int:
+        """Move merged outputs without chunks of their kind back into a chunk.
+
+        The merged file covers the run from its first step and may extend past
+        the checkpoint, so it is named as a chunk ending after ``step_no`` and
+        the caller cuts it back like any other straddling chunk.  When chunks
+        of the same kind are still on disk (``cleanup_chunks`` off) the merged
+        file only repeats them and is rebuilt at the end anyway.
+        """
+
+        merge_root = self.merge_outdir if self.merge_outdir is not None else self.outdir
+        series_dir = self.outdir / "series"
+        adopted = 0
+        for prefix, chunks in (
+            ("run", self.run_chunks),
+            ("diagnostics", self.diag_chunks),
+            ("psd_hist", self.psd_chunks),
+        ):
+            merged = merge_root / "series" / f"{prefix}.parquet"
+            if chunks or not merged.exists():
+                continue
+            dest = series_dir / f"{prefix}_chunk_{0:09d}_{step_no + 1:09d}.parquet"
+            try:
+                writer._ensure_parent(dest)
+                shutil.move(str(merged), str(dest))
+            except OSError as exc:
+                logger.warning("Failed to adopt merged output %s for resume: %s", merged, exc)
+                continue
+            chunks.append(dest)
+            adopted += 1
+        return adopted
+
+    def _trim_chunk(self, path: Path, start: int, step_no: int, cutoff: float) -> Optional[Path]:
+        try:
+            table = pq.read_table(path)
+        except Exception as exc:
+            logger.warning("Failed to read chunk %s for resume trimming: %s", path, exc)
+            self._cleanup_chunk_files([path])
+            return None
+        if "time" in table.column_names:
+            mask = pc.less(table.column("time"), pa.scalar(cutoff, type=table.schema.field("time").type))
+            table = table.filter(pc.fill_null(mask, False))
+        if table.num_rows == 0:
+            self._cleanup_chunk_files([path])
+            return None
+        prefix = path.name.split("_chunk_")[0]
+        dest = path.with_name(f"{prefix}_chunk_{start:09d}_{step_no:09d}.parquet")
+        # Write the cut-back chunk before dropping the original.
+        pq.write_table(table, dest, compression=self.compression)
+        self._cleanup_chunk_files([path])
+        return dest
+
+    def _trim_step_diagnostics(self, cutoff: float) -> int:
+        path = self.step_diag_path
+        if path is None:
+            return 0
+        try:
+            if self.step_diag_format == "parquet":
+                frame = pq.read_table(path).to_pandas()
+            elif self.step_diag_format == "jsonl":
+                frame = pd.read_json(path, lines=True)
+            else:
+                frame = pd.read_csv(path)
+        except Exception as exc:
+            logger.warning("Failed to read %s for resume trimming: %s", path, exc)
+            return 0
+        if "time" not in frame.columns:
+            return 0
+        keep = pd.to_numeric(frame["time"], errors="coerce") < cutoff
+        removed = int((~keep).sum())
+        if removed:
+            frame = frame.loc[keep]
+            if self.step_diag_format == "parquet":
+                pq.write_table(pa.Table.from_pandas(frame, preserve_index=False), path)
+            elif self.step_diag_format == "jsonl":
+                frame.to_json(path, orient="records", lines=True)
+            else:
+                frame.to_csv(path, index=False)
+        return removed
+
     def _scan_chunks(self, root: Path, pattern: str) -> List[Path]:
         if not root.exists():
             return []
@@ -349,12 +568,21 @@ class StreamingState:
             by_name[chunk.name] = chosen
         return self._sort_chunks(list(by_name.values()))
 
+    def _column_kwargs(self, columns: Optional[List[str]]) -> Dict[str, object]:
+        return {
+            "ensure_columns": columns,
+            "drop_extra_columns": self.drop_extra_columns,
+            "float32_columns": self.float32_columns,
+        }
+
     def flush(self, history: ZeroDHistory, step_end: int) -> None:
         if not self.enabled:
             return
+        flush_start = time.perf_counter()
         label = self._chunk_label(step_end)
         series_dir = self.outdir / "series"
         wrote_any = False
+        self.rows_flushed += len(history.records)
         if history.records:
             path = series_dir / f"run_chunk_{label}.parquet"
             if isinstance(history.records, ColumnarBuffer):
@@ -364,6 +592,7 @@ class StreamingState:
                         table,
                         path,
                         compression=self.compression,
+                        **self._column_kwargs(self.series_columns),
                     )
                 except Exception as exc:
                     logger.warning("Columnar flush failed for %s: %s; falling back to row write", path, exc)
@@ -371,14 +600,14 @@ class StreamingState:
                         history.records.to_records(),
                         path,
                         compression=self.compression,
-                        ensure_columns=self.series_columns,
+                        **self._column_kwargs(self.series_columns),
                     )
             else:
                 writer.write_parquet(
                     history.records,
                     path,
                     compression=self.compression,
-                    ensure_columns=self.series_columns,
+                    **self._column_kwargs(self.series_columns),
                 )
             self.run_chunks.append(path)
             history.records.clear()
@@ -398,6 +627,7 @@ class StreamingState:
                         table,
                         path,
                         compression=self.compression,
+                        **self._column_kwargs(self.diagnostic_columns),
                     )
                 except Exception as exc:
                     logger.warning(
@@ -409,46 +639,88 @@ class StreamingState:
                         history.diagnostics.to_records(),
                         path,
                         compression=self.compression,
-                        ensure_columns=self.diagnostic_columns,
+                        **self._column_kwargs(self.diagnostic_columns),
                     )
             else:
                 writer.write_parquet(
                     history.diagnostics,
                     path,
                     compression=self.compression,
-                    ensure_columns=self.diagnostic_columns,
+                    **self._column_kwargs(self.diagnostic_columns),
                 )
             self.diag_chunks.append(path)
             history.diagnostics.clear()
             wrote_any = True
-        if history.mass_budget:
-            header = not self.mass_budget_header_written
-            wrote = writer.append_csv(history.mass_budget, self.mass_budget_path, header=header)
-            self.mass_budget_header_written = self.mass_budget_header_written or wrote
-            history.mass_budget.clear()
-        if history.mass_budget_cells:
-            header = not self.mass_budget_cells_header_written
-            wrote = writer.append_csv(
-                history.mass_budget_cells,
-                self.mass_budget_cells_path,
-                header=header,
-            )
-            self.mass_budget_cells_header_written = self.mass_budget_cells_header_written or wrote
-            history.mass_budget_cells.clear()
+        self.flush_mass_budget(history)
         if self.step_diag_enabled and history.step_diag_records and self.step_diag_path is not None:
-            header = not self.step_diag_header_written
-            wrote = writer.append_step_diagnostics(
-                history.step_diag_records,
-                self.step_diag_path,
-                fmt=self.step_diag_format,
-                header=header,
-            )
+            if self.step_diag_format == "parquet":
+                if self._step_diag_appender is None:
+                    self._step_diag_appender = writer.ParquetAppender(
+                        self.step_diag_path,
+                        compression=self.step_diag_compression,
+                        carry_existing=self.step_diag_header_written,
+                    )
+                wrote = self._step_diag_appender.append_rows(history.step_diag_records)
+            else:
+                header = not self.step_diag_header_written
+                wrote = writer.append_step_diagnostics(
+                    history.step_diag_records,
+                    self.step_diag_path,
+                    fmt=self.step_diag_format,
+                    header=header,
+                )
             self.step_diag_header_written = self.step_diag_header_written or wrote
             history.step_diag_records.clear()
         if wrote_any:
             self.chunk_index += 1
             self.chunk_start_step = step_end + 1
             self._offload_old_chunks()
+        self.flush_count += 1
+        self.last_flush_step = int(step_end)
+        self.flush_seconds += time.perf_counter() - flush_start
+
+    def write_partial_summary(self, payload: Mapping[str, Any]) -> None:
+        """Atomically refresh ``summary.partial.json`` with the state of the last flush.
+
+        ``payload`` carries the runner state (time, cumulative losses, perf
+        counters); the chunk bookkeeping needed to resume or merge a killed run
+        is added here.  The file is kept apart from ``summary.json`` so tools
+        that take an existing ``summary.json`` as "run finished" never see a
+        half-done run; :meth:`clear_partial_summary` drops it once the final
+        summary is written.
+        """
+
+        if not self.partial_summary_enabled:
+            return
+        summary: Dict[str, Any] = dict(payload)
+        summary["summary_status"] = "partial"
+        summary["streaming"] = {
+            "chunk_index": self.chunk_index,
+            "next_chunk_start_step": self.chunk_start_step,
+            "last_flush_step": self.last_flush_step,
+            "flush_count": self.flush_count,
+            "flush_seconds": self.flush_seconds,
+            "rows_flushed": self.rows_flushed,
+            "run_chunks": [str(path) for path in self.run_chunks],
+            "diagnostics_chunks": [str(path) for path in self.diag_chunks],
+            "psd_hist_chunks": [str(path) for path in self.psd_chunks],
+            "mass_budget_path": str(self.mass_budget_path),
+            "mass_budget_max_error_percent": self.mass_budget_log.max_error_percent,
+        }
+        try:
+            writer.write_summary(summary, self.outdir / PARTIAL_SUMMARY_NAME)
+        except (OSError, TypeError, ValueError) as exc:
+            logger.warning("Failed to refresh partial summary in %s: %s", self.outdir, exc)
+
+    def clear_partial_summary(self) -> None:
+        """Remove ``summary.partial.json`` after the final summary was written."""
+
+        try:
+            (self.outdir / PARTIAL_SUMMARY_NAME).unlink()
+        except FileNotFoundError:
+            pass
+        except OSError as exc:
+            logger.warning("Failed to remove partial summary in %s: %s", self.outdir, exc)
 
     def merge_chunks(self) -> None:
         if not self.enabled or not self.merge_at_end:
@@ -573,6 +845,7 @@ class StreamingState:
 
 __all__ = [
     "StreamingState",
+    "PARTIAL_SUMMARY_NAME",
     "MEMORY_RUN_ROW_BYTES",
     "MEMORY_PSD_ROW_BYTES",
     "MEMORY_DIAG_ROW_BYTES",
@@ -0,0 +1,353 @@
+"""Parallel, incremental collection of per-run sweep outputs.
+
+Sweep post-processing used to open every run directory in turn and read
+``summary.json``, the full ``series/run.parquet`` and
+``checks/mass_budget.csv``.  :func:`collect_runs` builds one record per run
+instead:
+
+* ``summary.json`` is parsed on a thread pool.  Numeric top-level fields
+  become ``summary.<key>`` columns and the raw text is kept in
+  ``summary_json``.  ``summary_status`` is carried as a column; a run with
+  only ``summary.partial.json`` or a legacy partial ``summary.json``
+  contributes nothing else, so unfinished runs never look like results.
+* ``series/run.parquet`` contributes the row count and per-column min/max
+  from the footer statistics (no data pages), plus the last value of each
+  requested column, read from the final row group only.
+* ``checks/mass_budget.csv`` is read with a column projection; a Parquet
+  ``checks/mass_budget.parquet`` log is answered from its footer.
+
+Records are cached in one Arrow IPC file, keyed by run directory, with a
+``(size, mtime_ns)`` fingerprint of the input files.  A later call re-reads
+only the runs that are new or whose inputs changed, and drops runs that are
+gone.  :func:`collect_series` applies the same fingerprinting to the
+concatenated series table.
+"""
+from __future__ import annotations
+
+import hashlib
+import json
+import math
+import os
+from concurrent.futures import ThreadPoolExecutor
+from pathlib import Path
+from typing import Any, Dict, Iterable, List, Mapping, Optional, Sequence, Tuple
+
+import numpy as np
+import pandas as pd
+import pyarrow as pa
+import pyarrow.compute as pc
+import pyarrow.csv as pa_csv
+import pyarrow.feather as feather
+import pyarrow.parquet as pq
+
+from . import mass_budget as mass_budget_io
+from .streaming import PARTIAL_SUMMARY_NAME
+
+SUMMARY_NAME = "summary.json"
+SERIES_RELPATH = Path("series") / "run.parquet"
+BUDGET_RELPATH = Path("checks") / "mass_budget.csv"
+BUDGET_PARQUET_RELPATH = BUDGET_RELPATH.with_suffix(".parquet")
+DEFAULT_SERIES_COLUMNS: Tuple[str, ...] = ("time", "tau", "tau_los_mars", "s_min", "a_blow")
+DEFAULT_BUDGET_COLUMNS: Tuple[str, ...] = ("error_percent",)
+CACHE_METADATA_KEY = b"marsdisk.sweep_collect"
+SERIES_METADATA_KEY = b"marsdisk.collect_series"
+# Bump when the record layout changes so older caches are re-collected.
+RECORD_VERSION = "2"
+DEFAULT_IO_WORKERS = min(32, 4 * (os.cpu_count() or 1))
+
+
+def _file_stamp(path: Path) -> str:
+    try:
+        stat = path.stat()
+    except OSError:
+        return "-"
+    return f"{int(stat.st_size)}:{int(stat.st_mtime_ns)}"
+
+
+def run_fingerprint(run_dir: Path) -> str:
+    """``size:mtime_ns`` of the summary, series and mass-budget files (CSV and Parquet)."""
+
+    run_dir = Path(run_dir)
+    return "|".join(
+        _file_stamp(run_dir / rel)
+        for rel in (Path(SUMMARY_NAME), SERIES_RELPATH, BUDGET_RELPATH, BUDGET_PARQUET_RELPATH)
+    )
+
+
+def _stat_value(value: Any) -> float:
+    try:
+        return float(value)
+    except (TypeError, ValueError):
+        return float("nan")
+
+
+def series_stats(path: Path, columns: Sequence[str]) -> Dict[str, Any]:
+    """Row count, min/max from row-group statistics, and last values.
+
+    Only the footer and the requested columns of the last row group are
+    read.
+    """
+
+    record: Dict[str, Any] = {}
+    if not path.exists():
+        return record
+    parquet = pq.ParquetFile(path)
+    meta = parquet.metadata
+    record["series_rows"] = int(meta.num_rows)
+    names = parquet.schema_arrow.names
+    present = [name for name in columns if name in names]
+    if not present or meta.num_row_groups == 0:
+        return record
+    index = {meta.row_group(0).column(i).path_in_schema: i for i in range(meta.num_columns)}
+    for name in present:
+        lo, hi = math.inf, -math.inf
+        complete = True
+        for rg in range(meta.num_row_groups):
+            stats = meta.row_group(rg).column(index[name]).statistics
+            if stats is None or not stats.has_min_max:
+                complete = False
+                break
+            lo = min(lo, _stat_value(stats.min))
+            hi = max(hi, _stat_value(stats.max))
+        record[f"series.{name}.min"] = lo if complete and math.isfinite(lo) else float("nan")
+        record[f"series.{name}.max"] = hi if complete and math.isfinite(hi) else float("nan")
+    tail = parquet.read_row_group(meta.num_row_groups - 1, columns=present)
+    if tail.num_rows:
+        for name in present:
+            record[f"series.{name}.last"] = _stat_value(tail.column(name)[-1].as_py())
+    return record
+
+
+def budget_stats(path: Path, columns: Sequence[str]) -> Dict[str, Any]:
+    """Max ``|value|`` of the requested mass-budget columns.
+
+    Parquet logs are answered from the footer (row count and row-group
+    statistics, see :func:`marsdisk.io.mass_budget.max_error_percent`).
+    """
+
+    record: Dict[str, Any] = {}
+    if not path.exists():
+        return record
+    if path.suffix == ".parquet":
+        parquet = pq.ParquetFile(path)
+        names = parquet.schema_arrow.names
+        present = [name for name in columns if name in names]
+        if not present:
+            return record
+        record["budget_rows"] = int(parquet.metadata.num_rows)
+        for name in present:
+            value = mass_budget_io.max_error_percent(path, column=name)
+            record[f"budget.{name}.max_abs"] = float(value) if value is not None else float("nan")
+        return record
+    with path.open("rb") as fh:
+        header = fh.readline().decode("utf-8").strip().split(",")
+    present = [name for name in columns if name in header]
+    if not present:
+        return record
+    table = pa_csv.read_csv(path, convert_options=pa_csv.ConvertOptions(include_columns=present))
+    record["budget_rows"] = int(table.num_rows)
+    for name in present:
+        values = table.column(name).to_numpy(zero_copy_only=False).astype(float)
+        finite = values[np.isfinite(values)]
+        record[f"budget.{name}.max_abs"] = float(np.max(np.abs(finite))) if finite.size else float("nan")
+    return record
+
+
+def collect_run(
+    run_dir: Path,
+    *,
+    series_columns: Sequence[str] = DEFAULT_SERIES_COLUMNS,
+    budget_columns: Sequence[str] = DEFAULT_BUDGET_COLUMNS,
+) -> Dict[str, Any]:
+    """One flat record for ``run_dir``."""
+
+    run_dir = Path(run_dir)
+    record: Dict[str, Any] = {"run_dir": str(run_dir), "_fingerprint": run_fingerprint(run_dir)}
+    summary_path = run_dir / SUMMARY_NAME
+    record["summary_json"] = None
+    record["summary_status"] = None
+    if summary_path.exists():
+        try:
+            text = summary_path.read_text(encoding="utf-8")
+            summary = json.loads(text)
+        except (OSError, ValueError):
+            summary = None
+        if isinstance(summary, dict):
+            record["summary_status"] = str(summary.get("summary_status") or "complete")
+            if record["summary_status"] == "partial":
+                # Progress snapshot of an unfinished run: not a result yet.
+                return record
+            record["summary_json"] = text
+            for key, value in summary.items():
+                if isinstance(value, bool):
+                    record[f"summary.{key}"] = float(value)
+                elif isinstance(value, (int, float)):
+                    record[f"summary.{key}"] = float(value)
+    elif (run_dir / PARTIAL_SUMMARY_NAME).exists():
+        # Still running (or interrupted): only a progress snapshot exists.
+        record["summary_status"] = "partial"
+        return record
+    record.update(series_stats(run_dir / SERIES_RELPATH, series_columns))
+    budget_path = mass_budget_io.resolve_existing_path(run_dir / BUDGET_RELPATH.parent)
+    if budget_path is not None:
+        record.update(budget_stats(budget_path, budget_columns))
+    return record
+
+
+def _spec_digest(*parts: Sequence[str]) -> str:
+    payload = json.dumps([list(part) for part in parts])
+    return hashlib.sha256(payload.encode("utf-8")).hexdigest()[:16]
+
+
+def _load_cache(cache_path: Optional[Path], spec: str) -> Dict[str, Dict[str, Any]]:
+    if cache_path is None or not cache_path.exists():
+        return {}
+    try:
+        table = feather.read_table(cache_path)
+    except (OSError, pa.ArrowInvalid):
+        return {}
+    meta = table.schema.metadata or {}
+    if meta.get(CACHE_METADATA_KEY, b"").decode("utf-8") != spec:
+        return {}
+    cached: Dict[str, Dict[str, Any]] = {}
+    for row in table.to_pylist():
+        cached[str(row["run_dir"])] = {key: value for key, value in row.items() if value is not None}
+    return cached
+
+
+def _write_cache(cache_path: Path, frame: pd.DataFrame, spec: str) -> None:
+    table = pa.Table.from_pandas(frame, preserve_index=False)
+    meta = dict(table.schema.metadata or {})
+    meta[CACHE_METADATA_KEY] = spec.encode("utf-8")
+    table = table.replace_schema_metadata(meta)
+    cache_path.parent.mkdir(parents=True, exist_ok=True)
+    tmp_path = cache_path.with_name(cache_path.name + ".tmp")
+    feather.write_feather(table, tmp_path)
+    os.replace(tmp_path, cache_path)
+
+
+def collect_runs(
+    run_dirs: Iterable[Path],
+    *,
+    cache_path: Optional[Path] = None,
+    series_columns: Sequence[str] = DEFAULT_SERIES_COLUMNS,
+    budget_columns: Sequence[str] = DEFAULT_BUDGET_COLUMNS,
+    jobs: int = DEFAULT_IO_WORKERS,
+) -> Tuple[pd.DataFrame, Dict[str, int]]:
+    """Return one row per run (in input order) and ``{collected, reused, dropped}``."""
+
+    run_dirs = [Path(p) for p in run_dirs]
+    spec = _spec_digest(series_columns, budget_columns, (RECORD_VERSION,))
+    cached = _load_cache(Path(cache_path) if cache_path is not None else None, spec)
+    workers = max(min(int(jobs), max(len(run_dirs), 1)), 1)
+
+    with ThreadPoolExecutor(max_workers=workers) as pool:
+        fingerprints = list(pool.map(run_fingerprint, run_dirs))
+        stale = [
+            run_dir
+            for run_dir, fingerprint in zip(run_dirs, fingerprints)
+            if cached.get(str(run_dir), {}).get("_fingerprint") != fingerprint
+        ]
+        fresh = pool.map(
+            lambda p: collect_run(p, series_columns=series_columns, budget_columns=budget_columns),
+            stale,
+        )
+        records = {record["run_dir"]: record for record in fresh}
+
+    rows: List[Dict[str, Any]] = []
+    for run_dir in run_dirs:
+        key = str(run_dir)
+        rows.append(records[key] if key in records else cached[key])
+    frame = pd.DataFrame(rows)
+    if "run_dir" not in frame.columns:
+        frame = pd.DataFrame({"run_dir": pd.Series(dtype=str), "_fingerprint": pd.Series(dtype=str)})
+    if "summary_json" in frame.columns:
+        frame["summary_json"] = frame["summary_json"].astype(object).where(frame["summary_json"].notna(), None)
+
+    current = {str(p) for p in run_dirs}
+    report = {
+        "collected": len(records),
+        "reused": len(run_dirs) - len(records),
+        "dropped": sum(1 for key in cached if key not in current),
+    }
+    if cache_path is not None:
+        _write_cache(Path(cache_path), frame, spec)
+    return frame, report
+
+
+def _series_table(series_path: Path, columns: Optional[Sequence[str]]) -> pa.Table:
+    if columns:
+        names = pq.ParquetFile(series_path).schema_arrow.names
+        table = pq.read_table(series_path, columns=[c for c in columns if c in names])
+    else:
+        table = pq.read_table(series_path)
+    run_dir = series_path.parent.parent
+    n_rows = table.num_rows
+    table = table.append_column("case_id", pa.array([run_dir.parent.name] * n_rows, type=pa.string()))
+    table = table.append_column("outdir", pa.array([str(run_dir)] * n_rows, type=pa.string()))
+    return table.replace_schema_metadata(None)
+
+
+def collect_series(
+    series_paths: Sequence[Path],
+    out_path: Path,
+    *,
+    columns: Optional[Sequence[str]] = None,
+    jobs: int = DEFAULT_IO_WORKERS,
+) -> Dict[str, int]:
+    """Concatenate ``series_paths`` into ``out_path``, reusing unchanged runs.
+
+    ``out_path`` records ``{outdir: size:mtime_ns}`` and the column selection
+    in its schema metadata; rows of unchanged runs are copied from the
+    previous output instead of re-reading their series.
+    """
+
+    series_paths = [Path(p) for p in series_paths]
+    if not series_paths:
+        raise FileNotFoundError("No series/run.parquet files found under the provided roots.")
+    stamps = {str(p.parent.parent): _file_stamp(p) for p in series_paths}
+    column_key = list(columns) if columns else None
+
+    previous: Optional[pa.Table] = None
+    previous_stamps: Mapping[str, str] = {}
+    if out_path.exists():
+        try:
+            old = pq.read_table(out_path)
+        except (OSError, pa.ArrowInvalid):
+            old = None
+        meta = (old.schema.metadata or {}) if old is not None else {}
+        if SERIES_METADATA_KEY in meta:
+            payload = json.loads(meta[SERIES_METADATA_KEY].decode("utf-8"))
+            if payload.get("columns") == column_key:
+                previous = old
+                previous_stamps = payload.get("stamps", {})
+
+    keep = [outdir for outdir, stamp in stamps.items() if previous_stamps.get(outdir) == stamp]
+    todo = [p for p in series_paths if str(p.parent.parent) not in set(keep)]
+    workers = max(min(int(jobs), max(len(todo), 1)), 1)
+    with ThreadPoolExecutor(max_workers=workers) as pool:
+        tables = list(pool.map(lambda p: _series_table(p, columns), todo))
+
+    if previous is not None and keep:
+        kept = previous.filter(pc.is_in(previous.column("outdir"), value_set=pa.array(keep, type=pa.string())))
+        tables.insert(0, kept.replace_schema_metadata(None))
+    combined = pa.concat_tables(tables, promote_options="default")
+    payload = {"columns": column_key, "stamps": stamps}
+    combined = combined.replace_schema_metadata({SERIES_METADATA_KEY: json.dumps(payload).encode("utf-8")})
+    out_path.parent.mkdir(parents=True, exist_ok=True)
+    tmp_path = out_path.with_name(out_path.name + ".tmp")
+    pq.write_table(combined, tmp_path)
+    os.replace(tmp_path, out_path)
+    return {"runs": len(series_paths), "read": len(todo), "reused": len(keep)}
+
+
+__all__ = [
+    "DEFAULT_BUDGET_COLUMNS",
+    "DEFAULT_SERIES_COLUMNS",
+    "budget_stats",
+    "collect_run",
+    "collect_runs",
+    "collect_series",
+    "run_fingerprint",
+    "series_stats",
+]
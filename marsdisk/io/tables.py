@@ -529,6 +529,8 @@ def load_phi_table(path: str | Path) -> Callable[[float], float]:
         )
         return float(np.clip(value, 0.0, 1.0))
 
+    # Exposed so batch callers can interpolate whole arrays with the same nodes.
+    phi_fn.tau_phi_table = (tau_vals, phi_vals)
     return phi_fn
 
 
@@ -9,6 +9,9 @@ necessary.
 from __future__ import annotations
 
 import json
+import logging
+import os
+import tempfile
 from pathlib import Path
 from typing import Any, Iterable, Literal, Mapping, Sequence
 
@@ -16,12 +19,21 @@ import pandas as pd
 import pyarrow as pa
 import pyarrow.parquet as pq
 
+from ..output_schema import FLOAT32_PROTECTED_KEYS
+
+logger = logging.getLogger(__name__)
+
 
 def _ensure_parent(path: Path) -> None:
     path.parent.mkdir(parents=True, exist_ok=True)
 
 
-def _ensure_table_columns(table: pa.Table, ensure_columns: Iterable[str] | None) -> pa.Table:
+def _ensure_table_columns(
+    table: pa.Table,
+    ensure_columns: Iterable[str] | None,
+    *,
+    drop_extra_columns: bool = False,
+) -> pa.Table:
     if ensure_columns is None:
         return table
     ensure_list = list(ensure_columns)
@@ -33,20 +45,38 @@ def _ensure_table_columns(table: pa.Table, ensure_columns: Iterable[str] | None)
             table = table.append_column(name, pa.nulls(len(table)))
     ordered = [name for name in ensure_list if name in table.column_names]
     extras = [name for name in table.column_names if name not in ensure_set]
-    if extras:
+    if extras and not drop_extra_columns:
         return table.select(ordered + extras)
     return table.select(ordered)
 
 
+def _downcast_float32(table: pa.Table, float32_columns: Iterable[str] | None) -> pa.Table:
+    """Cast selected float64 columns to float32 (``"*"`` selects all but time/dt)."""
+
+    if not float32_columns:
+        return table
+    targets = set(float32_columns)
+    wildcard = "*" in targets
+    for idx, field in enumerate(table.schema):
+        if not pa.types.is_float64(field.type):
+            continue
+        if field.name in targets or (wildcard and field.name not in FLOAT32_PROTECTED_KEYS):
+            table = table.set_column(idx, field.name, table.column(idx).cast(pa.float32()))
+    return table
+
+
 def _write_parquet_table_internal(
     table: pa.Table,
     path: Path,
     *,
     compression: str = "snappy",
     ensure_columns: Iterable[str] | None = None,
+    drop_extra_columns: bool = False,
+    float32_columns: Iterable[str] | None = None,
 ) -> None:
     _ensure_parent(path)
-    table = _ensure_table_columns(table, ensure_columns)
+    table = _ensure_table_columns(table, ensure_columns, drop_extra_columns=drop_extra_columns)
+    table = _downcast_float32(table, float32_columns)
     units = {
         "time": "s",
         "dt": "s",
@@ -415,6 +445,8 @@ def write_parquet(
     *,
     compression: str = "snappy",
     ensure_columns: Iterable[str] | None = None,
+    drop_extra_columns: bool = False,
+    float32_columns: Iterable[str] | None = None,
 ) -> None:
     """Write tabular records to a Parquet file using ``pyarrow``.
 
@@ -424,6 +456,12 @@ def write_parquet(
         Table to serialise (DataFrame or list-of-dicts).
     path:
         Destination file path.
+    ensure_columns:
+        Columns placed first (null-filled when absent).
+    drop_extra_columns:
+        Drop columns not listed in ``ensure_columns`` (output profiles).
+    float32_columns:
+        float64 columns stored as float32; ``"*"`` selects all but time/dt.
     """
     if isinstance(df, pd.DataFrame):
         table = pa.Table.from_pandas(df, preserve_index=False)
@@ -435,6 +473,8 @@ def write_parquet(
         path,
         compression=compression,
         ensure_columns=ensure_columns,
+        drop_extra_columns=drop_extra_columns,
+        float32_columns=float32_columns,
     )
 
 
@@ -444,6 +484,8 @@ def write_parquet_table(
     *,
     compression: str = "snappy",
     ensure_columns: Iterable[str] | None = None,
+    drop_extra_columns: bool = False,
+    float32_columns: Iterable[str] | None = None,
 ) -> None:
     """Write a pre-built Arrow table to Parquet with metadata attached."""
 
@@ -452,6 +494,8 @@ def write_parquet_table(
         path,
         compression=compression,
         ensure_columns=ensure_columns,
+        drop_extra_columns=drop_extra_columns,
+        float32_columns=float32_columns,
     )
 
 
@@ -461,6 +505,8 @@ def write_parquet_columns(
     *,
     compression: str = "snappy",
     ensure_columns: Iterable[str] | None = None,
+    drop_extra_columns: bool = False,
+    float32_columns: Iterable[str] | None = None,
 ) -> None:
     """Write column arrays to Parquet with output metadata attached."""
 
@@ -470,26 +516,153 @@ def write_parquet_columns(
         path,
         compression=compression,
         ensure_columns=ensure_columns,
+        drop_extra_columns=drop_extra_columns,
+        float32_columns=float32_columns,
     )
 
 
+def _default_file_mode() -> int:
+    umask = os.umask(0)
+    os.umask(umask)
+    return 0o666 & ~umask
+
+
+_FILE_MODE = _default_file_mode()
+
+
+def write_text_atomic(text: str, path: Path) -> None:
+    """Replace ``path`` with ``text`` via a temporary file and ``os.replace``.
+
+    Readers (and a run killed mid-write) see either the previous content or
+    the new one, never a truncated file.
+    """
+
+    path = Path(path)
+    _ensure_parent(path)
+    fd, tmp_name = tempfile.mkstemp(prefix=f".{path.name}.", suffix=".tmp", dir=path.parent)
+    try:
+        # mkstemp creates 0600 files; match what open() would have produced.
+        os.chmod(tmp_name, _FILE_MODE)
+        with os.fdopen(fd, "w", encoding="utf-8") as fh:
+            fh.write(text)
+            fh.flush()
+            os.fsync(fh.fileno())
+        os.replace(tmp_name, path)
+    except BaseException:
+        try:
+            os.unlink(tmp_name)
+        except OSError:
+            pass
+        raise
+
+
+def write_json_atomic(payload: Mapping[str, Any], path: Path) -> None:
+    """Atomically write ``payload`` as indented, key-sorted JSON."""
+
+    write_text_atomic(json.dumps(payload, indent=2, sort_keys=True), path)
+
+
 def write_summary(summary: Mapping[str, Any], path: Path) -> None:
     """Write a summary dictionary to ``summary.json``.
 
     The JSON file is formatted with a small indentation for human
-    readability.
+    readability and replaced atomically, so the partial summaries refreshed
+    during streaming runs are never left half-written.
     """
-    _ensure_parent(path)
-    with path.open("w", encoding="utf-8") as fh:
-        json.dump(summary, fh, indent=2, sort_keys=True)
+    write_json_atomic(summary, path)
 
 
 def write_run_config(config: Mapping[str, Any], path: Path) -> None:
     """Persist the deterministic run configuration metadata."""
 
-    _ensure_parent(path)
-    with path.open("w", encoding="utf-8") as fh:
-        json.dump(config, fh, indent=2, sort_keys=True)
+    write_json_atomic(config, path)
+
+
+class ParquetAppender:
+    """Append record batches to a single Parquet file as row groups.
+
+    The schema is fixed by the first batch (all-null columns are promoted to
+    float64); later batches are cast to it, missing columns are null-filled
+    and unknown columns are dropped with a warning.  With ``carry_existing``
+    the rows of an existing file are copied over first, which keeps a resumed
+    log complete.  :meth:`close` must be called to write the footer.
+    """
+
+    def __init__(
+        self,
+        path: Path,
+        *,
+        compression: str | None = "snappy",
+        carry_existing: bool = False,
+    ) -> None:
+        self.path = Path(path)
+        self.compression = None if compression in (None, "none") else compression
+        self.carry_existing = bool(carry_existing)
+        self.rows_written = 0
+        self._writer: pq.ParquetWriter | None = None
+        self._schema: pa.Schema | None = None
+
+    def _open(self, schema: pa.Schema) -> pq.ParquetWriter:
+        _ensure_parent(self.path)
+        schema = pa.schema(
+            [
+                pa.field(field.name, pa.float64()) if pa.types.is_null(field.type) else field
+                for field in schema
+            ]
+        )
+        carried: pa.Table | None = None
+        if self.carry_existing and self.path.exists():
+            try:
+                carried = pq.read_table(self.path)
+                schema = pa.unify_schemas([carried.schema, schema], promote_options="permissive")
+            except Exception as exc:
+                logger.warning("Failed to read existing Parquet log %s: %s", self.path, exc)
+                carried = None
+        parquet_writer = pq.ParquetWriter(self.path, schema, compression=self.compression)
+        self._schema = schema
+        if carried is not None and carried.num_rows:
+            parquet_writer.write_table(self._conform(carried))
+        return parquet_writer
+
+    def _conform(self, table: pa.Table) -> pa.Table:
+        schema = self._schema
+        if schema is None:
+            return table
+        extras = [name for name in table.column_names if schema.get_field_index(name) < 0]
+        if extras:
+            logger.warning(
+                "Dropping columns absent from the %s schema: %s",
+                self.path.name,
+                ", ".join(extras),
+            )
+        arrays = []
+        for field in schema:
+            if field.name in table.column_names:
+                arrays.append(table.column(field.name).cast(field.type))
+            else:
+                arrays.append(pa.nulls(table.num_rows, type=field.type))
+        return pa.Table.from_arrays(arrays, schema=schema)
+
+    @property
+    def is_open(self) -> bool:
+        return self._writer is not None
+
+    def append_table(self, table: pa.Table) -> None:
+        if self._writer is None:
+            self._writer = self._open(table.schema)
+        self._writer.write_table(self._conform(table))
+        self.rows_written += table.num_rows
+
+    def append_rows(self, rows: Sequence[Mapping[str, Any]]) -> bool:
+        if not rows:
+            return False
+        self.append_table(pa.Table.from_pylist(list(rows)))
+        return True
+
+    def close(self) -> None:
+        if self._writer is not None:
+            self._writer.close()
+            self._writer = None
 
 
 def write_mass_budget(records: Iterable[Mapping[str, Any]], path: Path) -> None:
@@ -533,14 +706,18 @@ def write_step_diagnostics(
     rows: Iterable[Mapping[str, Any]],
     path: Path,
     *,
-    fmt: Literal["csv", "jsonl"] = "csv",
+    fmt: Literal["csv", "jsonl", "parquet"] = "csv",
+    compression: str = "zstd",
 ) -> None:
     """Serialise per-step loss channel diagnostics."""
 
     rows = list(rows)
     _ensure_parent(path)
     fmt_lower = str(fmt).lower()
-    if fmt_lower == "csv":
+    if fmt_lower == "parquet":
+        table = pa.Table.from_pylist(rows)
+        pq.write_table(table, path, compression=None if compression == "none" else compression)
+    elif fmt_lower == "csv":
         df = pd.DataFrame(rows)
         df.to_csv(path, index=False)
     elif fmt_lower == "jsonl":
@@ -559,7 +736,10 @@ def append_step_diagnostics(
     fmt: Literal["csv", "jsonl"] = "csv",
     header: bool = True,
 ) -> bool:
-    """Append per-step diagnostics in CSV or JSONL format."""
+    """Append per-step diagnostics in CSV or JSONL format.
+
+    Parquet output is appended through :class:`ParquetAppender` instead.
+    """
 
     rows = list(rows)
     if not rows:
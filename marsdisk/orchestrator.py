@@ -45,7 +45,7 @@ import hashlib
 import logging
 import math
 import random
-from dataclasses import dataclass, field
+from dataclasses import asdict, dataclass, field
 from pathlib import Path
 from typing import Any, Dict, List, Optional, Sequence
 
@@ -158,7 +158,7 @@ class SimulationState:
     orbits_completed: int = 0
 
 
-@dataclass
+@dataclass(frozen=True)
 class PhysicsFlags:
     """Boolean flags controlling physics behavior.
     
@@ -175,6 +175,36 @@ class PhysicsFlags:
     phase_enabled: bool = False
 
 
+@dataclass(frozen=True)
+class RunPlan(PhysicsFlags):
+    """Config values read inside the step and cell loops, resolved once.
+
+    Built by :func:`resolve_run_plan` after the runner has finished adjusting
+    ``cfg``; loops read these fields instead of walking pydantic attribute
+    chains with ``getattr`` defaults on every step.
+    """
+
+    physics_mode: str = "default"
+    stop_on_blowout_below_smin: bool = False
+    retire_inert_cells: bool = True
+    collision_solver: str = "smol"
+    use_tcoll: bool = False
+    sinks_mode: str = "sublimation"
+    enable_sublimation: bool = False
+    enable_gas_drag: bool = False
+    rho_gas: float = 0.0
+    mass_conserving_sublimation: bool = False
+    i0: float = 0.05
+    eps_restitution: float = 0.5
+    f_ke_cratering: float = 0.1
+    f_ke_fragmentation: Optional[float] = None
+    enable_e_damping: bool = False
+    energy_bookkeeping_enabled: bool = False
+    mass_total: float = 0.0
+    dsdt_model: Optional[str] = None
+    dsdt_params: Any = None
+
+
 @dataclass 
 class OrchestrationContext:
     """Context object holding all simulation parameters and state.
@@ -420,6 +450,43 @@ def resolve_physics_flags(cfg: Config, physics_mode: str) -> PhysicsFlags:
     )
 
 
+def resolve_run_plan(cfg: Config, physics_mode: str) -> RunPlan:
+    """Freeze the loop-invariant configuration into a :class:`RunPlan`."""
+
+    flags = resolve_physics_flags(cfg, physics_mode)
+    numerics = getattr(cfg, "numerics", None)
+    surface_cfg = getattr(cfg, "surface", None)
+    sinks_cfg = getattr(cfg, "sinks", None)
+    dynamics = getattr(cfg, "dynamics", None)
+    sizes_cfg = getattr(cfg, "sizes", None)
+    energy_cfg = getattr(getattr(cfg, "diagnostics", None), "energy_bookkeeping", None)
+    f_ke_frag = getattr(dynamics, "f_ke_fragmentation", None)
+    return RunPlan(
+        **asdict(flags),
+        physics_mode=str(physics_mode),
+        stop_on_blowout_below_smin=bool(getattr(numerics, "stop_on_blowout_below_smin", False)),
+        retire_inert_cells=bool(getattr(numerics, "retire_inert_cells", True)),
+        collision_solver=str(getattr(surface_cfg, "collision_solver", "smol")),
+        use_tcoll=bool(getattr(surface_cfg, "use_tcoll", False)),
+        sinks_mode=str(getattr(sinks_cfg, "mode", "sublimation")),
+        enable_sublimation=bool(getattr(sinks_cfg, "enable_sublimation", False)),
+        enable_gas_drag=bool(getattr(sinks_cfg, "enable_gas_drag", False)),
+        rho_gas=float(getattr(sinks_cfg, "rho_g", 0.0)),
+        mass_conserving_sublimation=bool(
+            getattr(getattr(sinks_cfg, "sub_params", None), "mass_conserving", False)
+        ),
+        i0=float(getattr(dynamics, "i0", 0.05)),
+        eps_restitution=float(getattr(dynamics, "eps_restitution", 0.5)),
+        f_ke_cratering=float(getattr(dynamics, "f_ke_cratering", 0.1)),
+        f_ke_fragmentation=float(f_ke_frag) if f_ke_frag is not None else None,
+        enable_e_damping=bool(getattr(dynamics, "enable_e_damping", False)),
+        energy_bookkeeping_enabled=bool(getattr(energy_cfg, "enabled", False)),
+        mass_total=float(cfg.initial.mass_total),
+        dsdt_model=getattr(sizes_cfg, "dsdt_model", None),
+        dsdt_params=getattr(sizes_cfg, "dsdt_params", None),
+    )
+
+
 # ===========================================================================
 # Utility Functions
 # ===========================================================================
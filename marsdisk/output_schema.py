@@ -2,7 +2,8 @@
 
 from __future__ import annotations
 
-from typing import Dict, Iterable
+from dataclasses import dataclass
+from typing import Dict, Iterable, Sequence
 
 ZERO_D_SERIES_KEYS: list[str] = [
     "time",
@@ -310,6 +311,109 @@ ONE_D_EXTRA_SERIES_KEYS: list[str] = [
 
 ONE_D_EXTRA_DIAGNOSTIC_KEYS: list[str] = ["cell_index"]
 
+# Output profiles (``io.output_profile``).  ``full`` keeps every column above
+# plus any extra keys a record carries; ``standard``/``minimal`` write only the
+# listed columns.  ``minimal`` drops diagnostics.parquet altogether so the
+# diagnostics rows are never assembled.
+OUTPUT_PROFILES: tuple[str, ...] = ("minimal", "standard", "full")
+
+MINIMAL_SERIES_KEYS: list[str] = [
+    "time",
+    "dt",
+    "r_RM",
+    "T_M_used",
+    "tau",
+    "tau_los_mars",
+    "t_blow_s",
+    "t_coll",
+    "a_blow",
+    "s_min",
+    "beta_at_smin",
+    "Sigma_surf",
+    "sigma_surf",
+    "Sigma_tau1",
+    "M_out_dot",
+    "M_sink_dot",
+    "dM_dt_surface_total",
+    "M_loss_cum",
+    "M_sink_cum",
+    "mass_total_bins",
+    "mass_lost_by_blowout",
+    "mass_lost_by_sinks",
+    "n_substeps",
+    "case_status",
+]
+
+STANDARD_SERIES_KEYS: list[str] = MINIMAL_SERIES_KEYS + [
+    "Omega_s",
+    "t_orb_s",
+    "ts_ratio",
+    "r_m",
+    "T_p_effective",
+    "dt_over_t_blow",
+    "kappa",
+    "kappa_eff",
+    "Qpr_mean",
+    "s_blow_m",
+    "sigma_deep",
+    "headroom",
+    "outflux_surface",
+    "sink_flux_surface",
+    "prod_subblow_area_rate",
+    "dotSigma_prod",
+    "supply_rate_nominal",
+    "supply_rate_applied",
+    "supply_headroom",
+    "supply_clip_factor",
+    "deep_to_surf_flux_applied",
+    "dSigma_dt_blowout",
+    "dSigma_dt_sinks",
+    "dSigma_dt_sublimation",
+    "mass_lost_sublimation_step",
+    "mass_lost_hydro_step",
+    "M_loss_rp_mars",
+    "M_loss_hydro",
+    "smol_mass_error",
+    "fast_blowout_factor",
+    "phase_state",
+    "phase_bulk_state",
+    "sink_selected",
+]
+
+MINIMAL_ONE_D_SERIES_KEYS: list[str] = [
+    "cell_index",
+    "cell_active",
+    "cell_stop_reason",
+    "cell_stop_time",
+]
+
+STANDARD_DIAGNOSTIC_KEYS: list[str] = [
+    "time",
+    "dt",
+    "r_RM_used",
+    "T_M_used",
+    "F_abs",
+    "t_sink_total_s",
+    "sigma_tau1",
+    "tau_eff",
+    "kappa_eff",
+    "phi_effective",
+    "psi_shield",
+    "s_min",
+    "s_peak",
+    "supply_rate_applied",
+    "supply_visibility_factor",
+    "M_out_cum",
+    "M_sink_cum",
+    "M_loss_cum",
+    "phase_state",
+    "smol_mass_error",
+    "blowout_gate_factor",
+]
+
+# Columns that keep float64 when ``io.float32_columns`` contains ``"*"``.
+FLOAT32_PROTECTED_KEYS: frozenset[str] = frozenset({"time", "dt"})
+
 
 def _ensure_keys(record: Dict[str, object], keys: Iterable[str]) -> None:
     missing = None
@@ -323,16 +427,124 @@ def _ensure_keys(record: Dict[str, object], keys: Iterable[str]) -> None:
         record.update(missing)
 
 
-def ensure_series_keys(record: Dict[str, object], *, include_1d: bool = True) -> None:
-    _ensure_keys(record, ZERO_D_SERIES_KEYS)
+def _check_profile(profile: str) -> str:
+    if profile not in OUTPUT_PROFILES:
+        raise ValueError(f"Unknown output profile: {profile!r}")
+    return profile
+
+
+def series_keys_for_profile(profile: str = "full", *, include_1d: bool = True) -> list[str]:
+    """Return the ordered series columns written under ``profile``."""
+
+    profile = _check_profile(profile)
+    if profile == "full":
+        keys = list(ZERO_D_SERIES_KEYS)
+        extra = ONE_D_EXTRA_SERIES_KEYS
+    else:
+        keys = list(MINIMAL_SERIES_KEYS if profile == "minimal" else STANDARD_SERIES_KEYS)
+        extra = MINIMAL_ONE_D_SERIES_KEYS
     if include_1d:
-        _ensure_keys(record, ONE_D_EXTRA_SERIES_KEYS)
+        keys.extend(extra)
+    return keys
+
 
+def diagnostic_keys_for_profile(profile: str = "full", *, include_1d: bool = True) -> list[str]:
+    """Return the ordered diagnostics columns; empty when diagnostics are off."""
 
-def ensure_diagnostic_keys(record: Dict[str, object], *, include_1d: bool = True) -> None:
-    _ensure_keys(record, ZERO_D_DIAGNOSTIC_KEYS)
+    profile = _check_profile(profile)
+    if profile == "minimal":
+        return []
+    keys = list(ZERO_D_DIAGNOSTIC_KEYS if profile == "full" else STANDARD_DIAGNOSTIC_KEYS)
     if include_1d:
-        _ensure_keys(record, ONE_D_EXTRA_DIAGNOSTIC_KEYS)
+        keys.extend(ONE_D_EXTRA_DIAGNOSTIC_KEYS)
+    return keys
+
+
+@dataclass(frozen=True)
+class OutputSelection:
+    """Resolved column selection for series/diagnostics Parquet output."""
+
+    profile: str
+    series_columns: list[str]
+    diagnostic_columns: list[str]
+    drop_extra_columns: bool
+    float32_columns: tuple[str, ...] = ()
+
+    @property
+    def diagnostics_enabled(self) -> bool:
+        return bool(self.diagnostic_columns)
+
+    @classmethod
+    def from_config(cls, io_cfg: object, *, include_1d: bool) -> "OutputSelection":
+        profile = str(getattr(io_cfg, "output_profile", "full") or "full")
+        series_override = getattr(io_cfg, "series_columns", None)
+        diag_override = getattr(io_cfg, "diagnostic_columns", None)
+        series_columns = (
+            _with_required(series_override, include_1d=include_1d)
+            if series_override is not None
+            else series_keys_for_profile(profile, include_1d=include_1d)
+        )
+        if diag_override is None:
+            diagnostic_columns = diagnostic_keys_for_profile(profile, include_1d=include_1d)
+        elif diag_override:
+            diagnostic_columns = _with_required(
+                diag_override, include_1d=include_1d, one_d_keys=ONE_D_EXTRA_DIAGNOSTIC_KEYS
+            )
+        else:
+            # An explicit empty list switches diagnostics off.
+            diagnostic_columns = []
+        return cls(
+            profile=profile,
+            series_columns=series_columns,
+            diagnostic_columns=diagnostic_columns,
+            drop_extra_columns=(
+                profile != "full" or series_override is not None or diag_override is not None
+            ),
+            float32_columns=tuple(getattr(io_cfg, "float32_columns", None) or ()),
+        )
+
+    def write_kwargs(self, kind: str) -> Dict[str, object]:
+        """Keyword arguments for :mod:`marsdisk.io.writer` Parquet helpers."""
+
+        columns = self.series_columns if kind == "series" else self.diagnostic_columns
+        return {
+            "ensure_columns": columns,
+            "drop_extra_columns": self.drop_extra_columns,
+            "float32_columns": self.float32_columns or None,
+        }
+
+
+def _with_required(
+    columns: Iterable[str],
+    *,
+    include_1d: bool,
+    one_d_keys: Sequence[str] = MINIMAL_ONE_D_SERIES_KEYS,
+) -> list[str]:
+    keys = ["time", "dt"]
+    if include_1d:
+        keys.extend(one_d_keys)
+    for name in columns:
+        if name not in keys:
+            keys.append(name)
+    return keys
+
+
+def ensure_series_keys(
+    record: Dict[str, object],
+    *,
+    include_1d: bool = True,
+    profile: str = "full",
+) -> None:
+    _ensure_keys(record, series_keys_for_profile(profile, include_1d=include_1d))
+
+
+def ensure_diagnostic_keys(
+    record: Dict[str, object],
+    *,
+    include_1d: bool = True,
+    profile: str = "full",
+) -> None:
+    _ensure_keys(record, diagnostic_keys_for_profile(profile, include_1d=include_1d))
 
 
 __all__ = [
@@ -340,6 +552,15 @@ __all__ = [
     "ZERO_D_DIAGNOSTIC_KEYS",
     "ONE_D_EXTRA_SERIES_KEYS",
     "ONE_D_EXTRA_DIAGNOSTIC_KEYS",
+    "OUTPUT_PROFILES",
+    "MINIMAL_SERIES_KEYS",
+    "STANDARD_SERIES_KEYS",
+    "MINIMAL_ONE_D_SERIES_KEYS",
+    "STANDARD_DIAGNOSTIC_KEYS",
+    "FLOAT32_PROTECTED_KEYS",
+    "OutputSelection",
+    "series_keys_for_profile",
+    "diagnostic_keys_for_profile",
     "ensure_series_keys",
     "ensure_diagnostic_keys",
 ]
@@ -52,10 +52,12 @@ __all__ = [
     "compute_weights_table_numba",
     "fill_fragment_tensor_numba",
     "gain_from_kernel_tensor_numba",
+    "gain_from_kernel_tensor_into_numba",
     "collision_kernel_numba",
     "collision_kernel_bookkeeping_numba",
     "compute_prod_subblow_area_rate_C2_numba",
     "loss_sum_numba",
+    "loss_sum_into_numba",
     "mass_budget_error_numba",
     "gain_tensor_fallback_numba",
     "fragment_tensor_fallback_numba",
@@ -178,7 +180,7 @@ def fill_fragment_tensor_numba(
 # ---------------------------------------------------------------------------
 
 
-@njit(cache=True, parallel=True)
+@njit(cache=True)
 def gain_from_kernel_tensor_numba(C: np.ndarray, Y: np.ndarray, m: np.ndarray) -> np.ndarray:
     """Return gain vector using a parallelised triple loop over C and Y.
 
@@ -188,6 +190,15 @@ def gain_from_kernel_tensor_numba(C: np.ndarray, Y: np.ndarray, m: np.ndarray) -
 
     n = C.shape[0]
     out = np.zeros(n, dtype=np.float64)
+    gain_from_kernel_tensor_into_numba(C, Y, m, out)
+    return out
+
+
+@njit(cache=True, parallel=True)
+def gain_from_kernel_tensor_into_numba(C: np.ndarray, Y: np.ndarray, m: np.ndarray, out: np.ndarray) -> None:
+    """In-place variant of :func:`gain_from_kernel_tensor_numba` writing into ``out``."""
+
+    n = C.shape[0]
     for k in prange(n):
         acc = 0.0
         for i in range(n):
@@ -198,7 +209,6 @@ def gain_from_kernel_tensor_numba(C: np.ndarray, Y: np.ndarray, m: np.ndarray) -
             out[k] = acc / m[k]
         else:
             out[k] = 0.0
-    return out
 
 
 @njit(cache=True, parallel=True)
@@ -366,14 +376,21 @@ def compute_prod_subblow_area_rate_C2_numba(C: np.ndarray, m_subblow: np.ndarray
 def loss_sum_numba(C: np.ndarray) -> np.ndarray:
     """Row-wise sum of the collision kernel."""
 
+    out = np.zeros(C.shape[0], dtype=np.float64)
+    loss_sum_into_numba(C, out)
+    return out
+
+
+@njit(cache=True)
+def loss_sum_into_numba(C: np.ndarray, out: np.ndarray) -> None:
+    """In-place variant of :func:`loss_sum_numba` writing into ``out``."""
+
     n = C.shape[0]
-    out = np.zeros(n, dtype=np.float64)
     for i in range(n):
         acc = 0.0
         for j in range(n):
             acc += C[i, j]
         out[i] = acc
-    return out
 
 
 @njit(cache=True)
@@ -1,7 +1,10 @@
 """Numba-accelerated helpers for radiation-pressure relations."""
 from __future__ import annotations
 
+import math
+
 from .. import constants
+from ..io._numba_tables import qpr_interp_scalar_numba
 
 try:
     from numba import njit
@@ -17,6 +20,8 @@ except ImportError:  # pragma: no cover
 __all__ = [
     "NUMBA_AVAILABLE",
     "blowout_radius_numba",
+    "blowout_fixed_point_numba",
+    "qpr_table_lookup_numba",
 ]
 
 _BLOWOUT_COEFF = float(
@@ -34,3 +39,34 @@ def NUMBA_AVAILABLE() -> bool:
 def blowout_radius_numba(rho: float, T_M: float, qpr: float) -> float:
     """Evaluate the blow-out grain size for beta=0.5 using R3."""
     return _BLOWOUT_COEFF * (T_M**4) * qpr / rho
+
+
+@njit(cache=True)
+def qpr_table_lookup_numba(s_vals, T_vals, q_vals, s: float, T_M: float) -> float:
+    """Table ⟨Q_pr⟩ at ``(s, T_M)``; NaN when the point needs clamping."""
+    if s < s_vals[0] or s > s_vals[-1] or T_M < T_vals[0] or T_M > T_vals[-1]:
+        return math.nan
+    return qpr_interp_scalar_numba(s_vals, T_vals, q_vals, s, T_M)
+
+
+@njit(cache=True)
+def blowout_fixed_point_numba(s_vals, T_vals, q_vals, rho: float, T_M: float, initial: float, iterations: int):
+    """Self-consistent R3 blow-out size with tabulated ⟨Q_pr⟩.
+
+    Mirrors the iteration in ``physics_step.compute_radiation_parameters``
+    and returns ``(a_blow, qpr_at_a_blow)``.  NaN signals a point outside
+    the table (or a non-positive ⟨Q_pr⟩) that the Python path must handle.
+    """
+    s_eval = max(initial, 1.0e-12)
+    n_iter = max(iterations, 1)
+    a_blow = math.nan
+    for _ in range(n_iter + 1):
+        qpr = qpr_table_lookup_numba(s_vals, T_vals, q_vals, s_eval, T_M)
+        if not (qpr > 0.0):
+            return math.nan, math.nan
+        a_blow = blowout_radius_numba(rho, T_M, qpr)
+        s_eval = max(a_blow, 1.0e-12)
+    qpr_blow = qpr_table_lookup_numba(s_vals, T_vals, q_vals, s_eval, T_M)
+    if not (qpr_blow > 0.0):
+        return math.nan, math.nan
+    return a_blow, qpr_blow
@@ -450,31 +450,40 @@ _FRAG_CACHE_LOCK = threading.Lock()
 _WEIGHTS_CACHE_MAX = _DEFAULT_WEIGHTS_CACHE_MAX
 _QSTAR_CACHE_MAX = _DEFAULT_QSTAR_CACHE_MAX
 _SUPPLY_CACHE_MAX = _DEFAULT_SUPPLY_CACHE_MAX
+_CACHE_SCALE = 1.0
 
 # Cache keys cover size/edge versions (or fingerprints), rho, scalar v_rel, alpha_frag,
 # and the Q_D* signature to prevent cross-cell contamination in 1D runs.
 
 
-def reset_collision_caches() -> None:
-    """Clear run-local collision caches (fragment/weights/qstar/supply)."""
+def reset_collision_caches(*, keep_size_only: bool = False) -> None:
+    """Clear run-local collision caches (fragment/weights/qstar/supply).
+
+    ``keep_size_only`` keeps the caches whose keys depend only on the size
+    grid (fragment weights table, supply injection weights) and drops the
+    ones that also depend on rho or the Q_D* coefficients.  Ensemble runs
+    that vary material/Q_D* parameters over a fixed grid use this.
+    """
 
     with _FRAG_CACHE_LOCK:
         _FRAG_CACHE.clear()
-    for name in ("weights_cache", "qstar_cache", "supply_cache"):
+    names = ("qstar_cache",) if keep_size_only else ("weights_cache", "qstar_cache", "supply_cache")
+    for name in names:
         cache = getattr(_THREAD_LOCAL, name, None)
         if cache is not None:
             cache.clear()
-    if hasattr(_THREAD_LOCAL, "frag_ws"):
+    if not keep_size_only and hasattr(_THREAD_LOCAL, "frag_ws"):
         _THREAD_LOCAL.frag_ws = None
 
 
 def configure_collision_cache_limits(*, scale: float | None = None) -> None:
     """Configure LRU limits for collision caches."""
 
-    global _FRAG_CACHE_MAX, _WEIGHTS_CACHE_MAX, _QSTAR_CACHE_MAX, _SUPPLY_CACHE_MAX
+    global _FRAG_CACHE_MAX, _WEIGHTS_CACHE_MAX, _QSTAR_CACHE_MAX, _SUPPLY_CACHE_MAX, _CACHE_SCALE
     scale_value = 1.0 if scale is None else float(scale)
     if not math.isfinite(scale_value) or scale_value <= 0.0:
         raise MarsDiskError("collision cache size_scale must be positive and finite")
+    _CACHE_SCALE = scale_value
     _FRAG_CACHE_MAX = max(1, int(round(_DEFAULT_FRAG_CACHE_MAX * scale_value)))
     _WEIGHTS_CACHE_MAX = max(1, int(round(_DEFAULT_WEIGHTS_CACHE_MAX * scale_value)))
     _QSTAR_CACHE_MAX = max(1, int(round(_DEFAULT_QSTAR_CACHE_MAX * scale_value)))
@@ -494,6 +503,49 @@ def configure_collision_cache_limits(*, scale: float | None = None) -> None:
             cache.popitem(last=False)
 
 
+def _get_step_arena() -> smol.SmolStepArena:
+    """Thread-local Smol step arena.
+
+    Cells assigned to one worker are stepped sequentially and every arena
+    buffer is consumed within a step, so one arena per worker thread serves
+    all of its cells.
+    """
+
+    arena = getattr(_THREAD_LOCAL, "step_arena", None)
+    if arena is None:
+        arena = smol.SmolStepArena()
+        _THREAD_LOCAL.step_arena = arena
+    return arena
+
+
+def collision_cache_scale() -> float:
+    """Return the size_scale last applied by :func:`configure_collision_cache_limits`."""
+
+    return _CACHE_SCALE
+
+
+def collision_cache_footprint(n_bins: int, *, scale: float | None = None, threads: int = 1) -> float:
+    """Upper bound in bytes of the collision caches when they are full.
+
+    The fragment cache is shared (``n_bins**3`` tensors); the weights, Q_D*
+    (``n_bins**2``) and supply (``n_bins``) caches are thread-local, so they
+    are counted once per worker thread.
+    """
+
+    n = max(int(n_bins), 0)
+    scale_value = _CACHE_SCALE if scale is None else float(scale)
+
+    def _limit(default: int) -> int:
+        return max(1, int(round(default * scale_value)))
+
+    frag = _limit(_DEFAULT_FRAG_CACHE_MAX) * n**3 * 8.0
+    per_thread = (
+        (_limit(_DEFAULT_WEIGHTS_CACHE_MAX) + _limit(_DEFAULT_QSTAR_CACHE_MAX)) * n**2
+        + _limit(_DEFAULT_SUPPLY_CACHE_MAX) * n
+    ) * 8.0
+    return frag + max(int(threads), 1) * per_thread
+
+
 def _get_fragment_workspace(
     sizes_arr: np.ndarray,
     masses_arr: np.ndarray,
@@ -1185,10 +1237,12 @@ def step_collisions_smol_0d(
     sigma_for_step = sigma_before_step
     prod_subblow_area_rate = max(float(prod_subblow_area_rate), 0.0)
 
+    step_arena = _get_step_arena()
     sizes_arr, widths_arr, m_k, N_k, scale_to_sigma = smol.psd_state_to_number_density(
         psd_state,
         sigma_for_step,
         rho_fallback=rho,
+        arena=step_arena,
     )
     sizes_version = psd_state.get("sizes_version")
     edges_version = psd_state.get("edges_version")
@@ -1269,6 +1323,7 @@ def step_collisions_smol_0d(
         imex_workspace = smol.ImexWorkspace(
             gain=np.zeros_like(N_k, dtype=float),
             loss=np.zeros_like(N_k, dtype=float),
+            arena=step_arena,
         )
         _THREAD_LOCAL.imex_ws = imex_workspace
         _THREAD_LOCAL.imex_ws_key = N_k.shape
@@ -1488,15 +1543,17 @@ def step_collisions_smol_0d(
 
     S_sink = None
     mass_loss_rate_sink = 0.0
+    step_scratch = step_arena.buffer("step_scratch", N_k.shape)
     if t_sink is not None and t_sink > 0.0:
         sink_rate = 1.0 / t_sink
-        S_sink = np.full_like(N_k, sink_rate)
-        mass_loss_rate_sink = float(np.sum(m_k * sink_rate * N_k))
+        S_sink = step_arena.filled("step_S_sink", N_k.shape, sink_rate)
+        np.multiply(m_k, sink_rate, out=step_scratch)
+        mass_loss_rate_sink = float(np.sum(np.multiply(step_scratch, N_k, out=step_scratch)))
 
     S_sub_k = None
     mass_loss_rate_sub = 0.0
     if ds_dt_val is not None:
-        ds_dt_k = np.full_like(sizes_arr, float(ds_dt_val), dtype=float)
+        ds_dt_k = step_arena.filled("step_ds_dt", sizes_arr.shape, float(ds_dt_val))
         if mass_conserving_sublimation and a_blow > 0.0 and dt > 0.0:
             mask = (ds_dt_k < 0.0) & np.isfinite(ds_dt_k) & (sizes_arr > a_blow)
             if np.any(mask):
@@ -1518,7 +1575,8 @@ def step_collisions_smol_0d(
                 m_k,
             )
 
-    mass_loss_rate_blow = float(np.sum(m_k * S_blow * N_k))
+    np.multiply(m_k, S_blow, out=step_scratch)
+    mass_loss_rate_blow = float(np.sum(np.multiply(step_scratch, N_k, out=step_scratch)))
 
     extra_mass_loss_rate = mass_loss_rate_blow + mass_loss_rate_sink + mass_loss_rate_sub
 
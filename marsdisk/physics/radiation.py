@@ -436,6 +436,41 @@ def qpr_lookup_array(
     return np.asarray(values, dtype=float).reshape(s_arr.shape)
 
 
+def compiled_qpr_table() -> tuple[np.ndarray, np.ndarray, np.ndarray] | None:
+    """Return the active ⟨Q_pr⟩ grid when compiled kernels reproduce :func:`qpr_lookup`.
+
+    ``None`` when Numba is unavailable or disabled, the active lookup is not
+    a :class:`~marsdisk.io.tables.QPrTable`, or cache rounding would make
+    memoised lookups differ from a direct interpolation.
+    """
+
+    if not (_USE_NUMBA_RADIATION and _USE_NUMBA_TABLES) or _NUMBA_FAILED:
+        return None
+    if not tables._USE_NUMBA or tables._NUMBA_FAILED:
+        return None
+    if _QPR_CACHE_ENABLED and _QPR_CACHE_ROUND is not None:
+        return None
+    lookup = _QPR_LOOKUP
+    table_obj = getattr(lookup, "__self__", None)
+    if lookup is tables.interp_qpr:
+        if getattr(tables, "_QPR_TABLE_PATH", None) is None:
+            return None
+        table_obj = getattr(tables, "_QPR_TABLE", None)
+    if not isinstance(table_obj, tables.QPrTable) or getattr(lookup, "__func__", None) not in (
+        None,
+        tables.QPrTable.interp,
+    ):
+        return None
+    s_vals = np.ascontiguousarray(table_obj.s_vals, dtype=np.float64)
+    T_vals = np.ascontiguousarray(table_obj.T_vals, dtype=np.float64)
+    q_vals = np.ascontiguousarray(table_obj.q_vals, dtype=np.float64)
+    if s_vals.size < 2 or T_vals.size < 2 or q_vals.shape != (T_vals.size, s_vals.size):
+        return None
+    if np.any(np.diff(s_vals) <= 0.0) or np.any(np.diff(T_vals) <= 0.0):
+        return None
+    return s_vals, T_vals, q_vals
+
+
 def planck_mean_qpr(
     s: float,
     T_M: float,
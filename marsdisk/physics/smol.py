@@ -3,7 +3,9 @@ from __future__ import annotations
 """Smoluchowski coagulation/fragmentation solver (C3--C4)."""
 
 import logging
+import threading
 import warnings
+import weakref
 from dataclasses import dataclass
 from typing import Iterable, MutableMapping
 
@@ -16,8 +18,10 @@ from .collide import compute_collision_kernel_C1, compute_prod_subblow_area_rate
 try:
     from ._numba_kernels import (
         NUMBA_AVAILABLE,
+        gain_from_kernel_tensor_into_numba,
         gain_from_kernel_tensor_numba,
         gain_tensor_fallback_numba,
+        loss_sum_into_numba,
         loss_sum_numba,
         mass_budget_error_numba,
     )
@@ -38,9 +42,80 @@ __all__ = [
     "psd_state_to_number_density",
     "number_density_to_psd_state",
     "ImexWorkspace",
+    "SmolStepArena",
+    "arena_stats",
     "get_numba_status",
 ]
 
+_ARENA_LOCK = threading.Lock()
+_ARENA_ALLOCATIONS = 0
+_LIVE_ARENAS: "weakref.WeakSet[SmolStepArena]" = weakref.WeakSet()
+
+
+class SmolStepArena:
+    """Named scratch buffers reused by every Smol step of one worker.
+
+    Buffers are allocated on first use and whenever ``n_bins`` changes; in
+    steady state a step draws every temporary from the arena.  Arrays handed
+    out by the arena (including the ``N_new`` returned by
+    :func:`step_imex_bdf1_C3`) are overwritten by the next step, so callers
+    must copy anything they keep.
+    """
+
+    def __init__(self) -> None:
+        self._buffers: dict[tuple[str, np.dtype], np.ndarray] = {}
+        self.allocations = 0
+        self.steps = 0
+        with _ARENA_LOCK:
+            _LIVE_ARENAS.add(self)
+
+    def buffer(self, name: str, shape: tuple[int, ...], dtype: type = float) -> np.ndarray:
+        """Return the buffer ``name`` with ``shape`` (contents undefined)."""
+
+        global _ARENA_ALLOCATIONS
+        key = (name, np.dtype(dtype))
+        buf = self._buffers.get(key)
+        if buf is None or buf.shape != shape:
+            buf = np.empty(shape, dtype=dtype)
+            self._buffers[key] = buf
+            self.allocations += 1
+            with _ARENA_LOCK:
+                _ARENA_ALLOCATIONS += 1
+        return buf
+
+    def filled(self, name: str, shape: tuple[int, ...], value: float) -> np.ndarray:
+        buf = self.buffer(name, shape)
+        buf.fill(value)
+        return buf
+
+    def lower_mask(self, n: int) -> np.ndarray:
+        """Strictly lower-triangular mask (the entries ``np.triu`` clears)."""
+
+        key = ("lower_mask", np.dtype(bool))
+        mask = self._buffers.get(key)
+        if mask is None or mask.shape != (n, n):
+            mask = self.buffer("lower_mask", (n, n), bool)
+            mask[...] = np.tri(n, n, -1, dtype=bool)
+        return mask
+
+    @property
+    def nbytes(self) -> int:
+        return int(sum(buf.nbytes for buf in self._buffers.values()))
+
+
+def arena_stats() -> dict[str, int]:
+    """Process-wide arena counters (allocations are cumulative)."""
+
+    with _ARENA_LOCK:
+        arenas = list(_LIVE_ARENAS)
+        allocations = _ARENA_ALLOCATIONS
+    return {
+        "allocations": int(allocations),
+        "live_arenas": len(arenas),
+        "bytes": sum(arena.nbytes for arena in arenas),
+        "steps": sum(arena.steps for arena in arenas),
+    }
+
 
 @dataclass
 class ImexWorkspace:
@@ -51,6 +126,7 @@ class ImexWorkspace:
     m_sum: np.ndarray | None = None
     denom: np.ndarray | None = None
     m_cache_key: tuple | None = None
+    arena: SmolStepArena | None = None
 
 logger = logging.getLogger(__name__)
 
@@ -74,6 +150,7 @@ def psd_state_to_number_density(
     sigma_surf: float,
     *,
     rho_fallback: float | None = None,
+    arena: SmolStepArena | None = None,
 ) -> tuple[np.ndarray, np.ndarray, np.ndarray, np.ndarray, float]:
     """Return Smoluchowski-ready arrays derived from a PSD state.
 
@@ -89,6 +166,9 @@ def psd_state_to_number_density(
         Surface mass density (kg/m^2) used to scale the counts.
     rho_fallback:
         Optional material density used when ``psd_state`` lacks ``rho``.
+    arena:
+        Optional :class:`SmolStepArena`; ``N_k`` is then written into an
+        arena buffer that the next step overwrites.
 
     Returns
     -------
@@ -142,16 +222,29 @@ def psd_state_to_number_density(
         psd_state["_mk_cache"] = m_k
 
     if sigma_surf <= 0.0 or not np.isfinite(sigma_surf):
+        if arena is not None:
+            return sizes_arr, widths_arr, m_k, arena.filled("psd_N_k", sizes_arr.shape, 0.0), 0.0
         return sizes_arr, widths_arr, m_k, np.zeros_like(sizes_arr), 0.0
 
-    base_counts = number_arr * widths_arr
-    mass_density_raw = float(np.sum(m_k * base_counts))
+    if arena is not None:
+        base_counts = np.multiply(number_arr, widths_arr, out=arena.buffer("psd_N_k", sizes_arr.shape))
+        scratch = np.multiply(m_k, base_counts, out=arena.buffer("psd_scratch", sizes_arr.shape))
+        mass_density_raw = float(np.sum(scratch))
+    else:
+        base_counts = number_arr * widths_arr
+        mass_density_raw = float(np.sum(m_k * base_counts))
     if not np.isfinite(mass_density_raw) or mass_density_raw <= 0.0:
         warnings.warn(
             "psd_state_to_number_density: mass density is non-finite or non-positive; returning zero counts.",
             NumericalWarning,
         )
     scale_to_sigma = sigma_surf / mass_density_raw if mass_density_raw > 0.0 else 0.0
+    if arena is not None:
+        if scale_to_sigma > 0.0:
+            np.multiply(base_counts, scale_to_sigma, out=base_counts)
+        else:
+            base_counts.fill(0.0)
+        return sizes_arr, widths_arr, m_k, base_counts, scale_to_sigma
     N_k = base_counts * scale_to_sigma if scale_to_sigma > 0.0 else np.zeros_like(base_counts)
     return sizes_arr, widths_arr, m_k, N_k, scale_to_sigma
 
@@ -222,8 +315,17 @@ def _gain_tensor(
 
     global _NUMBA_FAILED
     m_arr = np.asarray(m, dtype=np.float64)
+    arena = workspace.arena if workspace is not None else None
     if _USE_NUMBA and not _NUMBA_FAILED:
         try:
+            if out is not None and out.shape == m_arr.shape and out.dtype == np.float64:
+                gain_from_kernel_tensor_into_numba(
+                    np.asarray(C, dtype=np.float64),
+                    np.asarray(Y, dtype=np.float64),
+                    m_arr,
+                    out,
+                )
+                return out
             gain_arr = gain_from_kernel_tensor_numba(
                 np.asarray(C, dtype=np.float64),
                 np.asarray(Y, dtype=np.float64),
@@ -276,7 +378,17 @@ def _gain_tensor(
     if m_sum is None or denom is None:
         m_sum = m_arr[:, None] + m_arr[None, :]
         denom = np.where(m_arr > 0.0, m_arr, 1.0)
-    weighted_C = np.triu(np.asarray(C, dtype=np.float64) * m_sum)
+    C_arr = np.asarray(C, dtype=np.float64)
+    if arena is not None and out is not None:
+        weighted_C = np.multiply(C_arr, m_sum, out=arena.buffer("gain_weighted_C", C_arr.shape))
+        np.copyto(weighted_C, 0.0, where=arena.lower_mask(m_arr.size))
+        np.einsum("ij,kij->k", weighted_C, Y, out=out)
+        np.divide(out, denom, out=out)
+        nonpositive = np.greater(m_arr, 0.0, out=arena.buffer("gain_m_positive", m_arr.shape, bool))
+        np.logical_not(nonpositive, out=nonpositive)
+        np.copyto(out, 0.0, where=nonpositive)
+        return out
+    weighted_C = np.triu(C_arr * m_sum)
     result = np.einsum("ij,kij->k", weighted_C, Y, out=out)
     if result is None and out is not None:
         result = out
@@ -359,7 +471,9 @@ def step_imex_bdf1_C3(
         sink, source) after the step is accepted.
     workspace:
         Optional reusable buffers for ``gain`` and ``loss`` vectors to reduce
-        allocations when calling the solver repeatedly.
+        allocations when calling the solver repeatedly.  When it carries a
+        :class:`SmolStepArena` every other temporary is drawn from the arena
+        as well and ``N_new`` is an arena buffer (valid until the next step).
 
     Returns
     -------
@@ -370,11 +484,11 @@ def step_imex_bdf1_C3(
 
     global _NUMBA_FAILED
     N_arr = np.asarray(N, dtype=float)
-    S_base = np.zeros_like(N_arr) if S is None else np.asarray(S, dtype=float)
+    S_base = None if S is None else np.asarray(S, dtype=float)
     m_arr = np.asarray(m, dtype=float)
-    if N_arr.ndim != 1 or S_base.ndim != 1 or m_arr.ndim != 1:
+    if N_arr.ndim != 1 or (S_base is not None and S_base.ndim != 1) or m_arr.ndim != 1:
         raise MarsDiskError("N, S and m must be one-dimensional")
-    if not (len(N_arr) == len(S_base) == len(m_arr)):
+    if not (len(N_arr) == len(m_arr) and (S_base is None or len(S_base) == len(N_arr))):
         raise MarsDiskError("array lengths must match")
     if C.shape != (N_arr.size, N_arr.size):
         raise MarsDiskError("C has incompatible shape")
@@ -383,9 +497,18 @@ def step_imex_bdf1_C3(
     if dt <= 0.0:
         raise MarsDiskError("dt must be positive")
 
-    def _optional_sink(arr: Iterable[float] | None, name: str) -> np.ndarray:
+    arena = workspace.arena if workspace is not None else None
+    if arena is not None:
+        arena.steps += 1
+
+    def _buf(name: str, dtype: type = float) -> np.ndarray:
+        if arena is not None:
+            return arena.buffer(name, N_arr.shape, dtype)
+        return np.empty(N_arr.shape, dtype=dtype)
+
+    def _optional_sink(arr: Iterable[float] | None, name: str) -> np.ndarray | None:
         if arr is None:
-            return np.zeros_like(N_arr)
+            return None
         arr_np = np.asarray(arr, dtype=float)
         if arr_np.shape != N_arr.shape:
             raise MarsDiskError(f"{name} has incompatible shape")
@@ -394,7 +517,19 @@ def step_imex_bdf1_C3(
     source_arr = _optional_sink(source_k, "source_k")
     S_external_arr = _optional_sink(S_external_k, "S_external_k")
     S_sub_arr = _optional_sink(S_sublimation_k, "S_sublimation_k")
-    S_arr = S_base + S_external_arr + S_sub_arr
+    if source_arr is None:
+        source_arr = _buf("imex_zeros")
+        source_arr.fill(0.0)
+    S_arr = _buf("imex_S")
+    if S_base is None:
+        S_arr.fill(0.0)
+    else:
+        np.copyto(S_arr, S_base)
+    if S_external_arr is not None:
+        np.add(S_arr, S_external_arr, out=S_arr)
+    if S_sub_arr is not None:
+        np.add(S_arr, S_sub_arr, out=S_arr)
+    scratch = _buf("imex_scratch")
 
     gain_out = None
     loss_out = None
@@ -405,32 +540,36 @@ def step_imex_bdf1_C3(
             gain_out = gain_buf
         if isinstance(loss_buf, np.ndarray) and loss_buf.shape == N_arr.shape:
             loss_out = loss_buf
+    if gain_out is None and arena is not None:
+        gain_out = _buf("imex_gain")
+    loss = loss_out if loss_out is not None else _buf("imex_loss")
 
     try_use_numba = _USE_NUMBA and not _NUMBA_FAILED
     if try_use_numba:
         try:
-            loss = loss_sum_numba(np.asarray(C, dtype=np.float64))
+            loss_sum_into_numba(np.asarray(C, dtype=np.float64), loss)
         except Exception as exc:  # pragma: no cover - fallback
             try_use_numba = False
             _NUMBA_FAILED = True
             warnings.warn(f"loss_sum_numba failed ({exc!r}); falling back to NumPy.", NumericalWarning)
     if not try_use_numba:
-        if loss_out is not None:
-            np.sum(C, axis=1, out=loss_out)
-            loss = loss_out
-        else:
-            loss = np.sum(C, axis=1)
+        np.sum(C, axis=1, out=loss)
     # C_ij already halves the diagonal, so add it back for the loss coefficient.
     if C.size:
-        loss = loss + np.diagonal(C)
+        np.add(loss, np.diagonal(C), out=loss)
     # Convert summed collision rate (includes N_i) to the loss coefficient.
-    safe_N = np.where(N_arr > 0.0, N_arr, 1.0)
-    loss = np.where(N_arr > 0.0, loss / safe_N, 0.0)
-    t_coll = 1.0 / np.maximum(loss, 1e-30)
+    positive = np.greater(N_arr, 0.0, out=_buf("imex_positive", bool))
+    safe_N = _buf("imex_safe_N")
+    safe_N.fill(1.0)
+    np.copyto(safe_N, N_arr, where=positive)
+    np.divide(loss, safe_N, out=loss)
+    np.copyto(loss, 0.0, where=np.logical_not(positive, out=positive))
+    t_coll = np.maximum(loss, 1e-30, out=_buf("imex_t_coll"))
+    np.divide(1.0, t_coll, out=t_coll)
     dt_max = safety * float(np.min(t_coll))
     dt_eff = min(float(dt), dt_max)
 
-    source_mass_rate = float(np.sum(m_arr * source_arr))
+    source_mass_rate = float(np.sum(np.multiply(m_arr, source_arr, out=scratch)))
     if prod_subblow_mass_rate is None:
         prod_mass_rate_budget = source_mass_rate
     else:
@@ -438,9 +577,19 @@ def step_imex_bdf1_C3(
 
     gain = _gain_tensor(C, Y, m_arr, out=gain_out, workspace=workspace)
 
+    # Explicit part (gain + source - S*N) does not depend on dt_eff.
+    explicit = np.add(gain, source_arr, out=_buf("imex_explicit"))
+    np.subtract(explicit, np.multiply(S_arr, N_arr, out=scratch), out=explicit)
+    N_new = _buf("imex_N_new")
+    denom = _buf("imex_denom")
+    negative = _buf("imex_negative", bool)
     while True:
-        N_new = (N_arr + dt_eff * (gain + source_arr - S_arr * N_arr)) / (1.0 + dt_eff * loss)
-        if np.any(N_new < 0.0):
+        np.multiply(explicit, dt_eff, out=N_new)
+        np.add(N_arr, N_new, out=N_new)
+        np.multiply(loss, dt_eff, out=denom)
+        np.add(denom, 1.0, out=denom)
+        np.divide(N_new, denom, out=N_new)
+        if np.less(N_new, 0.0, out=negative).any():
             dt_eff *= 0.5
             continue
         mass_err = compute_mass_budget_error_C4(
@@ -450,6 +599,7 @@ def step_imex_bdf1_C3(
             prod_mass_rate_budget,
             dt_eff,
             extra_mass_loss_rate=float(extra_mass_loss_rate),
+            scratch=scratch if arena is not None else None,
         )
         if not np.isfinite(mass_err):
             raise MarsDiskError("mass budget error is non-finite; check PSD or kernel inputs")
@@ -460,10 +610,12 @@ def step_imex_bdf1_C3(
         dt_eff *= 0.5
 
     if diag_out is not None:
-        diag_out["gain_mass_rate"] = float(np.sum(m_arr * gain))
-        diag_out["loss_mass_rate"] = float(np.sum(m_arr * loss * N_new))
-        diag_out["sink_mass_rate"] = float(np.sum(m_arr * S_arr * N_arr))
-        diag_out["source_mass_rate"] = float(np.sum(m_arr * source_arr))
+        diag_out["gain_mass_rate"] = float(np.sum(np.multiply(m_arr, gain, out=scratch)))
+        np.multiply(m_arr, loss, out=scratch)
+        diag_out["loss_mass_rate"] = float(np.sum(np.multiply(scratch, N_new, out=scratch)))
+        np.multiply(m_arr, S_arr, out=scratch)
+        diag_out["sink_mass_rate"] = float(np.sum(np.multiply(scratch, N_arr, out=scratch)))
+        diag_out["source_mass_rate"] = float(np.sum(np.multiply(m_arr, source_arr, out=scratch)))
 
     return N_new, dt_eff, mass_err
 
@@ -476,6 +628,7 @@ def compute_mass_budget_error_C4(
     dt: float,
     *,
     extra_mass_loss_rate: float = 0.0,
+    scratch: np.ndarray | None = None,
 ) -> float:
     """Return the relative mass budget error according to (C4).
 
@@ -483,6 +636,8 @@ def compute_mass_budget_error_C4(
     and explicit source/sink fluxes:
 
     ``M_old + dt * prod_subblow_mass_rate = M_new + dt * extra_mass_loss_rate``.
+
+    ``scratch`` (same shape as ``m``) avoids the temporary products.
     """
 
     global _NUMBA_FAILED
@@ -491,13 +646,21 @@ def compute_mass_budget_error_C4(
     m_arr = np.asarray(m, dtype=float)
     if not (N_old_arr.shape == N_new_arr.shape == m_arr.shape):
         raise MarsDiskError("array shapes must match")
+    if scratch is not None and scratch.shape != m_arr.shape:
+        scratch = None
 
     if _USE_NUMBA and not _NUMBA_FAILED:
         try:
+            if scratch is not None:
+                N_old_c = np.ascontiguousarray(N_old_arr)
+                N_new_c = np.ascontiguousarray(N_new_arr)
+            else:
+                N_old_c = m_arr * 0.0 + N_old_arr  # ensure contiguous copies
+                N_new_c = m_arr * 0.0 + N_new_arr
             err = float(
                 mass_budget_error_numba(
-                    m_arr * 0.0 + N_old_arr,  # ensure contiguous copies
-                    m_arr * 0.0 + N_new_arr,
+                    N_old_c,
+                    N_new_c,
                     m_arr,
                     float(prod_subblow_mass_rate),
                     float(dt),
@@ -515,8 +678,12 @@ def compute_mass_budget_error_C4(
         err = None
 
     if err is None:
-        M_before = float(np.sum(m_arr * N_old_arr))
-        M_after = float(np.sum(m_arr * N_new_arr))
+        if scratch is not None:
+            M_before = float(np.sum(np.multiply(m_arr, N_old_arr, out=scratch)))
+            M_after = float(np.sum(np.multiply(m_arr, N_new_arr, out=scratch)))
+        else:
+            M_before = float(np.sum(m_arr * N_old_arr))
+            M_after = float(np.sum(m_arr * N_new_arr))
         prod_term = dt * float(prod_subblow_mass_rate)
         extra_term = dt * float(extra_mass_loss_rate)
         diff = M_after + extra_term - (M_before + prod_term)
@@ -28,6 +28,7 @@ import numpy as np
 
 from . import constants, grid
 from .physics import radiation, shielding, psd, surface, sinks, sizes
+from .physics import _numba_radiation
 from .physics.sublimation import grain_temperature_graybody
 from .runtime.helpers import compute_gate_factor, fast_blowout_correction_factor
 
@@ -251,6 +252,99 @@ def compute_radiation_parameters(
     )
 
 
+class RadiationStepDriver:
+    """Per-step R1–R3 evaluation for the 0D loop.
+
+    With a ⟨Q_pr⟩ table and Numba available, the blow-out fixed point and
+    the ⟨Q_pr⟩ lookups run in compiled kernels
+    (:mod:`marsdisk.physics._numba_radiation`) instead of a dozen validated
+    Python lookups per step.  Clamped table points, ``qpr_override`` and
+    custom lookups take the Python path, so results are identical to
+    :func:`compute_radiation_parameters`.  The grid is captured once; the
+    ⟨Q_pr⟩ table must not be reloaded while the driver is in use.
+    """
+
+    def __init__(self, rho: float, *, qpr_override: Optional[float] = None, iterations: int = 6) -> None:
+        self.rho = float(rho)
+        self.qpr_override = qpr_override
+        self.iterations = int(iterations)
+        self._table = None if qpr_override is not None else radiation.compiled_qpr_table()
+        self.compiled_steps = 0
+        self.python_steps = 0
+
+    @property
+    def compiled(self) -> bool:
+        return self._table is not None
+
+    def _temperature_ok(self, T_M: float) -> bool:
+        T_min, T_max = radiation.T_M_RANGE
+        return math.isfinite(T_M) and T_min <= T_M <= T_max
+
+    def blowout(self, s_min: float, T_M: float, *, initial: Optional[float] = None) -> Tuple[float, float]:
+        """Return ``(a_blow, ⟨Q_pr⟩(a_blow))`` for the current step."""
+
+        if self._table is not None and self._temperature_ok(T_M):
+            s_vals, T_vals, q_vals = self._table
+            s_init = float(initial if initial is not None else s_min)
+            a_blow, qpr_blow = _numba_radiation.blowout_fixed_point_numba(
+                s_vals, T_vals, q_vals, self.rho, float(T_M), s_init, self.iterations
+            )
+            if math.isfinite(a_blow):
+                self.compiled_steps += 1
+                return float(a_blow), float(qpr_blow)
+        self.python_steps += 1
+        rad = compute_radiation_parameters(
+            s_min,
+            self.rho,
+            T_M,
+            qpr_override=self.qpr_override,
+            initial=initial,
+            iterations=self.iterations,
+        )
+        a_blow = float(rad.a_blow)
+        if self.qpr_override is not None:
+            return a_blow, float(self.qpr_override)
+        return a_blow, float(radiation.qpr_lookup(max(a_blow, 1.0e-12), T_M))
+
+    def at_smin(
+        self,
+        s_min: float,
+        T_M: float,
+        *,
+        a_blow: float,
+        qpr_lookup_fn: Optional[Callable[[float, float], float]] = None,
+    ) -> RadiationResult:
+        """Equivalent of ``compute_radiation_parameters(..., a_blow_override=a_blow)``."""
+
+        if self._table is not None and self._temperature_ok(T_M):
+            s_vals, T_vals, q_vals = self._table
+            qpr_mean = _numba_radiation.qpr_table_lookup_numba(
+                s_vals, T_vals, q_vals, max(float(s_min), 1.0e-12), float(T_M)
+            )
+            if qpr_mean > 0.0:
+                return RadiationResult(
+                    qpr_mean=float(qpr_mean),
+                    beta=radiation.beta(s_min, self.rho, T_M, Q_pr=float(qpr_mean)),
+                    a_blow=float(a_blow),
+                    T_M=T_M,
+                )
+        return compute_radiation_parameters(
+            s_min,
+            self.rho,
+            T_M,
+            qpr_override=self.qpr_override,
+            qpr_lookup_fn=qpr_lookup_fn,
+            a_blow_override=a_blow,
+        )
+
+    def stats(self) -> Dict[str, Any]:
+        return {
+            "compiled": self.compiled,
+            "compiled_steps": int(self.compiled_steps),
+            "python_steps": int(self.python_steps),
+        }
+
+
 # ===========================================================================
 # Shielding Functions (S0)
 # ===========================================================================
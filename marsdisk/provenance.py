@@ -3,18 +3,42 @@
 This module gathers lightweight metadata needed to reproduce a run from
 the on-disk artifacts. All collectors must be exception-safe: failures
 should return ``None`` values instead of raising.
+
+File digests are memoised per ``(path, size, mtime_ns, inode)`` and git
+metadata is resolved once per process.  Sweep drivers call
+:func:`publish_snapshot` before starting workers.  It hashes the shared
+tables in parallel, resolves git once, and exports the result through
+``MARSDISK_PROVENANCE_SNAPSHOT``.  Worker processes and ``marsdisk.run``
+subprocesses then load that snapshot instead of re-hashing and
+re-running git.
 """
 
 from __future__ import annotations
 
+import contextlib
 import datetime as dt
 import hashlib
+import json
+import os
 import platform
 import subprocess
 import sys
+import tempfile
+import threading
+from concurrent.futures import ThreadPoolExecutor
 from importlib import metadata
 from pathlib import Path
-from typing import Any, Iterable, Sequence
+from typing import Any, Dict, Iterable, Iterator, Optional, Sequence, Tuple
+
+SNAPSHOT_ENV = "MARSDISK_PROVENANCE_SNAPSHOT"
+_REPO_ROOT = Path(__file__).resolve().parents[1]
+_HASH_WORKERS = 4
+
+_StatKey = Tuple[str, int, int, int]
+_DIGESTS: Dict[_StatKey, str] = {}
+_GIT_INFO: Dict[str, Dict[str, Any]] = {}
+_CACHE_LOCK = threading.Lock()
+_SNAPSHOT_LOADED: Optional[str] = None
 
 _DEFAULT_PACKAGE_DISTS: tuple[str, ...] = (
     "numpy",
@@ -41,33 +65,59 @@ def _safe_package_version(dist_name: str) -> str | None:
         return None
 
 
-def _safe_git_commit(repo_root: Path | None = None) -> str | None:
-    root = repo_root
-    if root is None:
-        root = Path(__file__).resolve().parents[1]
-    try:
-        commit = subprocess.check_output(
-            ["git", "rev-parse", "HEAD"],
-            cwd=root,
-            text=True,
+def _run_git(args: Sequence[str], cwd: Path) -> str | None:
+    try:
+        return subprocess.check_output(
+            ["git", *args], cwd=cwd, text=True, stderr=subprocess.DEVNULL
         ).strip()
     except Exception:
         return None
-    return commit or None
 
 
-def _safe_sha256(
-    path: Path,
-    *,
-    max_bytes: int | None = None,
-    chunk_bytes: int = 1024 * 1024,
-) -> str | None:
+def _resolve_git_info(root: Path) -> Dict[str, Any]:
+    commit = _run_git(["rev-parse", "HEAD"], root)
+    branch = _run_git(["rev-parse", "--abbrev-ref", "HEAD"], root)
+    status = _run_git(["status", "--short"], root)
+    return {
+        "commit": commit or None,
+        "branch": branch or None,
+        "dirty": bool(status) if status is not None else None,
+    }
+
+
+def git_info(repo_root: Path | None = None) -> Dict[str, Any]:
+    """Return ``{"commit", "branch", "dirty"}`` for ``repo_root`` (memoised).
+
+    Values are ``None`` when git is unavailable.  A published snapshot (see
+    :func:`publish_snapshot`) is used when present.
+    """
+
+    _load_snapshot_from_env()
+    root = Path(repo_root) if repo_root is not None else _REPO_ROOT
+    key = str(root.resolve())
+    with _CACHE_LOCK:
+        cached = _GIT_INFO.get(key)
+    if cached is not None:
+        return dict(cached)
+    info = _resolve_git_info(root)
+    with _CACHE_LOCK:
+        _GIT_INFO.setdefault(key, info)
+    return dict(info)
+
+
+def _safe_git_commit(repo_root: Path | None = None) -> str | None:
+    return git_info(repo_root).get("commit")
+
+
+def _stat_key(path: Path) -> _StatKey | None:
     try:
-        size_bytes = path.stat().st_size
+        stat = path.stat()
     except Exception:
         return None
-    if max_bytes is not None and size_bytes > max_bytes:
-        return None
+    return (str(path), int(stat.st_size), int(stat.st_mtime_ns), int(stat.st_ino))
+
+
+def _hash_file(path: Path, chunk_bytes: int) -> str | None:
     hasher = hashlib.sha256()
     try:
         with path.open("rb") as fh:
@@ -78,6 +128,179 @@ def _safe_sha256(
     return hasher.hexdigest()
 
 
+def _safe_sha256(
+    path: Path,
+    *,
+    max_bytes: int | None = None,
+    chunk_bytes: int = 1024 * 1024,
+) -> str | None:
+    key = _stat_key(path)
+    if key is None:
+        return None
+    if max_bytes is not None and key[1] > max_bytes:
+        return None
+    _load_snapshot_from_env()
+    with _CACHE_LOCK:
+        cached = _DIGESTS.get(key)
+    if cached is not None:
+        return cached
+    digest = _hash_file(path, chunk_bytes)
+    if digest is not None:
+        with _CACHE_LOCK:
+            _DIGESTS[key] = digest
+    return digest
+
+
+def hash_files(
+    paths: Iterable[str | Path | None],
+    *,
+    max_bytes: int | None = None,
+    max_workers: int = _HASH_WORKERS,
+) -> Dict[str, str | None]:
+    """Return ``{resolved_path: sha256}``, hashing uncached files in parallel.
+
+    ``hashlib`` releases the GIL on large buffers, so threads overlap both
+    I/O and digest computation.
+    """
+
+    resolved: list[Path] = []
+    seen: set[str] = set()
+    for item in paths:
+        if not item:
+            continue
+        try:
+            path = Path(str(item)).expanduser().resolve()
+        except Exception:
+            continue
+        if str(path) in seen:
+            continue
+        seen.add(str(path))
+        resolved.append(path)
+    if len(resolved) <= 1 or max_workers <= 1:
+        return {str(path): _safe_sha256(path, max_bytes=max_bytes) for path in resolved}
+    with ThreadPoolExecutor(max_workers=min(max_workers, len(resolved))) as pool:
+        digests = list(pool.map(lambda p: _safe_sha256(p, max_bytes=max_bytes), resolved))
+    return {str(path): digest for path, digest in zip(resolved, digests)}
+
+
+def provenance_snapshot() -> Dict[str, Any]:
+    """JSON-serialisable copy of the memoised git info and file digests."""
+
+    with _CACHE_LOCK:
+        return {
+            "git": {root: dict(info) for root, info in _GIT_INFO.items()},
+            "digests": [
+                {"path": key[0], "size": key[1], "mtime_ns": key[2], "inode": key[3], "sha256": digest}
+                for key, digest in _DIGESTS.items()
+            ],
+        }
+
+
+def install_snapshot(snapshot: Dict[str, Any]) -> None:
+    """Seed the memo caches from :func:`provenance_snapshot` output.
+
+    Digests are keyed by the file's stat tuple, so entries for files that
+    changed since the snapshot are simply never hit.
+    """
+
+    git_payload = snapshot.get("git") if isinstance(snapshot, dict) else None
+    digests = snapshot.get("digests") if isinstance(snapshot, dict) else None
+    with _CACHE_LOCK:
+        if isinstance(git_payload, dict):
+            for root, info in git_payload.items():
+                if isinstance(info, dict):
+                    _GIT_INFO.setdefault(str(root), dict(info))
+        if isinstance(digests, list):
+            for row in digests:
+                try:
+                    key = (str(row["path"]), int(row["size"]), int(row["mtime_ns"]), int(row["inode"]))
+                except (KeyError, TypeError, ValueError):
+                    continue
+                if row.get("sha256"):
+                    _DIGESTS.setdefault(key, str(row["sha256"]))
+
+
+def _load_snapshot_from_env() -> None:
+    global _SNAPSHOT_LOADED
+    path = os.environ.get(SNAPSHOT_ENV)
+    if not path or path == _SNAPSHOT_LOADED:
+        return
+    _SNAPSHOT_LOADED = path
+    try:
+        payload = json.loads(Path(path).read_text(encoding="utf-8"))
+    except Exception:
+        return
+    install_snapshot(payload)
+
+
+def publish_snapshot(
+    *,
+    external_files: Iterable[str | Path | None] = (),
+    path: str | Path | None = None,
+    max_external_file_bytes: int = 50 * 1024 * 1024,
+) -> Path | None:
+    """Resolve git and hash ``external_files`` once, then export for workers.
+
+    The snapshot is written to ``path`` (a temporary file by default) and
+    ``MARSDISK_PROVENANCE_SNAPSHOT`` is set in ``os.environ`` so forked or
+    spawned workers and ``marsdisk.run`` subprocesses inherit it.
+    """
+
+    git_info()
+    hash_files(external_files, max_bytes=max_external_file_bytes)
+    payload = provenance_snapshot()
+    try:
+        if path is None:
+            fd, tmp_name = tempfile.mkstemp(prefix="marsdisk_provenance_", suffix=".json")
+            os.close(fd)
+            target = Path(tmp_name)
+        else:
+            target = Path(path)
+            target.parent.mkdir(parents=True, exist_ok=True)
+        target.write_text(json.dumps(payload), encoding="utf-8")
+    except Exception:
+        return None
+    global _SNAPSHOT_LOADED
+    os.environ[SNAPSHOT_ENV] = str(target)
+    _SNAPSHOT_LOADED = str(target)
+    return target
+
+
+@contextlib.contextmanager
+def shared_snapshot(
+    *,
+    external_files: Iterable[str | Path | None] = (),
+    max_external_file_bytes: int = 50 * 1024 * 1024,
+) -> Iterator[Path | None]:
+    """:func:`publish_snapshot` into a temporary file for the ``with`` block."""
+
+    previous = os.environ.get(SNAPSHOT_ENV)
+    target = publish_snapshot(
+        external_files=external_files,
+        max_external_file_bytes=max_external_file_bytes,
+    )
+    try:
+        yield target
+    finally:
+        if previous is None:
+            os.environ.pop(SNAPSHOT_ENV, None)
+        else:
+            os.environ[SNAPSHOT_ENV] = previous
+        if target is not None:
+            try:
+                target.unlink()
+            except OSError:
+                pass
+
+
+def clear_provenance_cache() -> None:
+    global _SNAPSHOT_LOADED
+    with _CACHE_LOCK:
+        _DIGESTS.clear()
+        _GIT_INFO.clear()
+    _SNAPSHOT_LOADED = None
+
+
 def gather_runtime_provenance(
     *,
     external_files: Iterable[str | Path | None] = (),
@@ -135,6 +358,8 @@ def gather_runtime_provenance(
     for dist in package_dists or _DEFAULT_PACKAGE_DISTS:
         packages[dist] = _safe_package_version(dist)
 
+    external_files = list(external_files)
+    digests = hash_files(external_files, max_bytes=max_external_file_bytes)
     external_rows: list[dict[str, Any]] = []
     seen: set[str] = set()
     for item in external_files:
@@ -173,10 +398,9 @@ def gather_runtime_provenance(
                 size_bytes = path_resolved.stat().st_size
             except Exception:
                 size_bytes = None
-            sha256 = _safe_sha256(
-                path_resolved,
-                max_bytes=max_external_file_bytes,
-            )
+            sha256 = digests.get(key)
+            if sha256 is None:
+                sha256 = _safe_sha256(path_resolved, max_bytes=max_external_file_bytes)
 
         external_rows.append(
             {
@@ -202,4 +426,14 @@ def gather_runtime_provenance(
     }
 
 
-__all__ = ["gather_runtime_provenance"]
+__all__ = [
+    "SNAPSHOT_ENV",
+    "clear_provenance_cache",
+    "gather_runtime_provenance",
+    "git_info",
+    "hash_files",
+    "install_snapshot",
+    "provenance_snapshot",
+    "publish_snapshot",
+    "shared_snapshot",
+]
@@ -2,6 +2,7 @@
 from __future__ import annotations
 
 import copy
+import json
 import logging
 import math
 import os
@@ -23,8 +24,12 @@ from .orchestrator import (
     resolve_seed as _resolve_seed,
     human_bytes as _human_bytes,
     memory_estimate as _memory_estimate,
+    resolve_run_plan as _resolve_run_plan,
 )
-from .runtime import ColumnarBuffer, ProgressReporter, ZeroDHistory
+from .runtime import ArrayColumnarBuffer, ColumnarBuffer, ProgressReporter, ZeroDHistory, new_record_buffer
+from .runtime.history import RECORD_STORAGE_MODES
+from .runtime.events import EventEngine
+from .runtime import memory_plan as memory_plan_mod, placement as placement_mod, thread_budget
 from .runtime.helpers import (
     compute_phase_tau_fields,
     compute_gate_factor,
@@ -36,12 +41,7 @@ from .runtime.helpers import (
     safe_float as _safe_float,
     float_or_nan as _float_or_nan,
 )
-from .output_schema import (
-    ONE_D_EXTRA_DIAGNOSTIC_KEYS,
-    ONE_D_EXTRA_SERIES_KEYS,
-    ZERO_D_DIAGNOSTIC_KEYS,
-    ZERO_D_SERIES_KEYS,
-)
+from .output_schema import OutputSelection
 from .schema import Config
 from .physics import (
     psd,
@@ -110,6 +110,20 @@ class CellStepPayload(NamedTuple):
     sums: np.ndarray
 
 
+def _write_cell_rows(
+    buffer: ArrayColumnarBuffer,
+    row_base: int,
+    rows: List[tuple[int, Dict[str, Any]]],
+) -> None:
+    """Write ``(cell_index, record)`` pairs into reserved rows, one contiguous cell run at a time."""
+
+    run_start = 0
+    for pos in range(1, len(rows) + 1):
+        if pos == len(rows) or rows[pos][0] != rows[pos - 1][0] + 1:
+            buffer.write_rows(row_base + rows[run_start][0], [record for _, record in rows[run_start:pos]])
+            run_start = pos
+
+
 def _clamp_sigma_surf(value: float, *, label: str = "sigma_surf") -> float:
     """Return a non-negative finite surface density (clamped to 0 on invalid)."""
 
@@ -146,6 +160,82 @@ def _env_int(name: str) -> Optional[int]:
         return None
 
 
+def _load_adaptive_pilot(pilot_dir: Path) -> tuple[np.ndarray, np.ndarray, np.ndarray]:
+    """Return ``(edges_m, Sigma_surf, tau)`` at the last step of a finished 1D run."""
+
+    pilot_dir = Path(pilot_dir)
+    series_dir = pilot_dir / "series"
+    run_path = series_dir / "run.parquet"
+    if not run_path.exists():
+        chunks = sorted(series_dir.glob("run_chunk_*.parquet"))
+        if not chunks:
+            raise ConfigurationError(f"geometry.adapt_from has no 1D run series: {pilot_dir}")
+        run_path = chunks[-1]
+    columns = ["time", "cell_index", "r_m", "Sigma_surf", "tau_los_mars"]
+    try:
+        df = pd.read_parquet(run_path, columns=columns)
+    except Exception as exc:
+        raise ConfigurationError(f"geometry.adapt_from series lacks 1D columns {columns}: {run_path}") from exc
+    last = df[df["time"] == df["time"].max()].sort_values("cell_index")
+    r_centres = last["r_m"].to_numpy(dtype=float)
+    sigma = last["Sigma_surf"].to_numpy(dtype=float)
+    tau = last["tau_los_mars"].to_numpy(dtype=float)
+
+    edges = None
+    summary_path = pilot_dir / "summary.json"
+    if summary_path.exists():
+        geometry_summary = json.loads(summary_path.read_text(encoding="utf-8")).get("geometry") or {}
+        edges_raw = geometry_summary.get("edges_m")
+        if edges_raw is not None and len(edges_raw) == r_centres.size + 1:
+            edges = np.asarray(edges_raw, dtype=float)
+    if edges is None:
+        # Older pilots only carry cell centres; rebuild edges from the midpoints.
+        if r_centres.size < 2:
+            raise ConfigurationError("geometry.adapt_from needs a pilot with at least two cells")
+        inner = 0.5 * (r_centres[:-1] + r_centres[1:])
+        edges = np.concatenate(
+            ([2.0 * r_centres[0] - inner[0]], inner, [2.0 * r_centres[-1] - inner[-1]])
+        )
+    return edges, sigma, tau
+
+
+def _build_radial_grid(
+    geometry_cfg: Any,
+    r_in_m: float,
+    r_out_m: float,
+    n_cells: int,
+) -> tuple[grid.RadialGrid, Dict[str, Any]]:
+    """Build the 1D cell layout requested by ``geometry.spacing``."""
+
+    spacing = str(getattr(geometry_cfg, "spacing", "linear") or "linear")
+    info: Dict[str, Any] = {"spacing": spacing}
+    if spacing == "log":
+        return grid.RadialGrid.logarithmic(r_in_m, r_out_m, n_cells), info
+    if spacing == "edges":
+        edges_rm = np.asarray(getattr(geometry_cfg, "edges_RM"), dtype=float)
+        return grid.RadialGrid.from_edges(edges_rm * constants.R_MARS), info
+    if spacing == "adaptive":
+        pilot_dir = Path(getattr(geometry_cfg, "adapt_from"))
+        pilot_edges, pilot_sigma, pilot_tau = _load_adaptive_pilot(pilot_dir)
+        # Clip the pilot layout to this run's radii so no cell falls outside the disk.
+        pilot_edges = np.clip(pilot_edges, r_in_m, r_out_m)
+        pilot_edges[0] = r_in_m
+        pilot_edges[-1] = r_out_m
+        keep = np.concatenate(([True], np.diff(pilot_edges) > 0.0))
+        keep_cells = keep[1:]
+        edges, stats = grid.adapt_edges(
+            pilot_edges[keep],
+            [pilot_sigma[keep_cells], pilot_tau[keep_cells]],
+            split_tol=float(getattr(geometry_cfg, "adapt_split_tol", 0.2)),
+            merge_tol=float(getattr(geometry_cfg, "adapt_merge_tol", 0.02)),
+            n_min=max(n_cells, 1),
+            n_max=getattr(geometry_cfg, "adapt_max_cells", None),
+        )
+        info.update({"adapt_from": str(pilot_dir), "pilot_cells": int(pilot_sigma.size), **stats})
+        return grid.RadialGrid.from_edges(edges), info
+    return grid.RadialGrid.linear(r_in_m, r_out_m, n_cells), info
+
+
 def _resolve_cell_parallel_config(
     *,
     os_name: str,
@@ -233,8 +323,9 @@ def run_one_d(
     geometry_cfg = getattr(cfg, "geometry", None)
     if geometry_cfg is None or getattr(geometry_cfg, "mode", "0D") != "1D":
         raise ConfigurationError("run_one_d requires geometry.mode='1D'")
+    grid_spacing = str(getattr(geometry_cfg, "spacing", "linear") or "linear")
     n_cells = int(getattr(geometry_cfg, "Nr", 0) or 0)
-    if n_cells <= 0:
+    if n_cells <= 0 and grid_spacing != "adaptive":
         raise ConfigurationError("geometry.Nr must be positive for 1D runs")
 
     disk_geom = getattr(cfg, "disk", None)
@@ -252,12 +343,19 @@ def run_one_d(
         r_in_m = float(r_in_raw)
         r_out_m = float(r_out_raw)
         geometry_source = "geometry.r_in_out"
+    if grid_spacing == "edges":
+        # Explicit edges define the disk extent.
+        edges_rm_cfg = list(getattr(geometry_cfg, "edges_RM"))
+        r_in_m = float(edges_rm_cfg[0]) * constants.R_MARS
+        r_out_m = float(edges_rm_cfg[-1]) * constants.R_MARS
+        geometry_source = "geometry.edges_RM"
     if r_in_m <= 0.0 or r_out_m <= 0.0 or not (math.isfinite(r_in_m) and math.isfinite(r_out_m)):
         raise ConfigurationError("geometry.r_in/r_out must be positive and finite")
     if r_in_m >= r_out_m:
         raise ConfigurationError("geometry.r_in must be less than r_out")
 
-    radial_grid = grid.RadialGrid.linear(r_in_m, r_out_m, n_cells)
+    radial_grid, radial_grid_info = _build_radial_grid(geometry_cfg, r_in_m, r_out_m, n_cells)
+    n_cells = int(radial_grid.r.size)
     r_vals = np.asarray(radial_grid.r, dtype=float)
     r_rm_vals = r_vals / constants.R_MARS
     area_vals = np.asarray(radial_grid.areas, dtype=float)
@@ -317,6 +415,28 @@ def run_one_d(
         cell_min_cells_per_job = 1
     cell_chunk_size_raw = cell_chunk_size_env if cell_chunk_size_env is not None else 0
 
+    # Cell workers are created before the time grid exists, so the budget caps
+    # them here from the fixed footprint (caches + Smol temporaries) only.
+    memory_budget_cfg = getattr(cfg.io, "memory_budget", None)
+    collision_cache_cfg = getattr(cfg.numerics, "collision_cache", None)
+    cache_scale_requested = (
+        float(getattr(collision_cache_cfg, "size_scale", 3.0))
+        if collision_cache_cfg is not None
+        else collisions_smol.collision_cache_scale()
+    )
+    memory_worker_plan = memory_plan_mod.plan_from_config(
+        memory_budget_cfg,
+        memory_plan_mod.MemoryRequest(
+            n_steps=0,
+            n_bins=int(getattr(cfg.sizes, "n_bins", 40)),
+            n_cells=n_cells,
+            cell_jobs=cell_jobs_requested,
+            cache_scale=cache_scale_requested,
+        ),
+    )
+    if memory_worker_plan is not None:
+        cell_jobs_requested = memory_worker_plan.cell_jobs
+
     cell_coupling_enabled = bool(
         getattr(cfg.numerics, "enable_viscosity", False)
         or getattr(cfg.numerics, "enable_radial_transport", False)
@@ -343,17 +463,13 @@ def run_one_d(
         numba_threads_env = None
     numba_threads_auto = None
     numba_threads_effective = None
+    thread_plan = thread_budget.ThreadBudget.from_env().partition(
+        cell_workers=cell_jobs_effective if cell_parallel_enabled else 1
+    )
     if cell_parallel_enabled and cell_jobs_effective > 1 and numba_threads_env is None:
-        cores = os.cpu_count() or 1
-        numba_threads_auto = max(1, cores // cell_jobs_effective)
+        numba_threads_auto = thread_plan.numba_threads
         os.environ["NUMBA_NUM_THREADS"] = str(numba_threads_auto)
-        try:
-            import numba  # type: ignore
-
-            numba.set_num_threads(numba_threads_auto)
-            numba_threads_effective = int(numba.get_num_threads())
-        except Exception:
-            numba_threads_effective = None
+        numba_threads_effective = thread_budget.set_numba_threads(numba_threads_auto)["applied"]
 
     cell_parallel_info = {
         "requested": cell_parallel_requested,
@@ -383,6 +499,7 @@ def run_one_d(
     }
     thread_info = {
         "env": thread_env,
+        "budget": thread_plan.to_dict(),
         "numba_threads_env": numba_threads_env,
         "numba_threads_auto": numba_threads_auto,
         "numba_threads_effective": numba_threads_effective,
@@ -403,12 +520,23 @@ def run_one_d(
 
     cell_chunks = None
     cell_executor = None
+    cell_parallel_info["placement"] = {"enabled": False}
     if cell_parallel_enabled:
         cell_chunks = [
             range(start, min(start + cell_chunk_size_effective, n_cells))
             for start in range(0, n_cells, cell_chunk_size_effective)
         ]
-        cell_executor = ThreadPoolExecutor(max_workers=cell_jobs_effective)
+        cell_placement_plan = []
+        if placement_mod.placement_requested() and hasattr(os, "sched_setaffinity"):
+            cell_placement_plan = placement_mod.plan_placement(
+                cell_jobs_effective,
+                threads_per_worker=numba_threads_effective or numba_threads_auto or 1,
+            )
+        if cell_placement_plan:
+            cell_executor = placement_mod.PinnedWorkerPool(cell_placement_plan)
+            cell_parallel_info["placement"] = cell_executor.report()
+        else:
+            cell_executor = ThreadPoolExecutor(max_workers=cell_jobs_effective)
 
     scope_cfg = getattr(cfg, "scope", None)
     analysis_window_years = float(getattr(scope_cfg, "analysis_years", 2.0)) if scope_cfg else 2.0
@@ -718,7 +846,16 @@ def run_one_d(
     M_loss_cum = np.zeros(n_cells, dtype=float)
     M_sink_cum = np.zeros(n_cells, dtype=float)
     M_spill_cum = np.zeros(n_cells, dtype=float)
-    cell_active = np.ones(n_cells, dtype=bool)
+    cell_events = EventEngine(n_cells)
+    if optical_depth_enabled and optical_tau_stop is not None:
+        cell_events.register(
+            "tau_exceeded",
+            threshold=optical_tau_stop * (1.0 + float(optical_tau_stop_tol or 0.0)),
+            direction="above",
+        )
+    cell_active = cell_events.active
+    # Run-level stop conditions are observed on their own single-subject engine.
+    run_events = EventEngine(1)
     cell_solid_state = np.zeros(n_cells, dtype=bool)
     cell_stop_reason: List[Optional[str]] = [None] * n_cells
     cell_stop_time = np.full(n_cells, float("nan"), dtype=float)
@@ -935,6 +1072,11 @@ def run_one_d(
             raise ConfigurationError(
                 "numerics.mass_loss_rate_stop_Mmars_s must be non-negative and finite"
             )
+        run_events.register(
+            "loss_rate_below_threshold",
+            threshold=loss_rate_stop_threshold,
+            direction="below",
+        )
     max_steps = MAX_STEPS
     if n_steps > max_steps:
         n_steps = max_steps
@@ -1067,19 +1209,61 @@ def run_one_d(
         diagnostics_stride = 1
     mass_budget_cells_enabled = bool(getattr(cfg.io, "mass_budget_cells", True))
 
+    memory_plan = None
+    if memory_worker_plan is not None:
+        memory_plan = memory_plan_mod.plan_from_config(
+            memory_budget_cfg,
+            memory_plan_mod.MemoryRequest(
+                n_steps=n_steps,
+                n_bins=n_bins,
+                n_cells=n_cells,
+                cell_jobs=cell_jobs_effective if cell_parallel_enabled else 1,
+                cache_scale=memory_worker_plan.cache_scale,
+                streaming_enabled=streaming_enabled,
+                step_flush_interval=streaming_step_interval,
+                memory_limit_gb=streaming_memory_limit_gb,
+                series_stride=series_stride,
+                diagnostics_enabled=OutputSelection.from_config(cfg.io, include_1d=True).diagnostics_enabled,
+                diagnostics_stride=diagnostics_stride,
+                psd_history_enabled=psd_history_enabled,
+                psd_history_stride=psd_history_stride,
+                mass_budget_cells_enabled=mass_budget_cells_enabled,
+            ),
+            # The cell worker count was fixed by the first plan above.
+            adjust_cell_jobs=False,
+        )
+    if memory_plan is not None:
+        memory_plan.adjustments[:0] = memory_worker_plan.adjustments
+        streaming_step_interval = memory_plan.step_flush_interval
+        streaming_memory_limit_gb = memory_plan.memory_limit_gb
+        psd_history_stride = memory_plan.psd_history_stride
+        memory_plan_mod.apply_cache_scale(memory_plan.cache_scale)
+    memory_watchdog = memory_plan_mod.watchdog_from_plan(memory_budget_cfg, memory_plan)
+
     record_storage_mode = str(getattr(cfg.io, "record_storage_mode", "row") or "row").lower()
-    if record_storage_mode not in {"row", "columnar"}:
+    if record_storage_mode not in RECORD_STORAGE_MODES:
         record_storage_mode = "row"
-    columnar_enabled = record_storage_mode == "columnar"
+    columnar_enabled = record_storage_mode != "row"
     if _env_flag("MARSDISK_DISABLE_COLUMNAR") is True:
         columnar_enabled = False
 
     history = ZeroDHistory()
     if columnar_enabled:
-        history.records = ColumnarBuffer()
-        history.diagnostics = ColumnarBuffer()
-    series_columns = list(ZERO_D_SERIES_KEYS) + list(ONE_D_EXTRA_SERIES_KEYS)
-    diagnostic_columns = list(ZERO_D_DIAGNOSTIC_KEYS) + list(ONE_D_EXTRA_DIAGNOSTIC_KEYS)
+        steps_hint = streaming_step_interval if streaming_enabled and streaming_step_interval > 0 else n_steps
+        history.records = new_record_buffer(
+            record_storage_mode, rows_hint=(steps_hint // series_stride + 1) * n_cells
+        )
+        history.diagnostics = new_record_buffer(
+            record_storage_mode, rows_hint=(steps_hint // diagnostics_stride + 1) * n_cells
+        )
+    # Array-backed buffers let each cell write its row slot in place instead of
+    # staging per-step lists that are merged afterwards.
+    series_rows_direct = isinstance(history.records, ArrayColumnarBuffer)
+    diagnostics_rows_direct = isinstance(history.diagnostics, ArrayColumnarBuffer)
+    output_selection = OutputSelection.from_config(cfg.io, include_1d=True)
+    series_columns = output_selection.series_columns
+    diagnostic_columns = output_selection.diagnostic_columns
+    diagnostics_enabled = output_selection.diagnostics_enabled
     streaming_state = StreamingState(
         enabled=streaming_enabled,
         outdir=Path(cfg.io.outdir),
@@ -1091,12 +1275,16 @@ def run_one_d(
         cleanup_chunks=streaming_cleanup_chunks,
         series_columns=series_columns,
         diagnostic_columns=diagnostic_columns,
+        drop_extra_columns=output_selection.drop_extra_columns,
+        float32_columns=list(output_selection.float32_columns),
         offload_enabled=offload_enabled,
         offload_dir=offload_dir_final,
         offload_keep_last_n=offload_keep_last_n,
         offload_mode=offload_mode,
         offload_verify=offload_verify,
         offload_skip_if_same_device=offload_skip_if_same_device,
+        mass_budget_format=str(getattr(cfg.io, "mass_budget_format", "csv") or "csv"),
+        partial_summary=bool(getattr(streaming_cfg, "partial_summary", True)),
     )
     steps_since_flush = 0
 
@@ -1107,7 +1295,7 @@ def run_one_d(
         series_stride=series_stride,
         psd_history_enabled=psd_history_enabled,
         psd_history_stride=psd_history_stride,
-        diagnostics_enabled=True,
+        diagnostics_enabled=diagnostics_enabled,
         diagnostics_stride=diagnostics_stride,
         mass_budget_enabled=True,
         mass_budget_cells_enabled=mass_budget_cells_enabled,
@@ -1123,6 +1311,11 @@ def run_one_d(
         memory_header=mem_long,
     )
     progress.emit_header()
+    run_plan = _resolve_run_plan(cfg, physics_mode)
+    # Only supply or radial coupling can refill an empty cell.
+    retire_inert_cells = bool(
+        run_plan.retire_inert_cells and not supply_enabled_cfg and not cell_coupling_enabled
+    )
 
     time = 0.0
     step_no = 0
@@ -1145,7 +1338,7 @@ def run_one_d(
                 or step_no % series_stride == 0
                 or step_no == n_steps - 1
             )
-            diagnostics_write = (
+            diagnostics_write = diagnostics_enabled and (
                 diagnostics_stride <= 1
                 or step_no % diagnostics_stride == 0
                 or step_no == n_steps - 1
@@ -1177,7 +1370,7 @@ def run_one_d(
             s_min_effective_last = s_min_effective
             step_end_time = time + dt
             if (
-                bool(getattr(cfg.numerics, "stop_on_blowout_below_smin", False))
+                run_plan.stop_on_blowout_below_smin
                 and a_blow_step <= s_min_config
                 and (min_duration_s <= 0.0 or time >= min_duration_s)
             ):
@@ -1194,10 +1387,20 @@ def run_one_d(
                 step_records = []
                 step_diagnostics = []
             step_sums = np.zeros(STEP_SUM_COUNT, dtype=float)
+            series_row_base = (
+                history.records.reserve_rows(n_cells) if series_write and series_rows_direct else None
+            )
+            diagnostics_row_base = (
+                history.diagnostics.reserve_rows(n_cells)
+                if diagnostics_write and diagnostics_rows_direct
+                else None
+            )
 
             def _run_cell_indices(indices):
                 local_step_records = []
                 local_step_diagnostics = []
+                local_series_rows = []
+                local_diagnostics_rows = []
                 local_sums = np.zeros(STEP_SUM_COUNT, dtype=float)
                 local_psd_hist_records = [] if psd_history_enabled else None
                 local_mass_budget_cells = [] if mass_budget_cells_enabled else None
@@ -1405,7 +1608,9 @@ def run_one_d(
                                 "cell_stop_time": float(cell_stop_time[idx]) if math.isfinite(cell_stop_time[idx]) else None,
                                 "cell_stop_tau": float(cell_stop_tau[idx]) if math.isfinite(cell_stop_tau[idx]) else None,
                             }
-                        if series_write:
+                        if series_row_base is not None:
+                            local_series_rows.append((idx, record))
+                        elif series_write:
                             local_step_records.append(record)
                         tau_los_inactive = record.get("tau_los_mars")
                         if diagnostics_write:
@@ -1504,7 +1709,10 @@ def run_one_d(
                                 "mass_loss_surface_solid_step": 0.0,
                                 "blowout_gate_factor": 1.0,
                             }
-                            local_step_diagnostics.append(diag_entry)
+                            if diagnostics_row_base is not None:
+                                local_diagnostics_rows.append((idx, diag_entry))
+                            else:
+                                local_step_diagnostics.append(diag_entry)
                         local_sums[SUM_AREA] += area_val
                         local_sums[SUM_DT_OVER_T_BLOW] += 0.0
                         continue
@@ -1513,7 +1721,7 @@ def run_one_d(
                         sigma_val = 0.0
 
                     psd_state["s_min"] = s_min_effective
-                    if getattr(cfg.radiation, "freeze_kappa", False):
+                    if run_plan.freeze_kappa:
                         kappa_surf = kappa_surf_initial
                     else:
                         kappa_surf = ensure_finite_kappa(psd.compute_kappa(psd_state), label="kappa_surf_step")
@@ -1597,7 +1805,7 @@ def run_one_d(
                             enable_sublimation=sublimation_enabled_cfg,
                             sub_params=sub_params,
                             enable_gas_drag=gas_drag_enabled_cfg,
-                            rho_g=cfg.sinks.rho_g if gas_drag_enabled_cfg else 0.0,
+                            rho_g=run_plan.rho_gas if gas_drag_enabled_cfg else 0.0,
                         )
                         sink_result = sinks.total_sink_timescale(
                             T_use,
@@ -1704,7 +1912,7 @@ def run_one_d(
                         and supply_rate_applied_current <= supply_visibility_eps
                     )
 
-                    if collisions_active_step and getattr(cfg.surface, "collision_solver", "smol") != "smol":
+                    if collisions_active_step and run_plan.collision_solver != "smol":
                         raise ConfigurationError("1D runner supports collision_solver='smol' only")
 
                     outflux_surface = 0.0
@@ -1726,7 +1934,7 @@ def run_one_d(
                             ),
                             dynamics=collisions_smol.DynamicsParams(
                                 e_value=float(e_cells[idx]),
-                                i_value=float(getattr(cfg.dynamics, "i0", 0.05)),
+                                i_value=run_plan.i0,
                                 dynamics_cfg=(
                                     dynamics_cfg_cells[idx] if dynamics_cfg_cells is not None else cfg.dynamics
                                 ),
@@ -1744,15 +1952,15 @@ def run_one_d(
                             control=collisions_smol.CollisionControlFlags(
                                 enable_blowout=enable_blowout_step,
                                 collisions_enabled=collisions_active_step,
-                                mass_conserving_sublimation=bool(getattr(cfg.sinks.sub_params, "mass_conserving", False)),
+                                mass_conserving_sublimation=run_plan.mass_conserving_sublimation,
                                 headroom_policy=supply_headroom_policy,
                                 sigma_tau1=sigma_tau1_limit,
                                 t_sink=t_sink_step,
                                 ds_dt_val=ds_dt_val if sublimation_to_smol else None,
                                 energy_bookkeeping_enabled=False,
-                                eps_restitution=float(getattr(cfg.dynamics, "eps_restitution", 0.5)),
-                                f_ke_cratering=float(getattr(cfg.dynamics, "f_ke_cratering", 0.1)),
-                                f_ke_fragmentation=getattr(cfg.dynamics, "f_ke_fragmentation", None),
+                                eps_restitution=run_plan.eps_restitution,
+                                f_ke_cratering=run_plan.f_ke_cratering,
+                                f_ke_fragmentation=run_plan.f_ke_fragmentation,
                             ),
                             sigma_surf=sigma_val,
                         )
@@ -1793,12 +2001,12 @@ def run_one_d(
                         outflux_surface = surface_step.outflux
                         sink_flux_surface = surface_step.sink_flux
 
-                    if getattr(cfg.surface, "freeze_sigma", False):
+                    if run_plan.freeze_sigma:
                         sigma_val = float(sigma_surf0[idx])
 
                     sigma_val = _clamp_sigma_surf(sigma_val)
 
-                    if getattr(cfg.radiation, "freeze_kappa", False):
+                    if run_plan.freeze_kappa:
                         kappa_surf = kappa_surf_initial
                     else:
                         kappa_surf = ensure_finite_kappa(psd.compute_kappa(psd_state), label="kappa_surf_update")
@@ -1867,16 +2075,21 @@ def run_one_d(
                     if optical_depth_enabled and optical_tau_stop is not None and cell_is_solid:
                         kappa_for_stop = kappa_eff if math.isfinite(kappa_eff) else kappa_surf
                         tau_stop_los_current = float(kappa_for_stop * sigma_val * los_factor)
-                        if (
-                            math.isfinite(tau_stop_los_current)
-                            and tau_stop_los_current
-                            > optical_tau_stop * (1.0 + float(optical_tau_stop_tol or 0.0))
-                        ):
-                            cell_active[idx] = False
+                        if cell_events.observe("tau_exceeded", time + dt, tau_stop_los_current, idx) is not None:
                             cell_stop_tau[idx] = tau_stop_los_current
                             cell_stop_time[idx] = time + dt
                             cell_stop_reason[idx] = "tau_exceeded"
 
+                    if (
+                        retire_inert_cells
+                        and cell_active[idx]
+                        and sigma_val <= 0.0
+                        and sigma_deep_val <= 0.0
+                    ):
+                        cell_events.retire(idx, "inert")
+                        cell_stop_time[idx] = time + dt
+                        cell_stop_reason[idx] = "inert"
+
                     sigma_surf[idx] = sigma_val
                     psd_states[idx] = psd_state
 
@@ -2124,7 +2337,9 @@ def run_one_d(
                         "cell_stop_time": float(cell_stop_time[idx]) if math.isfinite(cell_stop_time[idx]) else None,
                         "cell_stop_tau": float(cell_stop_tau[idx]) if math.isfinite(cell_stop_tau[idx]) else None,
                     }
-                    if series_write:
+                    if series_row_base is not None:
+                        local_series_rows.append((idx, record))
+                    elif series_write:
                         local_step_records.append(record)
                     F_abs_geom = rad_flux_step * (constants.R_MARS / r_val) ** 2
                     F_abs_geom_qpr = F_abs_geom * qpr_mean_step
@@ -2255,7 +2470,10 @@ def run_one_d(
                             "smol_source_mass_rate": smol_source_mass_rate,
                             "blowout_gate_factor": gate_factor,
                         }
-                        local_step_diagnostics.append(diag_entry)
+                        if diagnostics_row_base is not None:
+                            local_diagnostics_rows.append((idx, diag_entry))
+                        else:
+                            local_step_diagnostics.append(diag_entry)
                     local_sums[SUM_AREA] += area_val
                     local_sums[SUM_SUPPLY_RATE_NOMINAL] += _safe_float(supply_rate_nominal_current) * area_val
                     local_sums[SUM_SUPPLY_RATE_SCALED] += _safe_float(supply_rate_scaled_current) * area_val
@@ -2333,6 +2551,10 @@ def run_one_d(
                             }
                         )
 
+                if series_row_base is not None:
+                    _write_cell_rows(history.records, series_row_base, local_series_rows)
+                if diagnostics_row_base is not None:
+                    _write_cell_rows(history.diagnostics, diagnostics_row_base, local_diagnostics_rows)
                 return CellStepPayload(
                     records=local_step_records,
                     diagnostics=local_step_diagnostics,
@@ -2413,6 +2635,10 @@ def run_one_d(
                 total_time_weight_sum += dt
 
             t_coll_min_output = float(t_coll_min) if math.isfinite(t_coll_min) else None
+            if series_row_base is not None:
+                history.records.set_column_range(
+                    "t_coll_kernel_min", series_row_base, series_row_base + n_cells, t_coll_min_output
+                )
             if step_records:
                 if isinstance(step_records, ColumnarBuffer):
                     step_records.set_column_constant("t_coll_kernel_min", t_coll_min_output)
@@ -2503,15 +2729,39 @@ def run_one_d(
             steps_since_flush += 1
             progress.update(step_no, time)
 
-            if streaming_state.should_flush(history, steps_since_flush):
+            watchdog_actions = memory_watchdog.check(step_no) if memory_watchdog is not None else ()
+            if "raise_stride" in watchdog_actions:
+                psd_history_stride = memory_watchdog.psd_history_stride
+            if streaming_state.should_flush(history, steps_since_flush) or (
+                "flush" in watchdog_actions and streaming_state.enabled
+            ):
                 streaming_state.flush(history, step_no)
+                streaming_state.write_partial_summary(
+                    {
+                        "geometry_mode": "1D",
+                        "time": float(time),
+                        "step_no": int(step_no),
+                        "n_steps": int(n_steps),
+                        "t_end": float(t_end),
+                        "M_loss": float(np.sum(M_loss_cum) + np.sum(M_sink_cum)),
+                        "M_out_cum": float(np.sum(M_loss_cum)),
+                        "M_sink_cum": float(np.sum(M_sink_cum)),
+                        "M_spill_cum": float(np.sum(M_spill_cum)),
+                        "cells_active": int(np.count_nonzero(cell_active)),
+                        "n_cells": int(n_cells),
+                        "perf": progress.perf_counters(step_no),
+                    }
+                )
                 steps_since_flush = 0
 
-            all_cells_solid_state = bool(np.all(cell_solid_state))
-
-            if np.all(~cell_active) and all_cells_solid_state:
-                early_stop_reason = "tau_exceeded_all_cells"
-                break
+            if cell_events.all_retired:
+                # Retired cells are terminal only once they are solid or provably inert.
+                inert_cells = np.array([reason == "inert" for reason in cell_stop_reason], dtype=bool)
+                if bool(np.all(cell_solid_state | inert_cells)):
+                    early_stop_reason = (
+                        "all_cells_retired" if bool(np.any(inert_cells)) else "tau_exceeded_all_cells"
+                    )
+                    break
 
             if (
                 loss_rate_stop_threshold is not None
@@ -2522,7 +2772,7 @@ def run_one_d(
                     loss_rate_total = (
                         float(step_sums[SUM_OUT_MASS]) + float(step_sums[SUM_SINK_MASS])
                     ) / dt
-                if math.isfinite(loss_rate_total) and loss_rate_total <= loss_rate_stop_threshold:
+                if run_events.observe("loss_rate_below_threshold", time, loss_rate_total) is not None:
                     early_stop_reason = "loss_rate_below_threshold"
                     logger.info(
                         "Early stop triggered: loss_rate=%.3e M_Mars/s <= threshold=%.3e at t=%.3e s (step %d)",
@@ -2543,6 +2793,8 @@ def run_one_d(
                 dt = dt_nominal
     finally:
         if cell_executor is not None:
+            if isinstance(cell_executor, placement_mod.PinnedWorkerPool):
+                cell_parallel_info["placement"] = cell_executor.report()
             cell_executor.shutdown(wait=True)
     progress.finish(step_no, time)
 
@@ -2553,69 +2805,55 @@ def run_one_d(
         if history.records:
             if isinstance(history.records, ColumnarBuffer):
                 table = history.records.to_table(ensure_columns=series_columns)
-                writer.write_parquet_table(table, outdir / "series" / "run.parquet")
+                writer.write_parquet_table(
+                    table,
+                    outdir / "series" / "run.parquet",
+                    **output_selection.write_kwargs("series"),
+                )
             else:
                 writer.write_parquet(
                     history.records,
                     outdir / "series" / "run.parquet",
-                    ensure_columns=series_columns,
+                    **output_selection.write_kwargs("series"),
                 )
         if history.diagnostics:
             if isinstance(history.diagnostics, ColumnarBuffer):
                 table = history.diagnostics.to_table(ensure_columns=diagnostic_columns)
-                writer.write_parquet_table(table, outdir / "series" / "diagnostics.parquet")
+                writer.write_parquet_table(
+                    table,
+                    outdir / "series" / "diagnostics.parquet",
+                    **output_selection.write_kwargs("diagnostics"),
+                )
             else:
                 writer.write_parquet(
                     history.diagnostics,
                     outdir / "series" / "diagnostics.parquet",
-                    ensure_columns=diagnostic_columns,
+                    **output_selection.write_kwargs("diagnostics"),
                 )
         if history.psd_hist_records:
             writer.write_parquet(
                 history.psd_hist_records,
                 outdir / "series" / "psd_hist.parquet",
             )
-    mass_budget_path = (
-        streaming_state.mass_budget_path if streaming_state.enabled else outdir / "checks" / "mass_budget.csv"
+    streaming_state.flush_mass_budget(history)
+    streaming_state.close_mass_budget()
+    streaming_state.mass_budget_log.ensure_exists(
+        ["time", "mass_initial", "mass_remaining", "mass_lost", "error_percent", "tolerance_percent"]
     )
-    if history.mass_budget:
-        writer.append_csv(history.mass_budget, mass_budget_path, header=not mass_budget_path.exists())
-        history.mass_budget.clear()
-    if not mass_budget_path.exists():
-        mass_budget_path.parent.mkdir(parents=True, exist_ok=True)
-        pd.DataFrame(columns=["time", "mass_initial", "mass_remaining", "mass_lost", "error_percent", "tolerance_percent"]).to_csv(
-            mass_budget_path,
-            index=False,
-        )
-
     if mass_budget_cells_enabled:
-        mass_budget_cells_path = (
-            streaming_state.mass_budget_cells_path
-            if streaming_state.enabled
-            else outdir / "checks" / "mass_budget_cells.csv"
+        streaming_state.mass_budget_cells_log.ensure_exists(
+            [
+                "time",
+                "cell_index",
+                "r_RM",
+                "mass_initial",
+                "mass_remaining",
+                "mass_lost",
+                "error_percent",
+                "tolerance_percent",
+                "cell_active",
+            ]
         )
-        if history.mass_budget_cells:
-            writer.append_csv(
-                history.mass_budget_cells,
-                mass_budget_cells_path,
-                header=not mass_budget_cells_path.exists(),
-            )
-            history.mass_budget_cells.clear()
-        if not mass_budget_cells_path.exists():
-            mass_budget_cells_path.parent.mkdir(parents=True, exist_ok=True)
-            pd.DataFrame(
-                columns=[
-                    "time",
-                    "cell_index",
-                    "r_RM",
-                    "mass_initial",
-                    "mass_remaining",
-                    "mass_lost",
-                    "error_percent",
-                    "tolerance_percent",
-                    "cell_active",
-                ]
-            ).to_csv(mass_budget_cells_path, index=False)
 
     M_out_cum = float(np.sum(M_loss_cum))
     M_sink_cum = float(np.sum(M_sink_cum))
@@ -2778,6 +3016,8 @@ def run_one_d(
             "r_in_m": float(r_in_m),
             "r_out_m": float(r_out_m),
             "Nr": int(n_cells),
+            "edges_m": [float(v) for v in radial_grid.edges],
+            **radial_grid_info,
         },
         "sigma_surf0_avg": sigma_surf0_avg,
         "sigma_surf0_target": sigma_surf0_target,
@@ -2792,6 +3032,9 @@ def run_one_d(
         "early_stop_reason": early_stop_reason,
         "stop_reason": stop_reason,
         "cells_stopped": int(np.sum(~cell_active)),
+        "cells_retired_inert": int(sum(1 for reason in cell_stop_reason if reason == "inert")),
+        "stop_events": cell_events.report(),
+        "run_stop_events": run_events.report(),
         "cells_total": int(n_cells),
         "time_end_s": time,
         "time_grid": {
@@ -2883,7 +3126,9 @@ def run_one_d(
         summary["M_out_mean_per_orbit"] = None
         summary["M_sink_mean_per_orbit"] = None
         summary["M_loss_mean_per_orbit"] = None
+    summary["summary_status"] = "complete"
     writer.write_summary(summary, outdir / "summary.json")
+    streaming_state.clear_partial_summary()
 
     sublimation_provenance = {
         "sublimation_formula": "HKL",
@@ -2979,6 +3224,9 @@ def run_one_d(
     }
     run_config_snapshot["cell_parallel"] = cell_parallel_info
     run_config_snapshot["threading"] = thread_info
+    if memory_plan is not None:
+        run_config_snapshot["memory_budget"] = memory_plan_mod.report(memory_plan, memory_watchdog)
+    run_config_snapshot["smol_arena"] = smol.arena_stats()
     run_config_snapshot["numba"] = numba_status
     if auto_tune_info is not None:
         run_config_snapshot["auto_tune"] = auto_tune_info
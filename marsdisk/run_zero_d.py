@@ -8,7 +8,6 @@ import logging
 import math
 import random
 import shutil
-import subprocess
 import textwrap
 import hashlib
 import json
@@ -36,18 +35,26 @@ from .orchestrator import (
     resolve_seed as _resolve_seed,
     human_bytes as _human_bytes,
     memory_estimate as _memory_estimate,
+    resolve_run_plan as _resolve_run_plan,
 )
 from .schema import Config
 from .runtime import (
     ColumnarBuffer,
     ProgressReporter,
     ZeroDHistory,
+    ZeroDRunResult,
+    new_record_buffer,
     ensure_finite_kappa as _ensure_finite_kappa,
     safe_float as _safe_float,
     float_or_nan as _float_or_nan,
     format_exception_short as _format_exception_short,
     log_stage,
 )
+from .runtime.history import RECORD_STORAGE_MODES
+from .runtime.events import EventEngine
+from .runtime.step_sampler import StepDiagnosticsSampler
+from .runtime import placement as placement_mod
+from .runtime import memory_plan as memory_plan_mod
 from .runtime.helpers import (
     compute_phase_tau_fields,
     resolve_feedback_tau_field as _resolve_feedback_tau_field,
@@ -85,7 +92,7 @@ from .io.streaming import (
     MEMORY_PSD_ROW_BYTES,
     MEMORY_DIAG_ROW_BYTES,
 )
-from .output_schema import ZERO_D_DIAGNOSTIC_KEYS, ZERO_D_SERIES_KEYS
+from .output_schema import OutputSelection
 from .physics.sublimation import SublimationParams, p_sat, grain_temperature_graybody, sublimation_sink_from_dsdt
 from . import constants
 from .errors import ConfigurationError, PhysicsError, NumericalError, MarsDiskError
@@ -108,6 +115,150 @@ _compute_gate_factor = compute_gate_factor
 _fast_blowout_correction_factor = fast_blowout_correction_factor
 
 _LAST_COLLISION_CACHE_SIGNATURE: str | None = None
+_LAST_COLLISION_SIZE_SIGNATURE: str | None = None
+
+# Optional series/diagnostics fields normalised per step (see the time loop).
+_SERIES_OPTIONAL_FLOAT_KEYS = frozenset(
+    {
+        "t_coll",
+        "ts_ratio",
+        "Sigma_surf0",
+        "Sigma_tau1",
+        "Sigma_tau1_active",
+        "sigma_tau1",
+        "Sigma_tau1_last_finite",
+        "tau_phase_los",
+        "tau_phase_used",
+        "t_solid_s",
+        "prod_subblow_area_rate_raw",
+        "dotSigma_prod",
+        "mu_orbit10pct",
+        "epsilon_mix",
+        "prod_rate_raw",
+        "supply_rate_nominal",
+        "supply_rate_scaled",
+        "supply_headroom",
+        "headroom",
+        "supply_clip_factor",
+        "supply_visibility_factor",
+        "supply_temperature_scale",
+        "supply_temperature_value",
+        "supply_feedback_scale",
+        "supply_feedback_error",
+        "supply_reservoir_remaining_Mmars",
+        "supply_reservoir_fraction",
+        "phi_effective",
+        "phi_used",
+        "kappa_eff",
+        "kappa_surf",
+        "phase_f_vap",
+        "phase_bulk_f_liquid",
+        "phase_bulk_f_solid",
+        "phase_bulk_f_vapor",
+        "M_sink_cum",
+        "e_kernel_used",
+        "i_kernel_used",
+        "e_kernel_base",
+        "i_kernel_base",
+        "e_kernel_supply",
+        "i_kernel_supply",
+        "e_kernel_effective",
+        "i_kernel_effective",
+        "supply_velocity_weight_w",
+        "s_min_surface_energy",
+        "e_state_next",
+        "i_state_next",
+        "t_damp_collisions",
+        "e_eq_target",
+    }
+)
+_SERIES_OPTIONAL_STRING_KEYS = frozenset(
+    {
+        "phase_tau_field",
+        "phase_temperature_input",
+        "supply_transport_mode",
+        "tau_phase_used",
+        "case_status",
+        "T_M_source",
+        "T_source",
+        "phase_state",
+        "phase_method",
+        "phase_reason",
+        "phase_bulk_state",
+        "blowout_layer_mode",
+        "blowout_target_phase",
+        "sink_selected",
+        "supply_temperature_value_kind",
+    }
+)
+_DIAG_OPTIONAL_FLOAT_KEYS = frozenset(
+    {
+        "sigma_tau1",
+        "sigma_tau1_active",
+        "Sigma_tau1_last_finite",
+        "tau_phase_los",
+        "tau_phase_used",
+        "t_sink_total_s",
+        "t_sink_surface_s",
+        "t_sink_sublimation_s",
+        "t_sink_gas_drag_s",
+        "prod_subblow_area_rate_raw",
+        "supply_rate_nominal",
+        "supply_rate_scaled",
+        "supply_tau_clip_spill_rate",
+        "supply_headroom",
+        "headroom",
+        "supply_clip_factor",
+        "prod_rate_raw",
+        "prod_rate_applied_to_surf",
+        "prod_rate_diverted_to_deep",
+        "prod_rate_into_deep",
+        "deep_to_surf_flux_attempt",
+        "deep_to_surf_flux",
+        "deep_to_surf_flux_applied",
+        "supply_temperature_scale",
+        "supply_temperature_value",
+        "supply_feedback_scale",
+        "supply_feedback_error",
+        "supply_reservoir_remaining_Mmars",
+        "supply_reservoir_fraction",
+        "s_min_effective",
+        "phi_effective",
+        "chi_blow_eff",
+        "ds_step_uniform",
+        "mass_ratio_uniform",
+        "smol_dt_eff",
+        "smol_sigma_before",
+        "smol_sigma_after",
+        "smol_sigma_loss",
+        "smol_prod_mass_rate",
+        "smol_extra_mass_loss_rate",
+        "smol_mass_budget_delta",
+        "smol_mass_error",
+        "smol_gain_mass_rate",
+        "smol_loss_mass_rate",
+        "smol_sink_mass_rate",
+        "smol_source_mass_rate",
+        "hydro_timescale_s",
+        "mass_loss_surface_solid_step",
+        "ds_dt_sublimation",
+        "ds_dt_sublimation_raw",
+    }
+)
+_DIAG_OPTIONAL_STRING_KEYS = frozenset(
+    {
+        "phase_tau_field",
+        "phase_temperature_input",
+        "tau_phase_used",
+        "supply_transport_mode",
+        "phase_state",
+        "phase_method",
+        "phase_reason",
+        "phase_bulk_state",
+        "supply_temperature_value_kind",
+        "phase_payload",
+    }
+)
 
 @dataclass
 class SmolSinkWorkspace:
@@ -203,6 +354,7 @@ class RunZeroDTimeGridStage:
     checkpoint_interval_s: float
     checkpoint_format: str
     checkpoint_keep_last: int
+    checkpoint_flush_streaming: bool
     checkpoint_dir: Path
     resume_enabled: bool
     resume_path: Optional[Path]
@@ -250,10 +402,13 @@ class RunZeroDTimeGridStage:
     psd_history_enabled: bool
     psd_history_stride: int
     diagnostics_stride: int
+    memory_plan: Optional[memory_plan_mod.MemoryPlan]
+    memory_watchdog: Optional[memory_plan_mod.MemoryWatchdog]
     record_storage_mode: str
     columnar_enabled: bool
     series_columns: List[str]
     diagnostic_columns: List[str]
+    output_selection: OutputSelection
     history: ZeroDHistory
     last_step_index: int
     sigma_surf: float
@@ -284,6 +439,7 @@ def _get_smol_sink_workspace(
             imex=smol.ImexWorkspace(
                 gain=np.zeros(n_bins, dtype=float),
                 loss=np.zeros(n_bins, dtype=float),
+                arena=smol.SmolStepArena(),
             ),
         )
     workspace.zeros_source.fill(0.0)
@@ -469,20 +625,37 @@ def _resolve_t_coll_step(
     return None
 
 
-def _reset_collision_runtime_state(*, persist: bool, signature: str | None) -> bool:
-    """Clear per-run collision caches and warning state when needed."""
+def _reset_collision_runtime_state(
+    *,
+    persist: bool,
+    signature: str | None,
+    size_signature: str | None = None,
+) -> str:
+    """Clear per-run collision caches and warning state when needed.
+
+    With persistence on, a run whose ``signature`` differs from the previous
+    one but whose ``size_signature`` (size/edge grid and alpha_frag) matches
+    keeps the size-only caches; only rho/Q_D*-dependent entries are dropped.
+    Returns ``"reuse"``, ``"size_only"``, ``"reset"`` or ``"off"``.
+    """
 
-    global _LAST_COLLISION_CACHE_SIGNATURE
+    global _LAST_COLLISION_CACHE_SIGNATURE, _LAST_COLLISION_SIZE_SIGNATURE
+    keep_size_only = False
     if persist and signature:
         if _LAST_COLLISION_CACHE_SIGNATURE == signature:
             collisions_smol._F_KE_MISMATCH_WARNED = False
-            return True
+            return "reuse"
+        keep_size_only = size_signature is not None and _LAST_COLLISION_SIZE_SIGNATURE == size_signature
         _LAST_COLLISION_CACHE_SIGNATURE = signature
+        _LAST_COLLISION_SIZE_SIGNATURE = size_signature
+        action = "size_only" if keep_size_only else "reset"
     else:
         _LAST_COLLISION_CACHE_SIGNATURE = None
-    collisions_smol.reset_collision_caches()
+        _LAST_COLLISION_SIZE_SIGNATURE = None
+        action = "off"
+    collisions_smol.reset_collision_caches(keep_size_only=keep_size_only)
     collisions_smol._F_KE_MISMATCH_WARNED = False
-    return False
+    return action
 
 
 def _get_max_steps() -> int:
@@ -974,6 +1147,7 @@ def _prepare_time_grid_and_runtime(
     )
     checkpoint_format = str(getattr(checkpoint_cfg, "format", "pickle") or "pickle")
     checkpoint_keep_last = int(getattr(checkpoint_cfg, "keep_last_n", 3) or 0)
+    checkpoint_flush_streaming = bool(getattr(checkpoint_cfg, "flush_streaming", False))
     checkpoint_dir = (
         Path(checkpoint_cfg.path) if checkpoint_cfg and getattr(checkpoint_cfg, "path", None) else Path(cfg.io.outdir) / "checkpoints"
     )
@@ -1016,7 +1190,9 @@ def _prepare_time_grid_and_runtime(
             series_stride=series_stride_hint,
             psd_history_enabled=psd_history_enabled_hint,
             psd_history_stride=psd_history_stride_hint,
-            diagnostics_enabled=True,
+            diagnostics_enabled=OutputSelection.from_config(
+                cfg.io, include_1d=False
+            ).diagnostics_enabled,
             diagnostics_stride=diagnostics_stride_hint,
             mass_budget_enabled=True,
             mass_budget_cells_enabled=False,
@@ -1033,6 +1209,7 @@ def _prepare_time_grid_and_runtime(
     progress.emit_header()
 
     resume_applied = False
+    resume_checkpoint: Optional[checkpoint_io.CheckpointState] = None
     checkpoint_next_time = checkpoint_interval_s
     if resume_enabled:
         resolved_resume = resume_path if resume_path is not None else checkpoint_io.find_latest_checkpoint(checkpoint_dir)
@@ -1079,6 +1256,7 @@ def _prepare_time_grid_and_runtime(
                 except Exception:
                     logger.warning("Failed to restore Python RNG state from checkpoint")
                 progress_state_from_ckpt = getattr(state_ckpt, "progress_state", None)
+                resume_checkpoint = state_ckpt
                 resume_applied = True
                 logger.info(
                     "Resumed from checkpoint %s at step=%d time=%.3e s (offset=%.3e s)",
@@ -1108,8 +1286,8 @@ def _prepare_time_grid_and_runtime(
     step_diag_cfg = getattr(cfg.io, "step_diagnostics", None)
     step_diag_enabled = bool(getattr(step_diag_cfg, "enable", False)) if step_diag_cfg else False
     step_diag_format = str(getattr(step_diag_cfg, "format", "csv") or "csv").lower()
-    if step_diag_format not in {"csv", "jsonl"}:
-        raise ConfigurationError("io.step_diagnostics.format must be either 'csv' or 'jsonl'")
+    if step_diag_format not in {"csv", "jsonl", "parquet"}:
+        raise ConfigurationError("io.step_diagnostics.format must be 'csv', 'jsonl' or 'parquet'")
     step_diag_path_cfg = getattr(step_diag_cfg, "path", None) if step_diag_cfg else None
     step_diag_path: Optional[Path] = None
     if step_diag_enabled:
@@ -1118,8 +1296,7 @@ def _prepare_time_grid_and_runtime(
             if not step_diag_path.is_absolute():
                 step_diag_path = Path(cfg.io.outdir) / step_diag_path
         else:
-            ext = "jsonl" if step_diag_format == "jsonl" else "csv"
-            step_diag_path = Path(cfg.io.outdir) / "series" / f"step_diagnostics.{ext}"
+            step_diag_path = Path(cfg.io.outdir) / "series" / f"step_diagnostics.{step_diag_format}"
 
     def _env_flag(name: str) -> Optional[bool]:
         raw = os.environ.get(name)
@@ -1215,12 +1392,39 @@ def _prepare_time_grid_and_runtime(
     if diagnostics_stride < 1:
         diagnostics_stride = 1
     streaming_merge_completed: Optional[bool] = None
-    series_columns = list(ZERO_D_SERIES_KEYS)
-    diagnostic_columns = list(ZERO_D_DIAGNOSTIC_KEYS)
+    output_selection = OutputSelection.from_config(cfg.io, include_1d=False)
+    series_columns = output_selection.series_columns
+    diagnostic_columns = output_selection.diagnostic_columns
+    memory_budget_cfg = getattr(cfg.io, "memory_budget", None)
+    collision_cache_cfg = getattr(cfg.numerics, "collision_cache", None)
+    memory_plan = memory_plan_mod.plan_from_config(
+        memory_budget_cfg,
+        memory_plan_mod.MemoryRequest(
+            n_steps=n_steps,
+            n_bins=int(getattr(cfg.sizes, "n_bins", 0) or 0),
+            cache_scale=float(getattr(collision_cache_cfg, "size_scale", 3.0))
+            if collision_cache_cfg is not None
+            else 3.0,
+            streaming_enabled=streaming_enabled,
+            step_flush_interval=streaming_step_interval,
+            memory_limit_gb=streaming_memory_limit_gb,
+            series_stride=series_stride,
+            diagnostics_enabled=output_selection.diagnostics_enabled,
+            diagnostics_stride=diagnostics_stride,
+            psd_history_enabled=psd_history_enabled,
+            psd_history_stride=psd_history_stride,
+            step_diag_enabled=step_diag_enabled,
+        ),
+    )
+    if memory_plan is not None:
+        streaming_step_interval = memory_plan.step_flush_interval
+        streaming_memory_limit_gb = memory_plan.memory_limit_gb
+        psd_history_stride = memory_plan.psd_history_stride
+    memory_watchdog = memory_plan_mod.watchdog_from_plan(memory_budget_cfg, memory_plan)
     record_storage_mode = str(getattr(cfg.io, "record_storage_mode", "row") or "row").lower()
-    if record_storage_mode not in {"row", "columnar"}:
+    if record_storage_mode not in RECORD_STORAGE_MODES:
         record_storage_mode = "row"
-    columnar_enabled = record_storage_mode == "columnar"
+    columnar_enabled = record_storage_mode != "row"
     if _env_flag("MARSDISK_DISABLE_COLUMNAR") is True:
         columnar_enabled = False
     streaming_state = StreamingState(
@@ -1235,15 +1439,30 @@ def _prepare_time_grid_and_runtime(
         step_diag_enabled=step_diag_enabled,
         step_diag_path=step_diag_path,
         step_diag_format=step_diag_format,
+        step_diag_compression=str(getattr(step_diag_cfg, "compression", "zstd") or "zstd"),
         series_columns=series_columns,
         diagnostic_columns=diagnostic_columns,
+        drop_extra_columns=output_selection.drop_extra_columns,
+        float32_columns=list(output_selection.float32_columns),
+        mass_budget_format=str(getattr(cfg.io, "mass_budget_format", "csv") or "csv"),
+        partial_summary=bool(getattr(streaming_cfg, "partial_summary", True)),
     )
+    if resume_checkpoint is not None and streaming_state.enabled:
+        resume_report = streaming_state.resume_from_checkpoint(
+            int(resume_checkpoint.step_no),
+            float(resume_checkpoint.time_s),
+            float(resume_checkpoint.dt_s),
+        )
+        logger.info("Resumed streaming outputs: %s", resume_report)
 
     last_step_index = max(start_step - 1, -1)
     history = ZeroDHistory()
     if columnar_enabled:
-        history.records = ColumnarBuffer()
-        history.diagnostics = ColumnarBuffer()
+        rows_hint = streaming_step_interval if streaming_enabled and streaming_step_interval > 0 else n_steps
+        history.records = new_record_buffer(record_storage_mode, rows_hint=rows_hint // series_stride + 1)
+        history.diagnostics = new_record_buffer(
+            record_storage_mode, rows_hint=rows_hint // diagnostics_stride + 1
+        )
 
     return RunZeroDTimeGridStage(
         t_end=t_end,
@@ -1259,6 +1478,7 @@ def _prepare_time_grid_and_runtime(
         checkpoint_interval_s=checkpoint_interval_s,
         checkpoint_format=checkpoint_format,
         checkpoint_keep_last=checkpoint_keep_last,
+        checkpoint_flush_streaming=checkpoint_flush_streaming,
         checkpoint_dir=checkpoint_dir,
         resume_enabled=resume_enabled,
         resume_path=resume_path,
@@ -1306,10 +1526,13 @@ def _prepare_time_grid_and_runtime(
         psd_history_enabled=psd_history_enabled,
         psd_history_stride=psd_history_stride,
         diagnostics_stride=diagnostics_stride,
+        memory_plan=memory_plan,
+        memory_watchdog=memory_watchdog,
         record_storage_mode=record_storage_mode,
         columnar_enabled=columnar_enabled,
         series_columns=series_columns,
         diagnostic_columns=diagnostic_columns,
+        output_selection=output_selection,
         history=history,
         last_step_index=last_step_index,
         sigma_surf=sigma_surf,
@@ -1331,15 +1554,18 @@ def _prepare_time_grid_and_runtime(
 # ---------------------------------------------------------------------------
 
 
-def load_config(path: Path, overrides: Optional[Sequence[str]] = None) -> Config:
-    """Load a YAML configuration file into a :class:`Config` instance."""
+def load_config(path: Path, overrides: config_utils.OverrideSpec = None) -> Config:
+    """Load a YAML configuration file into a :class:`Config` instance.
 
-    from ruamel.yaml import YAML
+    ``overrides`` accepts ``PATH=VALUE`` strings, pre-parsed
+    :class:`~marsdisk.config_utils.OverrideDelta` objects or a
+    ``{path: value}`` mapping.  The parsed YAML is cached per file (see
+    :func:`~marsdisk.config_utils.load_yaml_payload`), so repeated loads of a
+    sweep base only pay for the overrides and the pydantic build.
+    """
 
-    yaml = YAML(typ="safe")
     source_path = Path(path).resolve()
-    with source_path.open("r", encoding="utf-8") as fh:
-        data = yaml.load(fh)
+    data = config_utils.load_yaml_payload(source_path)
     if overrides:
         if not isinstance(data, dict):
             raise TypeError(
@@ -1356,33 +1582,6 @@ def load_config(path: Path, overrides: Optional[Sequence[str]] = None) -> Config
     return cfg
 
 
-def _gather_git_info() -> Dict[str, Any]:
-    """Return basic git metadata for provenance recording."""
-
-    repo_root = Path(__file__).resolve().parents[1]
-    info: Dict[str, Any] = {}
-    try:
-        info["commit"] = subprocess.check_output(
-            ["git", "rev-parse", "HEAD"], cwd=repo_root, text=True
-        ).strip()
-    except Exception:
-        info["commit"] = "unknown"
-    try:
-        info["branch"] = subprocess.check_output(
-            ["git", "rev-parse", "--abbrev-ref", "HEAD"], cwd=repo_root, text=True
-        ).strip()
-    except Exception:
-        info["branch"] = "unknown"
-    try:
-        status = subprocess.check_output(
-            ["git", "status", "--short"], cwd=repo_root, text=True
-        )
-        info["dirty"] = bool(status.strip())
-    except Exception:
-        info["dirty"] = None
-    return info
-
-
 class MassBudgetViolationError(NumericalError):
     """Raised when the mass budget tolerance is exceeded."""
 
@@ -1395,7 +1594,7 @@ def run_zero_d(
     enforce_mass_budget: bool = False,
     physics_mode_override: Optional[str] = None,
     physics_mode_source_override: Optional[str] = None,
-) -> None:
+) -> ZeroDRunResult:
     """Execute the full-feature zero-dimensional simulation.
 
     This is the production driver: it resolves configuration, builds PSD
@@ -1407,6 +1606,12 @@ def run_zero_d(
     ----------
     cfg:
         Parsed configuration object.
+
+    Returns
+    -------
+    ZeroDRunResult
+        The summary payload and the first/last mass-budget and
+        step-diagnostics rows, mirroring what was written under ``outdir``.
     """
 
     config_source_path_raw = getattr(cfg, "_source_path", None)
@@ -1417,6 +1622,7 @@ def run_zero_d(
         except Exception:
             config_source_path = None
     outdir = Path(cfg.io.outdir)
+    run_result = ZeroDRunResult(outdir=outdir)
 
     scope_cfg = getattr(cfg, "scope", None)
     process_cfg = getattr(cfg, "process", None)
@@ -1855,6 +2061,8 @@ def run_zero_d(
         _ = T_M
         return _lookup_qpr(size)
 
+    radiation_driver = physics_step.RadiationStepDriver(rho_used, qpr_override=qpr_override)
+
     def _psd_mass_peak() -> float:
         """Return the size corresponding to the peak mass content."""
 
@@ -2447,6 +2655,7 @@ def run_zero_d(
     checkpoint_interval_s = time_grid_stage.checkpoint_interval_s
     checkpoint_format = time_grid_stage.checkpoint_format
     checkpoint_keep_last = time_grid_stage.checkpoint_keep_last
+    checkpoint_flush_streaming = time_grid_stage.checkpoint_flush_streaming
     checkpoint_dir = time_grid_stage.checkpoint_dir
     resume_enabled = time_grid_stage.resume_enabled
     resume_path = time_grid_stage.resume_path
@@ -2494,10 +2703,16 @@ def run_zero_d(
     psd_history_enabled = time_grid_stage.psd_history_enabled
     psd_history_stride = time_grid_stage.psd_history_stride
     diagnostics_stride = time_grid_stage.diagnostics_stride
+    memory_plan = time_grid_stage.memory_plan
+    memory_watchdog = time_grid_stage.memory_watchdog
     record_storage_mode = time_grid_stage.record_storage_mode
     columnar_enabled = time_grid_stage.columnar_enabled
     series_columns = time_grid_stage.series_columns
     diagnostic_columns = time_grid_stage.diagnostic_columns
+    output_selection = time_grid_stage.output_selection
+    diagnostics_enabled = output_selection.diagnostics_enabled
+    # Non-full selections keep only the written columns in the record buffer.
+    series_record_keys = tuple(series_columns) if output_selection.drop_extra_columns else None
     history = time_grid_stage.history
     last_step_index = time_grid_stage.last_step_index
     sigma_surf = time_grid_stage.sigma_surf
@@ -2519,6 +2734,10 @@ def run_zero_d(
         streaming_state.chunk_start_step = start_step
         if streaming_state.mass_budget_path.exists():
             streaming_state.mass_budget_header_written = True
+        step_diag_path_existing = streaming_state.step_diag_path
+        if start_step > 0 and step_diag_path_existing is not None and step_diag_path_existing.exists():
+            # Resumed run: keep the rows already logged before the checkpoint.
+            streaming_state.step_diag_header_written = True
 
     def _build_checkpoint_state(step_no: int, time_after_step: float) -> checkpoint_io.CheckpointState:
         supply_payload: Dict[str, Any] = {}
@@ -2549,6 +2768,25 @@ def run_zero_d(
             progress_state=progress_payload,
         )
 
+    def _partial_summary_payload(step_no: int, step_end_time: float) -> Dict[str, Any]:
+        latest_ckpt = checkpoint_io.find_latest_checkpoint(checkpoint_dir) if checkpoint_enabled else None
+        return {
+            "geometry_mode": "0D",
+            "time": float(step_end_time),
+            "step_no": int(step_no),
+            "n_steps": int(n_steps),
+            "t_end": float(t_end),
+            "rng_seed": int(seed),
+            "M_loss": float(M_loss_cum + M_sink_cum),
+            "M_out_cum": float(M_loss_cum),
+            "M_sink_cum": float(M_sink_cum),
+            "M_spill_cum": float(M_spill_cum),
+            "M_sublimation_cum": float(M_sublimation_cum),
+            "M_hydro_cum": float(M_hydro_cum),
+            "perf": progress.perf_counters(step_no + 1 - start_step),
+            "latest_checkpoint": str(latest_ckpt) if latest_ckpt is not None else None,
+        }
+
     def _streaming_cleanup_on_exit() -> None:
         """Flush remaining streaming buffers and merge chunks on shutdown."""
 
@@ -2581,6 +2819,15 @@ def run_zero_d(
     energy_budget: List[Dict[str, float]] = []
     last_mass_budget_entry: Optional[Dict[str, Any]] = None
     step_diag_records = history.step_diag_records
+    step_diag_sampler = StepDiagnosticsSampler(
+        step_diag_records,
+        mode=str(getattr(step_diag_cfg, "sampling", "all") or "all"),
+        sparse_stride=int(getattr(step_diag_cfg, "sparse_stride", 100) or 1),
+        window_steps=int(getattr(step_diag_cfg, "window_steps", 64) or 0),
+        post_event_steps=int(getattr(step_diag_cfg, "post_event_steps", 64) or 0),
+        dt_collapse_ratio=float(getattr(step_diag_cfg, "dt_collapse_ratio", 0.1) or 0.1),
+        mass_error_percent=getattr(step_diag_cfg, "mass_error_percent", 0.1),
+    )
     debug_sinks_enabled = bool(getattr(cfg.io, "debug_sinks", False))
     correct_fast_blowout = bool(getattr(cfg.io, "correct_fast_blowout", False))
     substep_fast_enabled = bool(getattr(cfg.io, "substep_fast_blowout", False))
@@ -2612,6 +2859,17 @@ def run_zero_d(
     min_duration_s = 0.0
     if min_duration_years is not None:
         min_duration_s = float(min_duration_years) * SECONDS_PER_YEAR
+    stop_events = EventEngine(1)
+    if optical_depth_enabled and optical_tau_stop is not None:
+        stop_events.register(
+            "tau_exceeded",
+            threshold=optical_tau_stop * (1.0 + float(optical_tau_stop_tol or 0.0)),
+            direction="above",
+        )
+    if loss_rate_stop_threshold is not None:
+        stop_events.register("loss_rate_below_threshold", threshold=loss_rate_stop_threshold, direction="below")
+    if stop_on_blowout_below_smin:
+        stop_events.register("a_blow_below_s_min_config", threshold=blowout_stop_threshold, direction="below")
 
     orbit_time_accum = 0.0
     orbit_loss_blow = 0.0
@@ -2682,6 +2940,8 @@ def run_zero_d(
     energy_count = 0
     collision_cache_cfg = getattr(cfg.numerics, "collision_cache", None)
     cache_scale = float(getattr(collision_cache_cfg, "size_scale", 3.0)) if collision_cache_cfg is not None else 3.0
+    if memory_plan is not None:
+        cache_scale = memory_plan.cache_scale
     try:
         collisions_smol.configure_collision_cache_limits(scale=cache_scale)
     except Exception as exc:
@@ -2693,6 +2953,7 @@ def run_zero_d(
         logger.info("collision cache persistence disabled: surface sublimation updates PSD sizes")
         persist_collision_cache = False
     collision_cache_signature: str | None = None
+    collision_size_signature: str | None = None
     if persist_collision_cache:
         sizes_arr = np.asarray(psd_state.get("sizes"), dtype=float)
         widths_arr = np.asarray(psd_state.get("widths"), dtype=float)
@@ -2723,20 +2984,19 @@ def run_zero_d(
                 )
                 psd_state["sizes_version"] = int(sizes_hash)
                 psd_state["edges_version"] = int(edges_hash)
+                collision_size_signature = f"{sizes_hash}:{edges_hash}:{alpha_frag!r}"
             except Exception as exc:
                 logger.warning("collision cache persistence disabled: signature failed (%s)", exc)
                 persist_collision_cache = False
                 collision_cache_signature = None
-    collision_cache_reused = _reset_collision_runtime_state(
+    run_result.collision_cache = _reset_collision_runtime_state(
         persist=persist_collision_cache,
         signature=collision_cache_signature,
+        size_signature=collision_size_signature,
     )
     if persist_collision_cache:
         sig_short = collision_cache_signature[:12] if collision_cache_signature else "none"
-        if collision_cache_reused:
-            logger.info("collision cache: reuse (signature=%s)", sig_short)
-        else:
-            logger.info("collision cache: reset (signature=%s)", sig_short)
+        logger.info("collision cache: %s (signature=%s)", run_result.collision_cache, sig_short)
     smol_sink_workspace: SmolSinkWorkspace | None = None
 
     def _mark_reservoir_depletion(current_time: float) -> None:
@@ -2760,12 +3020,14 @@ def run_zero_d(
         if value is not None and math.isfinite(value):
             sigma_tau1_limit_last_finite = float(value)
 
+    run_plan = _resolve_run_plan(cfg, physics_mode)
+
     def _run_time_evolution_loop() -> None:
         nonlocal a_blow_effective_step, a_blow_step, beta_at_smin_effective, blowout_effective_warned, checkpoint_next_time, early_stop_reason, early_stop_step, early_stop_time_s
         nonlocal energy_count, energy_last_row, energy_sum_diss, energy_sum_rel, energy_sum_ret, e0_effective
         nonlocal i0_effective, last_mass_budget_entry, last_step_index, last_time_value, mass_budget_max_error, M_hydro_cum
         nonlocal M_loss_cum, M_sink_cum, M_spill_cum, M_sublimation_cum, Omega_step, orbit_loss_blow
-        nonlocal orbit_loss_sink, orbit_time_accum, orbits_completed, psd_state, qpr_for_blow_step, qpr_mean_step
+        nonlocal orbit_loss_sink, orbit_time_accum, orbits_completed, psd_history_stride, psd_state, qpr_for_blow_step, qpr_mean_step
         nonlocal kappa_surf, sigma_deep, sigma_surf, s_min_effective, s_min_floor_dynamic, s_min_evolved_value, smol_sink_workspace
         nonlocal steps_since_flush, supply_clip_time, supply_clip_streak, supply_rate_scaled_initial, supply_reservoir_depleted_time, T_use
         nonlocal t_mix_seconds_current, t_orb_step, tau_gate_block_time, tau_stop_los_value, time, total_time_elapsed
@@ -2777,7 +3039,7 @@ def run_zero_d(
                 or step_no % series_stride == 0
                 or step_no == n_steps - 1
             )
-            diagnostics_write = (
+            diagnostics_write = diagnostics_enabled and (
                 diagnostics_stride <= 1
                 or step_no % diagnostics_stride == 0
                 or step_no == n_steps - 1
@@ -2845,20 +3107,12 @@ def run_zero_d(
                 setattr(sub_params, "runtime_Omega", Omega_step)
 
                 blowout_init = float(psd_state.get("s_min", s_min_config))
-                rad_blow = physics_step.compute_radiation_parameters(
+                a_blow_step, qpr_for_blow = radiation_driver.blowout(
                     s_min_effective,
-                    rho_used,
                     T_use,
-                    qpr_override=qpr_override,
                     initial=blowout_init,
                 )
-                a_blow_step = float(rad_blow.a_blow)
                 a_blow_effective_step = float(max(s_min_config, a_blow_step))
-                qpr_for_blow = (
-                    float(qpr_override)
-                    if qpr_override is not None
-                    else float(radiation.qpr_lookup(max(a_blow_step, 1.0e-12), T_use))
-                )
                 if (
                     not blowout_effective_warned
                     and a_blow_effective_step > a_blow_step * (1.0 + 1.0e-12)
@@ -2886,13 +3140,11 @@ def run_zero_d(
                 s_min_components["blowout_effective"] = float(a_blow_effective_step)
                 s_min_components["effective"] = float(s_min_effective)
                 s_min_components["floor_dynamic"] = float(s_min_floor_dynamic)
-                rad_step = physics_step.compute_radiation_parameters(
+                rad_step = radiation_driver.at_smin(
                     s_min_effective,
-                    rho_used,
                     T_use,
-                    qpr_override=qpr_override,
                     qpr_lookup_fn=_lookup_qpr_cached,
-                    a_blow_override=a_blow_step,
+                    a_blow=a_blow_step,
                 )
                 qpr_mean_step = float(rad_step.qpr_mean)
                 beta_at_smin_effective = float(rad_step.beta)
@@ -2900,8 +3152,8 @@ def run_zero_d(
             beta_track.append(beta_at_smin_effective)
             ablow_track.append(a_blow_step)
 
-            if stop_on_blowout_below_smin and a_blow_step <= blowout_stop_threshold:
-                if min_duration_s <= 0.0 or time >= min_duration_s:
+            if stop_on_blowout_below_smin and (min_duration_s <= 0.0 or time >= min_duration_s):
+                if stop_events.observe("a_blow_below_s_min_config", time, a_blow_step) is not None:
                     early_stop_reason = "a_blow_below_s_min_config"
                     early_stop_step = step_no
                     early_stop_time_s = time
@@ -3034,7 +3286,7 @@ def run_zero_d(
                 M_sink_cum += mass_loss_sublimation_step
                 M_sublimation_cum += mass_loss_sublimation_step
 
-            if cfg.sinks.mode == "none" or not sink_timescale_active:
+            if run_plan.sinks_mode == "none" or not sink_timescale_active:
                 sink_result = sinks.SinkTimescaleResult(
                     t_sink=None,
                     components={"sublimation": None, "gas_drag": None},
@@ -3231,7 +3483,7 @@ def run_zero_d(
                             tau_fixed_target=tau_fixed_target,
                             sigma_tau1_fixed_target=sigma_tau1_fixed_target,
                             los_factor=los_factor,
-                            use_tcoll=bool(getattr(cfg.surface, "use_tcoll", False)),
+                            use_tcoll=run_plan.use_tcoll,
                             enable_blowout_step=enable_blowout_step,
                             sink_timescale_active=sink_timescale_active,
                             t_sink_step_effective=t_sink_step_effective,
@@ -3348,7 +3600,7 @@ def run_zero_d(
                         tau_fixed_target=tau_fixed_target,
                         sigma_tau1_fixed_target=sigma_tau1_fixed_target,
                         los_factor=los_factor,
-                        use_tcoll=bool(getattr(cfg.surface, "use_tcoll", False)),
+                        use_tcoll=run_plan.use_tcoll,
                         enable_blowout_step=enable_blowout_step,
                         sink_timescale_active=sink_timescale_active,
                         t_sink_step_effective=t_sink_step_effective,
@@ -3437,13 +3689,13 @@ def run_zero_d(
                                 sigma_tau1=sigma_tau1_active,
                                 t_sink=t_sink_current if sink_timescale_active else None,
                                 ds_dt_val=ds_dt_val if sublimation_smol_active_step else None,
-                                energy_bookkeeping_enabled=bool(getattr(cfg.diagnostics.energy_bookkeeping, "enabled", False)),
-                                eps_restitution=float(getattr(cfg.dynamics, "eps_restitution", 0.5)),
-                                f_ke_cratering=float(getattr(cfg.dynamics, "f_ke_cratering", 0.1)),
-                                f_ke_fragmentation=getattr(cfg.dynamics, "f_ke_fragmentation", None),
+                                energy_bookkeeping_enabled=run_plan.energy_bookkeeping_enabled,
+                                eps_restitution=run_plan.eps_restitution,
+                                f_ke_cratering=run_plan.f_ke_cratering,
+                                f_ke_fragmentation=run_plan.f_ke_fragmentation,
                             ),
                             sigma_surf=sigma_surf,
-                            enable_e_damping=bool(getattr(cfg.dynamics, "enable_e_damping", False)),
+                            enable_e_damping=run_plan.enable_e_damping,
                             t_coll_for_damp=t_coll_step,
                         )
                         smol_res = collisions_smol.step_collisions(collision_ctx, psd_state)
@@ -3461,7 +3713,7 @@ def run_zero_d(
                         i_state_next_step = smol_res.i_next
                         e_damp_target_step = smol_res.e_eq_target
                         t_damp_applied_step = smol_res.t_damp_used
-                        if bool(getattr(cfg.dynamics, "enable_e_damping", False)) and smol_res.e_next is not None:
+                        if run_plan.enable_e_damping and smol_res.e_next is not None:
                             e0_effective = float(smol_res.e_next)
                             i0_effective = float(
                                 smol_res.i_next if smol_res.i_next is not None else i0_effective
@@ -3787,7 +4039,7 @@ def run_zero_d(
                 and (min_duration_s <= 0.0 or time >= min_duration_s)
             ):
                 loss_rate_total = max(M_out_dot, 0.0) + max(M_sink_dot, 0.0)
-                if math.isfinite(loss_rate_total) and loss_rate_total <= loss_rate_stop_threshold:
+                if stop_events.observe("loss_rate_below_threshold", time + dt, loss_rate_total) is not None:
                     stop_after_record = True
                     if stop_after_record_reason is None:
                         stop_after_record_reason = "loss_rate_below_threshold"
@@ -3829,7 +4081,7 @@ def run_zero_d(
                     "n_fragmentation": float(energy_columns.get("n_fragmentation", 0.0)),
                     "frac_cratering": float(energy_columns.get("frac_cratering", 0.0)),
                     "frac_fragmentation": float(energy_columns.get("frac_fragmentation", 0.0)),
-                    "eps_restitution": float(getattr(cfg.dynamics, "eps_restitution", 0.5)),
+                    "eps_restitution": run_plan.eps_restitution,
                     "f_ke_eps_mismatch": float(energy_columns.get("f_ke_eps_mismatch", 0.0)),
                     "E_numerical_error_relative": float(E_err),
                     "error_flag": err_flag,
@@ -3860,8 +4112,8 @@ def run_zero_d(
                     M_orbit_sink = orbit_loss_sink * fraction
                     orbits_completed += 1
                     mass_loss_frac = float("nan")
-                    if cfg.initial.mass_total > 0.0:
-                        mass_loss_frac = (M_orbit_blow + M_orbit_sink) / cfg.initial.mass_total
+                    if run_plan.mass_total > 0.0:
+                        mass_loss_frac = (M_orbit_blow + M_orbit_sink) / run_plan.mass_total
                     time_s_end = time - max(orbit_time_accum_before - t_orb_step, 0.0)
                     orbit_rollup_rows.append(
                         {
@@ -3892,8 +4144,8 @@ def run_zero_d(
                 s_min_evolved_value = psd.evolve_min_size(
                     s_min_evolved_value,
                     dt=dt,
-                    model=getattr(cfg.sizes, "dsdt_model", None),
-                    params=getattr(cfg.sizes, "dsdt_params", None),
+                    model=run_plan.dsdt_model,
+                    params=run_plan.dsdt_params,
                     T=T_use,
                     rho=rho_used,
                     s_floor=s_min_effective,
@@ -3948,11 +4200,11 @@ def run_zero_d(
                         "sublimation_blocked_by_phase": bool(sublimation_blocked_by_phase),
                         "hydro_timescale_s": _safe_float(hydro_timescale_last),
                         "mass_loss_hydro_step": mass_loss_hydro_step,
-                        "sinks_mode": cfg.sinks.mode,
-                        "enable_sublimation": cfg.sinks.enable_sublimation,
-                        "enable_gas_drag": cfg.sinks.enable_gas_drag,
+                        "sinks_mode": run_plan.sinks_mode,
+                        "enable_sublimation": run_plan.enable_sublimation,
+                        "enable_gas_drag": run_plan.enable_gas_drag,
                         "rho_particle_kg_m3": rho_used,
-                        "rho_gas_kg_m3": cfg.sinks.rho_g,
+                        "rho_gas_kg_m3": run_plan.rho_gas,
                         "sink_components_timescale_s": sink_result.components,
                         "T_eval_sink_K": sink_result.T_eval,
                         "dt_over_t_blow": dt_over_t_blow,
@@ -3980,9 +4232,7 @@ def run_zero_d(
             ):
                 kappa_for_stop = kappa_eff if kappa_eff is not None and math.isfinite(kappa_eff) else kappa_surf
                 tau_stop_los_current = float(kappa_for_stop * sigma_surf * los_factor)
-                if math.isfinite(tau_stop_los_current) and tau_stop_los_current > optical_tau_stop * (
-                    1.0 + float(optical_tau_stop_tol or 0.0)
-                ):
+                if stop_events.observe("tau_exceeded", time + dt, tau_stop_los_current) is not None:
                     stop_after_record = True
                     tau_stop_los_value = tau_stop_los_current
                     stop_after_record_reason = "tau_exceeded"
@@ -4097,274 +4347,210 @@ def run_zero_d(
             tau_record = tau_los_last
             if tau_record is None:
                 tau_record = float(kappa_surf * sigma_surf * los_factor)
-            # Force optional numeric/string fields to concrete types to stabilise streaming chunk schemas.
-            _series_optional_float_keys = {
-                "t_coll",
-                "ts_ratio",
-                "Sigma_surf0",
-                "Sigma_tau1",
-                "Sigma_tau1_active",
-                "sigma_tau1",
-                "Sigma_tau1_last_finite",
-                "tau_phase_los",
-                "tau_phase_used",
-                "t_solid_s",
-                "prod_subblow_area_rate_raw",
-                "dotSigma_prod",
-                "mu_orbit10pct",
-                "epsilon_mix",
-                "prod_rate_raw",
-                "supply_rate_nominal",
-                "supply_rate_scaled",
-                "supply_headroom",
-                "headroom",
-                "supply_clip_factor",
-                "supply_visibility_factor",
-                "supply_temperature_scale",
-                "supply_temperature_value",
-                "supply_feedback_scale",
-                "supply_feedback_error",
-                "supply_reservoir_remaining_Mmars",
-                "supply_reservoir_fraction",
-                "phi_effective",
-                "phi_used",
-                "kappa_eff",
-                "kappa_surf",
-                "phase_f_vap",
-                "phase_bulk_f_liquid",
-                "phase_bulk_f_solid",
-                "phase_bulk_f_vapor",
-                "M_sink_cum",
-                "e_kernel_used",
-                "i_kernel_used",
-                "e_kernel_base",
-                "i_kernel_base",
-                "e_kernel_supply",
-                "i_kernel_supply",
-                "e_kernel_effective",
-                "i_kernel_effective",
-                "supply_velocity_weight_w",
-                "s_min_surface_energy",
-                "e_state_next",
-                "i_state_next",
-                "t_damp_collisions",
-                "e_eq_target",
-            }
-            _series_optional_string_keys = {
-                "phase_tau_field",
-                "phase_temperature_input",
-                "supply_transport_mode",
-                "tau_phase_used",
-                "case_status",
-                "T_M_source",
-                "T_source",
-                "phase_state",
-                "phase_method",
-                "phase_reason",
-                "phase_bulk_state",
-                "blowout_layer_mode",
-                "blowout_target_phase",
-                "sink_selected",
-                "supply_temperature_value_kind",
-            }
-
-            record = {
-                "time": time,
-                "dt": dt,
-                "Omega_s": Omega_step,
-                "t_orb_s": t_orb_step,
-                "t_blow_s": t_blow_step,
-                "t_coll": t_coll_step,
-                "ts_ratio": ts_ratio_value,
-                "r_m": r,
-                "r_RM": r_RM,
-                "r_orbit_RM": r_RM,
-                "r_source": r_source,
-                "T_M_used": T_use,
-                "T_M_source": T_M_source,
-                "T_p_effective": T_p_effective,
-                "phase_temperature_input": phase_temperature_input_mode,
-                "rad_flux_Mars": rad_flux_step,
-                "dt_over_t_blow": dt_over_t_blow,
-                "tau": tau_record,
-                "tau_los_mars": tau_record,
-                "a_blow_step": a_blow_step,
-                "a_blow": a_blow_step,
-                "a_blow_at_smin": a_blow_step,
-                "s_min": s_min_effective,
-                "s_min_surface_energy": s_min_surface_energy,
-                "kappa": kappa_eff,
-                "kappa_eff": kappa_eff,
-                "kappa_surf": kappa_surf,
-                "Qpr_mean": qpr_mean_step,
-                "Q_pr_at_smin": qpr_mean_step,
-                "beta_at_smin_config": beta_at_smin_config,
-                "beta_at_smin_effective": beta_at_smin_effective,
-                "beta_at_smin": beta_at_smin_effective,
-                "beta_threshold": beta_threshold,
-                "Sigma_surf": sigma_surf,
-                "sigma_surf": sigma_surf,
-                "Sigma_surf0": sigma_surf0_target,
-                "Sigma_tau1": sigma_tau1_limit,
-                "Sigma_tau1_active": sigma_tau1_active_last,
-                "sigma_tau1": sigma_tau1_limit,
-                "Sigma_tau1_last_finite": sigma_tau1_limit_last_finite,
-                "tau_phase_los": tau_phase_los_last,
-                "tau_phase_used": tau_phase_used_last,
-                "phase_tau_field": phase_tau_field,
-                "sigma_deep": sigma_deep,
-                "headroom": _safe_float(headroom_current),
-                "outflux_surface": outflux_surface,
-                "t_solid_s": t_solid_step,
-                "blowout_gate_factor": gate_factor,
-                "sink_flux_surface": sink_flux_surface,
-                "t_blow": t_blow_step,
-                "prod_subblow_area_rate": prod_rate_last,
-                "prod_subblow_area_rate_raw": supply_diag_last.raw_rate if supply_diag_last else None,
-                "dotSigma_prod": _safe_float(supply_rate_scaled_current),
-                "mu_orbit10pct": supply_mu_orbit_cfg,
-                "epsilon_mix": supply_epsilon_mix,
-                "prod_rate_raw": _safe_float(prod_rate_raw_current),
-                "prod_rate_applied_to_surf": _safe_float(supply_rate_applied_current),
-                "prod_rate_diverted_to_deep": _safe_float(prod_rate_diverted_current),
-                "prod_rate_into_deep": _safe_float(prod_rate_into_deep_current),
-                "deep_to_surf_flux_attempt": _safe_float(deep_to_surf_flux_attempt_current),
-                "deep_to_surf_flux": _safe_float(deep_to_surf_flux_current),
-                "deep_to_surf_flux_applied": _safe_float(deep_to_surf_flux_current),
-                "supply_rate_nominal": _safe_float(supply_rate_nominal_current),
-                "supply_rate_scaled": _safe_float(supply_rate_scaled_current),
-                "supply_rate_applied": _safe_float(supply_rate_applied_current),
-                "supply_tau_clip_spill_rate": _safe_float(spill_rate_current),
-                "supply_headroom": _safe_float(headroom_current),
-                "supply_clip_factor": _safe_float(clip_factor_current),
-                "supply_visibility_factor": _safe_float(visibility_factor_current),
-                "supply_blocked_by_headroom": bool(supply_blocked_by_headroom_flag),
-                "supply_mixing_limited": bool(supply_mixing_limited_flag),
-                "supply_transport_mode": supply_transport_mode,
-                "e_kernel_used": _safe_float(e_kernel_step),
-                "i_kernel_used": _safe_float(i_kernel_step),
-                "e_kernel_base": _safe_float(e_kernel_base_step),
-                "i_kernel_base": _safe_float(i_kernel_base_step),
-                "e_kernel_supply": _safe_float(e_kernel_supply_step),
-                "i_kernel_supply": _safe_float(i_kernel_supply_step),
-                "e_kernel_effective": _safe_float(e_kernel_step),
-                "i_kernel_effective": _safe_float(i_kernel_step),
-                "e_state_next": _safe_float(e_state_next_step),
-                "i_state_next": _safe_float(i_state_next_step),
-                "t_damp_collisions": _safe_float(t_damp_applied_step),
-                "e_eq_target": _safe_float(e_damp_target_step),
-                "supply_velocity_weight_w": _safe_float(supply_velocity_weight_step),
-                "supply_temperature_scale": supply_diag_last.temperature_scale if supply_diag_last else None,
-                "supply_temperature_value": supply_diag_last.temperature_value if supply_diag_last else None,
-                "supply_temperature_value_kind": supply_diag_last.temperature_value_kind if supply_diag_last else None,
-                "supply_feedback_scale": supply_diag_last.feedback_scale if supply_diag_last else None,
-                "supply_feedback_error": supply_diag_last.feedback_error if supply_diag_last else None,
-                "supply_reservoir_remaining_Mmars": supply_diag_last.reservoir_remaining_Mmars if supply_diag_last else None,
-                "supply_reservoir_fraction": supply_diag_last.reservoir_fraction if supply_diag_last else None,
-                "supply_reservoir_clipped": bool(supply_diag_last.clipped_by_reservoir) if supply_diag_last else False,
-                "M_out_dot": M_out_dot,
-                "M_sink_dot": M_sink_dot,
-                "dM_dt_surface_total": dM_dt_surface_total,
-                "M_out_dot_avg": M_out_dot_avg,
-                "M_sink_dot_avg": M_sink_dot_avg,
-                "dM_dt_surface_total_avg": dM_dt_surface_total_avg,
-                "fast_blowout_factor_avg": fast_blowout_factor_avg,
-                "dSigma_dt_blowout": dSigma_dt_blowout,
-                "dSigma_dt_sinks": dSigma_dt_sinks,
-                "dSigma_dt_total": dSigma_dt_total,
-                "dSigma_dt_sublimation": dSigma_dt_sublimation_total,
-                "M_loss_cum": M_loss_cum + M_sink_cum,
-                "mass_total_bins": cfg.initial.mass_total - (M_loss_cum + M_sink_cum),
-                "mass_lost_by_blowout": M_loss_cum,
-                "mass_lost_by_sinks": M_sink_cum,
-                "M_sink_cum": M_sink_cum,
-                "mass_lost_sinks_step": mass_loss_sinks_step_total,
-                "mass_lost_sublimation_step": mass_loss_sublimation_step_diag,
-                "mass_lost_hydro_step": mass_loss_hydro_step,
-                "mass_lost_tau_clip_spill_step": mass_loss_spill_step,
-                "cum_mass_lost_tau_clip_spill": M_spill_cum,
-                "mass_lost_surface_solid_marsRP_step": mass_loss_surface_solid_step,
-                "M_loss_rp_mars": M_loss_cum,
-                "M_loss_surface_solid_marsRP": M_loss_cum,
-                "M_loss_hydro": M_hydro_cum,
-                "fast_blowout_factor": fast_blowout_factor_record,
-                "fast_blowout_corrected": fast_blowout_applied,
-                "fast_blowout_flag_gt3": fast_blowout_flag,
-                "fast_blowout_flag_gt10": fast_blowout_flag_strict,
-                "fast_blowout_ratio": fast_blowout_ratio_alias,
-                "n_substeps": int(n_substeps),
-                "substep_active": bool(substep_active),
-                "chi_blow_eff": chi_blow_eff,
-                "case_status": case_status,
-                "s_blow_m": a_blow_step,
-                "s_blow_m_effective": a_blow_effective_step,
-                "rho_used": rho_used,
-                "Q_pr_used": qpr_mean_step,
-                "Q_pr_blow": qpr_for_blow_step,
-                "s_min_effective": s_min_effective,
-                "s_min_config": s_min_config,
-                "s_min_effective_gt_config": s_min_effective > s_min_config,
-                "T_source": T_M_source,
-                "T_M_used": T_use,
-                "ds_dt_sublimation": ds_dt_val,
-                "ds_dt_sublimation_raw": ds_dt_raw,
-                "phi_effective": phi_effective_last,
-                "phi_used": phi_effective_last,
-                "e_kernel_used": _safe_float(e_kernel_step),
-                "i_kernel_used": _safe_float(i_kernel_step),
-                "e_kernel_base": _safe_float(e_kernel_base_step),
-                "i_kernel_base": _safe_float(i_kernel_base_step),
-                "e_kernel_supply": _safe_float(e_kernel_supply_step),
-                "i_kernel_supply": _safe_float(i_kernel_supply_step),
-                "e_kernel_effective": _safe_float(e_kernel_step),
-                "i_kernel_effective": _safe_float(i_kernel_step),
-                "supply_velocity_weight_w": _safe_float(supply_velocity_weight_step),
-                "phase_state": phase_state_last,
-                "phase_f_vap": phase_f_vap_last,
-                "phase_method": phase_method_last,
-                "phase_reason": phase_reason_last,
-                "phase_bulk_state": phase_bulk_state_last,
-                "phase_bulk_f_liquid": phase_bulk_f_liquid_last,
-                "phase_bulk_f_solid": phase_bulk_f_solid_last,
-                "phase_bulk_f_vapor": phase_bulk_f_vapor_last,
-                "tau_mars_line_of_sight": tau_los_last,
-                "tau_gate_blocked": tau_gate_block_last,
-                "blowout_beta_gate": beta_gate_last,
-                "blowout_phase_allowed": phase_allows_last,
-                "blowout_layer_mode": blowout_layer_mode,
-                "blowout_target_phase": blowout_target_phase,
-                "sink_selected": sink_selected_last,
-                "sublimation_blocked_by_phase": bool(sublimation_blocked_by_phase),
-            }
-            if "energy_columns" in locals():
-                record.update(energy_columns)
-            for key in _series_optional_float_keys:
-                if key in record:
-                    record[key] = _float_or_nan(record.get(key))
-            for key in _series_optional_string_keys:
-                if key in record:
-                    val = record.get(key)
-                    record[key] = "" if val is None else str(val)
+            if series_write:
+                # Rows are only assembled on written steps, trimmed to the selected columns.
+                record = {
+                    "time": time,
+                    "dt": dt,
+                    "Omega_s": Omega_step,
+                    "t_orb_s": t_orb_step,
+                    "t_blow_s": t_blow_step,
+                    "t_coll": t_coll_step,
+                    "ts_ratio": ts_ratio_value,
+                    "r_m": r,
+                    "r_RM": r_RM,
+                    "r_orbit_RM": r_RM,
+                    "r_source": r_source,
+                    "T_M_used": T_use,
+                    "T_M_source": T_M_source,
+                    "T_p_effective": T_p_effective,
+                    "phase_temperature_input": phase_temperature_input_mode,
+                    "rad_flux_Mars": rad_flux_step,
+                    "dt_over_t_blow": dt_over_t_blow,
+                    "tau": tau_record,
+                    "tau_los_mars": tau_record,
+                    "a_blow_step": a_blow_step,
+                    "a_blow": a_blow_step,
+                    "a_blow_at_smin": a_blow_step,
+                    "s_min": s_min_effective,
+                    "s_min_surface_energy": s_min_surface_energy,
+                    "kappa": kappa_eff,
+                    "kappa_eff": kappa_eff,
+                    "kappa_surf": kappa_surf,
+                    "Qpr_mean": qpr_mean_step,
+                    "Q_pr_at_smin": qpr_mean_step,
+                    "beta_at_smin_config": beta_at_smin_config,
+                    "beta_at_smin_effective": beta_at_smin_effective,
+                    "beta_at_smin": beta_at_smin_effective,
+                    "beta_threshold": beta_threshold,
+                    "Sigma_surf": sigma_surf,
+                    "sigma_surf": sigma_surf,
+                    "Sigma_surf0": sigma_surf0_target,
+                    "Sigma_tau1": sigma_tau1_limit,
+                    "Sigma_tau1_active": sigma_tau1_active_last,
+                    "sigma_tau1": sigma_tau1_limit,
+                    "Sigma_tau1_last_finite": sigma_tau1_limit_last_finite,
+                    "tau_phase_los": tau_phase_los_last,
+                    "tau_phase_used": tau_phase_used_last,
+                    "phase_tau_field": phase_tau_field,
+                    "sigma_deep": sigma_deep,
+                    "headroom": _safe_float(headroom_current),
+                    "outflux_surface": outflux_surface,
+                    "t_solid_s": t_solid_step,
+                    "blowout_gate_factor": gate_factor,
+                    "sink_flux_surface": sink_flux_surface,
+                    "t_blow": t_blow_step,
+                    "prod_subblow_area_rate": prod_rate_last,
+                    "prod_subblow_area_rate_raw": supply_diag_last.raw_rate if supply_diag_last else None,
+                    "dotSigma_prod": _safe_float(supply_rate_scaled_current),
+                    "mu_orbit10pct": supply_mu_orbit_cfg,
+                    "epsilon_mix": supply_epsilon_mix,
+                    "prod_rate_raw": _safe_float(prod_rate_raw_current),
+                    "prod_rate_applied_to_surf": _safe_float(supply_rate_applied_current),
+                    "prod_rate_diverted_to_deep": _safe_float(prod_rate_diverted_current),
+                    "prod_rate_into_deep": _safe_float(prod_rate_into_deep_current),
+                    "deep_to_surf_flux_attempt": _safe_float(deep_to_surf_flux_attempt_current),
+                    "deep_to_surf_flux": _safe_float(deep_to_surf_flux_current),
+                    "deep_to_surf_flux_applied": _safe_float(deep_to_surf_flux_current),
+                    "supply_rate_nominal": _safe_float(supply_rate_nominal_current),
+                    "supply_rate_scaled": _safe_float(supply_rate_scaled_current),
+                    "supply_rate_applied": _safe_float(supply_rate_applied_current),
+                    "supply_tau_clip_spill_rate": _safe_float(spill_rate_current),
+                    "supply_headroom": _safe_float(headroom_current),
+                    "supply_clip_factor": _safe_float(clip_factor_current),
+                    "supply_visibility_factor": _safe_float(visibility_factor_current),
+                    "supply_blocked_by_headroom": bool(supply_blocked_by_headroom_flag),
+                    "supply_mixing_limited": bool(supply_mixing_limited_flag),
+                    "supply_transport_mode": supply_transport_mode,
+                    "e_kernel_used": _safe_float(e_kernel_step),
+                    "i_kernel_used": _safe_float(i_kernel_step),
+                    "e_kernel_base": _safe_float(e_kernel_base_step),
+                    "i_kernel_base": _safe_float(i_kernel_base_step),
+                    "e_kernel_supply": _safe_float(e_kernel_supply_step),
+                    "i_kernel_supply": _safe_float(i_kernel_supply_step),
+                    "e_kernel_effective": _safe_float(e_kernel_step),
+                    "i_kernel_effective": _safe_float(i_kernel_step),
+                    "e_state_next": _safe_float(e_state_next_step),
+                    "i_state_next": _safe_float(i_state_next_step),
+                    "t_damp_collisions": _safe_float(t_damp_applied_step),
+                    "e_eq_target": _safe_float(e_damp_target_step),
+                    "supply_velocity_weight_w": _safe_float(supply_velocity_weight_step),
+                    "supply_temperature_scale": supply_diag_last.temperature_scale if supply_diag_last else None,
+                    "supply_temperature_value": supply_diag_last.temperature_value if supply_diag_last else None,
+                    "supply_temperature_value_kind": supply_diag_last.temperature_value_kind if supply_diag_last else None,
+                    "supply_feedback_scale": supply_diag_last.feedback_scale if supply_diag_last else None,
+                    "supply_feedback_error": supply_diag_last.feedback_error if supply_diag_last else None,
+                    "supply_reservoir_remaining_Mmars": supply_diag_last.reservoir_remaining_Mmars if supply_diag_last else None,
+                    "supply_reservoir_fraction": supply_diag_last.reservoir_fraction if supply_diag_last else None,
+                    "supply_reservoir_clipped": bool(supply_diag_last.clipped_by_reservoir) if supply_diag_last else False,
+                    "M_out_dot": M_out_dot,
+                    "M_sink_dot": M_sink_dot,
+                    "dM_dt_surface_total": dM_dt_surface_total,
+                    "M_out_dot_avg": M_out_dot_avg,
+                    "M_sink_dot_avg": M_sink_dot_avg,
+                    "dM_dt_surface_total_avg": dM_dt_surface_total_avg,
+                    "fast_blowout_factor_avg": fast_blowout_factor_avg,
+                    "dSigma_dt_blowout": dSigma_dt_blowout,
+                    "dSigma_dt_sinks": dSigma_dt_sinks,
+                    "dSigma_dt_total": dSigma_dt_total,
+                    "dSigma_dt_sublimation": dSigma_dt_sublimation_total,
+                    "M_loss_cum": M_loss_cum + M_sink_cum,
+                    "mass_total_bins": run_plan.mass_total - (M_loss_cum + M_sink_cum),
+                    "mass_lost_by_blowout": M_loss_cum,
+                    "mass_lost_by_sinks": M_sink_cum,
+                    "M_sink_cum": M_sink_cum,
+                    "mass_lost_sinks_step": mass_loss_sinks_step_total,
+                    "mass_lost_sublimation_step": mass_loss_sublimation_step_diag,
+                    "mass_lost_hydro_step": mass_loss_hydro_step,
+                    "mass_lost_tau_clip_spill_step": mass_loss_spill_step,
+                    "cum_mass_lost_tau_clip_spill": M_spill_cum,
+                    "mass_lost_surface_solid_marsRP_step": mass_loss_surface_solid_step,
+                    "M_loss_rp_mars": M_loss_cum,
+                    "M_loss_surface_solid_marsRP": M_loss_cum,
+                    "M_loss_hydro": M_hydro_cum,
+                    "fast_blowout_factor": fast_blowout_factor_record,
+                    "fast_blowout_corrected": fast_blowout_applied,
+                    "fast_blowout_flag_gt3": fast_blowout_flag,
+                    "fast_blowout_flag_gt10": fast_blowout_flag_strict,
+                    "fast_blowout_ratio": fast_blowout_ratio_alias,
+                    "n_substeps": int(n_substeps),
+                    "substep_active": bool(substep_active),
+                    "chi_blow_eff": chi_blow_eff,
+                    "case_status": case_status,
+                    "s_blow_m": a_blow_step,
+                    "s_blow_m_effective": a_blow_effective_step,
+                    "rho_used": rho_used,
+                    "Q_pr_used": qpr_mean_step,
+                    "Q_pr_blow": qpr_for_blow_step,
+                    "s_min_effective": s_min_effective,
+                    "s_min_config": s_min_config,
+                    "s_min_effective_gt_config": s_min_effective > s_min_config,
+                    "T_source": T_M_source,
+                    "T_M_used": T_use,
+                    "ds_dt_sublimation": ds_dt_val,
+                    "ds_dt_sublimation_raw": ds_dt_raw,
+                    "phi_effective": phi_effective_last,
+                    "phi_used": phi_effective_last,
+                    "e_kernel_used": _safe_float(e_kernel_step),
+                    "i_kernel_used": _safe_float(i_kernel_step),
+                    "e_kernel_base": _safe_float(e_kernel_base_step),
+                    "i_kernel_base": _safe_float(i_kernel_base_step),
+                    "e_kernel_supply": _safe_float(e_kernel_supply_step),
+                    "i_kernel_supply": _safe_float(i_kernel_supply_step),
+                    "e_kernel_effective": _safe_float(e_kernel_step),
+                    "i_kernel_effective": _safe_float(i_kernel_step),
+                    "supply_velocity_weight_w": _safe_float(supply_velocity_weight_step),
+                    "phase_state": phase_state_last,
+                    "phase_f_vap": phase_f_vap_last,
+                    "phase_method": phase_method_last,
+                    "phase_reason": phase_reason_last,
+                    "phase_bulk_state": phase_bulk_state_last,
+                    "phase_bulk_f_liquid": phase_bulk_f_liquid_last,
+                    "phase_bulk_f_solid": phase_bulk_f_solid_last,
+                    "phase_bulk_f_vapor": phase_bulk_f_vapor_last,
+                    "tau_mars_line_of_sight": tau_los_last,
+                    "tau_gate_blocked": tau_gate_block_last,
+                    "blowout_beta_gate": beta_gate_last,
+                    "blowout_phase_allowed": phase_allows_last,
+                    "blowout_layer_mode": blowout_layer_mode,
+                    "blowout_target_phase": blowout_target_phase,
+                    "sink_selected": sink_selected_last,
+                    "sublimation_blocked_by_phase": bool(sublimation_blocked_by_phase),
+                }
+                if energy_columns:
+                    record.update(energy_columns)
+                # Force optional numeric/string fields to concrete types to stabilise streaming chunk schemas.
+                for key in _SERIES_OPTIONAL_FLOAT_KEYS:
+                    if key in record:
+                        record[key] = _float_or_nan(record.get(key))
+                for key in _SERIES_OPTIONAL_STRING_KEYS:
+                    if key in record:
+                        val = record.get(key)
+                        record[key] = "" if val is None else str(val)
+                if extended_diag_enabled:
+                    record.update(
+                        {
+                            "mloss_blowout_rate": M_out_dot,
+                            "mloss_sink_rate": M_sink_dot,
+                            "mloss_total_rate": dM_dt_surface_total,
+                            "cum_mloss_blowout": M_loss_cum,
+                            "cum_mloss_sink": M_sink_cum,
+                            "cum_mloss_total": M_loss_cum + M_sink_cum,
+                            "beta_eff": beta_at_smin_effective,
+                            "kappa_eff": kappa_eff,
+                            "tau_eff": tau_eff_diag,
+                        }
+                    )
+                if evolve_min_size_enabled:
+                    record["s_min_evolved"] = s_min_evolved_value
+                if series_record_keys is not None:
+                    record = {key: record.get(key) for key in series_record_keys}
+                records.append(record)
             if extended_diag_enabled:
-                record.update(
-                    {
-                        "mloss_blowout_rate": M_out_dot,
-                        "mloss_sink_rate": M_sink_dot,
-                        "mloss_total_rate": dM_dt_surface_total,
-                        "cum_mloss_blowout": M_loss_cum,
-                        "cum_mloss_sink": M_sink_cum,
-                        "cum_mloss_total": M_loss_cum + M_sink_cum,
-                        "beta_eff": beta_at_smin_effective,
-                        "kappa_eff": kappa_eff,
-                        "tau_eff": tau_eff_diag,
-                    }
-                )
                 extended_total_rate_track.append(dM_dt_surface_total)
                 extended_total_rate_time_track.append(time)
                 if ts_ratio_value is not None and math.isfinite(ts_ratio_value):
                     extended_ts_ratio_track.append(ts_ratio_value)
-            if evolve_min_size_enabled:
-                record["s_min_evolved"] = s_min_evolved_value
             if supply_diag_last is not None:
                 if math.isfinite(supply_diag_last.feedback_scale):
                     supply_feedback_track.append(float(supply_diag_last.feedback_scale))
@@ -4372,8 +4558,6 @@ def run_zero_d(
                     supply_temperature_scale_track.append(float(supply_diag_last.temperature_scale))
                 if supply_diag_last.reservoir_remaining_Mmars is not None:
                     supply_reservoir_remaining_track.append(float(supply_diag_last.reservoir_remaining_Mmars))
-            if series_write:
-                records.append(record)
 
             if psd_history_enabled and (psd_history_stride <= 1 or step_no % psd_history_stride == 0):
                 try:
@@ -4404,211 +4588,147 @@ def run_zero_d(
                             }
                         )
 
-            F_abs_geom = constants.SIGMA_SB * (T_use**4) * (constants.R_MARS / r) ** 2
-            phi_effective_diag = phi_effective_last
-            if phi_effective_diag is None and kappa_surf > 0.0:
-                phi_effective_diag = kappa_eff / kappa_surf
-
-            s_peak_value = _psd_mass_peak()
-            F_abs_qpr = F_abs_geom * qpr_mean_step
-            tau_los_diag = tau_los_last if tau_los_last is not None else tau_record
-            _diag_optional_float_keys = {
-                "sigma_tau1",
-                "sigma_tau1_active",
-                "Sigma_tau1_last_finite",
-                "tau_phase_los",
-                "tau_phase_used",
-                "t_sink_total_s",
-                "t_sink_surface_s",
-                "t_sink_sublimation_s",
-                "t_sink_gas_drag_s",
-                "prod_subblow_area_rate_raw",
-                "supply_rate_nominal",
-                "supply_rate_scaled",
-                "supply_tau_clip_spill_rate",
-                "supply_headroom",
-                "headroom",
-                "supply_clip_factor",
-                "prod_rate_raw",
-                "prod_rate_applied_to_surf",
-                "prod_rate_diverted_to_deep",
-                "prod_rate_into_deep",
-                "deep_to_surf_flux_attempt",
-                "deep_to_surf_flux",
-                "deep_to_surf_flux_applied",
-                "supply_temperature_scale",
-                "supply_temperature_value",
-                "supply_feedback_scale",
-                "supply_feedback_error",
-                "supply_reservoir_remaining_Mmars",
-                "supply_reservoir_fraction",
-                "s_min_effective",
-                "phi_effective",
-                "chi_blow_eff",
-                "ds_step_uniform",
-                "mass_ratio_uniform",
-                "smol_dt_eff",
-                "smol_sigma_before",
-                "smol_sigma_after",
-                "smol_sigma_loss",
-                "smol_prod_mass_rate",
-                "smol_extra_mass_loss_rate",
-                "smol_mass_budget_delta",
-                "smol_mass_error",
-                "smol_gain_mass_rate",
-                "smol_loss_mass_rate",
-                "smol_sink_mass_rate",
-                "smol_source_mass_rate",
-                "hydro_timescale_s",
-                "mass_loss_surface_solid_step",
-                "ds_dt_sublimation",
-                "ds_dt_sublimation_raw",
-            }
-            _diag_optional_string_keys = {
-                "phase_tau_field",
-                "phase_temperature_input",
-                "tau_phase_used",
-                "supply_transport_mode",
-                "phase_state",
-                "phase_method",
-                "phase_reason",
-                "phase_bulk_state",
-                "supply_temperature_value_kind",
-                "phase_payload",
-            }
-
-            diag_entry = {
-                "time": time,
-                "dt": dt,
-                "dt_over_t_blow": dt_over_t_blow,
-                "r_m_used": r,
-                "r_RM_used": r_RM,
-                "T_M_used": T_use,
-                "T_p_effective": T_p_effective,
-                "phase_temperature_input": phase_temperature_input_mode,
-                "phase_temperature_used_K": temperature_for_phase,
-                "rad_flux_Mars": rad_flux_step,
-                "F_abs_geom": F_abs_geom,
-                "F_abs_geom_qpr": F_abs_qpr,
-                "F_abs": F_abs_qpr,
-                "Omega_s": Omega_step,
-                "t_orb_s": t_orb_step,
-                "t_blow_s": t_blow_step,
-                "t_solid_s": t_solid_step,
-                "t_sink_total_s": _safe_float(t_sink_total_value),
-                "t_sink_surface_s": float(t_sink_step) if t_sink_step is not None else None,
-                "t_sink_sublimation_s": _safe_float(sink_result.components.get("sublimation")),
-                "t_sink_gas_drag_s": _safe_float(sink_result.components.get("gas_drag")),
-                "mass_loss_sinks_step": mass_loss_sinks_step_total,
-                "mass_lost_by_sinks": M_sink_cum,
-                "mass_loss_sublimation_step": mass_loss_sublimation_step_diag,
-                "sigma_tau1": sigma_tau1_limit,
-                "sigma_tau1_active": sigma_tau1_active_last,
-                "Sigma_tau1_last_finite": sigma_tau1_limit_last_finite,
-                "tau_los_mars": tau_los_diag,
-                "tau_phase_los": tau_phase_los_last,
-                "tau_phase_used": tau_phase_used_last,
-                "phase_tau_field": phase_tau_field,
-                "kappa_eff": kappa_eff,
-                "kappa_surf": kappa_surf,
-                "phi_effective": phi_effective_diag,
-                "psi_shield": phi_effective_diag,
-                "sigma_surf": sigma_diag,
-                "sigma_deep": sigma_deep,
-                "kappa_Planck": kappa_surf,
-                "tau_eff": tau_eff_diag,
-                "s_min": s_min_effective,
-                "a_blow_at_smin": a_blow_step,
-                "beta_at_smin_effective": beta_at_smin_effective,
-                "beta_at_smin": beta_at_smin_effective,
-                "Q_pr_at_smin": qpr_mean_step,
-                "s_peak": s_peak_value,
-                "area_m2": area,
-                "prod_subblow_area_rate": prod_rate_last,
-                "prod_subblow_area_rate_raw": supply_diag_last.raw_rate if supply_diag_last else None,
-                "supply_rate_nominal": _safe_float(supply_rate_nominal_current),
-                "supply_rate_scaled": _safe_float(supply_rate_scaled_current),
-                "supply_rate_applied": _safe_float(supply_rate_applied_current),
-                "supply_tau_clip_spill_rate": _safe_float(spill_rate_current),
-                "supply_headroom": _safe_float(headroom_current),
-                "supply_clip_factor": _safe_float(clip_factor_current),
-                "headroom": _safe_float(headroom_current),
-                "prod_rate_raw": _safe_float(prod_rate_raw_current),
-                "prod_rate_applied_to_surf": _safe_float(supply_rate_applied_current),
-                "prod_rate_diverted_to_deep": _safe_float(prod_rate_diverted_current),
-                "prod_rate_into_deep": _safe_float(prod_rate_into_deep_current),
-                "deep_to_surf_flux_attempt": _safe_float(deep_to_surf_flux_attempt_current),
-                "deep_to_surf_flux": _safe_float(deep_to_surf_flux_current),
-                "deep_to_surf_flux_applied": _safe_float(deep_to_surf_flux_current),
-                "supply_visibility_factor": _safe_float(visibility_factor_current),
-                "supply_blocked_by_headroom": bool(supply_blocked_by_headroom_flag),
-                "supply_mixing_limited": bool(supply_mixing_limited_flag),
-                "supply_transport_mode": supply_transport_mode,
-                "supply_temperature_scale": supply_diag_last.temperature_scale if supply_diag_last else None,
-                "supply_temperature_value": supply_diag_last.temperature_value if supply_diag_last else None,
-                "supply_temperature_value_kind": supply_diag_last.temperature_value_kind if supply_diag_last else None,
-                "supply_feedback_scale": supply_diag_last.feedback_scale if supply_diag_last else None,
-                "supply_feedback_error": supply_diag_last.feedback_error if supply_diag_last else None,
-                "supply_reservoir_remaining_Mmars": supply_diag_last.reservoir_remaining_Mmars if supply_diag_last else None,
-                "supply_reservoir_fraction": supply_diag_last.reservoir_fraction if supply_diag_last else None,
-                "supply_reservoir_clipped": bool(supply_diag_last.clipped_by_reservoir) if supply_diag_last else False,
-                "s_min_effective": s_min_effective,
-                "qpr_mean": qpr_mean_step,
-                "chi_blow_eff": chi_blow_eff,
-                "ds_step_uniform": erosion_diag.get("ds_step"),
-                "mass_ratio_uniform": erosion_diag.get("mass_ratio"),
-                "M_out_cum": M_loss_cum,
-                "M_sink_cum": M_sink_cum,
-                "M_loss_cum": M_loss_cum + M_sink_cum,
-                "cum_mass_lost_tau_clip_spill": M_spill_cum,
-                "M_loss_surface_solid_marsRP": M_loss_cum,
-                "M_hydro_cum": M_hydro_cum,
-                "phase_state": phase_state_last,
-                "phase_method": phase_method_last,
-                "phase_reason": phase_reason_last,
-                "phase_f_vap": phase_f_vap_last,
-                "phase_bulk_state": phase_bulk_state_last,
-                "phase_bulk_f_liquid": phase_bulk_f_liquid_last,
-                "phase_bulk_f_solid": phase_bulk_f_solid_last,
-                "phase_bulk_f_vapor": phase_bulk_f_vapor_last,
-                "phase_payload": phase_payload_last,
-                "ds_dt_sublimation": ds_dt_val,
-                "ds_dt_sublimation_raw": ds_dt_raw,
-                "sublimation_blocked_by_phase": bool(sublimation_blocked_by_phase),
-                "tau_mars_line_of_sight": tau_los_last,
-                "tau_gate_blocked": tau_gate_block_last,
-                "blowout_beta_gate": beta_gate_last,
-                "blowout_phase_allowed": phase_allows_last,
-                "blowout_layer_mode": blowout_layer_mode,
-                "blowout_target_phase": blowout_target_phase,
-                "sink_selected": sink_selected_last,
-                "hydro_timescale_s": _safe_float(hydro_timescale_last),
-                "mass_loss_surface_solid_step": mass_loss_surface_solid_step,
-                "smol_dt_eff": smol_dt_eff,
-                "smol_sigma_before": smol_sigma_before,
-                "smol_sigma_after": smol_sigma_after,
-                "smol_sigma_loss": smol_sigma_loss,
-                "smol_prod_mass_rate": smol_prod_mass_rate,
-                "smol_extra_mass_loss_rate": smol_extra_mass_loss_rate,
-                "smol_mass_budget_delta": smol_mass_budget_delta,
-                "smol_mass_error": smol_mass_error,
-                "smol_gain_mass_rate": smol_gain_mass_rate,
-                "smol_loss_mass_rate": smol_loss_mass_rate,
-                "smol_sink_mass_rate": smol_sink_mass_rate,
-                "smol_source_mass_rate": smol_source_mass_rate,
-                "blowout_gate_factor": gate_factor,
-            }
-            for key in _diag_optional_float_keys:
-                if key in diag_entry:
-                    diag_entry[key] = _float_or_nan(diag_entry.get(key))
-            for key in _diag_optional_string_keys:
-                if key in diag_entry:
-                    val = diag_entry.get(key)
-                    diag_entry[key] = "" if val is None else str(val)
             if diagnostics_write:
+                F_abs_geom = constants.SIGMA_SB * (T_use**4) * (constants.R_MARS / r) ** 2
+                phi_effective_diag = phi_effective_last
+                if phi_effective_diag is None and kappa_surf > 0.0:
+                    phi_effective_diag = kappa_eff / kappa_surf
+
+                s_peak_value = _psd_mass_peak()
+                F_abs_qpr = F_abs_geom * qpr_mean_step
+                tau_los_diag = tau_los_last if tau_los_last is not None else tau_record
+
+                diag_entry = {
+                    "time": time,
+                    "dt": dt,
+                    "dt_over_t_blow": dt_over_t_blow,
+                    "r_m_used": r,
+                    "r_RM_used": r_RM,
+                    "T_M_used": T_use,
+                    "T_p_effective": T_p_effective,
+                    "phase_temperature_input": phase_temperature_input_mode,
+                    "phase_temperature_used_K": temperature_for_phase,
+                    "rad_flux_Mars": rad_flux_step,
+                    "F_abs_geom": F_abs_geom,
+                    "F_abs_geom_qpr": F_abs_qpr,
+                    "F_abs": F_abs_qpr,
+                    "Omega_s": Omega_step,
+                    "t_orb_s": t_orb_step,
+                    "t_blow_s": t_blow_step,
+                    "t_solid_s": t_solid_step,
+                    "t_sink_total_s": _safe_float(t_sink_total_value),
+                    "t_sink_surface_s": float(t_sink_step) if t_sink_step is not None else None,
+                    "t_sink_sublimation_s": _safe_float(sink_result.components.get("sublimation")),
+                    "t_sink_gas_drag_s": _safe_float(sink_result.components.get("gas_drag")),
+                    "mass_loss_sinks_step": mass_loss_sinks_step_total,
+                    "mass_lost_by_sinks": M_sink_cum,
+                    "mass_loss_sublimation_step": mass_loss_sublimation_step_diag,
+                    "sigma_tau1": sigma_tau1_limit,
+                    "sigma_tau1_active": sigma_tau1_active_last,
+                    "Sigma_tau1_last_finite": sigma_tau1_limit_last_finite,
+                    "tau_los_mars": tau_los_diag,
+                    "tau_phase_los": tau_phase_los_last,
+                    "tau_phase_used": tau_phase_used_last,
+                    "phase_tau_field": phase_tau_field,
+                    "kappa_eff": kappa_eff,
+                    "kappa_surf": kappa_surf,
+                    "phi_effective": phi_effective_diag,
+                    "psi_shield": phi_effective_diag,
+                    "sigma_surf": sigma_diag,
+                    "sigma_deep": sigma_deep,
+                    "kappa_Planck": kappa_surf,
+                    "tau_eff": tau_eff_diag,
+                    "s_min": s_min_effective,
+                    "a_blow_at_smin": a_blow_step,
+                    "beta_at_smin_effective": beta_at_smin_effective,
+                    "beta_at_smin": beta_at_smin_effective,
+                    "Q_pr_at_smin": qpr_mean_step,
+                    "s_peak": s_peak_value,
+                    "area_m2": area,
+                    "prod_subblow_area_rate": prod_rate_last,
+                    "prod_subblow_area_rate_raw": supply_diag_last.raw_rate if supply_diag_last else None,
+                    "supply_rate_nominal": _safe_float(supply_rate_nominal_current),
+                    "supply_rate_scaled": _safe_float(supply_rate_scaled_current),
+                    "supply_rate_applied": _safe_float(supply_rate_applied_current),
+                    "supply_tau_clip_spill_rate": _safe_float(spill_rate_current),
+                    "supply_headroom": _safe_float(headroom_current),
+                    "supply_clip_factor": _safe_float(clip_factor_current),
+                    "headroom": _safe_float(headroom_current),
+                    "prod_rate_raw": _safe_float(prod_rate_raw_current),
+                    "prod_rate_applied_to_surf": _safe_float(supply_rate_applied_current),
+                    "prod_rate_diverted_to_deep": _safe_float(prod_rate_diverted_current),
+                    "prod_rate_into_deep": _safe_float(prod_rate_into_deep_current),
+                    "deep_to_surf_flux_attempt": _safe_float(deep_to_surf_flux_attempt_current),
+                    "deep_to_surf_flux": _safe_float(deep_to_surf_flux_current),
+                    "deep_to_surf_flux_applied": _safe_float(deep_to_surf_flux_current),
+                    "supply_visibility_factor": _safe_float(visibility_factor_current),
+                    "supply_blocked_by_headroom": bool(supply_blocked_by_headroom_flag),
+                    "supply_mixing_limited": bool(supply_mixing_limited_flag),
+                    "supply_transport_mode": supply_transport_mode,
+                    "supply_temperature_scale": supply_diag_last.temperature_scale if supply_diag_last else None,
+                    "supply_temperature_value": supply_diag_last.temperature_value if supply_diag_last else None,
+                    "supply_temperature_value_kind": supply_diag_last.temperature_value_kind if supply_diag_last else None,
+                    "supply_feedback_scale": supply_diag_last.feedback_scale if supply_diag_last else None,
+                    "supply_feedback_error": supply_diag_last.feedback_error if supply_diag_last else None,
+                    "supply_reservoir_remaining_Mmars": supply_diag_last.reservoir_remaining_Mmars if supply_diag_last else None,
+                    "supply_reservoir_fraction": supply_diag_last.reservoir_fraction if supply_diag_last else None,
+                    "supply_reservoir_clipped": bool(supply_diag_last.clipped_by_reservoir) if supply_diag_last else False,
+                    "s_min_effective": s_min_effective,
+                    "qpr_mean": qpr_mean_step,
+                    "chi_blow_eff": chi_blow_eff,
+                    "ds_step_uniform": erosion_diag.get("ds_step"),
+                    "mass_ratio_uniform": erosion_diag.get("mass_ratio"),
+                    "M_out_cum": M_loss_cum,
+                    "M_sink_cum": M_sink_cum,
+                    "M_loss_cum": M_loss_cum + M_sink_cum,
+                    "cum_mass_lost_tau_clip_spill": M_spill_cum,
+                    "M_loss_surface_solid_marsRP": M_loss_cum,
+                    "M_hydro_cum": M_hydro_cum,
+                    "phase_state": phase_state_last,
+                    "phase_method": phase_method_last,
+                    "phase_reason": phase_reason_last,
+                    "phase_f_vap": phase_f_vap_last,
+                    "phase_bulk_state": phase_bulk_state_last,
+                    "phase_bulk_f_liquid": phase_bulk_f_liquid_last,
+                    "phase_bulk_f_solid": phase_bulk_f_solid_last,
+                    "phase_bulk_f_vapor": phase_bulk_f_vapor_last,
+                    "phase_payload": phase_payload_last,
+                    "ds_dt_sublimation": ds_dt_val,
+                    "ds_dt_sublimation_raw": ds_dt_raw,
+                    "sublimation_blocked_by_phase": bool(sublimation_blocked_by_phase),
+                    "tau_mars_line_of_sight": tau_los_last,
+                    "tau_gate_blocked": tau_gate_block_last,
+                    "blowout_beta_gate": beta_gate_last,
+                    "blowout_phase_allowed": phase_allows_last,
+                    "blowout_layer_mode": blowout_layer_mode,
+                    "blowout_target_phase": blowout_target_phase,
+                    "sink_selected": sink_selected_last,
+                    "hydro_timescale_s": _safe_float(hydro_timescale_last),
+                    "mass_loss_surface_solid_step": mass_loss_surface_solid_step,
+                    "smol_dt_eff": smol_dt_eff,
+                    "smol_sigma_before": smol_sigma_before,
+                    "smol_sigma_after": smol_sigma_after,
+                    "smol_sigma_loss": smol_sigma_loss,
+                    "smol_prod_mass_rate": smol_prod_mass_rate,
+                    "smol_extra_mass_loss_rate": smol_extra_mass_loss_rate,
+                    "smol_mass_budget_delta": smol_mass_budget_delta,
+                    "smol_mass_error": smol_mass_error,
+                    "smol_gain_mass_rate": smol_gain_mass_rate,
+                    "smol_loss_mass_rate": smol_loss_mass_rate,
+                    "smol_sink_mass_rate": smol_sink_mass_rate,
+                    "smol_source_mass_rate": smol_source_mass_rate,
+                    "blowout_gate_factor": gate_factor,
+                }
+                for key in _DIAG_OPTIONAL_FLOAT_KEYS:
+                    if key in diag_entry:
+                        diag_entry[key] = _float_or_nan(diag_entry.get(key))
+                for key in _DIAG_OPTIONAL_STRING_KEYS:
+                    if key in diag_entry:
+                        val = diag_entry.get(key)
+                        diag_entry[key] = "" if val is None else str(val)
                 diagnostics.append(diag_entry)
 
-            mass_initial = cfg.initial.mass_total
+            mass_initial = run_plan.mass_total
             mass_remaining = mass_initial - (M_loss_cum + M_sink_cum)
             mass_lost = M_loss_cum + M_sink_cum
             mass_diff = mass_initial - mass_remaining - mass_lost
@@ -4639,6 +4759,7 @@ def run_zero_d(
                 budget_entry["delta_mloss_vs_channels"] = delta_channels
             last_mass_budget_entry = budget_entry
             mass_budget.append(budget_entry)
+            run_result.record_mass_budget(budget_entry)
             if step_diag_enabled:
                 tau_surf_val = (
                     tau_los_last if tau_los_last is not None else kappa_surf * sigma_diag * los_factor
@@ -4652,32 +4773,38 @@ def run_zero_d(
                     dM_sub += sink_mass_total
                 elif sink_result.dominant_sink == "gas_drag":
                     dM_drag = sink_mass_total
-                step_diag_records.append(
-                    {
-                        "time": float(time),
-                        "sigma_surf": float(sigma_diag),
-                        "tau_surf": tau_surf_val,
-                        "t_coll": _safe_float(t_coll_step),
-                        "t_blow": _safe_float(t_blow_step),
-                        "t_sink": _safe_float(t_sink_step),
-                        "t_sink_sub": _safe_float(sink_sub_timescale),
-                        "t_sink_drag": _safe_float(sink_drag_timescale),
-                        "phase_state_step": phase_state_last,
-                        "phase_bulk_state": phase_bulk_state_last,
-                        "phase_bulk_f_liquid": _safe_float(phase_bulk_f_liquid_last),
-                        "phase_bulk_f_solid": _safe_float(phase_bulk_f_solid_last),
-                        "phase_bulk_f_vapor": _safe_float(phase_bulk_f_vapor_last),
-                        "ds_dt_sublimation": _safe_float(ds_dt_val),
-                        "ds_dt_sublimation_raw": _safe_float(ds_dt_raw),
-                        "sublimation_blocked_by_phase": bool(sublimation_blocked_by_phase),
-                        "dM_blowout_step": float(mass_loss_surface_solid_step),
-                        "dM_sinks_step": float(mass_loss_sinks_step_total),
-                        "dM_sublimation_step": float(dM_sub),
-                        "dM_gas_drag_step": float(dM_drag),
-                        "mass_total_bins": float(mass_remaining),
-                        "mass_lost_by_blowout": float(M_loss_cum),
-                        "mass_lost_by_sinks": float(M_sink_cum),
-                    }
+                step_diag_row = {
+                    "time": float(time),
+                    "sigma_surf": float(sigma_diag),
+                    "tau_surf": tau_surf_val,
+                    "t_coll": _safe_float(t_coll_step),
+                    "t_blow": _safe_float(t_blow_step),
+                    "t_sink": _safe_float(t_sink_step),
+                    "t_sink_sub": _safe_float(sink_sub_timescale),
+                    "t_sink_drag": _safe_float(sink_drag_timescale),
+                    "phase_state_step": phase_state_last,
+                    "phase_bulk_state": phase_bulk_state_last,
+                    "phase_bulk_f_liquid": _safe_float(phase_bulk_f_liquid_last),
+                    "phase_bulk_f_solid": _safe_float(phase_bulk_f_solid_last),
+                    "phase_bulk_f_vapor": _safe_float(phase_bulk_f_vapor_last),
+                    "ds_dt_sublimation": _safe_float(ds_dt_val),
+                    "ds_dt_sublimation_raw": _safe_float(ds_dt_raw),
+                    "sublimation_blocked_by_phase": bool(sublimation_blocked_by_phase),
+                    "dM_blowout_step": float(mass_loss_surface_solid_step),
+                    "dM_sinks_step": float(mass_loss_sinks_step_total),
+                    "dM_sublimation_step": float(dM_sub),
+                    "dM_gas_drag_step": float(dM_drag),
+                    "mass_total_bins": float(mass_remaining),
+                    "mass_lost_by_blowout": float(M_loss_cum),
+                    "mass_lost_by_sinks": float(M_sink_cum),
+                    "smol_arena_allocations": smol.arena_stats()["allocations"],
+                }
+                run_result.record_step_diag(step_diag_row)
+                step_diag_sampler.offer(
+                    step_no,
+                    step_diag_row,
+                    dt_eff=dt / max(n_substeps, 1),
+                    error_percent=error_percent,
                 )
 
             total_time_elapsed += dt
@@ -4685,14 +4812,26 @@ def run_zero_d(
                 tau_gate_block_time += dt
 
             time_after_step = time + dt
+            # End of this step on the run's time grid; checkpoints and partial
+            # summaries report this, and a resumed run picks up from it.
+            step_end_time = time_offset + (step_no + 1) * dt
             if checkpoint_enabled and time_after_step >= checkpoint_next_time:
                 ckpt_ext = ".pkl" if checkpoint_format == "pickle" else ".json"
                 ckpt_path = checkpoint_dir / f"ckpt_step_{step_no:09d}{ckpt_ext}"
+                flush_with_checkpoint = checkpoint_flush_streaming and streaming_state.enabled
                 try:
-                    state_ckpt = _build_checkpoint_state(step_no, time_after_step)
+                    if flush_with_checkpoint:
+                        # Chunks on disk then end at the checkpointed step.
+                        streaming_state.flush(history, step_no)
+                        steps_since_flush = 0
+                    state_ckpt = _build_checkpoint_state(step_no, step_end_time)
                     checkpoint_io.save_checkpoint(ckpt_path, state_ckpt, fmt=checkpoint_format)
                     checkpoint_io.prune_checkpoints(checkpoint_dir, checkpoint_keep_last)
                     checkpoint_next_time += checkpoint_interval_s
+                    if flush_with_checkpoint:
+                        streaming_state.write_partial_summary(
+                            _partial_summary_payload(step_no, step_end_time)
+                        )
                 except Exception as exc:
                     logger.error("Failed to write checkpoint %s: %s", ckpt_path, exc)
 
@@ -4762,8 +4901,16 @@ def run_zero_d(
                 )
 
             steps_since_flush += 1
-            if streaming_state.should_flush(history, steps_since_flush):
+            watchdog_actions = memory_watchdog.check(step_no) if memory_watchdog is not None else ()
+            if "raise_stride" in watchdog_actions:
+                psd_history_stride = memory_watchdog.psd_history_stride
+            if streaming_state.should_flush(history, steps_since_flush) or (
+                "flush" in watchdog_actions and streaming_state.enabled and steps_since_flush > 0
+            ):
                 streaming_state.flush(history, step_no)
+                streaming_state.write_partial_summary(
+                    _partial_summary_payload(step_no, step_end_time)
+                )
                 steps_since_flush = 0
 
 
@@ -4776,8 +4923,14 @@ def run_zero_d(
 
         final_step_index = last_step_index if last_step_index >= 0 else 0
         merge_status_message: Optional[str] = None
+        if step_diag_enabled:
+            step_diag_sampler.finalize(
+                anomaly=early_stop_reason
+                or ("mass_budget_violation" if history.mass_budget_violation is not None else None)
+            )
         if streaming_state.enabled:
             streaming_state.flush(history, final_step_index)
+            streaming_state.close_step_diagnostics()
 
         if orbit_rollup_enabled and not orbit_rollup_rows:
             # Fallback rollup for short integrations that do not complete a full orbit.
@@ -4860,10 +5013,13 @@ def run_zero_d(
                 step_diag_format=step_diag_format,
                 step_diag_path_cfg=step_diag_path_cfg,
                 step_diag_path=step_diag_path,
+                step_diag_compression=str(getattr(step_diag_cfg, "compression", "zstd") or "zstd"),
                 orbit_rollup_enabled=orbit_rollup_enabled,
                 extended_diag_enabled=extended_diag_enabled,
                 series_columns=series_columns,
                 diagnostic_columns=diagnostic_columns,
+                drop_extra_columns=output_selection.drop_extra_columns,
+                float32_columns=list(output_selection.float32_columns),
             )
         else:
             try:
@@ -5134,6 +5290,7 @@ def run_zero_d(
             "early_stop_time_s": early_stop_time_s,
             "stop_reason": "tau_exceeded" if early_stop_reason == "tau_exceeded" else None,
             "stop_tau_los": tau_stop_los_value if early_stop_reason == "tau_exceeded" else None,
+            "stop_events": stop_events.report(),
             "analysis_window_years_actual": total_time_elapsed / SECONDS_PER_YEAR if total_time_elapsed is not None else None,
             "beta_at_smin_min": beta_min,
             "beta_at_smin_median": beta_median,
@@ -5277,7 +5434,7 @@ def run_zero_d(
                 "run_chunks": [str(p) for p in streaming_state.run_chunks],
                 "psd_chunks": [str(p) for p in streaming_state.psd_chunks],
                 "diagnostics_chunks": [str(p) for p in streaming_state.diag_chunks],
-                "mass_budget_path": str(streaming_state.mass_budget_path if streaming_state.enabled else outdir / "checks" / "mass_budget.csv"),
+                "mass_budget_path": str(streaming_state.mass_budget_path),
                 "energy_streaming_enabled": energy_streaming_enabled,
                 "energy_streaming_config": bool(energy_streaming_cfg),
                 "energy_series_path": str(energy_series_path),
@@ -5375,24 +5532,21 @@ def run_zero_d(
             summary["M_loss_mean_per_orbit"] = (M_loss_cum + M_sink_cum) / orbits_completed
         if history.mass_budget_violation is not None:
             summary["mass_budget_violation"] = history.mass_budget_violation
+        if step_diag_enabled and step_diag_sampler.adaptive:
+            summary["step_diagnostics_sampling"] = step_diag_sampler.stats()
+        summary["summary_status"] = "complete"
         summary_path = outdir / "summary.json"
         writer.write_summary(summary, summary_path)
-        mass_budget_path = (
-            streaming_state.mass_budget_path if streaming_state.enabled else outdir / "checks" / "mass_budget.csv"
-        )
-        if streaming_state.enabled:
-            if mass_budget:
-                writer.append_csv(mass_budget, mass_budget_path, header=not mass_budget_path.exists())
-                mass_budget.clear()
-            if not mass_budget_path.exists():
-                if last_mass_budget_entry:
-                    pd.DataFrame(columns=list(last_mass_budget_entry.keys())).to_csv(
-                        mass_budget_path, index=False
-                    )
-                else:
-                    writer.write_mass_budget(mass_budget, mass_budget_path)
+        streaming_state.clear_partial_summary()
+        run_result.summary = summary
+        if mass_budget:
+            streaming_state.mass_budget_log.append(mass_budget)
+            mass_budget.clear()
+        streaming_state.close_mass_budget()
+        if last_mass_budget_entry:
+            streaming_state.mass_budget_log.ensure_exists(list(last_mass_budget_entry.keys()))
         else:
-            writer.write_mass_budget(mass_budget, mass_budget_path)
+            streaming_state.mass_budget_log.ensure_exists([])
         if orbit_rollup_enabled and streaming_state.enabled:
             writer.write_orbit_rollup(history.orbit_rollup_rows, outdir / "orbit_rollup.csv")
 
@@ -5573,6 +5727,12 @@ def run_zero_d(
         auto_tune_info = getattr(cfg, "_auto_tune_info", None)
         if auto_tune_info is not None:
             run_config["auto_tune"] = auto_tune_info
+        if placement_mod.placement_requested():
+            run_config["placement"] = placement_mod.current_affinity_report()
+        if memory_plan is not None:
+            run_config["memory_budget"] = memory_plan_mod.report(memory_plan, memory_watchdog)
+        run_config["smol_arena"] = smol.arena_stats()
+        run_config["radiation_driver"] = radiation_driver.stats()
         run_config["phase_temperature"] = {
             "mode": phase_temperature_input_mode,
             "q_abs_mean": phase_q_abs_mean,
@@ -5895,14 +6055,7 @@ def run_zero_d(
         run_card_path = outdir / "run_card.md"
         try:
             eb = summary.get("energy_bookkeeping", {})
-            try:
-                current_git_sha = (
-                    subprocess.check_output(["git", "rev-parse", "HEAD"], cwd=Path.cwd())
-                    .decode()
-                    .strip()
-                )
-            except Exception:
-                current_git_sha = "unknown"
+            current_git_sha = provenance_mod.git_info().get("commit") or "unknown"
             command_invoked = " ".join(sys.argv)
             rng_seed_resolved = getattr(cfg.initial, "rng_seed", None)
             numpy_version = np.__version__
@@ -6002,7 +6155,18 @@ def run_zero_d(
                         f"- suggested_sweep_jobs: {decision.get('suggested_sweep_jobs', 'unknown')}",
                     ]
                 )
-            run_card_path.write_text("\n".join(lines), encoding="utf-8")
+                calibration = auto_tune_info.get("calibration")
+                if isinstance(calibration, dict):
+                    lines.extend(
+                        [
+                            f"- calibration_key: {calibration.get('key')}",
+                            f"- calibration_cached: {calibration.get('cached')}",
+                            f"- cell_jobs: {decision.get('cell_jobs')}",
+                            f"- cell_chunk_size: {decision.get('cell_chunk_size')}",
+                            f"- seconds_per_cell_step: {calibration.get('seconds_per_cell_step')}",
+                        ]
+                    )
+            writer.write_text_atomic("\n".join(lines), run_card_path)
         except Exception as exc:  # pragma: no cover - best effort
             logger.warning("Failed to write run_card.md: %s", exc)
 
@@ -6041,6 +6205,7 @@ def run_zero_d(
 
 
     _finalize_zero_d_outputs()
+    return run_result
 
 
 def main(argv: Optional[List[str]] = None) -> None:
@@ -6103,9 +6268,17 @@ def main(argv: Optional[List[str]] = None) -> None:
     )
     parser.add_argument(
         "--auto-tune-profile",
-        choices=["auto", "light", "balanced", "throughput"],
+        choices=["auto", "light", "balanced", "throughput", "calibrate"],
         default="auto",
-        help="Select auto-tune profile when --auto-tune is enabled.",
+        help=(
+            "Select auto-tune profile when --auto-tune is enabled "
+            "(calibrate: benchmark Smol kernels at the configured n_bins and cache the optimum)."
+        ),
+    )
+    parser.add_argument(
+        "--auto-tune-recalibrate",
+        action="store_true",
+        help="Ignore the cached calibration and re-measure (with --auto-tune-profile calibrate).",
     )
     args = parser.parse_args(argv)
 
@@ -6117,11 +6290,25 @@ def main(argv: Optional[List[str]] = None) -> None:
         for group in args.override:
             override_list.extend(group)
     auto_tune_info = None
-    if args.auto_tune:
+    calibrate = args.auto_tune and args.auto_tune_profile == "calibrate"
+    if args.auto_tune and not calibrate:
         from .runtime import autotune as autotune_mod
 
         auto_tune_info = autotune_mod.apply_auto_tune(profile=args.auto_tune_profile)
     cfg = load_config(args.config, overrides=override_list)
+    if calibrate:
+        from .runtime import autotune as autotune_mod
+
+        # Calibration needs the grid shape, so it runs after the config is loaded.
+        n_cells = 1
+        if getattr(cfg.geometry, "mode", "0D") == "1D":
+            n_cells = int(getattr(cfg.geometry, "Nr", None) or 1)
+        auto_tune_info = autotune_mod.apply_auto_tune(
+            profile="calibrate",
+            n_bins=int(cfg.sizes.n_bins),
+            n_cells=n_cells,
+            recalibrate=bool(args.auto_tune_recalibrate),
+        )
     if auto_tune_info is not None:
         try:
             setattr(cfg, "_auto_tune_info", auto_tune_info)
@@ -6185,6 +6372,7 @@ __all__ = [
     "compute_phase_tau_fields",
     "StreamingState",
     "ZeroDHistory",
+    "ZeroDRunResult",
     "ProgressReporter",
     "RunConfig",
     "RunState",
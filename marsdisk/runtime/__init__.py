@@ -2,7 +2,7 @@
 
 from .progress import ProgressReporter
 from .autotune import apply_auto_tune, detect_machine_state
-from .history import ColumnarBuffer, ZeroDHistory
+from .history import ArrayColumnarBuffer, ColumnarBuffer, ZeroDHistory, ZeroDRunResult, new_record_buffer
 from .helpers import (
     ensure_finite_kappa,
     safe_float,
@@ -14,7 +14,10 @@ from .helpers import (
 __all__ = [
     "ProgressReporter",
     "ColumnarBuffer",
+    "ArrayColumnarBuffer",
+    "new_record_buffer",
     "ZeroDHistory",
+    "ZeroDRunResult",
     "apply_auto_tune",
     "detect_machine_state",
     "ensure_finite_kappa",
@@ -1,11 +1,17 @@
 """Runtime auto-tuning helpers (stdlib-first, psutil optional)."""
 from __future__ import annotations
 
-from dataclasses import dataclass, asdict
+from dataclasses import dataclass, asdict, field
+import json
+import logging
+import math
 import os
+from pathlib import Path
 import platform
+import socket
 import subprocess
-from typing import Any, Dict, Optional
+import time
+from typing import Any, Callable, Dict, List, Optional, Sequence, Tuple
 
 try:  # optional dependency
     import psutil  # type: ignore
@@ -15,7 +21,12 @@ except Exception:  # pragma: no cover - optional dependency
     _PSUTIL_AVAILABLE = False
 
 
-_PROFILE_CHOICES = ("auto", "light", "balanced", "throughput")
+logger = logging.getLogger(__name__)
+
+_PROFILE_CHOICES = ("auto", "light", "balanced", "throughput", "calibrate")
+CALIBRATION_CACHE_ENV = "MARSDISK_AUTOTUNE_CACHE"
+CALIBRATION_CACHE_VERSION = 1
+_DEFAULT_CALIBRATION_CACHE = Path.home() / ".cache" / "marsdisk" / "autotune_calibration.json"
 
 
 @dataclass
@@ -34,6 +45,7 @@ class MachineState:
     platform_system: str
     platform_machine: str
     psutil_available: bool
+    numa_node_cpus: Optional[List[List[int]]] = None
 
     def to_dict(self) -> Dict[str, Any]:
         return asdict(self)
@@ -48,6 +60,8 @@ class AutoTuneDecision:
     numba_threads: int
     numba_thread_source: str
     suggested_sweep_jobs: int
+    cell_jobs: Optional[int] = None
+    cell_chunk_size: Optional[int] = None
 
     def to_dict(self) -> Dict[str, Any]:
         return asdict(self)
@@ -99,6 +113,46 @@ def _job_core_budget(state: MachineState, cores: int) -> int:
     return cores
 
 
+_NUMA_SYSFS_ROOT = Path("/sys/devices/system/node")
+
+
+def parse_cpulist(text: str) -> List[int]:
+    """Parse a Linux cpulist string such as ``"0-3,8,10-11"``."""
+
+    cpus: List[int] = []
+    for part in text.strip().split(","):
+        part = part.strip()
+        if not part:
+            continue
+        if "-" in part:
+            lo, hi = part.split("-", 1)
+            cpus.extend(range(int(lo), int(hi) + 1))
+        else:
+            cpus.append(int(part))
+    return cpus
+
+
+def _detect_numa_nodes(root: Path = _NUMA_SYSFS_ROOT) -> Optional[List[List[int]]]:
+    """Return the CPUs of each NUMA node (Linux sysfs only)."""
+
+    try:
+        node_dirs = sorted(
+            (p for p in root.glob("node[0-9]*") if p.name[4:].isdigit()),
+            key=lambda p: int(p.name[4:]),
+        )
+    except OSError:
+        return None
+    nodes: List[List[int]] = []
+    for node_dir in node_dirs:
+        try:
+            cpus = parse_cpulist((node_dir / "cpulist").read_text())
+        except (OSError, ValueError):
+            continue
+        if cpus:
+            nodes.append(cpus)
+    return nodes or None
+
+
 def detect_machine_state() -> MachineState:
     """Collect a minimal machine state snapshot using stdlib first."""
 
@@ -149,6 +203,7 @@ def detect_machine_state() -> MachineState:
         platform_system=platform_system,
         platform_machine=platform.machine(),
         psutil_available=_PSUTIL_AVAILABLE,
+        numa_node_cpus=_detect_numa_nodes() if platform_system == "Linux" else None,
     )
 
 
@@ -219,55 +274,398 @@ def _suggest_sweep_jobs(cores: int, numba_threads: int) -> int:
     return max(1, cores // numba_threads)
 
 
-def _apply_numba_threads(numba_threads: int) -> Dict[str, Any]:
-    """Attempt to apply Numba thread count at runtime."""
+@dataclass
+class CalibrationResult:
+    """Measured optimum of the Smol kernel benchmark for one cache key."""
+
+    key: str
+    numba_threads: int
+    cell_jobs: int
+    cell_chunk_size: int
+    seconds_per_cell_step: float
+    baseline_seconds_per_cell_step: Optional[float]
+    trials: List[Dict[str, Any]] = field(default_factory=list)
+    measured_at: Optional[float] = None
+    cached: bool = False
+
+    def to_dict(self) -> Dict[str, Any]:
+        return asdict(self)
+
+
+def calibration_cache_path(path: Optional[os.PathLike[str] | str] = None) -> Path:
+    """Return the calibration cache path (``MARSDISK_AUTOTUNE_CACHE`` overrides)."""
+
+    if path is not None:
+        return Path(path)
+    env_path = os.environ.get(CALIBRATION_CACHE_ENV)
+    if env_path:
+        return Path(env_path)
+    return _DEFAULT_CALIBRATION_CACHE
+
+
+def smol_backend() -> str:
+    """Return the Smol backend currently in use (``numba`` or ``numpy``)."""
+
+    from ..physics import smol
+
+    status = smol.get_numba_status()
+    if status.get("use_numba") and not status.get("numba_failed"):
+        return "numba"
+    return "numpy"
+
+
+def calibration_key(
+    *,
+    n_bins: int,
+    n_cells: int,
+    backend: str,
+    host: Optional[str] = None,
+) -> str:
+    """Cache key for ``(host, n_bins, Nr, backend)``."""
+
+    host = host or socket.gethostname() or "unknown"
+    return f"{host}|n_bins={int(n_bins)}|Nr={int(n_cells)}|backend={backend}"
 
-    result: Dict[str, Any] = {"requested": numba_threads, "applied": None, "status": "skipped"}
+
+def _load_calibration_cache(path: Path) -> Dict[str, Any]:
+    try:
+        payload = json.loads(path.read_text(encoding="utf-8"))
+    except (OSError, ValueError):
+        return {}
+    if not isinstance(payload, dict) or payload.get("version") != CALIBRATION_CACHE_VERSION:
+        return {}
+    entries = payload.get("entries")
+    return entries if isinstance(entries, dict) else {}
+
+
+def _store_calibration(path: Path, result: CalibrationResult) -> None:
+    from ..io import writer
+
+    entries = _load_calibration_cache(path)
+    entry = result.to_dict()
+    entry.pop("cached", None)
+    entries[result.key] = entry
+    try:
+        writer.write_json_atomic(
+            {"version": CALIBRATION_CACHE_VERSION, "entries": entries}, path
+        )
+    except OSError as exc:
+        logger.warning("autotune: failed to write calibration cache %s: %s", path, exc)
+
+
+def _power_of_two_candidates(limit: int) -> List[int]:
+    values = []
+    value = 1
+    while value <= max(limit, 1):
+        values.append(value)
+        value *= 2
+    if limit > 1 and values[-1] != limit:
+        values.append(limit)
+    return values
+
+
+def _smol_benchmark_problem(n_bins: int) -> Tuple[Any, Any, Any, Any]:
+    """Synthetic Smol problem with the configured bin count."""
+
+    import numpy as np
+
+    n = max(int(n_bins), 2)
+    s = np.geomspace(1.0e-6, 1.0, n)
+    m = 4.0 / 3.0 * math.pi * 3000.0 * s**3
+    N = 1.0e3 * (s / s[0]) ** (-3.5)
+    C = 1.0e-12 * np.outer(N, N)
+    C = 0.5 * (C + C.T)
+    C[np.diag_indices(n)] *= 0.5
+    Y = np.zeros((n, n, n), dtype=float)
+    for i in range(n):
+        for j in range(n):
+            kmax = min(i, j) + 1
+            Y[:kmax, i, j] = 1.0 / kmax
+    return N, C, Y, m
+
+
+def _time_cell_sweep(
+    step: Callable[[int], None],
+    *,
+    n_cells: int,
+    cell_jobs: int,
+    chunk_size: int,
+    repeats: int,
+) -> float:
+    """Best-of-``repeats`` wall time for one step of all cells."""
+
+    from concurrent.futures import ThreadPoolExecutor
+
+    chunks = [range(start, min(start + chunk_size, n_cells)) for start in range(0, n_cells, chunk_size)]
+
+    def _run_chunk(indices: range) -> None:
+        for idx in indices:
+            step(idx)
+
+    best = math.inf
+    executor = ThreadPoolExecutor(max_workers=cell_jobs) if cell_jobs > 1 else None
+    try:
+        for _ in range(max(repeats, 1)):
+            start = time.perf_counter()
+            if executor is None:
+                for chunk in chunks:
+                    _run_chunk(chunk)
+            else:
+                list(executor.map(_run_chunk, chunks))
+            best = min(best, time.perf_counter() - start)
+    finally:
+        if executor is not None:
+            executor.shutdown(wait=True)
+    return best
+
+
+def calibrate_smol_kernels(
+    *,
+    n_bins: int,
+    n_cells: int = 1,
+    state: Optional[MachineState] = None,
+    thread_candidates: Optional[Sequence[int]] = None,
+    job_candidates: Optional[Sequence[int]] = None,
+    chunk_candidates: Optional[Sequence[int]] = None,
+    repeats: int = 3,
+    max_bench_cells: int = 32,
+    time_budget_s: float = 20.0,
+) -> CalibrationResult:
+    """Benchmark ``step_imex_bdf1_C3`` at ``n_bins`` and return the fastest setting.
+
+    Each candidate ``(numba_threads, cell_jobs, chunk_size)`` times one
+    IMEX step over ``min(n_cells, max_bench_cells)`` independent cells.
+    Combinations that oversubscribe the logical cores are skipped, and the
+    search stops once ``time_budget_s`` is spent (the best so far wins).
+    """
+
+    import numpy as np
+
+    from ..physics import smol
+
+    state = state or detect_machine_state()
+    logical = max(state.cpu_logical, 1)
+    n_cells = max(int(n_cells), 1)
+    bench_cells = min(n_cells, max(int(max_bench_cells), 1))
+    threads_list = list(thread_candidates or _power_of_two_candidates(_thread_core_budget(state)))
+    if n_cells > 1:
+        jobs_list = list(job_candidates or _power_of_two_candidates(min(logical, bench_cells)))
+    else:
+        jobs_list = [1]
+
+    N, C, Y, m = _smol_benchmark_problem(n_bins)
+    workspaces = [
+        smol.ImexWorkspace(gain=np.zeros_like(N), loss=np.zeros_like(N)) for _ in range(bench_cells)
+    ]
+
+    def _step(idx: int) -> None:
+        smol.step_imex_bdf1_C3(
+            N,
+            C,
+            Y,
+            None,
+            m,
+            None,
+            1.0,
+            mass_tol=math.inf,
+            workspace=workspaces[idx],
+        )
+
+    original_threads: Optional[int] = None
     try:
         import numba  # type: ignore
 
-        numba.set_num_threads(int(numba_threads))
-        result["applied"] = int(numba.get_num_threads())
-        result["status"] = "ok"
-    except Exception as exc:  # pragma: no cover - optional dependency
-        result["status"] = f"error: {exc!s}"
+        original_threads = int(numba.get_num_threads())
+    except Exception:  # pragma: no cover - optional dependency
+        numba = None  # type: ignore
+    if numba is None:
+        threads_list = [1]
+
+    # Warm-up compiles the JIT kernels outside the timed region.
+    _step(0)
+
+    trials: List[Dict[str, Any]] = []
+    deadline = time.perf_counter() + float(time_budget_s)
+    best: Optional[Dict[str, Any]] = None
+    baseline: Optional[float] = None
+    try:
+        for threads in threads_list:
+            if numba is not None:
+                try:
+                    numba.set_num_threads(int(threads))
+                except Exception:
+                    continue
+            for jobs in jobs_list:
+                if jobs > 1 and jobs * threads > logical:
+                    continue
+                auto_chunk = int(math.ceil(bench_cells / jobs))
+                if jobs == 1:
+                    chunks = [bench_cells]
+                else:
+                    chunks = sorted(
+                        {max(1, min(int(c), bench_cells)) for c in (chunk_candidates or (auto_chunk, 1))}
+                    )
+                for chunk in chunks:
+                    elapsed = _time_cell_sweep(
+                        _step, n_cells=bench_cells, cell_jobs=jobs, chunk_size=chunk, repeats=repeats
+                    )
+                    per_cell = elapsed / float(bench_cells)
+                    trial = {
+                        "numba_threads": int(threads),
+                        "cell_jobs": int(jobs),
+                        "cell_chunk_size": int(chunk),
+                        "seconds_per_cell_step": per_cell,
+                    }
+                    trials.append(trial)
+                    if baseline is None:
+                        baseline = per_cell
+                    if best is None or per_cell < best["seconds_per_cell_step"]:
+                        best = trial
+                    if time.perf_counter() > deadline:
+                        break
+                if time.perf_counter() > deadline:
+                    break
+            if time.perf_counter() > deadline:
+                logger.info("autotune: calibration time budget exhausted after %d trials", len(trials))
+                break
+    finally:
+        if numba is not None and original_threads is not None:
+            try:
+                numba.set_num_threads(original_threads)
+            except Exception:  # pragma: no cover - defensive
+                pass
+
+    assert best is not None
+    # Scale the measured chunk back to the real cell count.
+    chunk_size = int(best["cell_chunk_size"])
+    if chunk_size == int(math.ceil(bench_cells / best["cell_jobs"])):
+        chunk_size = int(math.ceil(n_cells / best["cell_jobs"]))
+    return CalibrationResult(
+        key="",
+        numba_threads=int(best["numba_threads"]),
+        cell_jobs=int(best["cell_jobs"]),
+        cell_chunk_size=chunk_size,
+        seconds_per_cell_step=float(best["seconds_per_cell_step"]),
+        baseline_seconds_per_cell_step=baseline,
+        trials=trials,
+        measured_at=time.time(),
+    )
+
+
+def resolve_calibration(
+    *,
+    n_bins: int,
+    n_cells: int = 1,
+    backend: Optional[str] = None,
+    cache_path: Optional[os.PathLike[str] | str] = None,
+    recalibrate: bool = False,
+    state: Optional[MachineState] = None,
+    **calibrate_kwargs: Any,
+) -> CalibrationResult:
+    """Return the cached optimum for this machine, measuring it when missing."""
+
+    backend = backend or smol_backend()
+    key = calibration_key(n_bins=n_bins, n_cells=n_cells, backend=backend)
+    path = calibration_cache_path(cache_path)
+    if not recalibrate:
+        entry = _load_calibration_cache(path).get(key)
+        if isinstance(entry, dict):
+            try:
+                return CalibrationResult(**{**entry, "key": key, "cached": True})
+            except TypeError:
+                logger.info("autotune: ignoring malformed calibration entry for %s", key)
+    result = calibrate_smol_kernels(n_bins=n_bins, n_cells=n_cells, state=state, **calibrate_kwargs)
+    result.key = key
+    _store_calibration(path, result)
     return result
 
 
+def _apply_numba_threads(numba_threads: int) -> Dict[str, Any]:
+    """Attempt to apply Numba thread count at runtime."""
+
+    from .thread_budget import set_numba_threads
+
+    return set_numba_threads(numba_threads)
+
+
 def apply_auto_tune(
     *,
     profile: str = "auto",
     env: Optional[Dict[str, str]] = None,
+    n_bins: Optional[int] = None,
+    n_cells: int = 1,
+    backend: Optional[str] = None,
+    cache_path: Optional[os.PathLike[str] | str] = None,
+    recalibrate: bool = False,
 ) -> Dict[str, Any]:
-    """Apply auto-tuning decisions and return a structured report."""
+    """Apply auto-tuning decisions and return a structured report.
+
+    ``profile="calibrate"`` replaces the core-count heuristics with measured
+    Smol kernel timings at ``n_bins`` (see :func:`resolve_calibration`).  The
+    result is cached per ``(host, n_bins, Nr, backend)``; the chosen cell
+    jobs / chunk size are exported as ``MARSDISK_CELL_JOBS`` /
+    ``MARSDISK_CELL_CHUNK_SIZE`` unless already set.
+    """
 
     state = detect_machine_state()
-    resolved_profile = _resolve_profile(state, profile)
+    env = env if env is not None else os.environ
+    calibration: Optional[CalibrationResult] = None
+    if profile == "calibrate":
+        if n_bins is None:
+            raise ValueError("apply_auto_tune(profile='calibrate') requires n_bins")
+        calibration = resolve_calibration(
+            n_bins=n_bins,
+            n_cells=n_cells,
+            backend=backend,
+            cache_path=cache_path,
+            recalibrate=recalibrate,
+            state=state,
+        )
+        resolved_profile = "calibrate"
+    else:
+        resolved_profile = _resolve_profile(state, profile)
     cores = state.cpu_physical or state.cpu_logical
     thread_cores = _thread_core_budget(state)
-    numba_threads = _profile_threads(resolved_profile, thread_cores, state.platform_system)
+    if calibration is not None:
+        numba_threads = calibration.numba_threads
+    else:
+        numba_threads = _profile_threads(resolved_profile, thread_cores, state.platform_system)
 
-    env = env if env is not None else os.environ
     env_numba = env.get("NUMBA_NUM_THREADS")
     if env_numba is not None:
         numba_threads = _safe_int(env_numba, numba_threads)
         numba_source = "env"
     else:
         env["NUMBA_NUM_THREADS"] = str(numba_threads)
-        numba_source = "auto"
+        numba_source = "calibrated" if calibration is not None else "auto"
+
+    cell_jobs = None
+    cell_chunk_size = None
+    if calibration is not None and n_cells > 1:
+        cell_jobs = _safe_int(env.get("MARSDISK_CELL_JOBS"), calibration.cell_jobs)
+        cell_chunk_size = _safe_int(env.get("MARSDISK_CELL_CHUNK_SIZE"), calibration.cell_chunk_size)
+        env.setdefault("MARSDISK_CELL_JOBS", str(cell_jobs))
+        env.setdefault("MARSDISK_CELL_CHUNK_SIZE", str(cell_chunk_size))
 
     decision = AutoTuneDecision(
         profile_requested=profile,
         profile_resolved=resolved_profile,
         numba_threads=numba_threads,
         numba_thread_source=numba_source,
-        suggested_sweep_jobs=_suggest_sweep_jobs(_job_core_budget(state, cores), numba_threads),
+        suggested_sweep_jobs=_suggest_sweep_jobs(
+            _job_core_budget(state, cores), numba_threads * (cell_jobs or 1)
+        ),
+        cell_jobs=cell_jobs,
+        cell_chunk_size=cell_chunk_size,
     )
 
     numba_apply = _apply_numba_threads(numba_threads)
-    return {
+    report = {
         "enabled": True,
         "machine": state.to_dict(),
         "decision": decision.to_dict(),
         "numba": numba_apply,
     }
+    if calibration is not None:
+        report["calibration"] = calibration.to_dict()
+    return report
@@ -0,0 +1,170 @@
+"""Event engine for early termination and cell retirement.
+
+Stop conditions (``optical_depth.tau_stop``, ``numerics.mass_loss_rate_stop_Mmars_s``,
+``numerics.stop_on_blowout_below_smin`` and the 1D inert-cell retirement)
+are registered once with a threshold and a direction; the runners feed one
+scalar per subject (the 0D run is a single subject, 1D runs use one subject
+per radial cell) and act on the returned :class:`EventHit`.
+
+Predicates keep the comparison the runners always used: ``"above"`` fires
+on a strict exceedance (``value > threshold``) and ``"below"`` fires on
+reaching the threshold (``value <= threshold``).  When ``locate`` is set and
+the previous sample of the same subject lay on the other side, the crossing
+time is placed by linear interpolation between the two samples; the step
+time itself stays the time the runner acts on, so outputs do not move.
+
+A terminal event retires its subject.  ``active`` is exposed as a plain
+boolean array so the 1D runner can keep using it as ``cell_active``.
+Cell workers may observe distinct subjects concurrently; per-subject state
+is indexed by subject and the shared hit log is guarded by a lock.
+"""
+from __future__ import annotations
+
+import math
+import threading
+from dataclasses import asdict, dataclass
+from typing import Any, Dict, List, Optional
+
+import numpy as np
+
+EVENT_DIRECTIONS = ("above", "below")
+MAX_EVENT_LOG = 256
+
+
+@dataclass(frozen=True)
+class EventSpec:
+    name: str
+    threshold: float
+    direction: str = "above"
+    terminal: bool = True
+    locate: bool = True
+
+
+@dataclass(frozen=True)
+class EventHit:
+    name: str
+    subject: int
+    time: float
+    t_cross: float
+    value: float
+    threshold: float
+
+
+class EventEngine:
+    """Evaluate registered stop predicates and track retired subjects."""
+
+    def __init__(self, n_subjects: int = 1) -> None:
+        self.n_subjects = max(int(n_subjects), 1)
+        self.active = np.ones(self.n_subjects, dtype=bool)
+        self.retire_reason: List[Optional[str]] = [None] * self.n_subjects
+        self.specs: Dict[str, EventSpec] = {}
+        self._prev_time: Dict[str, np.ndarray] = {}
+        self._prev_value: Dict[str, np.ndarray] = {}
+        self.hits: List[EventHit] = []
+        self.hit_counts: Dict[str, int] = {}
+        self._lock = threading.Lock()
+
+    def register(
+        self,
+        name: str,
+        *,
+        threshold: float,
+        direction: str = "above",
+        terminal: bool = True,
+        locate: bool = True,
+    ) -> EventSpec:
+        if direction not in EVENT_DIRECTIONS:
+            raise ValueError(f"Unknown event direction: {direction!r}")
+        threshold = float(threshold)
+        if not math.isfinite(threshold):
+            raise ValueError(f"Event {name!r} needs a finite threshold")
+        spec = EventSpec(
+            name=str(name),
+            threshold=threshold,
+            direction=direction,
+            terminal=bool(terminal),
+            locate=bool(locate),
+        )
+        self.specs[spec.name] = spec
+        self._prev_time[spec.name] = np.full(self.n_subjects, np.nan)
+        self._prev_value[spec.name] = np.full(self.n_subjects, np.nan)
+        self.hit_counts[spec.name] = 0
+        return spec
+
+    def __contains__(self, name: str) -> bool:
+        return name in self.specs
+
+    @staticmethod
+    def _fires(spec: EventSpec, value: float) -> bool:
+        if spec.direction == "above":
+            return value > spec.threshold
+        return value <= spec.threshold
+
+    def observe(self, name: str, time: float, value: float, subject: int = 0) -> Optional[EventHit]:
+        """Feed ``value`` at ``time``; return a hit when the predicate fires."""
+
+        spec = self.specs.get(name)
+        if spec is None:
+            return None
+        value = float(value)
+        if not math.isfinite(value):
+            return None
+        prev_t = self._prev_time[name]
+        prev_v = self._prev_value[name]
+        if not self._fires(spec, value):
+            prev_t[subject] = time
+            prev_v[subject] = value
+            return None
+
+        t_cross = float(time)
+        t0 = float(prev_t[subject])
+        v0 = float(prev_v[subject])
+        if spec.locate and math.isfinite(t0) and math.isfinite(v0) and value != v0 and t0 < time:
+            frac = (spec.threshold - v0) / (value - v0)
+            if 0.0 <= frac <= 1.0:
+                t_cross = t0 + frac * (float(time) - t0)
+        hit = EventHit(
+            name=name,
+            subject=int(subject),
+            time=float(time),
+            t_cross=t_cross,
+            value=value,
+            threshold=spec.threshold,
+        )
+        prev_t[subject] = time
+        prev_v[subject] = value
+        with self._lock:
+            self.hit_counts[name] += 1
+            if len(self.hits) < MAX_EVENT_LOG:
+                self.hits.append(hit)
+        if spec.terminal:
+            self.retire(subject, name)
+        return hit
+
+    def retire(self, subject: int, reason: str) -> None:
+        if self.active[subject]:
+            self.active[subject] = False
+            self.retire_reason[subject] = reason
+
+    @property
+    def n_active(self) -> int:
+        return int(np.count_nonzero(self.active))
+
+    @property
+    def all_retired(self) -> bool:
+        return not bool(np.any(self.active))
+
+    def retired_by(self, reason: str) -> int:
+        return sum(1 for value in self.retire_reason if value == reason)
+
+    def report(self) -> Dict[str, Any]:
+        return {
+            "events": {name: asdict(spec) for name, spec in self.specs.items()},
+            "hit_counts": dict(self.hit_counts),
+            "hits": [asdict(hit) for hit in self.hits],
+            "subjects": int(self.n_subjects),
+            "subjects_active": self.n_active,
+        }
+
+
+__all__ = ["EVENT_DIRECTIONS", "EventEngine", "EventHit", "EventSpec"]
@@ -2,9 +2,11 @@
 
 from __future__ import annotations
 
+import threading
 from dataclasses import dataclass, field
 from typing import Any, Dict, Iterable, List, Mapping, Optional
 
+import numpy as np
 import pyarrow as pa
 
 
@@ -58,6 +60,9 @@ class ColumnarBuffer:
             raise ValueError("Cannot extend ColumnarBuffer with itself")
         if other.row_count == 0:
             return
+        if type(other) is not ColumnarBuffer:
+            self.extend_rows(other.to_records())
+            return
         for key in other._column_order:
             if key not in self._columns:
                 self._columns[key] = [None] * self._row_count
@@ -113,6 +118,352 @@ class ColumnarBuffer:
         return pa.Table.from_pydict(data)
 
 
+_KIND_FLOAT = "float"
+_KIND_INT = "int"
+_KIND_BOOL = "bool"
+_KIND_OBJECT = "object"
+_KIND_DTYPES = {
+    _KIND_FLOAT: np.float64,
+    _KIND_INT: np.int64,
+    _KIND_BOOL: np.bool_,
+}
+
+
+def _value_kind(value: Any) -> str:
+    if isinstance(value, (bool, np.bool_)):
+        return _KIND_BOOL
+    if isinstance(value, (int, np.integer)):
+        return _KIND_INT
+    if isinstance(value, (float, np.floating)):
+        return _KIND_FLOAT
+    return _KIND_OBJECT
+
+
+class ArrayColumnarBuffer(ColumnarBuffer):
+    """Column buffer backed by preallocated NumPy arrays.
+
+    Numeric and boolean columns live in growable NumPy arrays plus a validity
+    mask; :meth:`to_table` wraps them as Arrow arrays without copying the data
+    buffers.  Strings and other rare payloads fall back to Python lists.
+    :meth:`clear` only rewinds the write cursor so the storage is reused as a
+    ring across streaming flushes; tables returned by :meth:`to_table` are
+    therefore only valid until the next write after a ``clear``.
+
+    Besides the record-dict API, callers can :meth:`reserve_rows` a block and
+    fill it with :meth:`write_rows` / :meth:`write_column`, which lets the 1D
+    cell workers write each batch of cells straight into their row slots.
+    """
+
+    def __init__(self, columns: Iterable[str] | None = None, *, capacity: int = 1024) -> None:
+        self._capacity = max(int(capacity), 1)
+        self._kinds: Dict[str, Optional[str]] = {}
+        self._data: Dict[str, Any] = {}
+        self._valid: Dict[str, np.ndarray] = {}
+        self._lock = threading.Lock()
+        super().__init__(columns)
+        for name in self._column_order:
+            self._kinds[name] = None
+            self._valid[name] = np.zeros(self._capacity, dtype=bool)
+        self._columns = {}
+
+    @property
+    def capacity(self) -> int:
+        return self._capacity
+
+    def _grow(self, required: int) -> None:
+        new_capacity = self._capacity
+        while new_capacity < required:
+            new_capacity *= 2
+        if new_capacity == self._capacity:
+            return
+        for name, valid in self._valid.items():
+            grown = np.zeros(new_capacity, dtype=bool)
+            grown[: self._row_count] = valid[: self._row_count]
+            self._valid[name] = grown
+            kind = self._kinds.get(name)
+            if kind in _KIND_DTYPES:
+                data = np.zeros(new_capacity, dtype=_KIND_DTYPES[kind])
+                data[: self._row_count] = self._data[name][: self._row_count]
+                self._data[name] = data
+            elif kind == _KIND_OBJECT:
+                self._data[name].extend([None] * (new_capacity - self._capacity))
+        self._capacity = new_capacity
+
+    def _add_column(self, name: str) -> None:
+        self._kinds[name] = None
+        self._valid[name] = np.zeros(self._capacity, dtype=bool)
+        self._column_order.append(name)
+
+    def _set_kind(self, name: str, kind: str) -> None:
+        """Allocate or promote storage for ``name`` so it can hold ``kind``."""
+
+        current = self._kinds.get(name)
+        if current == kind or current == _KIND_OBJECT:
+            return
+        if current is None:
+            target = kind
+        elif {current, kind} == {_KIND_INT, _KIND_FLOAT}:
+            target = _KIND_FLOAT
+        else:
+            target = _KIND_OBJECT
+        if target == current:
+            return
+        rows = self._row_count
+        valid = self._valid[name]
+        if target == _KIND_OBJECT:
+            old = self._data.get(name)
+            values: List[Any] = [None] * self._capacity
+            if old is not None:
+                for idx in np.flatnonzero(valid[:rows]):
+                    values[idx] = old[idx].item()
+            self._data[name] = values
+        else:
+            data = np.zeros(self._capacity, dtype=_KIND_DTYPES[target])
+            old = self._data.get(name)
+            if old is not None:
+                data[:rows] = old[:rows]
+            self._data[name] = data
+        self._kinds[name] = target
+
+    def _store(self, name: str, row: int, value: Any) -> None:
+        if name not in self._kinds:
+            self._add_column(name)
+        if value is None:
+            self._valid[name][row] = False
+            return
+        kind = _value_kind(value)
+        current = self._kinds[name]
+        if current != kind and not (current == _KIND_FLOAT and kind == _KIND_INT):
+            self._set_kind(name, kind)
+        self._data[name][row] = value
+        self._valid[name][row] = True
+
+    def columns(self) -> List[str]:
+        return list(self._column_order)
+
+    def reserve_rows(self, count: int) -> int:
+        """Append ``count`` all-null rows and return the index of the first."""
+
+        count = int(count)
+        with self._lock:
+            start = self._row_count
+            stop = start + count
+            if stop > self._capacity:
+                self._grow(stop)
+            for valid in self._valid.values():
+                valid[start:stop] = False
+            self._row_count = stop
+        return start
+
+    def write_row(self, row: int, record: Mapping[str, Any]) -> None:
+        """Fill an already reserved row from a record mapping."""
+
+        if row < 0 or row >= self._row_count:
+            raise IndexError(f"row {row} outside reserved range [0, {self._row_count})")
+        with self._lock:
+            for key, value in record.items():
+                self._store(key, row, value)
+
+    def write_column(self, name: str, start: int, values: Any) -> None:
+        """Copy a NumPy/sequence block into ``name`` starting at ``start``."""
+
+        arr = np.asarray(values)
+        stop = start + arr.shape[0]
+        if stop > self._row_count:
+            raise IndexError(f"rows [{start}, {stop}) exceed reserved range {self._row_count}")
+        kind = _KIND_BOOL if arr.dtype == np.bool_ else _KIND_INT if arr.dtype.kind in "iu" else _KIND_FLOAT
+        if arr.dtype.kind not in "biuf":
+            kind = _KIND_OBJECT
+        with self._lock:
+            if name not in self._kinds:
+                self._add_column(name)
+            self._set_kind(name, kind)
+            data = self._data[name]
+            if self._kinds[name] == _KIND_OBJECT:
+                for offset, value in enumerate(arr.tolist()):
+                    data[start + offset] = value
+                self._valid[name][start:stop] = [v is not None for v in arr.tolist()]
+            else:
+                data[start:stop] = arr
+                self._valid[name][start:stop] = True
+
+    def write_rows(self, start: int, records: List[Mapping[str, Any]]) -> None:
+        """Fill reserved rows ``[start, start + len(records))`` column by column.
+
+        Keys whose non-null values share one numeric, boolean or string kind
+        are copied with a single :meth:`write_column` per key; keys with mixed
+        kinds (or other payloads) fall back to :meth:`write_row`.
+        """
+
+        if not records:
+            return
+        stop = start + len(records)
+        if start < 0 or stop > self._row_count:
+            raise IndexError(f"rows [{start}, {stop}) exceed reserved range {self._row_count}")
+        names: Dict[str, None] = {}
+        for record in records:
+            names.update(dict.fromkeys(record))
+        with self._lock:
+            for name in names:
+                if name not in self._kinds:
+                    self._add_column(name)
+        optional: List[str] = []
+        for name in names:
+            values = [record.get(name) for record in records]
+            missing = [offset for offset, value in enumerate(values) if value is None]
+            kinds = {_value_kind(value) for value in values if value is not None}
+            if not kinds:
+                continue
+            if kinds <= {_KIND_INT, _KIND_FLOAT} or kinds == {_KIND_BOOL}:
+                if missing:
+                    fill = False if kinds == {_KIND_BOOL} else 0
+                    values = [fill if value is None else value for value in values]
+                self.write_column(name, start, values)
+                if missing:
+                    with self._lock:
+                        self._valid[name][[start + offset for offset in missing]] = False
+            elif all(value is None or isinstance(value, str) for value in values):
+                self.write_column(name, start, np.asarray(values, dtype=object))
+            else:
+                optional.append(name)
+        if optional:
+            for offset, record in enumerate(records):
+                self.write_row(start + offset, {name: record.get(name) for name in optional})
+
+    def set_column_range(self, name: str, start: int, stop: int, value: Any) -> None:
+        """Broadcast a scalar (or None) over rows ``[start, stop)``."""
+
+        with self._lock:
+            if name not in self._kinds:
+                self._add_column(name)
+            if value is None:
+                self._valid[name][start:stop] = False
+                return
+            self._set_kind(name, _value_kind(value))
+            self._data[name][start:stop] = [value] * (stop - start) if self._kinds[name] == _KIND_OBJECT else value
+            self._valid[name][start:stop] = True
+
+    def append_row(self, record: Mapping[str, Any]) -> None:
+        if record is None:
+            return
+        if not isinstance(record, Mapping):
+            record = dict(record)
+        row = self.reserve_rows(1)
+        self.write_row(row, record)
+
+    def extend_buffer(self, other: "ColumnarBuffer") -> None:
+        if other is self:
+            raise ValueError("Cannot extend ColumnarBuffer with itself")
+        if other.row_count == 0:
+            return
+        if not isinstance(other, ArrayColumnarBuffer):
+            self.extend_rows(other.to_records())
+            return
+        rows = other.row_count
+        start = self.reserve_rows(rows)
+        stop = start + rows
+        for name in other._column_order:
+            kind = other._kinds.get(name)
+            with self._lock:
+                if name not in self._kinds:
+                    self._add_column(name)
+                if kind is None:
+                    continue
+                self._set_kind(name, kind)
+                src_valid = other._valid[name][:rows]
+                self._valid[name][start:stop] = src_valid
+                if self._kinds[name] == _KIND_OBJECT:
+                    dest = self._data[name]
+                    src = other._data[name]
+                    for offset in range(rows):
+                        if src_valid[offset]:
+                            value = src[offset]
+                            dest[start + offset] = value.item() if isinstance(value, np.generic) else value
+                else:
+                    self._data[name][start:stop] = other._data[name][:rows]
+
+    def set_column_constant(self, name: str, value: Any) -> None:
+        self.set_column_range(name, 0, self._row_count, value)
+
+    def clear(self) -> None:
+        self._row_count = 0
+
+    def _column_pylist(self, name: str) -> List[Any]:
+        rows = self._row_count
+        kind = self._kinds.get(name)
+        if name not in self._kinds or kind is None:
+            return [None] * rows
+        valid = self._valid[name][:rows]
+        if kind == _KIND_OBJECT:
+            data = self._data[name]
+            return [data[idx] if valid[idx] else None for idx in range(rows)]
+        values = self._data[name][:rows].tolist()
+        if not valid.all():
+            for idx in np.flatnonzero(~valid):
+                values[idx] = None
+        return values
+
+    def to_records(self) -> List[Dict[str, Any]]:
+        columns = {name: self._column_pylist(name) for name in self._column_order}
+        return [
+            {name: values[idx] for name, values in columns.items()}
+            for idx in range(self._row_count)
+        ]
+
+    def _column_array(self, name: str) -> pa.Array:
+        rows = self._row_count
+        kind = self._kinds.get(name)
+        if kind is None:
+            return pa.nulls(rows)
+        if kind == _KIND_OBJECT:
+            return pa.array(self._column_pylist(name))
+        data = self._data[name][:rows]
+        valid = self._valid[name][:rows]
+        if kind == _KIND_BOOL:
+            return pa.array(data, mask=~valid)
+        if valid.all():
+            return pa.array(data)
+        bitmap = pa.py_buffer(np.packbits(valid, bitorder="little"))
+        arrow_type = pa.from_numpy_dtype(data.dtype)
+        return pa.Array.from_buffers(
+            arrow_type,
+            rows,
+            [bitmap, pa.py_buffer(data)],
+            null_count=int(rows - np.count_nonzero(valid)),
+        )
+
+    def to_table(self, ensure_columns: Iterable[str] | None = None) -> pa.Table:
+        ensure_list = list(ensure_columns) if ensure_columns is not None else []
+        ensure_set = set(ensure_list)
+        ordered_names: List[str] = list(ensure_list)
+        ordered_names.extend(name for name in self._column_order if name not in ensure_set)
+        arrays = []
+        for name in ordered_names:
+            if name in self._kinds:
+                arrays.append(self._column_array(name))
+            else:
+                arrays.append(pa.nulls(self._row_count))
+        return pa.Table.from_arrays(arrays, names=ordered_names)
+
+
+RECORD_STORAGE_MODES = ("row", "columnar", "array")
+ARRAY_BUFFER_MAX_CAPACITY = 1 << 16
+
+
+def new_record_buffer(mode: str, *, rows_hint: int = 1024) -> ColumnarBuffer:
+    """Return the columnar buffer class matching ``io.record_storage_mode``.
+
+    ``rows_hint`` sizes the initial allocation of array-backed buffers (rows
+    expected between flushes); it is capped so huge flush intervals do not
+    pre-commit memory that may never be used.
+    """
+
+    if mode == "array":
+        capacity = min(max(int(rows_hint), 1), ARRAY_BUFFER_MAX_CAPACITY)
+        return ArrayColumnarBuffer(capacity=capacity)
+    return ColumnarBuffer()
+
+
 @dataclass
 class ZeroDHistory:
     """Per-step history bundle used by the full-feature zero-D driver."""
@@ -137,3 +488,33 @@ class ZeroDHistory:
     violation_triggered: bool = False
     tau_gate_block_time: float = 0.0
     total_time_elapsed: float = 0.0
+
+
+@dataclass
+class ZeroDRunResult:
+    """In-memory outcome of :func:`marsdisk.run.run_zero_d`.
+
+    Holds the summary payload plus the first and last mass-budget and
+    step-diagnostics rows, so callers that aggregate many runs do not need
+    to read ``summary.json`` or ``checks/mass_budget.csv`` back from disk.
+    ``collision_cache`` records how the collision caches were carried over
+    from the previous run in this process (see ``numerics.collision_cache``).
+    """
+
+    outdir: Any = None
+    summary: Dict[str, Any] = field(default_factory=dict)
+    mass_budget_first: Optional[Mapping[str, Any]] = None
+    mass_budget_last: Optional[Mapping[str, Any]] = None
+    step_diag_first: Optional[Mapping[str, Any]] = None
+    step_diag_last: Optional[Mapping[str, Any]] = None
+    collision_cache: str = "off"
+
+    def record_mass_budget(self, entry: Mapping[str, Any]) -> None:
+        if self.mass_budget_first is None:
+            self.mass_budget_first = dict(entry)
+        self.mass_budget_last = entry
+
+    def record_step_diag(self, entry: Mapping[str, Any]) -> None:
+        if self.step_diag_first is None:
+            self.step_diag_first = dict(entry)
+        self.step_diag_last = entry
@@ -0,0 +1,523 @@
+"""Memory budget planner and runtime watchdog.
+
+``io.memory_budget.enable=true`` sizes the memory-hungry knobs of a run
+before the first step so that the estimated footprint
+
+    baseline RSS + collision caches + cell-worker temporaries + output buffers
+
+stays below ``budget * headroom_fraction``.  The budget is
+``io.memory_budget.budget_gb`` or, when unset, the cgroup memory limit
+(physical memory outside a container).  The planner, in order:
+
+1. shrinks the collision cache ``size_scale`` (down to ``min_cache_scale``)
+   and then the number of cell workers until caches and workers take at most
+   half of the usable memory;
+2. gives the rest to the output buffers: ``io.streaming.step_flush_interval``
+   and ``memory_limit_gb`` are lowered so a full buffer fits, and the PSD
+   history stride is doubled when the flush interval would fall below
+   ``min_flush_interval`` (or, with streaming off, until the whole history
+   fits).
+
+Per-row costs are the ones used by :func:`marsdisk.orchestrator.memory_estimate`
+and :class:`marsdisk.io.streaming.StreamingState`, so the plan and the flush
+trigger agree.
+
+The plan is advisory: when even the most degraded settings do not fit,
+the run still starts with them and only a warning is logged (``fits`` in
+the run-config report records this).  Nothing is killed or refused.
+
+Python does not give freed memory back reliably, so the estimate can drift
+from the real RSS.  :class:`MemoryWatchdog` samples the RSS every
+``watchdog_interval_steps`` steps; above the planned limit it requests a
+streaming flush and, if the next check is still above, escalates by halving
+the collision cache scale and then doubling the PSD history stride.
+"""
+from __future__ import annotations
+
+import gc
+import logging
+import os
+import sys
+from dataclasses import asdict, dataclass, field
+from pathlib import Path
+from typing import Any, Callable, Dict, List, Optional, Tuple
+
+from ..io.streaming import MEMORY_DIAG_ROW_BYTES, MEMORY_PSD_ROW_BYTES, MEMORY_RUN_ROW_BYTES
+from ..physics import collisions_smol
+
+logger = logging.getLogger(__name__)
+
+CGROUP_ROOT = Path("/sys/fs/cgroup")
+# Caches and cell-worker temporaries may take at most this share of the
+# usable memory; the remainder is reserved for output buffers.
+FIXED_SHARE = 0.5
+# cgroup v1 reports "unlimited" as a page-aligned value close to 2**63.
+_CGROUP_UNLIMITED = 1 << 60
+
+
+def _read_text(path: Path) -> Optional[str]:
+    try:
+        return path.read_text(encoding="utf-8").strip()
+    except OSError:
+        return None
+
+
+def _parse_limit(text: Optional[str]) -> Optional[int]:
+    if not text or text == "max":
+        return None
+    try:
+        value = int(text)
+    except ValueError:
+        return None
+    if value <= 0 or value >= _CGROUP_UNLIMITED:
+        return None
+    return value
+
+
+def _cgroup_limit(root: Path) -> Optional[int]:
+    candidates: List[Path] = []
+    membership = _read_text(Path("/proc/self/cgroup")) or ""
+    for line in membership.splitlines():
+        parts = line.split(":", 2)
+        if len(parts) != 3:
+            continue
+        rel = parts[2].lstrip("/")
+        if parts[0] == "0" and parts[1] == "":
+            candidates.append(root / rel / "memory.max")
+        elif "memory" in parts[1].split(","):
+            candidates.append(root / "memory" / rel / "memory.limit_in_bytes")
+    candidates += [root / "memory.max", root / "memory" / "memory.limit_in_bytes"]
+    for path in candidates:
+        limit = _parse_limit(_read_text(path))
+        if limit is not None:
+            return limit
+    return None
+
+
+def _physical_memory() -> Optional[int]:
+    meminfo = _read_text(Path("/proc/meminfo"))
+    if meminfo:
+        for line in meminfo.splitlines():
+            if line.startswith("MemTotal:"):
+                try:
+                    return int(line.split()[1]) * 1024
+                except (IndexError, ValueError):
+                    break
+    try:
+        return int(os.sysconf("SC_PAGE_SIZE")) * int(os.sysconf("SC_PHYS_PAGES"))
+    except (AttributeError, ValueError, OSError):
+        pass
+    try:
+        import psutil  # type: ignore
+    except ImportError:
+        return None
+    try:
+        return int(psutil.virtual_memory().total)
+    except Exception:
+        return None
+
+
+def detect_memory_limit(root: Path = CGROUP_ROOT) -> Tuple[Optional[int], str]:
+    """Return ``(bytes, source)`` of the tightest of cgroup limit and physical memory."""
+
+    cgroup = _cgroup_limit(Path(root))
+    physical = _physical_memory()
+    if cgroup is not None and (physical is None or cgroup <= physical):
+        return cgroup, "cgroup"
+    if physical is not None:
+        return physical, "physical"
+    return None, "unknown"
+
+
+def current_rss_bytes() -> int:
+    """Resident set size of this process.
+
+    Uses /proc where available, then the peak RSS from :mod:`resource`
+    (Unix only), then psutil; returns 0 when none of them is available.
+    """
+
+    statm = _read_text(Path("/proc/self/statm"))
+    if statm:
+        try:
+            return int(statm.split()[1]) * int(os.sysconf("SC_PAGE_SIZE"))
+        except (IndexError, ValueError, OSError, AttributeError):
+            pass
+    try:
+        import resource
+    except ImportError:  # Windows
+        pass
+    else:
+        peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+        # ru_maxrss is in kilobytes on Linux and bytes on macOS.
+        return int(peak) if sys.platform == "darwin" else int(peak) * 1024
+    try:
+        import psutil  # type: ignore
+    except ImportError:
+        return 0
+    try:
+        return int(psutil.Process().memory_info().rss)
+    except Exception:
+        return 0
+
+
+def smol_worker_bytes(n_bins: int) -> float:
+    """Upper bound of the Smol step temporaries held by one cell worker.
+
+    A fragment tensor plus its workspace copy (``n_bins**3``) and the kernel,
+    Q_D*, velocity and weights matrices (``n_bins**2``).
+    """
+
+    n = max(int(n_bins), 0)
+    return 8.0 * (2 * n**3 + 8 * n**2)
+
+
+@dataclass
+class MemoryRequest:
+    """Run shape and requested settings the planner starts from."""
+
+    n_steps: int
+    n_bins: int
+    n_cells: int = 1
+    cell_jobs: int = 1
+    cache_scale: float = 1.0
+    streaming_enabled: bool = True
+    step_flush_interval: int = 10000
+    memory_limit_gb: float = 10.0
+    series_stride: int = 1
+    diagnostics_enabled: bool = True
+    diagnostics_stride: int = 1
+    psd_history_enabled: bool = True
+    psd_history_stride: int = 1
+    mass_budget_cells_enabled: bool = False
+    step_diag_enabled: bool = False
+
+
+def buffer_bytes_per_step(req: MemoryRequest, psd_history_stride: Optional[int] = None) -> float:
+    """Buffered output bytes added by one step (upper bound, strides rounded up)."""
+
+    cells = max(int(req.n_cells), 1)
+    stride = max(int(psd_history_stride or req.psd_history_stride), 1)
+    total = cells / max(int(req.series_stride), 1) * MEMORY_RUN_ROW_BYTES
+    if req.diagnostics_enabled:
+        total += cells / max(int(req.diagnostics_stride), 1) * MEMORY_DIAG_ROW_BYTES
+    if req.psd_history_enabled and req.n_bins > 0:
+        total += req.n_bins * cells / stride * MEMORY_PSD_ROW_BYTES
+    total += MEMORY_RUN_ROW_BYTES
+    if req.mass_budget_cells_enabled:
+        total += cells * MEMORY_RUN_ROW_BYTES
+    if req.step_diag_enabled:
+        total += MEMORY_DIAG_ROW_BYTES
+    return total
+
+
+@dataclass
+class MemoryPlan:
+    """Settings chosen by :func:`plan_memory` and the footprint they imply."""
+
+    budget_bytes: float
+    budget_source: str
+    headroom_fraction: float
+    baseline_bytes: float
+    cache_scale: float
+    cell_jobs: int
+    step_flush_interval: int
+    memory_limit_gb: float
+    psd_history_stride: int
+    cache_bytes: float
+    worker_bytes: float
+    buffer_bytes: float
+    fits: bool
+    adjustments: List[str] = field(default_factory=list)
+
+    @property
+    def limit_bytes(self) -> float:
+        return self.budget_bytes * self.headroom_fraction
+
+    @property
+    def total_bytes(self) -> float:
+        return self.baseline_bytes + self.cache_bytes + self.worker_bytes + self.buffer_bytes
+
+    def to_dict(self) -> Dict[str, Any]:
+        payload = asdict(self)
+        payload["limit_bytes"] = self.limit_bytes
+        payload["total_bytes"] = self.total_bytes
+        return payload
+
+
+def _fixed_bytes(n_bins: int, scale: float, jobs: int) -> Tuple[float, float]:
+    cache = collisions_smol.collision_cache_footprint(n_bins, scale=scale, threads=jobs)
+    return cache, jobs * smol_worker_bytes(n_bins)
+
+
+def plan_memory(
+    req: MemoryRequest,
+    budget_bytes: float,
+    *,
+    budget_source: str = "config",
+    headroom_fraction: float = 0.85,
+    baseline_bytes: Optional[float] = None,
+    min_flush_interval: int = 64,
+    min_cache_scale: float = 0.25,
+    max_psd_history_stride: int = 64,
+    adjust_cell_jobs: bool = True,
+) -> MemoryPlan:
+    """Choose cache scale, cell workers, flush interval and PSD stride for ``budget_bytes``.
+
+    ``adjust_cell_jobs=False`` keeps ``req.cell_jobs`` as is, for callers whose
+    worker pool already exists.
+    """
+
+    baseline = float(current_rss_bytes() if baseline_bytes is None else baseline_bytes)
+    usable = max(float(budget_bytes) * float(headroom_fraction) - baseline, 0.0)
+    adjustments: List[str] = []
+    n_bins = max(int(req.n_bins), 0)
+
+    scale = float(req.cache_scale)
+    jobs = max(int(req.cell_jobs), 1)
+    fixed_cap = usable * FIXED_SHARE
+    floor_scale = min(float(min_cache_scale), scale)
+    while sum(_fixed_bytes(n_bins, scale, jobs)) > fixed_cap and scale > floor_scale:
+        scale = max(scale / 2.0, floor_scale)
+    if scale != req.cache_scale:
+        adjustments.append(f"cache_scale {req.cache_scale:g}->{scale:g}")
+    while adjust_cell_jobs and sum(_fixed_bytes(n_bins, scale, jobs)) > fixed_cap and jobs > 1:
+        jobs -= 1
+    if jobs != max(int(req.cell_jobs), 1):
+        adjustments.append(f"cell_jobs {req.cell_jobs}->{jobs}")
+    cache_bytes, worker_bytes = _fixed_bytes(n_bins, scale, jobs)
+    buffer_allow = max(usable - cache_bytes - worker_bytes, 0.0)
+
+    steps = max(int(req.n_steps), 0)
+    stride = max(int(req.psd_history_stride), 1)
+    stride_cap = max(int(max_psd_history_stride), stride)
+    can_raise = req.psd_history_enabled and n_bins > 0
+
+    def _steps_fitting(psd_stride: int) -> int:
+        return int(buffer_allow // buffer_bytes_per_step(req, psd_stride))
+
+    interval = int(req.step_flush_interval)
+    memory_limit_gb = float(req.memory_limit_gb)
+    if req.streaming_enabled and steps > 0:
+        target = max(min(int(min_flush_interval), steps), 1)
+        while can_raise and _steps_fitting(stride) < target and stride < stride_cap:
+            stride = min(stride * 2, stride_cap)
+        fitting = max(_steps_fitting(stride), 1)
+        requested = interval if interval > 0 else steps
+        interval = min(requested, fitting)
+        if interval != req.step_flush_interval:
+            adjustments.append(f"step_flush_interval {req.step_flush_interval}->{interval}")
+        limit_gb = buffer_allow / (1024.0**3)
+        if 0.0 < limit_gb < memory_limit_gb:
+            memory_limit_gb = limit_gb
+            adjustments.append(f"memory_limit_gb {req.memory_limit_gb:g}->{limit_gb:.3g}")
+        buffered_steps = min(interval, steps)
+    else:
+        while can_raise and _steps_fitting(stride) < steps and stride < stride_cap:
+            stride = min(stride * 2, stride_cap)
+        buffered_steps = steps
+    if stride != req.psd_history_stride:
+        adjustments.append(f"psd_history_stride {req.psd_history_stride}->{stride}")
+
+    buffer_bytes = buffered_steps * buffer_bytes_per_step(req, stride)
+    plan = MemoryPlan(
+        budget_bytes=float(budget_bytes),
+        budget_source=budget_source,
+        headroom_fraction=float(headroom_fraction),
+        baseline_bytes=baseline,
+        cache_scale=scale,
+        cell_jobs=jobs,
+        step_flush_interval=interval,
+        memory_limit_gb=memory_limit_gb,
+        psd_history_stride=stride,
+        cache_bytes=cache_bytes,
+        worker_bytes=worker_bytes,
+        buffer_bytes=buffer_bytes,
+        fits=False,
+        adjustments=adjustments,
+    )
+    plan.fits = plan.total_bytes <= plan.limit_bytes
+    return plan
+
+
+def resolve_budget(budget_cfg: Any) -> Optional[Tuple[float, str]]:
+    """Return ``(bytes, source)`` for an enabled ``io.memory_budget`` section."""
+
+    if budget_cfg is None or not bool(getattr(budget_cfg, "enable", False)):
+        return None
+    budget_gb = getattr(budget_cfg, "budget_gb", None)
+    if budget_gb is not None:
+        return float(budget_gb) * (1024.0**3), "config"
+    limit, source = detect_memory_limit()
+    if limit is None:
+        logger.warning("memory budget: no budget_gb and no detectable memory limit; planner disabled")
+        return None
+    return float(limit), source
+
+
+def plan_from_config(
+    budget_cfg: Any,
+    req: MemoryRequest,
+    *,
+    adjust_cell_jobs: bool = True,
+) -> Optional[MemoryPlan]:
+    """Run :func:`plan_memory` with the ``io.memory_budget`` settings, or return None."""
+
+    resolved = resolve_budget(budget_cfg)
+    if resolved is None:
+        return None
+    budget_bytes, source = resolved
+    plan = plan_memory(
+        req,
+        budget_bytes,
+        budget_source=source,
+        headroom_fraction=float(getattr(budget_cfg, "headroom_fraction", 0.85)),
+        min_flush_interval=int(getattr(budget_cfg, "min_flush_interval", 64)),
+        min_cache_scale=float(getattr(budget_cfg, "min_cache_scale", 0.25)),
+        max_psd_history_stride=int(getattr(budget_cfg, "max_psd_history_stride", 64)),
+        adjust_cell_jobs=adjust_cell_jobs,
+    )
+    if not plan.fits:
+        logger.warning(
+            "memory budget (advisory): estimated %.3g GiB exceeds %.3g GiB (%s) even after %s; "
+            "continuing with the degraded settings",
+            plan.total_bytes / 1024.0**3,
+            plan.limit_bytes / 1024.0**3,
+            source,
+            ", ".join(plan.adjustments) or "no adjustments",
+        )
+    elif plan.adjustments:
+        logger.info("memory budget (%s): %s", source, ", ".join(plan.adjustments))
+    return plan
+
+
+def apply_cache_scale(scale: float) -> None:
+    """Apply a collision cache scale and return the evicted entries to the allocator."""
+
+    collisions_smol.configure_collision_cache_limits(scale=scale)
+    gc.collect()
+
+
+class MemoryWatchdog:
+    """Periodic RSS check with a flush -> shrink caches -> raise stride ladder."""
+
+    def __init__(
+        self,
+        limit_bytes: float,
+        *,
+        interval_steps: int = 100,
+        cache_scale: float = 1.0,
+        min_cache_scale: float = 0.25,
+        psd_history_stride: int = 1,
+        max_psd_history_stride: int = 64,
+        rss_reader: Optional[Callable[[], int]] = None,
+        apply_cache: Optional[Callable[[float], None]] = None,
+    ) -> None:
+        self.limit_bytes = float(limit_bytes)
+        self.interval_steps = max(int(interval_steps), 1)
+        self.cache_scale = float(cache_scale)
+        self.min_cache_scale = min(float(min_cache_scale), self.cache_scale)
+        self.psd_history_stride = max(int(psd_history_stride), 1)
+        self.max_psd_history_stride = max(int(max_psd_history_stride), self.psd_history_stride)
+        self._rss_reader = rss_reader if rss_reader is not None else current_rss_bytes
+        self._apply_cache = apply_cache if apply_cache is not None else apply_cache_scale
+        self._over_last_check = False
+        self._exhausted_logged = False
+        self.checks = 0
+        self.peak_rss_bytes = 0
+        self.actions: List[Dict[str, Any]] = []
+
+    def check(self, step_no: int) -> Tuple[str, ...]:
+        """Sample the RSS on every ``interval_steps``-th step; return the actions taken.
+
+        ``"flush"`` must be carried out by the caller; cache shrinking is
+        applied here and ``"raise_stride"`` updates :attr:`psd_history_stride`.
+        """
+
+        if step_no % self.interval_steps != 0:
+            return ()
+        self.checks += 1
+        rss = int(self._rss_reader())
+        self.peak_rss_bytes = max(self.peak_rss_bytes, rss)
+        if rss <= self.limit_bytes:
+            self._over_last_check = False
+            return ()
+        taken = ["flush"]
+        if self._over_last_check:
+            if self.cache_scale > self.min_cache_scale:
+                self.cache_scale = max(self.cache_scale / 2.0, self.min_cache_scale)
+                self._apply_cache(self.cache_scale)
+                taken.append("shrink_caches")
+            elif self.psd_history_stride < self.max_psd_history_stride:
+                self.psd_history_stride = min(self.psd_history_stride * 2, self.max_psd_history_stride)
+                taken.append("raise_stride")
+            elif not self._exhausted_logged:
+                self._exhausted_logged = True
+                logger.warning(
+                    "memory watchdog: RSS %.3g GiB above %.3g GiB with all degradations applied",
+                    rss / 1024.0**3,
+                    self.limit_bytes / 1024.0**3,
+                )
+        self._over_last_check = True
+        self.actions.append(
+            {
+                "step_no": int(step_no),
+                "rss_bytes": rss,
+                "actions": taken,
+                "cache_scale": self.cache_scale,
+                "psd_history_stride": self.psd_history_stride,
+            }
+        )
+        return tuple(taken)
+
+    def stats(self) -> Dict[str, Any]:
+        return {
+            "limit_bytes": self.limit_bytes,
+            "interval_steps": self.interval_steps,
+            "checks": self.checks,
+            "peak_rss_bytes": self.peak_rss_bytes,
+            "cache_scale": self.cache_scale,
+            "psd_history_stride": self.psd_history_stride,
+            "actions": list(self.actions[:256]),
+        }
+
+
+def watchdog_from_plan(budget_cfg: Any, plan: Optional[MemoryPlan]) -> Optional[MemoryWatchdog]:
+    """Build the watchdog for ``plan`` when ``io.memory_budget.watchdog`` is on."""
+
+    if plan is None or not bool(getattr(budget_cfg, "watchdog", True)):
+        return None
+    return MemoryWatchdog(
+        plan.limit_bytes,
+        interval_steps=int(getattr(budget_cfg, "watchdog_interval_steps", 100)),
+        cache_scale=plan.cache_scale,
+        min_cache_scale=float(getattr(budget_cfg, "min_cache_scale", 0.25)),
+        psd_history_stride=plan.psd_history_stride,
+        max_psd_history_stride=int(getattr(budget_cfg, "max_psd_history_stride", 64)),
+    )
+
+
+def report(plan: Optional[MemoryPlan], watchdog: Optional[MemoryWatchdog]) -> Dict[str, Any]:
+    """Run-config payload for the memory budget."""
+
+    return {
+        "enabled": plan is not None,
+        "plan": plan.to_dict() if plan is not None else None,
+        "watchdog": watchdog.stats() if watchdog is not None else None,
+    }
+
+
+__all__ = [
+    "MemoryPlan",
+    "MemoryRequest",
+    "MemoryWatchdog",
+    "apply_cache_scale",
+    "buffer_bytes_per_step",
+    "current_rss_bytes",
+    "detect_memory_limit",
+    "plan_from_config",
+    "plan_memory",
+    "report",
+    "resolve_budget",
+    "smol_worker_bytes",
+    "watchdog_from_plan",
+]
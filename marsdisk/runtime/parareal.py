@@ -0,0 +1,453 @@
+"""Experimental parareal driver for the 0D Smoluchowski system.
+
+A single 0D integration is sequential in time.  Parareal splits
+``[t0, t_end]`` into windows and iterates
+
+``U_{j+1}^{k+1} = G(U_j^{k+1}) + F(U_j^k) − G(U_j^k)``
+
+where ``F`` is the fine propagator (:func:`marsdisk.physics.smol.step_imex_bdf1_C3`
+with the production ``safety``/``mass_tol``) and ``G`` a cheap coarse one
+(the same IMEX-BDF1 step with one large ``dt`` per window and the step-size
+guards relaxed).  The fine windows of one iteration are independent and run
+on a worker pool; after ``k`` iterations the first ``k`` windows equal the
+serial fine solution exactly, so the driver never does worse than serial
+apart from the coarse sweeps.
+
+The state carried across window boundaries is the number density ``N_k``
+plus the cumulative sink loss and supply (both kg m⁻²), which lets the
+mass budget ``M + M_lost − M_supplied = M_0`` be checked at every boundary.
+Temperature-driven runs enter through the operator callable: e.g.
+:class:`TabulatedSmolOperators` interpolates per-bin sink rates (blow-out
+and sublimation) precomputed from a ``T_M(t)`` driver.
+:func:`problem_from_config` builds such a problem from a run configuration::
+
+    cfg = load_config(Path("configs/innerdisk_base.yml"))
+    problem = problem_from_config(cfg, sigma_surf=1.0e-3)
+    result = run_parareal(problem, n_windows=8, dt_fine=100.0, jobs=4)
+
+This covers the PSD state advanced by the Smol solver only; the full
+:func:`marsdisk.run.run_zero_d` bookkeeping (streaming output, phase and
+shielding state, diagnostics) is not windowed.
+"""
+from __future__ import annotations
+
+import concurrent.futures
+import math
+import multiprocessing
+import pickle
+from dataclasses import dataclass, field
+from typing import Any, Callable, Dict, List, Optional, Tuple
+
+import numpy as np
+
+from .. import config_utils, constants, grid, physics_step
+from ..physics import collide, collisions_smol, dynamics, psd, radiation, smol, tempdriver
+from ..schema import Config
+from . import helpers, placement, thread_budget
+
+__all__ = [
+    "PararealProblem",
+    "PararealResult",
+    "SmolOperators",
+    "TabulatedSmolOperators",
+    "problem_from_config",
+    "propagate",
+    "run_parareal",
+    "run_serial",
+]
+
+_UNBOUNDED = 1.0e300
+
+
+@dataclass
+class SmolOperators:
+    """Right-hand side pieces for one Smol step."""
+
+    C: np.ndarray
+    Y: np.ndarray
+    S: np.ndarray
+    source: np.ndarray
+
+
+@dataclass
+class TabulatedSmolOperators:
+    """Collision kernel from :func:`compute_collision_kernel_C1` plus tabulated sinks.
+
+    ``sink_rates[i]`` is the per-bin sink (1/s) at ``sink_times[i]``; values
+    in between are linearly interpolated and held constant outside the table.
+    Only arrays are stored, so instances pickle cheaply to worker processes.
+    """
+
+    sizes: np.ndarray
+    H: np.ndarray
+    v_rel: float
+    Y: np.ndarray
+    source: np.ndarray
+    sink_times: np.ndarray
+    sink_rates: np.ndarray
+    collisions_enabled: bool = True
+
+    def sink_at(self, t: float) -> np.ndarray:
+        times = np.asarray(self.sink_times, dtype=float)
+        rates = np.asarray(self.sink_rates, dtype=float)
+        if times.size == 1 or t <= times[0]:
+            return rates[0]
+        if t >= times[-1]:
+            return rates[-1]
+        idx = int(np.searchsorted(times, t, side="right")) - 1
+        w = (t - times[idx]) / (times[idx + 1] - times[idx])
+        return (1.0 - w) * rates[idx] + w * rates[idx + 1]
+
+    def __call__(self, t: float, N: np.ndarray) -> SmolOperators:
+        n = N.size
+        if self.collisions_enabled:
+            C = collide.compute_collision_kernel_C1(N, self.sizes, self.H, self.v_rel)
+        else:
+            C = np.zeros((n, n))
+        return SmolOperators(C=C, Y=self.Y, S=self.sink_at(t), source=self.source)
+
+
+@dataclass
+class PararealProblem:
+    """Initial state, bin masses and an ``operators(t, N)`` callable."""
+
+    m: np.ndarray
+    N0: np.ndarray
+    t0: float
+    t_end: float
+    operators: Callable[[float, np.ndarray], SmolOperators]
+
+    def initial_state(self) -> np.ndarray:
+        return np.concatenate([np.asarray(self.N0, dtype=float), [0.0, 0.0]])
+
+    def mass(self, state: np.ndarray) -> float:
+        return float(np.dot(self.m, state[:-2]))
+
+
+def problem_from_config(
+    cfg: Config,
+    *,
+    sigma_surf: float,
+    t_end: Optional[float] = None,
+    sink_samples: int = 33,
+) -> PararealProblem:
+    """Build a :class:`PararealProblem` with :func:`run_zero_d`'s initial setup.
+
+    The reference radius, ⟨Q_pr⟩ table, Mars temperature driver, blow-out
+    floor of ``s_min``, power-law PSD, kernel ``e``/``i``/``H`` and fragment
+    tensor follow the 0D runner.  The blow-out sink is tabulated at
+    ``sink_samples`` times of the ``T_M(t)`` driver.  ``sigma_surf`` (kg m⁻²)
+    normalises the initial PSD and ``t_end`` (s) defaults to the configured
+    ``numerics.t_end_years`` / ``t_end_orbits``.  Sublimation sinks, supply and
+    the ``initial.s0_mode`` variants are not included.
+    """
+
+    qpr_override = None
+    if cfg.radiation:
+        if cfg.radiation.qpr_table_resolved is not None:
+            radiation.load_qpr_table(cfg.radiation.qpr_table_resolved)
+        qpr_override = cfg.radiation.Q_pr
+    r, _, _ = config_utils.resolve_reference_radius(cfg)
+    Omega = grid.omega_kepler(r)
+    t_orb = 2.0 * math.pi / Omega
+    if t_end is None:
+        if cfg.numerics.t_end_years is not None:
+            t_end = float(cfg.numerics.t_end_years) * constants.SECONDS_PER_YEAR
+        else:
+            t_end = float(cfg.numerics.t_end_orbits or 0.0) * t_orb
+    if not t_end > 0.0:
+        raise ValueError("t_end must be positive")
+    temp_runtime = tempdriver.resolve_temperature_driver(cfg.radiation, t_orb=t_orb)
+    rho = float(cfg.material.rho)
+    s_min_config = float(cfg.sizes.s_min)
+
+    def radiation_at(T_M: float, s_min: float) -> physics_step.RadiationResult:
+        return physics_step.compute_radiation_parameters(s_min, rho, T_M, qpr_override=qpr_override)
+
+    T_init = float(temp_runtime.initial_value)
+    a_blow_init = float(radiation_at(T_init, s_min_config).a_blow)
+    if getattr(getattr(cfg.psd, "floor", None), "mode", "fixed") == "none":
+        s_min_effective = s_min_config
+    else:
+        s_min_effective = max(s_min_config, a_blow_init)
+    psd_state = psd.update_psd_state(
+        s_min=s_min_effective,
+        s_max=cfg.sizes.s_max,
+        alpha=cfg.psd.alpha,
+        wavy_strength=cfg.psd.wavy_strength,
+        n_bins=cfg.sizes.n_bins,
+        rho=rho,
+    )
+    sizes, _, m, N0, _ = smol.psd_state_to_number_density(psd_state, float(sigma_surf), rho_fallback=rho)
+    sizes = np.array(sizes, dtype=float)
+    m = np.array(m, dtype=float)
+
+    kernel_state = collisions_smol.compute_kernel_ei_state(
+        cfg.dynamics, 0.0, a_orbit_m=r, v_k=r * Omega, sizes=sizes
+    )
+    if getattr(cfg.dynamics, "v_rel_mode", "pericenter") == "pericenter":
+        v_rel = float(dynamics.v_rel_pericenter(kernel_state.e_used, v_k=r * Omega))
+    else:
+        v_rel = float(dynamics.v_ij(kernel_state.e_used, kernel_state.i_used, v_k=r * Omega))
+    edges = np.asarray(psd_state["edges"], dtype=float)
+    Y = collisions_smol._fragment_tensor(sizes, m, edges, v_rel, rho)
+
+    collisions_active = getattr(cfg, "physics_mode", "default") != "sublimation_only"
+    blowout_enabled = collisions_active and bool(getattr(getattr(cfg, "blowout", None), "enabled", True))
+    rp_blowout_cfg = getattr(cfg.sinks, "rp_blowout", None)
+    blowout_enabled = blowout_enabled and bool(getattr(rp_blowout_cfg, "enable", True))
+    if cfg.radiation is not None:
+        blowout_enabled = (
+            blowout_enabled
+            and str(getattr(cfg.radiation, "source", "mars")).lower() != "off"
+            and bool(getattr(cfg.radiation, "use_mars_rp", True))
+        )
+    if isinstance(cfg.chi_blow, str):
+        rad_init = radiation_at(T_init, s_min_effective)
+        chi_blow = helpers.auto_chi_blow(rad_init.beta, rad_init.qpr_mean)
+    else:
+        chi_blow = float(cfg.chi_blow)
+    t_blow = min(max(chi_blow, 0.5), 2.0) / Omega
+
+    # Bin lower edges, as in step_collisions_smol_0d, so the first bin is
+    # blown out when s_min sits on the blow-out size.
+    lower_edges = edges[:-1]
+    sink_times = np.linspace(0.0, float(t_end), max(int(sink_samples), 2))
+    sink_rates = np.array(
+        [
+            collisions_smol._blowout_sink_vector(
+                lower_edges,
+                float(radiation_at(temp_runtime.evaluate(float(t)), s_min_config).a_blow),
+                t_blow,
+                blowout_enabled,
+            )
+            for t in sink_times
+        ]
+    )
+    operators = TabulatedSmolOperators(
+        sizes=sizes,
+        H=np.asarray(kernel_state.H_k, dtype=float),
+        v_rel=v_rel,
+        Y=Y,
+        source=np.zeros_like(sizes),
+        sink_times=sink_times,
+        sink_rates=sink_rates,
+        collisions_enabled=collisions_active,
+    )
+    return PararealProblem(m=m, N0=np.array(N0, dtype=float), t0=0.0, t_end=float(t_end), operators=operators)
+
+
+def propagate(
+    problem: PararealProblem,
+    state: np.ndarray,
+    t_start: float,
+    t_stop: float,
+    dt: float,
+    *,
+    safety: float = 0.1,
+    mass_tol: float = 5e-3,
+) -> Tuple[np.ndarray, int]:
+    """Advance ``state`` from ``t_start`` to ``t_stop``; return ``(state, steps)``."""
+
+    m = np.asarray(problem.m, dtype=float)
+    N = np.array(state[:-2], dtype=float)
+    lost = float(state[-2])
+    supplied = float(state[-1])
+    t = float(t_start)
+    steps = 0
+    while t_stop - t > 1e-12 * max(abs(t_stop), 1.0):
+        ops = problem.operators(t, N)
+        sink_mass_rate = float(np.dot(m, ops.S * N))
+        N_new, dt_eff, _ = smol.step_imex_bdf1_C3(
+            N,
+            ops.C,
+            ops.Y,
+            None,
+            m,
+            None,
+            min(dt, t_stop - t),
+            source_k=ops.source,
+            S_external_k=ops.S,
+            extra_mass_loss_rate=sink_mass_rate,
+            mass_tol=mass_tol,
+            safety=safety,
+        )
+        lost += dt_eff * sink_mass_rate
+        supplied += dt_eff * float(np.dot(m, ops.source))
+        N = np.array(N_new, dtype=float)
+        t += dt_eff
+        steps += 1
+    return np.concatenate([N, [lost, supplied]]), steps
+
+
+def run_serial(problem: PararealProblem, dt: float, *, safety: float = 0.1, mass_tol: float = 5e-3) -> np.ndarray:
+    """Reference serial fine integration over the whole interval."""
+
+    state, _ = propagate(problem, problem.initial_state(), problem.t0, problem.t_end, dt, safety=safety, mass_tol=mass_tol)
+    return state
+
+
+def _fine_window(
+    problem: PararealProblem,
+    state: np.ndarray,
+    t_start: float,
+    t_stop: float,
+    dt: float,
+    safety: float,
+    mass_tol: float,
+) -> Tuple[np.ndarray, int]:
+    return propagate(problem, state, t_start, t_stop, dt, safety=safety, mass_tol=mass_tol)
+
+
+def _worker_context() -> multiprocessing.context.BaseContext:
+    methods = multiprocessing.get_all_start_methods()
+    return multiprocessing.get_context("forkserver" if "forkserver" in methods else "spawn")
+
+
+@dataclass
+class PararealResult:
+    times: np.ndarray
+    states: np.ndarray
+    iterations: int
+    converged: bool
+    history: List[Dict[str, Any]] = field(default_factory=list)
+    fine_steps: int = 0
+    pool: Dict[str, Any] = field(default_factory=dict)
+
+    @property
+    def final_state(self) -> np.ndarray:
+        return self.states[-1]
+
+
+def _budget_error_percent(problem: PararealProblem, state: np.ndarray, mass0: float) -> float:
+    if mass0 <= 0.0:
+        return float("nan")
+    residual = problem.mass(state) + state[-2] - state[-1] - mass0
+    return abs(residual) / mass0 * 100.0
+
+
+def run_parareal(
+    problem: PararealProblem,
+    *,
+    n_windows: int,
+    dt_fine: float,
+    coarse_steps: int = 1,
+    max_iterations: Optional[int] = None,
+    tol: float = 1e-6,
+    jobs: int = 1,
+    executor: str = "process",
+    safety: float = 0.1,
+    mass_tol: float = 5e-3,
+    coarse: Optional[Callable[[np.ndarray, float, float], np.ndarray]] = None,
+) -> PararealResult:
+    """Parareal over ``n_windows`` windows of ``[t0, t_end]``.
+
+    Convergence is declared when, at every window boundary, the change of the
+    state between iterations (mass-weighted ``|ΔN|`` plus the changes of the
+    cumulative loss and supply) is below ``tol × M_0``.  ``coarse`` overrides
+    the default coarse propagator and receives ``(state, t_start, t_stop)``.
+    With ``executor="process"`` the problem (including its operator callable)
+    must be picklable; lambdas and closures need ``executor="thread"``.
+    """
+
+    if n_windows < 1:
+        raise ValueError("n_windows must be at least 1")
+    if executor not in {"process", "thread"}:
+        raise ValueError(f"Unknown executor: {executor!r}")
+    times = np.linspace(problem.t0, problem.t_end, n_windows + 1)
+    max_iterations = n_windows if max_iterations is None else max(1, min(int(max_iterations), n_windows))
+    m = np.asarray(problem.m, dtype=float)
+
+    def coarse_prop(state: np.ndarray, t_a: float, t_b: float) -> np.ndarray:
+        if coarse is not None:
+            return np.asarray(coarse(state, t_a, t_b), dtype=float)
+        dt = (t_b - t_a) / max(int(coarse_steps), 1)
+        out, _ = propagate(problem, state, t_a, t_b, dt, safety=_UNBOUNDED, mass_tol=math.inf)
+        return out
+
+    U = np.empty((n_windows + 1, problem.initial_state().size))
+    U[0] = problem.initial_state()
+    G_prev = np.empty_like(U)
+    for j in range(n_windows):
+        G_prev[j + 1] = coarse_prop(U[j], times[j], times[j + 1])
+        U[j + 1] = G_prev[j + 1]
+    mass0 = problem.mass(U[0])
+    scale = mass0 if mass0 > 0.0 else 1.0
+
+    pool: Optional[concurrent.futures.Executor] = None
+    workers = max(min(int(jobs), n_windows), 1)
+    pool_info: Dict[str, Any] = {"executor": executor if workers > 1 else "serial", "workers": workers}
+    if workers > 1:
+        if executor == "thread":
+            pool = concurrent.futures.ThreadPoolExecutor(max_workers=workers)
+        else:
+            try:
+                pickle.dumps(problem)
+            except (pickle.PicklingError, AttributeError, TypeError) as exc:
+                raise ValueError(
+                    "executor='process' needs a picklable PararealProblem; use a module-level "
+                    "operators callable such as TabulatedSmolOperators or pass executor='thread'"
+                ) from exc
+            mp_context = _worker_context()
+            placement_kwargs, placement_report = placement.process_pool_options(workers, mp_context=mp_context)
+            pool_kwargs, budget_report = thread_budget.pool_options(
+                workers, n_windows, extra=placement_kwargs, mp_context=mp_context
+            )
+            pool_info["placement"] = placement_report
+            pool_info["thread_budget"] = budget_report
+            pool = concurrent.futures.ProcessPoolExecutor(max_workers=workers, **pool_kwargs)
+
+    history: List[Dict[str, Any]] = []
+    fine_steps = 0
+    converged = False
+    iteration = 0
+    try:
+        for iteration in range(1, max_iterations + 1):
+            first = iteration - 1  # windows before this one are already exact
+            args = [
+                (problem, U[j], times[j], times[j + 1], dt_fine, safety, mass_tol) for j in range(first, n_windows)
+            ]
+            if pool is None:
+                fine = [_fine_window(*a) for a in args]
+            else:
+                fine = list(pool.map(_fine_window, *zip(*args)))
+            fine_steps += sum(steps for _, steps in fine)
+
+            U_new = U.copy()
+            U_new[first + 1] = fine[0][0]
+            for offset, j in enumerate(range(first + 1, n_windows), start=1):
+                G_new = coarse_prop(U_new[j], times[j], times[j + 1])
+                U_new[j + 1] = G_new + fine[offset][0] - G_prev[j + 1]
+                np.maximum(U_new[j + 1][:-2], 0.0, out=U_new[j + 1][:-2])
+                G_prev[j + 1] = G_new
+
+            delta = U_new - U
+            change = (np.abs(delta[:, :-2]) @ m + np.abs(delta[:, -2]) + np.abs(delta[:, -1])) / scale
+            U = U_new
+            budget = [_budget_error_percent(problem, U[j], mass0) for j in range(n_windows + 1)]
+            entry = {
+                "iteration": iteration,
+                "max_change": float(np.max(change)),
+                "fine_windows": len(args),
+                "mass_final": problem.mass(U[-1]),
+                "mass_lost": float(U[-1][-2]),
+                "mass_budget_max_error_percent": float(np.nanmax(budget)),
+            }
+            history.append(entry)
+            # After n_windows iterations every window has been refined by F.
+            if entry["max_change"] <= tol or iteration == n_windows:
+                converged = True
+                break
+    finally:
+        if pool is not None:
+            pool.shutdown()
+
+    return PararealResult(
+        times=times,
+        states=U,
+        iterations=iteration,
+        converged=converged,
+        history=history,
+        fine_steps=fine_steps,
+        pool=pool_info,
+    )
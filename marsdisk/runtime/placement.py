@@ -0,0 +1,277 @@
+"""Opt-in NUMA-aware placement of cell workers and sweep workers.
+
+Enabled with ``MARSDISK_NUMA_PLACEMENT=1`` (Linux only).  The topology comes
+from :func:`marsdisk.runtime.autotune.detect_machine_state`; workers are
+spread round-robin over the NUMA nodes and pinned to CPUs of their node.
+
+Memory is bound through the kernel's first-touch policy: a pinned worker
+allocates its Smol temporaries, thread-local collision caches and updated
+PSD arrays on its own node.  When ``libnuma`` is loadable the worker also
+requests ``numa_set_localalloc`` explicitly.  Cell chunks are dispatched to
+a fixed worker (see :class:`PinnedWorkerPool`) so a cell's arrays stay on
+the node that touched them first.
+"""
+from __future__ import annotations
+
+import ctypes
+import ctypes.util
+import logging
+import multiprocessing
+import os
+import threading
+from concurrent.futures import Future, ThreadPoolExecutor
+from dataclasses import asdict, dataclass
+from typing import Any, Callable, Dict, Iterable, List, Mapping, Optional, Sequence, Tuple
+
+from .autotune import MachineState, detect_machine_state
+
+logger = logging.getLogger(__name__)
+
+PLACEMENT_ENV = "MARSDISK_NUMA_PLACEMENT"
+_FALSE_VALUES = {"", "0", "false", "off", "no"}
+
+
+def placement_requested(env: Optional[Mapping[str, str]] = None) -> bool:
+    """Return True when ``MARSDISK_NUMA_PLACEMENT`` asks for pinning."""
+
+    env = env if env is not None else os.environ
+    return str(env.get(PLACEMENT_ENV, "")).strip().lower() not in _FALSE_VALUES
+
+
+def _allowed_cpus() -> Optional[List[int]]:
+    getter = getattr(os, "sched_getaffinity", None)
+    if getter is None:
+        return None
+    try:
+        return sorted(getter(0))
+    except OSError:
+        return None
+
+
+@dataclass
+class WorkerPlacement:
+    """CPU set and NUMA node assigned to one worker slot."""
+
+    worker: int
+    node: int
+    cpus: List[int]
+
+    def to_dict(self) -> Dict[str, Any]:
+        return asdict(self)
+
+
+def node_cpus(state: Optional[MachineState] = None) -> List[List[int]]:
+    """NUMA node CPU lists restricted to the current affinity mask."""
+
+    state = state or detect_machine_state()
+    allowed = _allowed_cpus()
+    nodes = state.numa_node_cpus or [allowed or list(range(max(state.cpu_logical, 1)))]
+    if allowed is not None:
+        allowed_set = set(allowed)
+        nodes = [[cpu for cpu in cpus if cpu in allowed_set] for cpus in nodes]
+    return [cpus for cpus in nodes if cpus]
+
+
+def plan_placement(
+    n_workers: int,
+    *,
+    threads_per_worker: int = 1,
+    nodes: Optional[Sequence[Sequence[int]]] = None,
+) -> List[WorkerPlacement]:
+    """Spread ``n_workers`` round-robin over NUMA nodes.
+
+    Each worker receives ``threads_per_worker`` CPUs of its node; CPUs are
+    reused cyclically once a node is exhausted (oversubscription is left to
+    the thread budget, not rejected here).
+    """
+
+    node_list = [list(cpus) for cpus in (nodes if nodes is not None else node_cpus())]
+    node_list = [cpus for cpus in node_list if cpus]
+    if not node_list or n_workers < 1:
+        return []
+    width = max(int(threads_per_worker), 1)
+    cursor = [0] * len(node_list)
+    plan: List[WorkerPlacement] = []
+    for worker in range(int(n_workers)):
+        node = worker % len(node_list)
+        cpus = node_list[node]
+        start = cursor[node]
+        chosen = sorted({cpus[(start + k) % len(cpus)] for k in range(min(width, len(cpus)))})
+        cursor[node] = (start + width) % len(cpus)
+        plan.append(WorkerPlacement(worker=worker, node=node, cpus=chosen))
+    return plan
+
+
+_LIBNUMA: Optional[Any] = None
+_LIBNUMA_LOADED = False
+
+
+def _libnuma() -> Optional[Any]:
+    global _LIBNUMA, _LIBNUMA_LOADED
+    if _LIBNUMA_LOADED:
+        return _LIBNUMA
+    _LIBNUMA_LOADED = True
+    name = ctypes.util.find_library("numa")
+    if not name:
+        return None
+    try:
+        lib = ctypes.CDLL(name)
+        if lib.numa_available() < 0:
+            return None
+    except (OSError, AttributeError):
+        return None
+    _LIBNUMA = lib
+    return lib
+
+
+def bind_local_memory() -> str:
+    """Prefer node-local allocation for the calling thread; returns the policy."""
+
+    lib = _libnuma()
+    if lib is not None:
+        try:
+            lib.numa_set_localalloc()
+            return "libnuma_localalloc"
+        except AttributeError:  # pragma: no cover - very old libnuma
+            pass
+    return "first_touch"
+
+
+def pin_current_thread(cpus: Iterable[int]) -> bool:
+    """Pin the calling thread (pid 0 == caller on Linux) to ``cpus``."""
+
+    setter = getattr(os, "sched_setaffinity", None)
+    cpu_set = set(int(cpu) for cpu in cpus)
+    if setter is None or not cpu_set:
+        return False
+    try:
+        setter(0, cpu_set)
+    except OSError as exc:
+        logger.debug("placement: sched_setaffinity(%s) failed: %s", sorted(cpu_set), exc)
+        return False
+    return True
+
+
+def _pin_and_bind(slot: WorkerPlacement) -> Dict[str, Any]:
+    pinned = pin_current_thread(slot.cpus)
+    policy = bind_local_memory() if pinned else "none"
+    return {**slot.to_dict(), "pinned": pinned, "memory_policy": policy}
+
+
+class PinnedWorkerPool:
+    """Fixed set of single-thread executors, one per :class:`WorkerPlacement`.
+
+    ``map`` sends chunk ``i`` to worker ``i % n`` on every call, so the same
+    cells are always advanced by the same pinned thread.
+    """
+
+    def __init__(self, plan: Sequence[WorkerPlacement], *, thread_name_prefix: str = "marsdisk-cell") -> None:
+        if not plan:
+            raise ValueError("PinnedWorkerPool requires a non-empty placement plan")
+        self.plan = list(plan)
+        self.worker_status: List[Optional[Dict[str, Any]]] = [None] * len(self.plan)
+        self._lock = threading.Lock()
+        self._executors = [
+            ThreadPoolExecutor(
+                max_workers=1,
+                thread_name_prefix=f"{thread_name_prefix}-{slot.worker}",
+                initializer=self._init_worker,
+                initargs=(idx,),
+            )
+            for idx, slot in enumerate(self.plan)
+        ]
+
+    def _init_worker(self, idx: int) -> None:
+        status = _pin_and_bind(self.plan[idx])
+        with self._lock:
+            self.worker_status[idx] = status
+
+    def map(self, fn: Callable[[Any], Any], items: Iterable[Any]) -> List[Any]:
+        futures: List[Future] = [
+            self._executors[idx % len(self._executors)].submit(fn, item)
+            for idx, item in enumerate(items)
+        ]
+        return [future.result() for future in futures]
+
+    def shutdown(self, wait: bool = True) -> None:
+        for executor in self._executors:
+            executor.shutdown(wait=wait)
+
+    def report(self) -> Dict[str, Any]:
+        with self._lock:
+            workers = [
+                status if status is not None else {**slot.to_dict(), "pinned": None}
+                for slot, status in zip(self.plan, self.worker_status)
+            ]
+        return {"enabled": True, "scope": "cell_workers", "workers": workers}
+
+
+def _process_worker_init(plan: Sequence[Dict[str, Any]], counter: Any) -> None:
+    with counter.get_lock():
+        slot_idx = counter.value
+        counter.value += 1
+    if not plan:
+        return
+    slot = WorkerPlacement(**plan[slot_idx % len(plan)])
+    status = _pin_and_bind(slot)
+    logger.debug("placement: sweep worker pid=%s -> %s", os.getpid(), status)
+
+
+def process_pool_options(
+    jobs: int,
+    *,
+    threads_per_worker: int = 1,
+    env: Optional[Mapping[str, str]] = None,
+    mp_context: Optional[Any] = None,
+) -> Tuple[Dict[str, Any], Dict[str, Any]]:
+    """``ProcessPoolExecutor`` kwargs pinning each worker process, plus a report.
+
+    Returns ``({}, {"enabled": False, ...})`` unless placement is requested
+    and the platform supports affinity control.  ``mp_context`` must match
+    the executor's start method.
+    """
+
+    if not placement_requested(env):
+        return {}, {"enabled": False, "reason": "not_requested"}
+    if not hasattr(os, "sched_setaffinity"):
+        return {}, {"enabled": False, "reason": "unsupported_platform"}
+    plan = plan_placement(jobs, threads_per_worker=threads_per_worker)
+    if not plan:
+        return {}, {"enabled": False, "reason": "no_topology"}
+    counter = (mp_context if mp_context is not None else multiprocessing).Value("i", 0)
+    payload = [slot.to_dict() for slot in plan]
+    report = {
+        "enabled": True,
+        "scope": "sweep_workers",
+        "numa_nodes": len({slot.node for slot in plan}),
+        "workers": payload,
+        "memory_policy": "libnuma_localalloc" if _libnuma() is not None else "first_touch",
+    }
+    return {"initializer": _process_worker_init, "initargs": (payload, counter)}, report
+
+
+def current_affinity_report() -> Dict[str, Any]:
+    """Affinity of the current process, for run-config provenance."""
+
+    cpus = _allowed_cpus()
+    nodes = detect_machine_state().numa_node_cpus or []
+    cpu_set = set(cpus or [])
+    return {
+        "enabled": placement_requested(),
+        "affinity": cpus,
+        "numa_nodes_total": len(nodes),
+        "numa_nodes_local": [idx for idx, node in enumerate(nodes) if cpu_set & set(node)],
+    }
+
+__all__ = [
+    "PLACEMENT_ENV",
+    "PinnedWorkerPool",
+    "WorkerPlacement",
+    "bind_local_memory",
+    "current_affinity_report",
+    "node_cpus",
+    "pin_current_thread",
+    "placement_requested",
+    "plan_placement",
+    "process_pool_options",
+]
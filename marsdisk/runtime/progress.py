@@ -167,6 +167,17 @@ class ProgressReporter:
             "eta_samples": int(self._eta_samples),
         }
 
+    def perf_counters(self, steps_done: int) -> dict[str, float | int]:
+        """Return wall-clock counters for partial summaries (works when disabled)."""
+
+        wall = max(time.monotonic() - self.start, 0.0)
+        steps = max(int(steps_done), 0)
+        return {
+            "wall_time_s": wall,
+            "steps_completed": steps,
+            "steps_per_s": steps / wall if wall > 0.0 else 0.0,
+        }
+
     def restore_state(self, state: dict[str, float | int | None] | None) -> None:
         """Restore ETA state from a checkpoint payload."""
 
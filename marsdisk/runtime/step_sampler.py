@@ -0,0 +1,180 @@
+"""Adaptive sampling of per-step diagnostics rows.
+
+``io.step_diagnostics.sampling="all"`` keeps the historical behaviour of
+writing one row per step.  ``"adaptive"`` writes every ``sparse_stride``-th
+step and switches to dense output only around events:
+
+* a phase label change (``phase_state_step`` / ``phase_bulk_state``),
+* a collapse of the effective step (``dt / n_substeps`` falling below
+  ``dt_collapse_ratio`` times the previous value),
+* a mass-budget excursion above ``mass_error_percent``,
+* runner-reported events such as an early stop.
+
+The rows skipped since the last written one are kept in a rolling window of
+``window_steps`` entries; an event dumps the window first so the lead-up is
+preserved, then the next ``post_event_steps`` steps are written densely.
+Writing a sparse row discards the window so output stays in time order.
+"""
+from __future__ import annotations
+
+import math
+from collections import deque
+from typing import Any, Deque, Dict, Iterable, List, MutableSequence, Optional, Sequence, Tuple
+
+SAMPLING_MODES = ("all", "adaptive")
+DEFAULT_WATCH_KEYS: Tuple[str, ...] = ("phase_state_step", "phase_bulk_state")
+SAMPLE_REASON_KEY = "sample_reason"
+MAX_EVENT_LOG = 256
+
+
+class StepDiagnosticsSampler:
+    """Decide which step-diagnostics rows reach ``sink``."""
+
+    def __init__(
+        self,
+        sink: MutableSequence[Dict[str, Any]],
+        *,
+        mode: str = "all",
+        sparse_stride: int = 100,
+        window_steps: int = 64,
+        post_event_steps: int = 64,
+        dt_collapse_ratio: float = 0.1,
+        mass_error_percent: Optional[float] = 0.1,
+        watch_keys: Sequence[str] = DEFAULT_WATCH_KEYS,
+    ) -> None:
+        if mode not in SAMPLING_MODES:
+            raise ValueError(f"Unknown step diagnostics sampling mode: {mode!r}")
+        self.sink = sink
+        self.mode = mode
+        self.sparse_stride = max(int(sparse_stride), 1)
+        self.post_event_steps = max(int(post_event_steps), 0)
+        self.dt_collapse_ratio = float(dt_collapse_ratio)
+        self.mass_error_percent = mass_error_percent
+        self.watch_keys = tuple(watch_keys)
+        self._window: Deque[Dict[str, Any]] = deque(maxlen=max(int(window_steps), 0) or None)
+        self._window_enabled = int(window_steps) > 0
+        self._dense_until = -1
+        self._prev_dt_eff: Optional[float] = None
+        self._prev_watch: Optional[Tuple[Any, ...]] = None
+        self._last_row: Optional[Dict[str, Any]] = None
+        self._last_written = False
+        self.rows_seen = 0
+        self.rows_written = 0
+        self.event_count = 0
+        self.events: List[Dict[str, Any]] = []
+
+    @property
+    def adaptive(self) -> bool:
+        return self.mode == "adaptive"
+
+    def _emit(self, row: Dict[str, Any], reason: str) -> None:
+        row[SAMPLE_REASON_KEY] = reason
+        self.sink.append(row)
+        self.rows_written += 1
+
+    def _dump_window(self) -> None:
+        while self._window:
+            self._emit(self._window.popleft(), "window")
+
+    def _detect(
+        self,
+        row: Dict[str, Any],
+        dt_eff: Optional[float],
+        error_percent: Optional[float],
+        events: Iterable[str],
+    ) -> List[str]:
+        found = [str(event) for event in events]
+        watch = tuple(row.get(key) for key in self.watch_keys)
+        if self._prev_watch is not None and watch != self._prev_watch:
+            found.append("phase_transition")
+        self._prev_watch = watch
+        if dt_eff is not None and math.isfinite(dt_eff) and dt_eff > 0.0:
+            prev = self._prev_dt_eff
+            if prev is not None and dt_eff < self.dt_collapse_ratio * prev:
+                found.append("dt_collapse")
+            self._prev_dt_eff = dt_eff
+        if (
+            self.mass_error_percent is not None
+            and error_percent is not None
+            and math.isfinite(error_percent)
+            and error_percent > self.mass_error_percent
+        ):
+            found.append("mass_budget_excursion")
+        return found
+
+    def _record_events(self, step_no: int, row: Dict[str, Any], names: List[str]) -> None:
+        self.event_count += 1
+        if len(self.events) < MAX_EVENT_LOG:
+            self.events.append({"step_no": int(step_no), "time": row.get("time"), "events": names})
+
+    def offer(
+        self,
+        step_no: int,
+        row: Dict[str, Any],
+        *,
+        dt_eff: Optional[float] = None,
+        error_percent: Optional[float] = None,
+        events: Iterable[str] = (),
+    ) -> bool:
+        """Submit the row of ``step_no``; returns True when it was written."""
+
+        self.rows_seen += 1
+        if not self.adaptive:
+            self.sink.append(row)
+            self.rows_written += 1
+            return True
+        self._last_row = row
+        names = self._detect(row, dt_eff, error_percent, events)
+        if names:
+            self._record_events(step_no, row, names)
+            self._dump_window()
+            self._emit(row, "event:" + "+".join(names))
+            self._dense_until = step_no + self.post_event_steps
+        elif step_no <= self._dense_until:
+            self._emit(row, "post_event")
+        elif step_no % self.sparse_stride == 0:
+            self._window.clear()
+            self._emit(row, "sparse")
+        else:
+            if self._window_enabled:
+                self._window.append(row)
+            self._last_written = False
+            return False
+        self._last_written = True
+        return True
+
+    def finalize(self, *, anomaly: Optional[str] = None) -> None:
+        """Flush state at the end of the run.
+
+        An ``anomaly`` (early stop, mass-budget violation, ...) dumps the
+        rolling window; the final step is always written so the last state is
+        available.
+        """
+
+        if not self.adaptive or self._last_row is None:
+            return
+        if anomaly:
+            self._record_events(-1, self._last_row, [str(anomaly)])
+            if not self._last_written and self._window and self._window[-1] is self._last_row:
+                # The last row sits at the end of the window; with no window
+                # it is written below as the final row.
+                self._dump_window()
+                self._last_written = True
+        if not self._last_written:
+            if self._window and self._window[-1] is self._last_row:
+                self._window.pop()
+            self._window.clear()
+            self._emit(self._last_row, "final")
+            self._last_written = True
+
+    def stats(self) -> Dict[str, Any]:
+        return {
+            "sampling": self.mode,
+            "rows_seen": self.rows_seen,
+            "rows_written": self.rows_written,
+            "event_count": self.event_count,
+            "events": list(self.events),
+        }
+
+
+__all__ = ["SAMPLING_MODES", "SAMPLE_REASON_KEY", "StepDiagnosticsSampler"]
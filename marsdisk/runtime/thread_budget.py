@@ -0,0 +1,308 @@
+"""Process-wide thread budget shared by sweep workers, cell workers, Numba and BLAS.
+
+The budget is the number of cores this job may use:
+
+* ``MARSDISK_THREAD_BUDGET`` (absolute count) when set, otherwise
+* ``CELL_CPU_LOGICAL`` / ``CPU_LOGICAL`` / ``os.cpu_count()`` scaled by
+  ``CELL_CPU_FRACTION_USED`` / ``CELL_CPU_FRACTION`` (default 1.0 at runtime,
+  0.7 for the runset helper ``calc_thread_limit.py``).
+
+:meth:`ThreadBudget.partition` splits it as
+``processes x cell_workers x inner threads``.  Numba ``prange`` and BLAS
+never run concurrently inside one Smol step, so both get the same inner
+share.
+
+Sweep pools install a shared lease counter (:func:`pool_options`).  Each
+case takes a share of the free cores when it starts (:func:`lease`); once
+fewer cases remain than worker slots, the tail cases get the cores the
+finished workers released.
+
+This module is stdlib-only so scripts can load it before ``numpy`` is
+imported (see :func:`apply_thread_guard`).
+"""
+from __future__ import annotations
+
+import contextlib
+import math
+import multiprocessing
+import os
+from dataclasses import asdict, dataclass
+from typing import Any, Callable, Dict, Iterator, Mapping, MutableMapping, Optional, Tuple
+
+BUDGET_ENV = "MARSDISK_THREAD_BUDGET"
+GUARD_ENV = "MARSDISK_THREAD_GUARD"
+BLAS_ENV_KEYS = (
+    "OMP_NUM_THREADS",
+    "MKL_NUM_THREADS",
+    "OPENBLAS_NUM_THREADS",
+    "NUMEXPR_NUM_THREADS",
+    "VECLIB_MAXIMUM_THREADS",
+)
+_FALSE_VALUES = {"0", "false", "off", "no"}
+
+
+def _parse_int(value: Optional[str], default: int) -> int:
+    try:
+        parsed = int(str(value).strip())
+    except (TypeError, ValueError):
+        return default
+    return parsed if parsed > 0 else default
+
+
+def _parse_fraction(value: Optional[str], default: float) -> float:
+    try:
+        parsed = float(str(value).strip())
+    except (TypeError, ValueError):
+        return default
+    if parsed <= 0.0 or parsed > 1.0:
+        return default
+    return parsed
+
+
+@dataclass(frozen=True)
+class ThreadPlan:
+    """One partition of the budget."""
+
+    total: int
+    processes: int
+    cell_workers: int
+    numba_threads: int
+    blas_threads: int
+
+    def to_dict(self) -> Dict[str, Any]:
+        return asdict(self)
+
+    def env(self) -> Dict[str, str]:
+        """Environment variables enforcing the inner share in a child process."""
+
+        payload = {key: str(self.blas_threads) for key in BLAS_ENV_KEYS}
+        payload["NUMBA_NUM_THREADS"] = str(self.numba_threads)
+        return payload
+
+
+@dataclass(frozen=True)
+class ThreadBudget:
+    """Total core allocation for the current job."""
+
+    total: int
+    source: str = "cpu_count"
+
+    @classmethod
+    def from_env(
+        cls,
+        env: Optional[Mapping[str, str]] = None,
+        *,
+        default_fraction: float = 1.0,
+    ) -> "ThreadBudget":
+        env = env if env is not None else os.environ
+        explicit = _parse_int(env.get(BUDGET_ENV), 0)
+        if explicit > 0:
+            return cls(total=explicit, source="env")
+        logical = _parse_int(env.get("CELL_CPU_LOGICAL") or env.get("CPU_LOGICAL"), 0)
+        source = "cpu_logical_env" if logical > 0 else "cpu_count"
+        if logical <= 0:
+            logical = os.cpu_count() or 1
+        fraction = _parse_fraction(
+            env.get("CELL_CPU_FRACTION_USED") or env.get("CELL_CPU_FRACTION"),
+            default_fraction,
+        )
+        return cls(total=max(int(math.floor(logical * fraction)), 1), source=source)
+
+    def partition(self, *, processes: int = 1, cell_workers: int = 1) -> ThreadPlan:
+        processes = max(int(processes), 1)
+        cell_workers = max(int(cell_workers), 1)
+        inner = max(self.total // (processes * cell_workers), 1)
+        return ThreadPlan(
+            total=self.total,
+            processes=processes,
+            cell_workers=cell_workers,
+            numba_threads=inner,
+            blas_threads=inner,
+        )
+
+    def to_dict(self) -> Dict[str, Any]:
+        return asdict(self)
+
+
+def cell_thread_limit(env: Optional[Mapping[str, str]] = None, *, default_fraction: float = 0.7) -> int:
+    """Inner thread cap per cell worker (``MARSDISK_CELL_JOBS`` workers)."""
+
+    env = env if env is not None else os.environ
+    budget = ThreadBudget.from_env(env, default_fraction=default_fraction)
+    jobs = _parse_int(env.get("MARSDISK_CELL_JOBS"), 1)
+    return budget.partition(cell_workers=jobs).numba_threads
+
+
+def apply_thread_guard(env: Optional[MutableMapping[str, str]] = None) -> Optional[ThreadBudget]:
+    """Prepare a sweep process before ``numpy``/``numba`` are imported.
+
+    BLAS defaults to one thread (raised per case by :func:`lease`), and
+    ``NUMBA_NUM_THREADS`` is set to the whole budget so the Numba pool is
+    large enough for tail cases; :func:`lease` lowers the active count.
+    ``MARSDISK_THREAD_GUARD=0`` leaves the environment untouched.
+    """
+
+    env = env if env is not None else os.environ
+    if str(env.get(GUARD_ENV, "1")).strip().lower() in _FALSE_VALUES:
+        return None
+    budget = ThreadBudget.from_env(env)
+    for key in ("OMP_NUM_THREADS", "MKL_NUM_THREADS", "OPENBLAS_NUM_THREADS"):
+        env.setdefault(key, "1")
+    env.setdefault("NUMBA_NUM_THREADS", str(budget.total))
+    env.setdefault(BUDGET_ENV, str(budget.total))
+    return budget
+
+
+def set_numba_threads(threads: int) -> Dict[str, Any]:
+    """Set the active Numba thread count, clamped to the pool size."""
+
+    result: Dict[str, Any] = {"requested": int(threads), "applied": None, "status": "skipped"}
+    try:
+        import numba  # type: ignore
+
+        cap = int(getattr(numba.config, "NUMBA_NUM_THREADS", threads) or threads)
+        numba.set_num_threads(max(1, min(int(threads), cap)))
+        result["applied"] = int(numba.get_num_threads())
+        result["status"] = "ok"
+    except Exception as exc:  # pragma: no cover - optional dependency
+        result["status"] = f"error: {exc!s}"
+    return result
+
+
+def _set_blas_threads(threads: int) -> Optional[Any]:
+    try:
+        from threadpoolctl import threadpool_limits  # type: ignore
+    except Exception:  # pragma: no cover - optional dependency
+        return None
+    try:
+        return threadpool_limits(limits=int(threads), user_api="blas")
+    except Exception:  # pragma: no cover - defensive
+        return None
+
+
+# Shared lease state installed in sweep workers by ``pool_options``.
+_POOL_STATE: Optional[Tuple[Any, Any, int, int, int]] = None
+
+
+def _install_pool_state(free: Any, started: Any, total: int, slots: int, n_tasks: int) -> None:
+    global _POOL_STATE
+    _POOL_STATE = (free, started, int(total), int(slots), int(n_tasks))
+
+
+def _pool_initializer(
+    state_args: Tuple[Any, ...],
+    extra_init: Optional[Callable[..., None]],
+    extra_args: Tuple[Any, ...],
+) -> None:
+    _install_pool_state(*state_args)
+    if extra_init is not None:
+        extra_init(*extra_args)
+
+
+def pool_options(
+    jobs: int,
+    n_tasks: int,
+    *,
+    budget: Optional[ThreadBudget] = None,
+    extra: Optional[Mapping[str, Any]] = None,
+    mp_context: Optional[Any] = None,
+) -> Tuple[Dict[str, Any], Dict[str, Any]]:
+    """``ProcessPoolExecutor`` kwargs installing the shared lease counter.
+
+    ``extra`` holds another ``initializer``/``initargs`` pair (e.g. from
+    :func:`marsdisk.runtime.placement.process_pool_options`) that is chained.
+    With ``mp_context`` the counters are created in that context and it is
+    passed on to the executor (shared values cannot cross start methods).
+    """
+
+    budget = budget or ThreadBudget.from_env()
+    slots = max(min(int(jobs), max(int(n_tasks), 1)), 1)
+    ctx = mp_context if mp_context is not None else multiprocessing
+    free = ctx.Value("i", budget.total)
+    started = ctx.Value("i", 0)
+    extra = dict(extra or {})
+    kwargs = {
+        "initializer": _pool_initializer,
+        "initargs": (
+            (free, started, budget.total, slots, int(n_tasks)),
+            extra.get("initializer"),
+            tuple(extra.get("initargs", ())),
+        ),
+    }
+    if mp_context is not None:
+        kwargs["mp_context"] = mp_context
+    report = {
+        "budget": budget.to_dict(),
+        "base_plan": budget.partition(processes=slots).to_dict(),
+        "dynamic": True,
+    }
+    return kwargs, report
+
+
+def _acquire_share() -> Tuple[int, Optional[Any]]:
+    if _POOL_STATE is None:
+        return ThreadBudget.from_env().total, None
+    free, started, total, slots, n_tasks = _POOL_STATE
+    with free.get_lock():
+        with started.get_lock():
+            index = started.value
+            started.value += 1
+        remaining = max(n_tasks - index, 1)
+        fair = max(total // min(slots, remaining), 1)
+        share = max(min(fair, free.value), 1)
+        free.value -= share
+    return share, free
+
+
+def _release_share(share: int, free: Optional[Any]) -> None:
+    if free is None:
+        return
+    with free.get_lock():
+        free.value += share
+
+
+@contextlib.contextmanager
+def lease(*, apply: bool = True) -> Iterator[ThreadPlan]:
+    """Take a share of the budget for one case.
+
+    Inside a pool created with :func:`pool_options` the share is drawn from
+    the shared free-core counter; otherwise the whole budget is granted.
+    With ``apply=True`` the share is enforced in-process (Numba and, when
+    ``threadpoolctl`` is available, BLAS); subprocess launchers pass
+    ``plan.env()`` instead.
+    """
+
+    share, free = _acquire_share()
+    plan = ThreadPlan(
+        total=_POOL_STATE[2] if _POOL_STATE is not None else share,
+        processes=1,
+        cell_workers=1,
+        numba_threads=share,
+        blas_threads=share,
+    )
+    blas_ctx = None
+    try:
+        if apply:
+            set_numba_threads(share)
+            blas_ctx = _set_blas_threads(share)
+        yield plan
+    finally:
+        if blas_ctx is not None:
+            try:
+                blas_ctx.restore_original_limits()
+            except Exception:  # pragma: no cover - defensive
+                pass
+        _release_share(share, free)
+
+
+__all__ = [
+    "BLAS_ENV_KEYS",
+    "BUDGET_ENV",
+    "ThreadBudget",
+    "ThreadPlan",
+    "apply_thread_guard",
+    "cell_thread_limit",
+    "lease",
+    "pool_options",
+    "set_numba_threads",
+]
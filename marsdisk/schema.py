@@ -28,7 +28,55 @@ class Geometry(BaseModel):
     mode: Literal["0D", "1D"] = Field("0D", description="Spatial dimension: '0D' (radially uniform) or '1D'")
     r_in: Optional[float] = Field(None, description="Inner radius for 1D runs [m]")
     r_out: Optional[float] = Field(None, description="Outer radius for 1D runs [m]")
-    Nr: Optional[int] = Field(None, description="Number of radial zones for 1D runs")
+    Nr: Optional[int] = Field(
+        None,
+        description="Number of radial zones for 1D runs (lower bound on the cell count for spacing='adaptive').",
+    )
+    spacing: Literal["linear", "log", "edges", "adaptive"] = Field(
+        "linear",
+        description=(
+            "1D cell layout: 'linear' or 'log' spacing between the disk radii, 'edges' for edges_RM, "
+            "'adaptive' to split/merge cells from the Sigma_surf/tau gradients of a pilot run."
+        ),
+    )
+    edges_RM: Optional[List[float]] = Field(
+        None,
+        description="Explicit cell edges [Mars radii] for spacing='edges'; Nr is taken as len(edges_RM)-1.",
+    )
+    adapt_from: Optional[Path] = Field(
+        None,
+        description="Output directory of a previous 1D run whose final Sigma_surf/tau drive spacing='adaptive'.",
+    )
+    adapt_split_tol: float = Field(
+        0.2,
+        gt=0.0,
+        description="Split a cell when |Δ ln Sigma_surf| or |Δ ln tau| to a neighbour exceeds this value.",
+    )
+    adapt_merge_tol: float = Field(
+        0.02,
+        ge=0.0,
+        description="Merge neighbouring cells when all nearby jumps stay below this value.",
+    )
+    adapt_max_cells: Optional[int] = Field(
+        None,
+        gt=0,
+        description="Upper bound on the adapted cell count (default: 4 x pilot cells).",
+    )
+
+    @model_validator(mode="after")
+    def _check_spacing(cls, model: "Geometry") -> "Geometry":
+        if model.spacing == "edges":
+            edges = model.edges_RM
+            if edges is None or len(edges) < 2:
+                raise ConfigurationError("geometry.spacing='edges' requires geometry.edges_RM with >= 2 entries")
+            if any(not math.isfinite(v) or v <= 0.0 for v in edges) or any(
+                b <= a for a, b in zip(edges[:-1], edges[1:])
+            ):
+                raise ConfigurationError("geometry.edges_RM must be positive and strictly increasing")
+            model.Nr = len(edges) - 1
+        if model.spacing == "adaptive" and model.adapt_from is None:
+            raise ConfigurationError("geometry.spacing='adaptive' requires geometry.adapt_from")
+        return model
 
     @model_validator(mode="before")
     def _forbid_deprecated_radius(cls, data: Any) -> Any:
@@ -1680,6 +1728,13 @@ class Checkpoint(BaseModel):
         ge=0,
         description="Keep at most N recent checkpoints (0 disables pruning).",
     )
+    flush_streaming: bool = Field(
+        False,
+        description=(
+            "Flush streaming chunks (and refresh the partial summary) right before each checkpoint, "
+            "so the outputs on disk end exactly where a resumed run continues."
+        ),
+    )
 
 
 class Resume(BaseModel):
@@ -1730,6 +1785,13 @@ class Numerics(BaseModel):
         False,
         description="Stop the run early if the blow-out grain size falls below the configured minimum size.",
     )
+    retire_inert_cells: bool = Field(
+        True,
+        description=(
+            "1D only: retire a cell once its surface and deep reservoirs are empty and supply is disabled, "
+            "and stop the run when every cell is retired."
+        ),
+    )
     mass_loss_rate_stop_Mmars_s: Optional[float] = Field(
         None,
         ge=0.0,
@@ -1845,14 +1907,54 @@ class StepDiagnostics(BaseModel):
         False,
         description="Write per-step loss diagnostics to disk (CSV or JSONL).",
     )
-    format: Literal["csv", "jsonl"] = Field(
+    format: Literal["csv", "jsonl", "parquet"] = Field(
         "csv",
-        description="Serialisation format for the per-step diagnostics table.",
+        description=(
+            "Serialisation format for the per-step diagnostics table; 'parquet' appends one "
+            "compressed row group per streaming flush."
+        ),
     )
     path: Optional[Path] = Field(
         None,
         description="Optional path (absolute or relative to outdir) for the diagnostics file.",
     )
+    compression: Literal["snappy", "zstd", "gzip", "none"] = Field(
+        "zstd",
+        description="Parquet compression codec for format='parquet'.",
+    )
+    sampling: Literal["all", "adaptive"] = Field(
+        "all",
+        description=(
+            "'all' writes every step; 'adaptive' writes every sparse_stride-th step and "
+            "densely around phase transitions, dt collapses, mass-budget excursions and early stops."
+        ),
+    )
+    sparse_stride: int = Field(
+        100,
+        ge=1,
+        description="Step stride between rows written outside events (adaptive sampling).",
+    )
+    window_steps: int = Field(
+        64,
+        ge=0,
+        description="Rolling in-memory window of skipped rows dumped when an event fires.",
+    )
+    post_event_steps: int = Field(
+        64,
+        ge=0,
+        description="Number of steps written densely after an event.",
+    )
+    dt_collapse_ratio: float = Field(
+        0.1,
+        gt=0.0,
+        le=1.0,
+        description="Event when dt/n_substeps drops below this fraction of the previous step's value.",
+    )
+    mass_error_percent: Optional[float] = Field(
+        0.1,
+        ge=0.0,
+        description="Event when the step mass-budget error exceeds this percentage (null disables).",
+    )
 
 
 class Progress(BaseModel):
@@ -1947,6 +2049,14 @@ class Streaming(BaseModel):
         default_factory=StreamingOffload,
         description="Optional offload settings for moving old chunks to external storage.",
     )
+    partial_summary: bool = Field(
+        True,
+        description=(
+            "Atomically refresh summary.partial.json (summary_status='partial') after every chunk "
+            "flush with cumulative losses, current time and performance counters; summary.json "
+            "itself is only written when the run finishes."
+        ),
+    )
 
     @field_validator("memory_limit_gb")
     def _check_memory_limit(cls, value: float) -> float:
@@ -1961,6 +2071,60 @@ class Streaming(BaseModel):
         return int(value)
 
 
+class MemoryBudget(BaseModel):
+    """Memory budget planner and runtime watchdog (``marsdisk.runtime.memory_plan``)."""
+
+    enable: bool = Field(
+        False,
+        description=(
+            "Size streaming flushes, collision caches, PSD history stride and cell workers "
+            "so the estimated footprint stays within the budget. Advisory: a plan that "
+            "cannot fit only logs a warning and the run continues."
+        ),
+    )
+    budget_gb: Optional[float] = Field(
+        None,
+        gt=0.0,
+        description="Memory budget in gigabytes; when unset, the cgroup limit (or physical memory) is used.",
+    )
+    headroom_fraction: float = Field(
+        0.85,
+        gt=0.0,
+        le=1.0,
+        description="Fraction of the budget the planner may fill; the watchdog degrades above it.",
+    )
+    min_flush_interval: int = Field(
+        64,
+        ge=1,
+        description="Smallest step_flush_interval the planner chooses before raising the PSD history stride.",
+    )
+    min_cache_scale: float = Field(
+        0.25,
+        gt=0.0,
+        description="Lower bound for the collision cache size_scale chosen by the planner or watchdog.",
+    )
+    max_psd_history_stride: int = Field(
+        64,
+        ge=1,
+        description="Upper bound for the PSD history stride chosen by the planner or watchdog.",
+    )
+    watchdog: bool = Field(
+        True,
+        description="Check the resident set size during the run and degrade gracefully above the budget.",
+    )
+    watchdog_interval_steps: int = Field(
+        100,
+        ge=1,
+        description="Step interval between resident set size checks.",
+    )
+
+    @field_validator("min_cache_scale")
+    def _check_min_cache_scale(cls, value: float) -> float:
+        if not math.isfinite(value) or value <= 0.0:
+            raise ConfigurationError("io.memory_budget.min_cache_scale must be positive and finite")
+        return float(value)
+
+
 class Archive(BaseModel):
     """Archive controls for offloading completed runs to external storage."""
 
@@ -2062,10 +2226,15 @@ class IO(BaseModel):
     step_diagnostics: StepDiagnostics = StepDiagnostics()
     progress: Progress = Progress()
     streaming: Streaming = Field(default_factory=Streaming)
+    memory_budget: MemoryBudget = Field(default_factory=MemoryBudget)
     archive: Archive = Field(default_factory=Archive)
-    record_storage_mode: Literal["row", "columnar"] = Field(
+    record_storage_mode: Literal["row", "columnar", "array"] = Field(
         "row",
-        description="Storage mode for series/diagnostic records (row or columnar).",
+        description=(
+            "Storage mode for series/diagnostic records: row (list of dicts), columnar "
+            "(per-column lists) or array (preallocated NumPy columns handed to Arrow "
+            "without copying)."
+        ),
     )
     columnar_records: Optional[bool] = Field(
         None,
@@ -2090,10 +2259,37 @@ class IO(BaseModel):
         ge=1,
         description="Stride for diagnostics output (1 = every step).",
     )
+    output_profile: Literal["minimal", "standard", "full"] = Field(
+        "full",
+        description=(
+            "Column set written to series/run.parquet and diagnostics.parquet. "
+            "'full' keeps every column; 'standard' keeps the commonly analysed subset; "
+            "'minimal' keeps the mass-loss essentials and skips diagnostics entirely."
+        ),
+    )
+    series_columns: Optional[List[str]] = Field(
+        None,
+        description="Explicit run.parquet column list (overrides output_profile; time/dt are always kept).",
+    )
+    diagnostic_columns: Optional[List[str]] = Field(
+        None,
+        description="Explicit diagnostics.parquet column list; an empty list disables diagnostics output.",
+    )
+    float32_columns: List[str] = Field(
+        default_factory=list,
+        description="float64 columns stored as float32 in series/diagnostics; '*' selects all except time/dt.",
+    )
     mass_budget_cells: bool = Field(
         True,
         description="Write per-cell mass budget to checks/mass_budget_cells.csv.",
     )
+    mass_budget_format: Literal["csv", "parquet"] = Field(
+        "csv",
+        description=(
+            "Format of checks/mass_budget*.  'parquet' appends one row group per flush "
+            "to checks/mass_budget.parquet instead of formatting CSV rows."
+        ),
+    )
     quiet: bool = Field(
         False,
         description="Suppress INFO logging and Python warnings for cleaner CLI output.",
@@ -2117,6 +2313,16 @@ class IO(BaseModel):
         description="Upper limit for dt/t_blow before a step is subdivided (1.0 is effectively disabled; typical 0.3-0.5).",
     )
 
+    @field_validator("series_columns", "diagnostic_columns", "float32_columns")
+    @classmethod
+    def _validate_column_names(cls, value: Optional[List[str]], info: ValidationInfo) -> Optional[List[str]]:
+        if value is None:
+            return value
+        cleaned = [str(name).strip() for name in value]
+        if any(not name for name in cleaned):
+            raise ConfigurationError(f"io.{info.field_name} must not contain empty column names")
+        return cleaned
+
     @model_validator(mode="after")
     def _resolve_record_storage_mode(self) -> "IO":
         if self.columnar_records is not None:
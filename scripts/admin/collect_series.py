@@ -1,13 +1,24 @@
 #!/usr/bin/env python3
-"""Concatenate time-series outputs from multiple simulation runs."""
+"""Concatenate time-series outputs from multiple simulation runs.
+
+Series files are read in parallel (optionally only ``--columns``), and runs
+whose ``series/run.parquet`` is unchanged since the previous ``--out`` are
+copied from it instead of being read again (see
+:func:`marsdisk.io.sweep_collect.collect_series`).
+"""
 
 from __future__ import annotations
 
 import argparse
+import sys
 from pathlib import Path
-from typing import Iterable, List
+from typing import Dict, Iterable, List, Optional, Sequence
+
+REPO_ROOT = Path(__file__).resolve().parents[2]
+if str(REPO_ROOT) not in sys.path:
+    sys.path.insert(0, str(REPO_ROOT))
 
-import pandas as pd
+from marsdisk.io import sweep_collect
 
 
 def _iter_series_paths(root: Path) -> Iterable[Path]:
@@ -18,22 +29,17 @@ def _iter_series_paths(root: Path) -> Iterable[Path]:
     return sorted(root.glob("*/*/series/run.parquet"))
 
 
-def collect_series(roots: List[Path], out_path: Path) -> None:
+def collect_series(
+    roots: List[Path],
+    out_path: Path,
+    *,
+    columns: Optional[Sequence[str]] = None,
+    jobs: int = sweep_collect.DEFAULT_IO_WORKERS,
+) -> Dict[str, int]:
     """Aggregate series tables under ``roots`` and write a combined Parquet file."""
 
-    frames: list[pd.DataFrame] = []
-    for root in roots:
-        for series_path in _iter_series_paths(root):
-            run_dir = series_path.parent.parent
-            case_dir = run_dir.parent
-            df = pd.read_parquet(series_path)
-            df = df.assign(case_id=case_dir.name, outdir=str(run_dir))
-            frames.append(df)
-    if not frames:
-        raise FileNotFoundError("No series/run.parquet files found under the provided roots.")
-    combined = pd.concat(frames, ignore_index=True)
-    out_path.parent.mkdir(parents=True, exist_ok=True)
-    combined.to_parquet(out_path, index=False)
+    series_paths = [path for root in roots for path in _iter_series_paths(root)]
+    return sweep_collect.collect_series(series_paths, out_path, columns=columns, jobs=jobs)
 
 
 def _parse_args() -> argparse.Namespace:
@@ -49,6 +55,18 @@ def _parse_args() -> argparse.Namespace:
         required=True,
         help="Destination Parquet file.",
     )
+    parser.add_argument(
+        "--columns",
+        nargs="+",
+        default=None,
+        help="Only read these series columns (default: all).",
+    )
+    parser.add_argument(
+        "--jobs",
+        type=int,
+        default=sweep_collect.DEFAULT_IO_WORKERS,
+        help="Reader threads.",
+    )
     return parser.parse_args()
 
 
@@ -58,7 +76,11 @@ def main() -> None:
     args = _parse_args()
     roots = [Path(item).expanduser().resolve() for item in args.roots]
     out_path = Path(args.out).expanduser().resolve()
-    collect_series(roots, out_path)
+    report = collect_series(roots, out_path, columns=args.columns, jobs=args.jobs)
+    print(
+        f"[collect_series] {report['runs']} runs -> {out_path} "
+        f"(read {report['read']}, reused {report['reused']})"
+    )
 
 
 if __name__ == "__main__":
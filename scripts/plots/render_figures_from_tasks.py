@@ -3,8 +3,13 @@
 figure_tasks.json と resolved_manifest.json を読み込み、
 run_id→outdir を解決した上で図再生成コマンドのスケッチを出力する。
 
-実際の描画スクリプトのCLIはプロジェクト固有なので、本スクリプトは
+実際の描画スクリプトのCLIはプロジェクト固有なので、既定では
 「推奨コマンド」を commands.txt に書き出すのみ（自動実行はしない）。
+
+``--execute`` を付けると各タスクを図ビルドグラフ
+（tools/plotting/figure_graph.py）に登録して実行する。入力（描画スクリプト、
+run ディレクトリの summary/series/checks）の内容ハッシュが前回から
+変わったタスクだけを再実行し、独立したタスクは ``--jobs`` 並列で回す。
 """
 
 from __future__ import annotations
@@ -12,9 +17,20 @@ from __future__ import annotations
 import argparse
 import json
 import shlex
+import subprocess
+import sys
 from pathlib import Path
 from typing import Any, Dict, List
 
+REPO_ROOT = Path(__file__).resolve().parents[2]
+if str(REPO_ROOT) not in sys.path:
+    sys.path.insert(0, str(REPO_ROOT))
+
+from tools.plotting.figure_graph import FigureGraph
+
+DEFAULT_CACHE_MANIFEST = REPO_ROOT / ".cache" / "figures" / "figure_tasks.json"
+RUN_INPUT_PATTERNS = ("summary.json", "run_config.json", "series/*.parquet", "checks/*.csv")
+
 try:
     from paper.plot_style import apply_default_style
 except Exception:  # pragma: no cover - optional dependency path
@@ -44,11 +60,56 @@ def build_command(script: str, fig_id: str, run_paths: List[str], params: Dict[s
     return " ".join(shlex.quote(part) for part in cmd_parts)
 
 
+def run_inputs(run_path: str) -> List[Path]:
+    """run ディレクトリ内で図の入力になりうる成果物。"""
+
+    run_dir = Path(run_path)
+    if not run_dir.is_dir():
+        return []
+    paths: List[Path] = []
+    for pattern in RUN_INPUT_PATTERNS:
+        paths.extend(sorted(run_dir.glob(pattern)))
+    return paths
+
+
+def run_command(argv: List[str]) -> None:
+    subprocess.run(argv, check=True, cwd=REPO_ROOT)
+
+
+def build_graph(tasks: List[Dict[str, Any]], run_dir_map: Dict[str, str], manifest: Path | None) -> FigureGraph:
+    graph = FigureGraph(manifest)
+    for task in tasks:
+        fig_id = task.get("fig_id", "UNKNOWN")
+        script = task.get("script", "")
+        params = task.get("params", {}) or {}
+        run_paths = [run_dir_map.get(rid, rid) for rid in task.get("runs", [])]
+        inputs: List[Path] = [REPO_ROOT / script] if script else []
+        for run_path in run_paths:
+            inputs.extend(run_inputs(run_path))
+        graph.add(
+            fig_id,
+            run_command,
+            inputs=inputs,
+            outputs=[Path(p) for p in task.get("outputs", []) or []],
+            argv=shlex.split(build_command(script, fig_id, run_paths, params)),
+        )
+    return graph
+
+
 def main() -> None:
     parser = argparse.ArgumentParser(description="Render suggested commands from figure_tasks.json")
     parser.add_argument("--tasks", required=True, type=Path, help="figure_tasks.json from paper_manifest")
     parser.add_argument("--resolved-manifest", type=Path, help="resolved_manifest.json to map run_id->outdir")
     parser.add_argument("--commands-out", type=Path, help="path to write suggested commands (default: tasks dir/figure_commands.txt)")
+    parser.add_argument("--execute", action="store_true", help="run stale tasks through the figure build graph")
+    parser.add_argument("--jobs", type=int, default=1, help="parallel tasks with --execute")
+    parser.add_argument("--force", action="store_true", help="with --execute, rerun every task")
+    parser.add_argument(
+        "--cache-manifest",
+        type=Path,
+        default=DEFAULT_CACHE_MANIFEST,
+        help="input-hash manifest used by --execute",
+    )
     args = parser.parse_args()
 
     apply_default_style()  # ensure downstream scripts share unified style if they import this module
@@ -71,6 +132,19 @@ def main() -> None:
     out_path.write_text("\n".join(commands) + "\n", encoding="utf-8")
     print(f"[render_figures_from_tasks] wrote {out_path} ({len(commands)} commands)")
 
+    if args.execute:
+        graph = build_graph(tasks_data, run_dir_map, args.cache_manifest)
+        # Each task is its own subprocess, so threads are enough to overlap them.
+        report = graph.run(jobs=args.jobs, force=args.force, executor="thread")
+        print(
+            f"[render_figures_from_tasks] built={report['built']} cached={report['cached']} "
+            f"failed={len(report['failed'])}"
+        )
+        for entry in report["failed"]:
+            print(f"  [failed] {entry['fig_id']}: {entry['error']}", file=sys.stderr)
+        if report["failed"]:
+            raise SystemExit(1)
+
 
 if __name__ == "__main__":
     main()
@@ -1,50 +1,29 @@
 #!/usr/bin/env python3
-"""Compute thread cap for cell-parallel runs."""
-from __future__ import annotations
-
-import math
-import os
+"""Compute thread cap for cell-parallel runs.
 
+The partition is delegated to ``marsdisk/runtime/thread_budget.py`` (loaded by
+path so this helper stays import-light); CELL_CPU_FRACTION(_USED) defaults to
+0.7 here, as before.
+"""
+from __future__ import annotations
 
-def _parse_fraction(value: str | None, default: float) -> float:
-    try:
-        parsed = float(value)
-    except (TypeError, ValueError):
-        return default
-    if parsed <= 0 or parsed > 1:
-        return default
-    return parsed
-
+import importlib.util
+import sys
+from pathlib import Path
 
-def _parse_int(value: str | None, default: int) -> int:
-    try:
-        parsed = int(value)
-    except (TypeError, ValueError):
-        return default
-    if parsed <= 0:
-        return default
-    return parsed
+_BUDGET_PATH = Path(__file__).resolve().parents[3] / "marsdisk" / "runtime" / "thread_budget.py"
 
 
-def _get_cpu_logical() -> int:
-    env_val = os.environ.get("CELL_CPU_LOGICAL") or os.environ.get("CPU_LOGICAL")
-    count = _parse_int(env_val, 0)
-    if count <= 0:
-        count = os.cpu_count() or 0
-    if count <= 0:
-        count = 1
-    return count
+def _load_thread_budget():
+    spec = importlib.util.spec_from_file_location("_marsdisk_thread_budget", _BUDGET_PATH)
+    module = importlib.util.module_from_spec(spec)
+    sys.modules[spec.name] = module
+    spec.loader.exec_module(module)
+    return module
 
 
 def main() -> int:
-    cpu_logical = _get_cpu_logical()
-    jobs = _parse_int(os.environ.get("MARSDISK_CELL_JOBS"), 1)
-    fraction = _parse_fraction(
-        os.environ.get("CELL_CPU_FRACTION_USED") or os.environ.get("CELL_CPU_FRACTION"),
-        0.7,
-    )
-    limit = max(int(math.floor(cpu_logical * fraction / jobs)), 1)
-    print(limit)
+    print(_load_thread_budget().cell_thread_limit(default_fraction=0.7))
     return 0
 
 
@@ -50,6 +50,16 @@ def _format_title_token(raw: str) -> str:
     return token
 
 
+def _has_override_key(paths: list[str | None], prefix: str) -> bool:
+    for path in paths:
+        if not path or not Path(path).exists():
+            continue
+        for line in Path(path).read_text(encoding="utf-8").splitlines():
+            if line.strip().startswith(prefix):
+                return True
+    return False
+
+
 def _run_command(
     cmd: list[str],
     *,
@@ -222,6 +232,19 @@ def main() -> int:
     title = "_".join(title_parts)
     outdir_rel = batch_dir / title
     outdir = outdir_rel.resolve()
+
+    recovery = None
+    recovery_info = None
+    if _is_true(_env("SWEEP_RESUME", "1")):
+        if str(repo_root) not in sys.path:
+            sys.path.insert(0, str(repo_root))
+        from marsdisk.io import recovery
+
+        recovery_info = recovery.inspect_run(outdir)
+        if recovery_info.sweep_action == "skip":
+            log_info(f"case already complete; skipping: {outdir}")
+            return 0
+
     (outdir / "series").mkdir(parents=True, exist_ok=True)
     (outdir / "checks").mkdir(parents=True, exist_ok=True)
 
@@ -296,6 +319,27 @@ def main() -> int:
             case_lines.append(f"io.substep_max_ratio={substep_max_ratio}")
     if stream_mem_gb:
         case_lines.append(f"io.streaming.memory_limit_gb={stream_mem_gb}")
+    checkpoint_years = _env("SWEEP_CHECKPOINT_INTERVAL_YEARS", "0.1")
+    if checkpoint_years and float(checkpoint_years) > 0.0 and not _has_override_key(
+        [base_overrides_file, extra_overrides_file], "numerics.checkpoint."
+    ):
+        case_lines.extend(
+            [
+                "numerics.checkpoint.enabled=true",
+                f"numerics.checkpoint.interval_years={checkpoint_years}",
+                "numerics.checkpoint.flush_streaming=true",
+            ]
+        )
+    if recovery_info is not None and recovery_info.sweep_action == "resume":
+        log_info(
+            f"resume from {recovery_info.latest_checkpoint} "
+            f"(remaining={recovery_info.remaining_fraction:.0%})"
+        )
+        case_lines.extend(recovery_info.resume_overrides())
+    elif recovery_info is not None and recovery_info.status == recovery.SUMMARY_PARTIAL:
+        log_warn(f"partial outputs without checkpoint; restarting fresh: {outdir}")
+        if not args.dry_run:
+            recovery.clear_partial_outputs(outdir)
 
     Path(case_overrides_file).write_text("\n".join(case_lines) + "\n", encoding="utf-8")
 
@@ -3,14 +3,20 @@
 from __future__ import annotations
 
 import argparse
+import json
 import os
 import secrets
 import shlex
+import socket
 import subprocess
 import sys
+import threading
+import time
 import traceback
 from pathlib import Path
-from typing import Iterable, Iterator
+from typing import Callable, Iterable, Iterator
+
+CLAIM_NAME = ".sweep_claim"
 
 
 def _env(name: str, default: str | None = None) -> str | None:
@@ -156,6 +162,181 @@ def _load_sweep_list(path: Path) -> list[tuple[str, str, str, str | None, str |
     return cases
 
 
+def _case_title(
+    t_val: str,
+    eps_val: str,
+    tau_val: str,
+    i0_val: str | None,
+    mu_val: str | None,
+) -> str:
+    title_parts = [f"T{t_val}", f"eps{_format_title_token(eps_val)}", f"tau{_format_title_token(tau_val)}"]
+    if i0_val:
+        title_parts.append(f"i0{_format_title_token(i0_val)}")
+    if mu_val:
+        title_parts.append(f"mu{_format_title_token(mu_val)}")
+    return "_".join(title_parts)
+
+
+def _pid_alive(pid: int) -> bool:
+    if pid <= 0:
+        return False
+    if os.name == "nt":
+        # os.kill(pid, 0) terminates the process on Windows; ask tasklist instead.
+        result = subprocess.run(["tasklist", "/FI", f"PID eq {pid}"], capture_output=True, check=False)
+        return result.returncode == 0 and str(pid).encode("ascii") in (result.stdout or b"")
+    try:
+        os.kill(pid, 0)
+    except ProcessLookupError:
+        return False
+    except PermissionError:
+        return True
+    except OSError:
+        return False
+    return True
+
+
+class _CaseClaim:
+    """Exclusive claim on a case directory, kept fresh by a heartbeat thread.
+
+    A worker that is preempted mid-case stops refreshing its claim.  The claim
+    counts as stale once its owner process is gone (same host) or it has not
+    been touched for ``stale_seconds``; any worker may then take the case over.
+    """
+
+    def __init__(self, outdir: Path, owner: str, stale_seconds: float) -> None:
+        self.path = outdir / CLAIM_NAME
+        self.owner = owner
+        self.stale_seconds = max(float(stale_seconds), 1.0)
+        self._stop = threading.Event()
+        self._thread: threading.Thread | None = None
+
+    def _stale(self) -> bool:
+        try:
+            age = time.time() - self.path.stat().st_mtime
+            text = self.path.read_text(encoding="utf-8")
+        except OSError:
+            return True
+        try:
+            holder = json.loads(text)
+        except ValueError:
+            holder = {}
+        if holder.get("host") == socket.gethostname():
+            try:
+                if not _pid_alive(int(holder.get("pid", 0))):
+                    return True
+            except (TypeError, ValueError):
+                return True
+        return age > self.stale_seconds
+
+    def acquire(self) -> bool:
+        token = json.dumps({"owner": self.owner, "host": socket.gethostname(), "pid": os.getpid()})
+        try:
+            fd = os.open(self.path, os.O_CREAT | os.O_EXCL | os.O_WRONLY)
+        except FileExistsError:
+            if not self._stale():
+                return False
+            tmp_path = self.path.with_name(f"{CLAIM_NAME}.{os.getpid()}.tmp")
+            tmp_path.write_text(token, encoding="utf-8")
+            os.replace(tmp_path, self.path)
+            # Two workers may take over the same stale claim; the last write wins.
+            time.sleep(0.1)
+            try:
+                if self.path.read_text(encoding="utf-8") != token:
+                    return False
+            except OSError:
+                return False
+        else:
+            with os.fdopen(fd, "w", encoding="utf-8") as fh:
+                fh.write(token)
+        self._thread = threading.Thread(target=self._heartbeat, daemon=True)
+        self._thread.start()
+        return True
+
+    def _heartbeat(self) -> None:
+        interval = self.stale_seconds / 3.0
+        while not self._stop.wait(interval):
+            try:
+                os.utime(self.path)
+            except OSError:
+                return
+
+    def release(self) -> None:
+        self._stop.set()
+        if self._thread is not None:
+            self._thread.join(timeout=5.0)
+        try:
+            self.path.unlink()
+        except OSError:
+            pass
+
+
+def _claim_cases(
+    cases: list[dict],
+    *,
+    owner: str,
+    stale_seconds: float,
+    is_done: Callable[[dict], bool],
+    poll_seconds: float | None = None,
+    log: Callable[[str], None] = lambda message: None,
+) -> Iterator[tuple[dict, _CaseClaim]]:
+    """Yield ``(case, claim)`` for every case this worker manages to claim.
+
+    Cases held by another worker are polled again until their holder finishes
+    them (``is_done``) or its claim goes stale, so a case whose holder is
+    preempted at any point is still picked up by a worker that is running.
+    """
+
+    if poll_seconds is None:
+        poll_seconds = min(max(float(stale_seconds), 1.0) / 3.0, 30.0)
+    pending = list(cases)
+    first_pass = True
+    while pending:
+        deferred: list[dict] = []
+        claimed_any = False
+        for case in pending:
+            if not first_pass and is_done(case):
+                log(f"case finished by another worker: {case['outdir'].name}")
+                continue
+            case["outdir"].mkdir(parents=True, exist_ok=True)
+            claim = _CaseClaim(case["outdir"], owner, stale_seconds)
+            if claim.acquire():
+                claimed_any = True
+                yield case, claim
+            else:
+                deferred.append(case)
+        if deferred and not first_pass and not claimed_any:
+            log(f"{len(deferred)} case(s) held by other workers; polling again in {poll_seconds:.0f}s")
+            time.sleep(poll_seconds)
+        pending = deferred
+        first_pass = False
+
+
+def _schedule_cases(
+    cases: list[dict],
+    *,
+    part_index: int,
+    part_count: int,
+    mode: str,
+) -> list[dict]:
+    """Order the cases this worker should attempt.
+
+    ``static`` keeps the round-robin share of the sweep list.  ``claim`` lets
+    every worker walk the whole list and take cases through claim files, so
+    cases of a preempted worker are picked up by the others.  Either way the
+    cases with the largest remaining cost go first (longest-processing-time
+    order), and in ``claim`` mode ties go to the worker's own share first so a
+    fresh sweep starts out like the static split.
+    """
+
+    def own(case: dict) -> bool:
+        return part_count <= 1 or case["index"] % part_count == (part_index - 1)
+
+    pending = [case for case in cases if case["remaining"] > 0.0]
+    if mode != "claim":
+        pending = [case for case in pending if own(case)]
+    return sorted(pending, key=lambda case: (-case["remaining"], 0 if own(case) else 1, case["index"]))
+
+
 def main(argv: list[str] | None = None) -> int:
     ap = argparse.ArgumentParser(description=__doc__)
     ap.add_argument("--sweep-list", default=None)
@@ -321,30 +502,69 @@ def main(argv: list[str] | None = None) -> int:
     seed_override = _env("SEED_OVERRIDE")
     existing_override_keys = {key for key, _ in [*base_pairs, *extra_pairs]}
 
+    resume_enabled = _is_true(_env("SWEEP_RESUME", "1"))
+    checkpoint_years = _env("SWEEP_CHECKPOINT_INTERVAL_YEARS", "0.1")
+    schedule_mode = (_env("SWEEP_SCHEDULE") or ("claim" if part_count > 1 else "static")).strip().lower()
+    if schedule_mode not in {"static", "claim"}:
+        log_warn(f"unknown SWEEP_SCHEDULE={schedule_mode}; using static")
+        schedule_mode = "static"
+    claim_stale_seconds = float(_env("SWEEP_CLAIM_STALE_SECONDS") or 900.0)
+    worker_owner = f"{socket.gethostname()}:{os.getpid()}:{worker_tag}"
+
     exit_code = 0
     from marsdisk import run_zero_d
+    from marsdisk.io import recovery
+
+    case_specs: list[dict] = []
+    for idx, values in enumerate(cases):
+        outdir = (batch_dir / _case_title(*values)).resolve()
+        info = recovery.inspect_run(outdir) if resume_enabled else None
+        case_specs.append(
+            {
+                "index": idx,
+                "values": values,
+                "outdir": outdir,
+                "remaining": 1.0 if info is None else info.remaining_fraction,
+            }
+        )
+    scheduled = _schedule_cases(case_specs, part_index=part_index, part_count=part_count, mode=schedule_mode)
+    n_complete = sum(1 for case in case_specs if case["remaining"] <= 0.0)
+    n_partial = sum(1 for case in scheduled if case["remaining"] < 1.0)
+    log_info(
+        f"schedule={schedule_mode}: {len(scheduled)} case(s) queued, "
+        f"{n_partial} partially done, {n_complete} already complete"
+    )
 
-    for idx, (t_val, eps_val, tau_val, i0_val, mu_val) in enumerate(cases):
-        if part_count > 1 and idx % part_count != (part_index - 1):
-            continue
+    def iter_cases() -> Iterator[tuple[dict, _CaseClaim | None]]:
+        if schedule_mode != "claim" or args.dry_run:
+            for case in scheduled:
+                yield case, None
+            return
+        yield from _claim_cases(
+            scheduled,
+            owner=worker_owner,
+            stale_seconds=claim_stale_seconds,
+            is_done=lambda case: recovery.inspect_run(case["outdir"]).sweep_action == "skip",
+            log=log_debug,
+        )
+
+    def _run_case(case: dict) -> int | None:
+        t_val, eps_val, tau_val, i0_val, mu_val = case["values"]
+        outdir = case["outdir"]
+        info = recovery.inspect_run(outdir) if resume_enabled else None
+        if info is not None and info.sweep_action == "skip":
+            log_info(f"case already complete: {outdir}")
+            return None
 
         t_table = f"data/mars_temperature_T{t_val}p0K.csv"
-        eps_title = _format_title_token(eps_val)
-        tau_title = _format_title_token(tau_val)
-        i0_title = _format_title_token(i0_val) if i0_val else None
-        mu_title = _format_title_token(mu_val) if mu_val else None
         if seed_override:
             seed_value = seed_override
+        elif info is not None and info.sweep_action == "resume" and info.rng_seed is not None:
+            # Keep the seed of the segment that wrote the rows before the checkpoint.
+            seed_value = str(info.rng_seed)
         else:
             seed_value = str(secrets.randbelow(2**31))
 
-        title_parts = [f"T{t_val}", f"eps{eps_title}", f"tau{tau_title}"]
-        if i0_title:
-            title_parts.append(f"i0{i0_title}")
-        if mu_title:
-            title_parts.append(f"mu{mu_title}")
-        title = "_".join(title_parts)
-        outdir = (batch_dir / title).resolve()
         (outdir / "series").mkdir(parents=True, exist_ok=True)
         (outdir / "checks").mkdir(parents=True, exist_ok=True)
 
@@ -390,6 +610,26 @@ def main(argv: list[str] | None = None) -> int:
                 case_lines.append(f"io.substep_max_ratio={substep_max_ratio}")
         if stream_mem_gb:
             case_lines.append(f"io.streaming.memory_limit_gb={stream_mem_gb}")
+        if (
+            checkpoint_years
+            and float(checkpoint_years) > 0.0
+            and "numerics.checkpoint.enabled" not in existing_override_keys
+            and "numerics.checkpoint.interval_years" not in existing_override_keys
+        ):
+            case_lines.extend(
+                [
+                    "numerics.checkpoint.enabled=true",
+                    f"numerics.checkpoint.interval_years={checkpoint_years}",
+                    "numerics.checkpoint.flush_streaming=true",
+                ]
+            )
+        if info is not None and info.sweep_action == "resume":
+            log_info(f"resume from {info.latest_checkpoint} (remaining={info.remaining_fraction:.0%})")
+            case_lines.extend(info.resume_overrides())
+        elif info is not None and info.status == recovery.SUMMARY_PARTIAL:
+            log_warn(f"partial outputs without checkpoint; restarting fresh: {outdir}")
+            if not args.dry_run:
+                recovery.clear_partial_outputs(outdir)
 
         case_overrides_file.parent.mkdir(parents=True, exist_ok=True)
         case_overrides_file.write_text("\n".join(case_lines) + "\n", encoding="utf-8")
@@ -400,7 +640,7 @@ def main(argv: list[str] | None = None) -> int:
 
         if args.dry_run:
             log_info("dry-run: skipping marsdisk.run execution")
-            continue
+            return None
 
         run_args = [
             "--config",
@@ -458,10 +698,20 @@ def main(argv: list[str] | None = None) -> int:
                 if hook_result.returncode != 0:
                     log_warn(f"hook {hook} failed [rc={hook_result.returncode}]")
                     if hooks_strict:
-                        exit_code = hook_result.returncode or 1
-                        break
-            if exit_code != 0 and hooks_strict:
-                break
+                        return hook_result.returncode or 1
+        return 0
+
+    for case, claim in iter_cases():
+        try:
+            rc_case = _run_case(case)
+        finally:
+            if claim is not None:
+                claim.release()
+        if rc_case is None:
+            continue
+        if rc_case != 0:
+            exit_code = rc_case
+            break
 
     return exit_code
 
@@ -24,23 +24,16 @@ import math
 import shutil
 import tempfile
 from pathlib import Path
-from typing import Dict, Iterable, List, Tuple
+from typing import Dict, Iterable, Iterator, List, Optional, Tuple
 
+import matplotlib
+
+matplotlib.use("Agg")
 import matplotlib.pyplot as plt
 import numpy as np
 import pandas as pd
 import sys
 
-try:
-    from PIL import Image
-except ImportError:  # pragma: no cover - optional dependency
-    Image = None  # type: ignore[assignment]
-
-try:
-    import imageio.v2 as imageio
-except ImportError:  # pragma: no cover - optional dependency
-    imageio = None  # type: ignore[assignment]
-
 ROOT = Path(__file__).resolve().parents[1]
 DEFAULT_CONFIG = ROOT / "configs" / "innerdisk_base.yml"
 DEFAULT_OUTDIR = ROOT / "out"
@@ -49,6 +42,7 @@ DEFAULT_PHI_TABLES = {
     "037": ROOT / "data" / "phi_tau_phi1_037.csv",
     "060": ROOT / "data" / "phi_tau_phi1_060.csv",
 }
+ROLLUP_COLUMNS = ["orbit_index", "M_out_orbit"]
 PHI_CASE_VALUES = {
     "020": 0.20,
     "037": 0.37,
@@ -59,6 +53,7 @@ if str(ROOT) not in sys.path:
     sys.path.insert(0, str(ROOT))
 
 from marsdisk import config_utils, constants
+from tools.plotting.frame_stream import figure_to_rgb, open_gif_encoder, stream_frames, write_png
 from marsdisk.run import load_config, run_zero_d
 from marsdisk.schema import Config, Radiation, Shielding
 
@@ -198,10 +193,11 @@ def _run_single_case(
         orbit_path = _resolve_table_path(tmpdir / "orbit_rollup.csv")
         orbit_df: pd.DataFrame | None = None
         if orbit_path.exists():
+            # Only the per-orbit outflow feeds the frames; skip the other columns.
             if orbit_path.suffix.lower() in {".parquet", ".pq"}:
-                tmp_df = pd.read_parquet(orbit_path)
+                tmp_df = pd.read_parquet(orbit_path, columns=ROLLUP_COLUMNS)
             else:
-                tmp_df = pd.read_csv(orbit_path)
+                tmp_df = pd.read_csv(orbit_path, usecols=ROLLUP_COLUMNS)
             if not tmp_df.empty:
                 orbit_df = tmp_df
 
@@ -282,51 +278,16 @@ def _run_single_case(
         return summary, orbit_df
 
 
-def _gif_backend() -> str:
-    """Select GIF writer backend."""
-
-    if imageio is not None:
-        return "imageio"
-    if Image is not None:
-        return "pillow"
-    raise RuntimeError("Neither imageio nor Pillow is available for GIF creation.")
-
-
-def _save_gif(frame_paths: Iterable[Path], output_path: Path, duration_ms: int) -> None:
-    backend = _gif_backend()
-    frames = list(frame_paths)
-    if not frames:
-        raise RuntimeError("No frames were generated; cannot create GIF.")
-    if backend == "imageio":  # pragma: no branch - branch selection above
-        images = [imageio.imread(frame) for frame in frames]
-        imageio.mimsave(output_path, images, duration=duration_ms / 1000.0)
-    else:
-        images = [Image.open(frame) for frame in frames]
-        images[0].save(
-            output_path,
-            save_all=True,
-            append_images=images[1:],
-            duration=duration_ms,
-            loop=0,
-        )
-        for img in images:
-            img.close()
-
-
-def _plot_heatmap(
-    data: np.ndarray,
-    *,
-    r_values: np.ndarray,
-    T_values: np.ndarray,
-    phi_label: str,
-    frame_index: int,
-    total_frames: int,
-    output_path: Path,
-    colour_range: Tuple[float, float],
-) -> None:
-    """Render a single heatmap frame."""
+def _render_heatmap_frame(
+    payload: Tuple[np.ndarray, Dict[str, object], Optional[Path]],
+) -> np.ndarray:
+    """Rasterise a single heatmap frame (worker side); writes the PNG when a path is given."""
 
-    fig, ax = plt.subplots(figsize=(7.0, 5.0))
+    data, style, output_path = payload
+    r_values = style["r_values"]
+    T_values = style["T_values"]
+    colour_range = style["colour_range"]
+    fig, ax = plt.subplots(figsize=(7.0, 5.0), dpi=180)
     extent = [r_values[0], r_values[-1], T_values[0], T_values[-1]]
     masked = np.ma.masked_invalid(data)
     im = ax.imshow(
@@ -340,12 +301,41 @@ def _plot_heatmap(
     )
     ax.set_xlabel("r / R_Mars")
     ax.set_ylabel("T_M [K]")
-    ax.set_title(f"Φ(1)={PHI_CASE_VALUES[phi_label]:.2f} | frame {frame_index+1}/{total_frames}")
+    ax.set_title(style["title"])
     cbar = fig.colorbar(im, ax=ax)
     cbar.set_label("質量損失 / orbit [M_Mars]")
     fig.tight_layout()
-    fig.savefig(output_path, dpi=180)
+    rgb = figure_to_rgb(fig)
     plt.close(fig)
+    if output_path is not None:
+        write_png(output_path, rgb)
+    return rgb
+
+
+def _heatmap_payloads(
+    per_orbit_maps: List[np.ndarray],
+    *,
+    r_values: np.ndarray,
+    T_values: np.ndarray,
+    phi_label: str,
+    frames_dir: Path,
+    colour_range: Tuple[float, float],
+) -> Iterator[Tuple[np.ndarray, Dict[str, object], Optional[Path]]]:
+    """Forward-fill orbit maps and yield one frame snapshot at a time."""
+
+    current_frame = np.full(per_orbit_maps[0].shape, np.nan, dtype=np.float32)
+    total_frames = len(per_orbit_maps)
+    for orbit_idx, raw_frame in enumerate(per_orbit_maps):
+        mask = ~np.isnan(raw_frame)
+        current_frame[mask] = raw_frame[mask]
+        style = {
+            "r_values": r_values,
+            "T_values": T_values,
+            "colour_range": colour_range,
+            "title": f"Φ(1)={PHI_CASE_VALUES[phi_label]:.2f} | frame {orbit_idx+1}/{total_frames}",
+        }
+        # Snapshot: the fill buffer keeps changing while earlier frames are in flight.
+        yield current_frame.copy(), style, frames_dir / f"frame_{orbit_idx+1:04d}.png"
 
 
 def run_sweep(
@@ -357,6 +347,8 @@ def run_sweep(
     r_values: np.ndarray,
     frame_duration_ms: int,
     max_frames: int | None,
+    jobs: int = 1,
+    max_in_flight: int | None = None,
 ) -> None:
     """Execute the full sweep for all Φ cases."""
 
@@ -401,13 +393,15 @@ def run_sweep(
                 frame_limit = effective_orbits
                 if max_frames is not None:
                     frame_limit = min(frame_limit, max_frames)
-                for _, row in orbit_df.head(frame_limit).iterrows():
-                    orbit_index = int(row["orbit_index"]) - 1
+                head = orbit_df.head(frame_limit)
+                orbit_indices = head["orbit_index"].to_numpy(dtype=int) - 1
+                M_out_values = head["M_out_orbit"].to_numpy(dtype=float)
+                for orbit_index, M_out_orbit in zip(orbit_indices, M_out_values):
                     while len(per_orbit_maps) <= orbit_index:
                         per_orbit_maps.append(
                             np.full((n_T, n_r), np.nan, dtype=np.float32)
                         )
-                    per_orbit_maps[orbit_index][t_idx, r_idx] = float(row["M_out_orbit"])
+                    per_orbit_maps[orbit_index][t_idx, r_idx] = float(M_out_orbit)
 
                 if total_runs % 500 == 0 or total_runs == grid_total:
                     print(
@@ -434,32 +428,29 @@ def run_sweep(
         if math.isclose(vmin, vmax):
             vmax = vmin + 1e-8
 
-        current_frame = np.full((n_T, n_r), np.nan, dtype=np.float32)
-        frame_paths: List[Path] = []
-        total_frames = len(per_orbit_maps)
-        for orbit_idx, raw_frame in enumerate(per_orbit_maps):
-            np.copyto(current_frame, current_frame)  # no-op to keep array allocated
-            mask = ~np.isnan(raw_frame)
-            current_frame[mask] = raw_frame[mask]
-            frame_path = frames_dir / f"frame_{orbit_idx+1:04d}.png"
-            _plot_heatmap(
-                current_frame,
-                r_values=r_values,
-                T_values=T_values,
-                phi_label=phi_label,
-                frame_index=orbit_idx,
-                total_frames=total_frames,
-                output_path=frame_path,
-                colour_range=(vmin, vmax),
+        gif_path = case_outdir / "anim.gif"
+        payloads = _heatmap_payloads(
+            per_orbit_maps,
+            r_values=r_values,
+            T_values=T_values,
+            phi_label=phi_label,
+            frames_dir=frames_dir,
+            colour_range=(vmin, vmax),
+        )
+        with open_gif_encoder(gif_path, frame_duration_ms) as encoder:
+            frames_generated = stream_frames(
+                payloads,
+                _render_heatmap_frame,
+                encoder,
+                jobs=jobs,
+                max_in_flight=max_in_flight,
             )
-            frame_paths.append(frame_path)
+        if frames_generated == 0:
+            raise RuntimeError("No frames were generated; cannot create GIF.")
 
         # Latest snapshot corresponds to the last fully populated frame.
         latest_png = case_outdir / "heatmap_latest.png"
-        shutil.copy(frame_paths[-1], latest_png)
-
-        gif_path = case_outdir / "anim.gif"
-        _save_gif(frame_paths, gif_path, frame_duration_ms)
+        shutil.copy(frames_dir / f"frame_{frames_generated:04d}.png", latest_png)
 
         meta = {
             "phi_label": phi_label,
@@ -471,7 +462,7 @@ def run_sweep(
             "total_cases": grid_total,
             "max_orbits": int(max(orbit_counts) if orbit_counts else 0),
             "min_orbits": int(min(orbit_counts) if orbit_counts else 0),
-            "frames_generated": len(frame_paths),
+            "frames_generated": frames_generated,
             "frame_duration_ms": frame_duration_ms,
             "gif_path": str(gif_path),
         }
@@ -479,7 +470,7 @@ def run_sweep(
             json.dump(meta, fh, indent=2, ensure_ascii=False)
 
         print(
-            f"[Φ(1)={PHI_CASE_VALUES[phi_label]:.2f}] 完了: フレーム {len(frame_paths)} 枚, "
+            f"[Φ(1)={PHI_CASE_VALUES[phi_label]:.2f}] 完了: フレーム {frames_generated} 枚, "
             f"GIF -> {gif_path}",
             flush=True,
         )
@@ -549,6 +540,18 @@ def parse_args(argv: Iterable[str] | None = None) -> argparse.Namespace:
         default=200,
         help="半径グリッド数（線形分割）",
     )
+    parser.add_argument(
+        "--jobs",
+        type=int,
+        default=1,
+        help="フレーム描画のワーカープロセス数",
+    )
+    parser.add_argument(
+        "--max-in-flight",
+        type=int,
+        default=None,
+        help="ロード・描画・エンコード間で同時に保持するフレーム数（既定: 2×jobs）",
+    )
     return parser.parse_args(argv)
 
 
@@ -564,6 +567,8 @@ def main(argv: Iterable[str] | None = None) -> None:
         r_values=r_values,
         frame_duration_ms=args.frame_duration_ms,
         max_frames=args.max_frames,
+        jobs=args.jobs,
+        max_in_flight=args.max_in_flight,
     )
 
 
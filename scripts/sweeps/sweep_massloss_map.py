@@ -17,20 +17,36 @@ from __future__ import annotations
 # ---------------------------------------------------------------------------
 # When using ProcessPoolExecutor, each worker spawns its own process. If BLAS
 # or Numba also spawn multiple threads, the total thread count can explode
-# (e.g., 4 workers × 8 threads = 32 threads). Setting these to "1" ensures
-# "process parallelism only" mode, which is optimal for embarrassingly parallel
-# workloads like parameter sweeps. Set MARSDISK_THREAD_GUARD=0 to opt out.
+# (e.g., 4 workers × 8 threads = 32 threads). The shared thread budget
+# (marsdisk/runtime/thread_budget.py) owns the core count: every case leases
+# a share and passes it to its ``marsdisk.run`` subprocess, so the tail cases
+# get the cores released by finished workers. The module is loaded by path
+# because importing the ``marsdisk`` package would pull in numpy first.
+# Set MARSDISK_THREAD_GUARD=0 to opt out.
+import importlib.util as _importlib_util
 import os as _os
+import sys as _sys
+
+
+def _load_thread_budget():
+    path = _os.path.join(
+        _os.path.dirname(_os.path.dirname(_os.path.dirname(_os.path.abspath(__file__)))),
+        "marsdisk",
+        "runtime",
+        "thread_budget.py",
+    )
+    spec = _importlib_util.spec_from_file_location("_marsdisk_thread_budget", path)
+    module = _importlib_util.module_from_spec(spec)
+    _sys.modules[spec.name] = module
+    spec.loader.exec_module(module)
+    return module
+
+
+thread_budget = _load_thread_budget()
 
 
 def _apply_thread_guard() -> None:
-    guard = _os.environ.get("MARSDISK_THREAD_GUARD", "1").lower()
-    if guard in {"0", "false", "off", "no"}:
-        return
-    _os.environ.setdefault("OMP_NUM_THREADS", "1")
-    _os.environ.setdefault("MKL_NUM_THREADS", "1")
-    _os.environ.setdefault("OPENBLAS_NUM_THREADS", "1")
-    _os.environ.setdefault("NUMBA_NUM_THREADS", "1")
+    thread_budget.apply_thread_guard()
 
 
 _apply_thread_guard()
@@ -53,7 +69,7 @@ ROOT = Path(__file__).resolve().parents[1]
 if str(ROOT) not in sys.path:
     sys.path.insert(0, str(ROOT))
 
-from marsdisk import constants
+from marsdisk import constants, provenance
 
 DEFAULT_BASE_CONFIG = Path("_configs/05_massloss_base.yml")
 MAP_SUBDIR = "map1"
@@ -294,12 +310,14 @@ def _run_case(
     _write_yaml(config_path, cfg)
 
     cmd = [sys.executable, "-m", "marsdisk.run", "--config", str(config_path)]
-    proc = subprocess.run(
-        cmd,
-        cwd=ROOT,
-        capture_output=True,
-        text=True,
-    )
+    with thread_budget.lease(apply=False) as share:
+        proc = subprocess.run(
+            cmd,
+            cwd=ROOT,
+            capture_output=True,
+            text=True,
+            env={**_os.environ, **share.env()},
+        )
 
     spec.log_path.parent.mkdir(parents=True, exist_ok=True)
     with spec.log_path.open("w", encoding="utf-8") as fh:
@@ -411,16 +429,24 @@ def _run_parallel(
     base_cfg: Dict[str, Any],
     qpr_table: Path,
     jobs: int,
+    pool_info: Dict[str, Any] | None = None,
 ) -> List[Dict[str, Any]]:
     from concurrent.futures import ProcessPoolExecutor, as_completed
 
+    from marsdisk.runtime import placement
+
     payload = {
         "base_cfg": base_cfg,
         "qpr_table": qpr_table,
     }
+    placement_kwargs, placement_report = placement.process_pool_options(jobs)
+    pool_kwargs, budget_report = thread_budget.pool_options(jobs, len(specs), extra=placement_kwargs)
+    if pool_info is not None:
+        pool_info["placement"] = placement_report
+        pool_info["thread_budget"] = budget_report
     results: List[Dict[str, Any]] = []
     total = len(specs)
-    with ProcessPoolExecutor(max_workers=jobs) as executor:
+    with ProcessPoolExecutor(max_workers=jobs, **pool_kwargs) as executor:
         futures = {
             executor.submit(_run_case, spec, base_cfg=payload["base_cfg"], qpr_table=payload["qpr_table"]): spec
             for spec in specs
@@ -547,11 +573,25 @@ def main() -> None:
         dt_ratio_cap=DT_OVER_T_BLOW_CAP,
     )
 
+    # Hash the shared Q_pr table and resolve git once; each marsdisk.run
+    # subprocess inherits the snapshot through MARSDISK_PROVENANCE_SNAPSHOT.
+    provenance.publish_snapshot(
+        external_files=[qpr_table_path],
+        path=logs_dir / "provenance_snapshot.json",
+    )
+
     jobs = max(1, int(args.jobs))
+    pool_info: Dict[str, Any] = {"placement": {"enabled": False}}
     if jobs == 1:
         records = _run_sequential(specs, base_cfg=base_cfg, qpr_table=qpr_table_path)
     else:
-        records = _run_parallel(specs, base_cfg=base_cfg, qpr_table=qpr_table_path, jobs=jobs)
+        records = _run_parallel(
+            specs,
+            base_cfg=base_cfg,
+            qpr_table=qpr_table_path,
+            jobs=jobs,
+            pool_info=pool_info,
+        )
 
     if not records:
         raise RuntimeError("No simulation records produced; map.csv would be empty.")
@@ -588,6 +628,7 @@ def main() -> None:
         "base_config": str(base_cfg_path.resolve()),
         "qpr_table": str(qpr_table_path.resolve()),
         "outdir": str(outdir.resolve()),
+        **pool_info,
     }
     map_spec_path = map_dir / "map_spec.json"
     _write_json(map_spec_path, map_spec)
@@ -145,6 +145,71 @@ def test_columnar_one_d_schema_parity(tmp_path: Path) -> None:
     assert (col_dir / "checks" / "mass_budget.csv").exists()
 
 
+def test_array_storage_one_d_parity(tmp_path: Path, monkeypatch) -> None:
+    overrides = [
+        "geometry.mode=1D",
+        "geometry.Nr=3",
+        "numerics.t_end_orbits=0.02",
+        "numerics.t_end_years=null",
+        "numerics.dt_init=50.0",
+        "phase.enabled=false",
+        "radiation.TM_K=2000.0",
+        "io.streaming.enable=false",
+    ]
+    _, row_df, row_dir = run_one_d_case(
+        tmp_path / "row",
+        overrides + ["io.record_storage_mode=row"],
+    )
+    monkeypatch.setenv("MARSDISK_CELL_PARALLEL", "1")
+    monkeypatch.setenv("MARSDISK_CELL_JOBS", "2")
+    monkeypatch.setenv("MARSDISK_CELL_MIN_CELLS", "1")
+    monkeypatch.setenv("MARSDISK_CELL_CHUNK_SIZE", "1")
+    _, arr_df, arr_dir = run_one_d_case(
+        tmp_path / "array",
+        overrides + ["io.record_storage_mode=array"],
+    )
+
+    assert set(row_df.columns) == set(arr_df.columns)
+    _assert_column_equal(row_df, arr_df, "time")
+    _assert_column_equal(row_df, arr_df, "cell_index")
+    _assert_numeric_close(row_df, arr_df, ["dt", "M_out_dot", "M_loss_cum", "sigma_surf", "tau"])
+    _assert_nan_masks_equal(row_df, arr_df, ["s_min", "t_coll_kernel_min", "sigma_tau1", "T_p_effective"])
+    diag_row = pd.read_parquet(row_dir / "series" / "diagnostics.parquet")
+    diag_arr = pd.read_parquet(arr_dir / "series" / "diagnostics.parquet")
+    assert set(diag_row.columns) == set(diag_arr.columns)
+    _assert_column_equal(diag_row, diag_arr, "cell_index")
+    _assert_mass_budget_equal(row_dir, arr_dir)
+
+
+def test_array_storage_zero_d_streaming_order(tmp_path: Path, monkeypatch) -> None:
+    overrides_base = [
+        "geometry.mode=0D",
+        "numerics.t_end_orbits=0.02",
+        "numerics.t_end_years=null",
+        "numerics.dt_init=50.0",
+        "phase.enabled=false",
+        "radiation.TM_K=2000.0",
+    ]
+    _, row_df, _ = run_zero_d_case(
+        tmp_path / "row",
+        overrides_base + ["io.streaming.enable=false", "io.record_storage_mode=row"],
+    )
+    monkeypatch.setenv("FORCE_STREAMING_ON", "1")
+    monkeypatch.setenv("FORCE_STREAMING_OFF", "0")
+    _, arr_df, _ = run_zero_d_case(
+        tmp_path / "array",
+        overrides_base
+        + [
+            "io.streaming.enable=true",
+            "io.streaming.step_flush_interval=3",
+            "io.record_storage_mode=array",
+        ],
+    )
+    assert set(row_df.columns) == set(arr_df.columns)
+    _assert_column_equal(row_df, arr_df, "time")
+    _assert_numeric_close(row_df, arr_df, ["dt", "M_out_dot", "M_loss_cum"])
+
+
 def test_columnar_mass_budget_streaming(tmp_path: Path, monkeypatch) -> None:
     overrides = [
         "geometry.mode=0D",
@@ -0,0 +1,71 @@
+from __future__ import annotations
+
+import json
+from pathlib import Path
+
+import pandas as pd
+from ruamel.yaml import YAML
+
+from marsdisk import run_zero_d as run_zero_d_module
+from marsdisk import schema
+from marsdisk.analysis import ensemble
+from marsdisk.physics import qstar
+
+
+def _write_base_config(tmp_path: Path) -> Path:
+    cfg = schema.Config(
+        geometry=schema.Geometry(mode="0D"),
+        disk=schema.Disk(
+            geometry=schema.DiskGeometry(r_in_RM=2.6, r_out_RM=2.6, r_profile="uniform", p_index=0.0)
+        ),
+        material=schema.Material(rho=3000.0),
+        radiation=schema.Radiation(TM_K=1800.0, Q_pr=1.0),
+        sizes=schema.Sizes(s_min=1.0e-7, s_max=1.0e-3, n_bins=12),
+        initial=schema.Initial(mass_total=1.0e-8, s0_mode="upper"),
+        dynamics=schema.Dynamics(e0=0.05, i0=0.01, t_damp_orbits=1.0, f_wake=1.0),
+        psd=schema.PSD(alpha=1.7, wavy_strength=0.0),
+        qstar=schema.QStar(Qs=1.0e5, a_s=0.1, B=0.3, b_g=1.36, v_ref_kms=[1.0, 2.0]),
+        numerics=schema.Numerics(t_end_years=1.0e-5, dt_init=20.0),
+        io=schema.IO(outdir=tmp_path / "unused"),
+    )
+    cfg.sinks.mode = "none"
+    path = tmp_path / "base.yml"
+    yaml = YAML()
+    yaml.default_flow_style = False
+    with path.open("w", encoding="utf-8") as fh:
+        yaml.dump(cfg.model_dump(mode="json", exclude_defaults=True), fh)
+    return path
+
+
+def test_ensemble_shares_size_caches_and_writes_one_table(tmp_path: Path) -> None:
+    # The first sample must start from a cold cache whatever ran before in this worker.
+    run_zero_d_module._reset_collision_runtime_state(persist=False, signature=None)
+    config_path = _write_base_config(tmp_path)
+    specs = [ensemble.parse_parameter_spec("qstar.coeff_scale=loguniform:0.5:2.0")]
+    samples = ensemble.draw_samples(specs, 3, seed=7)
+    samples.loc[len(samples)] = {"qstar.coeff_scale": -1.0}  # rejected by the schema
+
+    result = ensemble.run_ensemble(
+        config_path,
+        samples,
+        outdir=tmp_path / "ens",
+        overrides=["qstar.override_coeffs=true"],
+        specs=specs,
+        seed=7,
+        keep_sample_outputs=False,
+    )
+
+    table = pd.read_parquet(result.table_path)
+    assert list(table["sample_status"]) == ["ok", "ok", "ok", "failed"]
+    assert list(table["collision_cache"][:3]) == ["reset", "size_only", "size_only"]
+    assert table.loc[:2, "summary.M_loss"].notna().all()
+    assert (table.loc[:2, "budget.error_percent.last"].abs() < 0.5).all()
+    assert not (tmp_path / "ens" / "samples").exists()
+    # No sample's Q_D* table or cache signature outlives the ensemble.
+    assert qstar.get_coefficient_table() == qstar.reset_coefficient_table()
+    assert run_zero_d_module._LAST_COLLISION_CACHE_SIGNATURE is None
+
+    meta = json.loads(result.metadata_path.read_text(encoding="utf-8"))
+    assert meta["n_samples"] == 4 and meta["n_failed"] == 1
+    assert meta["parameters"][0]["dist"] == "loguniform"
+    assert meta["statistics"]["summary.M_loss"]["count"] == 3.0
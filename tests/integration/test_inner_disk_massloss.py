@@ -1,12 +1,16 @@
 from __future__ import annotations
 
+import json
 from pathlib import Path
 
 import numpy as np
+import pandas as pd
+import pytest
 from ruamel.yaml import YAML
 
 from marsdisk import schema
 from marsdisk.analysis.inner_disk_runner import run_inner_disk_sweep
+from marsdisk.run import run_zero_d
 
 
 def _build_config(outdir: Path, *, sinks_mode: str, enable_sublimation: bool, enable_gas_drag: bool) -> schema.Config:
@@ -101,3 +105,44 @@ def test_inner_disk_sweep_runs_and_collects_massloss(tmp_path: Path) -> None:
     closure = df["M_remain"] + df["M_loss_total"]
     error_percent = np.abs((df["M_init"] - closure) / df["M_init"]) * 100.0
     assert (error_percent < 1.0).all(), "M_init が M_remain+M_loss_total と1%以内で一致しません"
+
+
+def test_run_zero_d_result_matches_written_outputs(tmp_path: Path) -> None:
+    cfg = _build_config(tmp_path / "out", sinks_mode="sublimation", enable_sublimation=True, enable_gas_drag=False)
+    cfg.numerics.t_end_years = 1.0e-5
+    result = run_zero_d(cfg)
+
+    summary = json.loads((tmp_path / "out" / "summary.json").read_text(encoding="utf-8"))
+    assert result.summary["M_loss_from_sinks"] == summary["M_loss_from_sinks"]
+    assert result.summary["mass_budget_max_error_percent"] == summary["mass_budget_max_error_percent"]
+
+    budget = pd.read_csv(tmp_path / "out" / "checks" / "mass_budget.csv")
+    assert result.mass_budget_first["mass_initial"] == pytest.approx(budget["mass_initial"].iloc[0], rel=1e-12)
+    assert result.mass_budget_last["mass_remaining"] == pytest.approx(budget["mass_remaining"].iloc[-1], rel=1e-12)
+    step_df = pd.read_csv(tmp_path / "out" / "series" / "step_diagnostics.csv")
+    assert result.step_diag_last["mass_total_bins"] == pytest.approx(step_df["mass_total_bins"].iloc[-1], rel=1e-12)
+
+
+def test_inner_disk_sweep_worker_pool_matches_serial(tmp_path: Path) -> None:
+    cfg_paths = []
+    for idx, enable_sublimation in enumerate([False, True]):
+        cfg = _build_config(
+            tmp_path / f"out_{idx}",
+            sinks_mode="sublimation" if enable_sublimation else "none",
+            enable_sublimation=enable_sublimation,
+            enable_gas_drag=False,
+        )
+        cfg_paths.append(_write_yaml(cfg, tmp_path / f"case_{idx}.yml"))
+
+    kwargs = dict(labels=["a", "b"], t_end_years=1.0e-5)
+    serial = run_inner_disk_sweep(cfg_paths, **kwargs)
+    pool_info: dict = {}
+    pooled = run_inner_disk_sweep(cfg_paths, jobs=2, pool_info=pool_info, **kwargs)
+
+    assert list(pooled["label"]) == ["a", "b"]
+    assert pool_info["thread_budget"]["dynamic"] is True
+    assert "enabled" in pool_info["placement"]
+    numeric = ["M_init", "M_loss_total", "M_remain", "f_loss", "f_subl", "T_M", "r_RM"]
+    np.testing.assert_allclose(
+        pooled[numeric].to_numpy(dtype=float), serial[numeric].to_numpy(dtype=float), rtol=1e-12
+    )
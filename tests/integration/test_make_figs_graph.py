@@ -0,0 +1,114 @@
+"""Tests for the cached figure build graph behind tools.plotting.make_figs."""
+from __future__ import annotations
+
+import json
+from pathlib import Path
+
+import numpy as np
+import pandas as pd
+import pytest
+
+from tools.plotting import figure_graph, make_figs
+
+
+def _make_run(root: Path, name: str, config_dir: Path) -> Path:
+    run_dir = root / name
+    (run_dir / "series").mkdir(parents=True)
+    (run_dir / "checks").mkdir()
+    time = np.linspace(0.0, 100.0, 6)
+    pd.DataFrame(
+        {
+            "time": time,
+            "mass_total_bins": 1.0 - 1e-3 * time,
+            "mass_lost_by_blowout": 8e-4 * time,
+            "mass_lost_by_sinks": 2e-4 * time,
+            "dSigma_dt_blowout": np.full_like(time, 1e-6),
+            "dSigma_dt_sinks": np.full_like(time, 2e-7),
+            "rho_used": np.full_like(time, 3000.0),
+            "s_min_effective": np.full_like(time, 1e-6),
+        }
+    ).to_parquet(run_dir / "series" / "run.parquet", index=False)
+    pd.DataFrame(
+        {
+            "time": time,
+            "mass_initial": np.ones_like(time),
+            "mass_lost": 1e-3 * time,
+            "error_percent": np.zeros_like(time),
+        }
+    ).to_csv(run_dir / "checks" / "mass_budget.csv", index=False)
+    (run_dir / "summary.json").write_text(json.dumps({"rho_used": 3000.0}), encoding="utf-8")
+    config_dir.mkdir(exist_ok=True)
+    (config_dir / f"{name}.yml").write_text(
+        "sizes:\n  s_min: 1.0e-6\n  s_max: 1.0e-2\n  n_bins: 12\n", encoding="utf-8"
+    )
+    return run_dir
+
+
+def _argv(runs: list[Path], config_dir: Path, manifest: Path, *extra: str) -> list[str]:
+    argv: list[str] = []
+    for run in runs:
+        argv += ["--single-run", str(run)]
+    return argv + ["--config-dir", str(config_dir), "--cache-manifest", str(manifest), *extra]
+
+
+def test_figures_rebuild_only_when_inputs_change(tmp_path: Path) -> None:
+    config_dir = tmp_path / "configs"
+    run_dir = _make_run(tmp_path, "case_a", config_dir)
+    manifest = tmp_path / "figs.json"
+    figure_graph.DATASET_CACHE.clear()
+
+    report = make_figs.main(_argv([run_dir], config_dir, manifest))
+    assert report["built"] == 2
+    assert (run_dir / "fig_contrib_by_size.png").exists()
+    assert (run_dir / "fig_mass_budget_timeline.png").exists()
+    # Both figures read run.parquet; the second read comes from memory.
+    assert figure_graph.DATASET_CACHE.stats()["hits"] >= 1
+
+    report = make_figs.main(_argv([run_dir], config_dir, manifest))
+    assert report["built"] == 0
+    assert report["cached"] == 2
+
+    budget = pd.read_csv(run_dir / "checks" / "mass_budget.csv")
+    budget["error_percent"] = 0.5
+    budget.to_csv(run_dir / "checks" / "mass_budget.csv", index=False)
+    report = make_figs.main(_argv([run_dir], config_dir, manifest))
+    assert report["figures"] == {
+        f"{run_dir}:contrib_by_size": "cached",
+        f"{run_dir}:mass_budget": "built",
+    }
+
+    (run_dir / "fig_contrib_by_size.png").unlink()
+    report = make_figs.main(_argv([run_dir], config_dir, manifest))
+    assert report["figures"][f"{run_dir}:contrib_by_size"] == "built"
+
+
+def test_independent_runs_form_parallel_groups(tmp_path: Path) -> None:
+    config_dir = tmp_path / "configs"
+    runs = [_make_run(tmp_path, f"case_{idx}", config_dir) for idx in range(2)]
+    args = make_figs.parse_args(_argv(runs, config_dir, tmp_path / "figs.json", "--jobs", "2"))
+    graph = make_figs.build_graph(args)
+
+    groups = figure_graph.group_nodes(graph.nodes)
+    assert [len(group) for group in groups] == [2, 2]
+
+    report = graph.run(jobs=2)
+    assert report["built"] == 4
+    assert report["jobs"] == 2
+    assert not report["failed"]
+
+
+def test_group_nodes_orders_producers_first(tmp_path: Path) -> None:
+    def _noop(**_: object) -> None:
+        return None
+
+    graph = figure_graph.FigureGraph()
+    panel = tmp_path / "panel.png"
+    graph.add("composite", _noop, inputs=[panel], outputs=[tmp_path / "composite.png"])
+    graph.add("panel", _noop, inputs=[tmp_path / "data.csv"], outputs=[panel])
+    graph.add("other", _noop, inputs=[tmp_path / "other.csv"], outputs=[tmp_path / "other.png"])
+
+    groups = figure_graph.group_nodes(graph.nodes)
+    assert [[node.fig_id for node in group] for group in groups] == [["panel", "composite"], ["other"]]
+
+    with pytest.raises(ValueError):
+        graph.add("panel", _noop, inputs=[], outputs=[])
@@ -112,3 +112,19 @@ def test_missing_summary_json(tmp_path: Path):
     assert len(cases) == 1
     # M_loss should be NaN since no summary.json
     assert cases[0].M_loss != cases[0].M_loss  # NaN check
+
+
+def test_partial_runs_are_skipped(mock_batch_dir: Path):
+    """Runs that have not finished do not show up as sweep cases."""
+    from tools.plotting.make_sweep_summary import discover_cases
+
+    legacy = mock_batch_dir / "T5000_eps1p0_tau1p0"
+    legacy.mkdir()
+    (legacy / "summary.json").write_text(json.dumps({"M_loss": 1.0, "summary_status": "partial"}))
+    running = mock_batch_dir / "T5000_eps0p5_tau1p0"
+    running.mkdir()
+    (running / "summary.partial.json").write_text(json.dumps({"M_loss": 1.0, "summary_status": "partial"}))
+
+    cases = discover_cases(mock_batch_dir, cache_path=mock_batch_dir / "sweep_summary.arrow")
+    assert len(cases) == 3
+    assert all(case.T_M != 5000.0 for case in cases)
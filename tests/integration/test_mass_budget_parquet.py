@@ -0,0 +1,95 @@
+"""Parquet mass-budget log: row-group streaming, incremental checks and CSV export."""
+
+from __future__ import annotations
+
+from pathlib import Path
+
+import numpy as np
+import pandas as pd
+import pyarrow.parquet as pq
+
+from marsdisk import run
+from marsdisk.io import mass_budget
+from one_d_helpers import run_one_d_case
+
+
+def _budget_rows(times, error):
+    return [
+        {
+            "time": float(t),
+            "mass_initial": 1.0,
+            "mass_remaining": 1.0,
+            "mass_lost": 0.0,
+            "mass_diff": 0.0,
+            "error_percent": float(error),
+            "tolerance_percent": 0.5,
+        }
+        for t in times
+    ]
+
+
+def test_streaming_flush_appends_row_groups(tmp_path: Path) -> None:
+    streaming = run.StreamingState(
+        enabled=True,
+        outdir=tmp_path,
+        step_flush_interval=1,
+        merge_at_end=False,
+        mass_budget_format="parquet",
+    )
+    history = run.ZeroDHistory()
+    history.mass_budget.extend(_budget_rows([1.0, 2.0], 0.1))
+    streaming.flush(history, step_end=1)
+    history.mass_budget.extend(_budget_rows([3.0], 0.9))
+    streaming.flush(history, step_end=2)
+    streaming.close_mass_budget()
+
+    path = tmp_path / "checks" / "mass_budget.parquet"
+    assert streaming.mass_budget_path == path
+    assert pq.ParquetFile(path).metadata.num_row_groups == 2
+    df = pd.read_parquet(path)
+    assert df["time"].tolist() == [1.0, 2.0, 3.0]
+
+    log = streaming.mass_budget_log
+    assert log.max_error_percent == 0.9
+    assert log.first_violation is not None and log.first_violation["time"] == 3.0
+    assert mass_budget.max_error_percent(path) == 0.9
+
+    csv_path = mass_budget.export_csv(path)
+    exported = pd.read_csv(csv_path)
+    pd.testing.assert_frame_equal(exported, df)
+
+
+def test_resumed_parquet_log_keeps_previous_rows(tmp_path: Path) -> None:
+    path = tmp_path / "checks" / "mass_budget.parquet"
+    first = mass_budget.MassBudgetLog(path, fmt="parquet")
+    first.append(_budget_rows([1.0], 0.0))
+    first.close()
+
+    resumed = mass_budget.MassBudgetLog(path, fmt="parquet")
+    resumed.header_written = True
+    resumed.append(_budget_rows([2.0], 0.0))
+    resumed.close()
+    assert pd.read_parquet(path)["time"].tolist() == [1.0, 2.0]
+
+
+def test_one_d_parquet_budget_matches_csv(tmp_path: Path) -> None:
+    overrides = [
+        "geometry.mode=1D",
+        "geometry.Nr=2",
+        "numerics.t_end_orbits=0.05",
+        "numerics.t_end_years=null",
+        "numerics.dt_init=50.0",
+        "phase.enabled=false",
+        "radiation.TM_K=2000.0",
+        "supply.enabled=false",
+        "io.streaming.enable=false",
+    ]
+    _, _, csv_dir = run_one_d_case(tmp_path / "csv", overrides)
+    _, _, pq_dir = run_one_d_case(tmp_path / "parquet", overrides + ["io.mass_budget_format=parquet"])
+
+    assert not (pq_dir / "checks" / "mass_budget.csv").exists()
+    for stem in ("mass_budget", "mass_budget_cells"):
+        ref = pd.read_csv(csv_dir / "checks" / f"{stem}.csv")
+        got = mass_budget.read_mass_budget(pq_dir / "checks" / f"{stem}.parquet")
+        assert len(got) == len(ref)
+        assert np.allclose(got["mass_lost"].to_numpy(), ref["mass_lost"].to_numpy())
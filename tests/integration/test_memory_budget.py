@@ -0,0 +1,47 @@
+from __future__ import annotations
+
+import json
+from pathlib import Path
+
+import numpy as np
+
+from marsdisk.runtime import memory_plan
+from one_d_helpers import run_zero_d_case
+
+
+BASE_OVERRIDES = [
+    "numerics.t_end_years=0.002",
+    "numerics.t_end_orbits=null",
+    "numerics.dt_init=50.0",
+    "phase.enabled=false",
+    "radiation.TM_K=2000.0",
+]
+
+
+def test_zero_d_memory_budget_matches_unbudgeted_run(tmp_path: Path, monkeypatch) -> None:
+    _, ref_df, _ = run_zero_d_case(tmp_path / "ref", list(BASE_OVERRIDES))
+
+    # The planner sees an empty process; every watchdog check then reads an
+    # RSS far above the limit, so the whole degradation ladder is exercised.
+    readings = iter([0])
+    monkeypatch.setattr(memory_plan, "current_rss_bytes", lambda: next(readings, 1 << 40))
+    overrides = BASE_OVERRIDES + [
+        "io.memory_budget.enable=true",
+        "io.memory_budget.budget_gb=64",
+        "io.memory_budget.watchdog_interval_steps=5",
+        "io.streaming.enable=true",
+    ]
+    _, df, outdir = run_zero_d_case(tmp_path / "budget", overrides)
+
+    run_config = json.loads((outdir / "run_config.json").read_text())
+    report = run_config["memory_budget"]
+    assert report["enabled"]
+    assert report["plan"]["budget_source"] == "config"
+    watchdog = report["watchdog"]
+    assert watchdog["checks"] > 0
+    assert watchdog["actions"]
+    assert watchdog["actions"][0]["actions"] == ["flush"]
+    assert "shrink_caches" in watchdog["actions"][1]["actions"]
+
+    assert len(df) == len(ref_df)
+    np.testing.assert_allclose(df["M_loss_cum"].to_numpy(), ref_df["M_loss_cum"].to_numpy(), rtol=1e-12)
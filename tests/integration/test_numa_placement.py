@@ -0,0 +1,49 @@
+from __future__ import annotations
+
+import json
+import os
+from pathlib import Path
+
+import numpy as np
+import pytest
+
+from one_d_helpers import run_one_d_case
+
+pytestmark = pytest.mark.skipif(
+    not hasattr(os, "sched_setaffinity"), reason="NUMA placement requires Linux affinity control"
+)
+
+
+def test_one_d_numa_placement_matches_serial(tmp_path: Path, monkeypatch) -> None:
+    overrides = [
+        "geometry.mode=1D",
+        "geometry.Nr=3",
+        "numerics.t_end_orbits=0.02",
+        "numerics.t_end_years=null",
+        "numerics.dt_init=50.0",
+        "phase.enabled=false",
+        "radiation.TM_K=2000.0",
+        "io.streaming.enable=false",
+    ]
+    _, serial_df, _ = run_one_d_case(tmp_path / "serial", overrides)
+
+    monkeypatch.setenv("MARSDISK_CELL_PARALLEL", "1")
+    monkeypatch.setenv("MARSDISK_CELL_PARALLEL_FORCE", "1")
+    monkeypatch.setenv("MARSDISK_CELL_JOBS", "2")
+    monkeypatch.setenv("MARSDISK_CELL_MIN_CELLS", "1")
+    monkeypatch.setenv("MARSDISK_CELL_MIN_CELLS_PER_JOB", "1")
+    monkeypatch.setenv("MARSDISK_CELL_CHUNK_SIZE", "1")
+    monkeypatch.setenv("MARSDISK_NUMA_PLACEMENT", "1")
+    _, pinned_df, pinned_dir = run_one_d_case(tmp_path / "pinned", overrides)
+
+    run_config = json.loads((pinned_dir / "run_config.json").read_text())
+    placement = run_config["cell_parallel"]["placement"]
+    assert run_config["cell_parallel"]["enabled"]
+    assert placement["enabled"] and placement["scope"] == "cell_workers"
+    assert len(placement["workers"]) == 2
+    assert all(worker["pinned"] for worker in placement["workers"])
+
+    assert len(serial_df) == len(pinned_df)
+    np.testing.assert_allclose(
+        pinned_df["M_loss_cum"].to_numpy(), serial_df["M_loss_cum"].to_numpy(), rtol=1e-12
+    )
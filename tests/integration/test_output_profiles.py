@@ -0,0 +1,82 @@
+from __future__ import annotations
+
+from pathlib import Path
+
+import pyarrow.parquet as pq
+
+from marsdisk.output_schema import (
+    MINIMAL_ONE_D_SERIES_KEYS,
+    MINIMAL_SERIES_KEYS,
+    STANDARD_DIAGNOSTIC_KEYS,
+    STANDARD_SERIES_KEYS,
+    ensure_series_keys,
+    series_keys_for_profile,
+)
+from one_d_helpers import run_one_d_case, run_zero_d_case
+
+BASE_0D = [
+    "geometry.mode=0D",
+    "numerics.t_end_orbits=0.02",
+    "numerics.t_end_years=null",
+    "numerics.dt_init=50.0",
+    "phase.enabled=false",
+    "radiation.TM_K=2000.0",
+    "io.streaming.enable=false",
+]
+
+
+def test_ensure_series_keys_honours_profile() -> None:
+    record: dict[str, object] = {"time": 0.0, "custom": 1}
+    ensure_series_keys(record, include_1d=False, profile="minimal")
+    assert set(record) == set(MINIMAL_SERIES_KEYS) | {"custom"}
+    full = series_keys_for_profile("full", include_1d=True)
+    assert set(STANDARD_SERIES_KEYS) < set(full)
+
+
+def test_minimal_profile_zero_d_skips_diagnostics(tmp_path: Path) -> None:
+    summary, run_df, outdir = run_zero_d_case(tmp_path, BASE_0D + ["io.output_profile=minimal"])
+    assert list(run_df.columns) == MINIMAL_SERIES_KEYS
+    assert not (outdir / "series" / "diagnostics.parquet").exists()
+    assert summary["M_loss"] >= 0.0
+
+
+def test_standard_profile_float32_zero_d(tmp_path: Path) -> None:
+    _, full_df, _ = run_zero_d_case(tmp_path / "full", BASE_0D)
+    _, std_df, outdir = run_zero_d_case(
+        tmp_path / "std",
+        BASE_0D + ["io.output_profile=standard", 'io.float32_columns=["*"]'],
+    )
+    assert list(std_df.columns) == STANDARD_SERIES_KEYS
+    schema = pq.read_schema(outdir / "series" / "run.parquet")
+    assert str(schema.field("time").type) == "double"
+    assert str(schema.field("M_loss_cum").type) == "float"
+    diag_schema = pq.read_schema(outdir / "series" / "diagnostics.parquet")
+    assert diag_schema.names == STANDARD_DIAGNOSTIC_KEYS
+    assert (full_df["time"].to_numpy() == std_df["time"].to_numpy()).all()
+    rel = abs(std_df["M_loss_cum"].iloc[-1] - full_df["M_loss_cum"].iloc[-1])
+    assert rel <= 1.0e-6 * max(abs(full_df["M_loss_cum"].iloc[-1]), 1.0e-30)
+
+
+def test_explicit_columns_one_d_streaming(tmp_path: Path, monkeypatch) -> None:
+    monkeypatch.setenv("FORCE_STREAMING_ON", "1")
+    monkeypatch.setenv("FORCE_STREAMING_OFF", "0")
+    _, run_df, outdir = run_one_d_case(
+        tmp_path,
+        [
+            "geometry.mode=1D",
+            "geometry.Nr=3",
+            "numerics.t_end_orbits=0.02",
+            "numerics.t_end_years=null",
+            "numerics.dt_init=50.0",
+            "phase.enabled=false",
+            "radiation.TM_K=2000.0",
+            "io.streaming.enable=true",
+            "io.streaming.step_flush_interval=2",
+            'io.series_columns=["M_loss_cum", "tau"]',
+            "io.diagnostic_columns=[]",
+            "io.record_storage_mode=array",
+        ],
+    )
+    assert list(run_df.columns) == ["time", "dt", *MINIMAL_ONE_D_SERIES_KEYS, "M_loss_cum", "tau"]
+    assert set(run_df["cell_index"]) == {0, 1, 2}
+    assert not (outdir / "series" / "diagnostics.parquet").exists()
@@ -0,0 +1,203 @@
+from __future__ import annotations
+
+import json
+import os
+import subprocess
+import sys
+from pathlib import Path
+
+import pandas as pd
+import pytest
+
+from marsdisk import run_zero_d as run_zero_d_mod
+from marsdisk.io import checkpoint as checkpoint_io
+from marsdisk.io import recovery
+from marsdisk.io.streaming import StreamingState
+from one_d_helpers import run_zero_d_case
+from tools.utilities import recover_run
+
+REPO_ROOT = Path(__file__).resolve().parents[2]
+
+OVERRIDES = [
+    "geometry.mode=0D",
+    "numerics.t_end_orbits=0.05",
+    "numerics.t_end_years=null",
+    "numerics.dt_init=50.0",
+    "phase.enabled=false",
+    "radiation.TM_K=2000.0",
+    "io.streaming.enable=true",
+    "io.streaming.step_flush_interval=2",
+    "numerics.checkpoint.enabled=true",
+    "numerics.checkpoint.interval_years=1.0e-6",
+]
+
+
+class _Killed(BaseException):
+    """Stand-in for SIGKILL: escapes every ``except Exception`` handler."""
+
+
+def test_partial_summary_survives_interrupted_run(tmp_path: Path, monkeypatch) -> None:
+    monkeypatch.setenv("FORCE_STREAMING_ON", "1")
+    monkeypatch.setenv("FORCE_STREAMING_OFF", "0")
+    original = StreamingState.write_partial_summary
+    calls = {"n": 0}
+
+    def _write_then_die(self, payload):
+        original(self, payload)
+        calls["n"] += 1
+        if calls["n"] == 2:
+            raise _Killed()
+
+    monkeypatch.setattr(StreamingState, "write_partial_summary", _write_then_die)
+    # A killed process runs no shutdown hooks, so keep the chunks on disk.
+    monkeypatch.setattr(run_zero_d_mod.weakref, "finalize", lambda *args, **kwargs: None)
+    monkeypatch.setattr(run_zero_d_mod.atexit, "register", lambda *args, **kwargs: None)
+    with pytest.raises(_Killed):
+        run_zero_d_case(tmp_path, OVERRIDES)
+
+    # Consumers take an existing summary.json as "finished": a killed run must not leave one.
+    assert not (tmp_path / "summary.json").exists()
+    summary = json.loads((tmp_path / "summary.partial.json").read_text(encoding="utf-8"))
+    assert summary["summary_status"] == "partial"
+    assert summary["step_no"] == 3
+    assert summary["time"] > 0.0
+    # Progress is reported at the end of the last completed step, as in the checkpoint.
+    latest = checkpoint_io.load_checkpoint(Path(summary["latest_checkpoint"]))
+    assert latest.step_no == summary["step_no"]
+    assert summary["time"] == pytest.approx(latest.time_s, rel=1e-12)
+    assert summary["M_loss"] >= 0.0
+    assert summary["perf"]["steps_completed"] == 4
+    assert summary["streaming"]["flush_count"] == 2
+    assert not list(tmp_path.glob(".summary.partial.json.*"))
+
+    info = recovery.inspect_run(tmp_path)
+    assert info.status == recovery.SUMMARY_PARTIAL
+    assert info.resumable
+    assert info.latest_chunk_step_end == 3
+    # Sweep workers resume with the seed of the interrupted segment.
+    assert info.rng_seed == summary["rng_seed"]
+    assert any(item.startswith("numerics.resume.from_path=") for item in info.resume_overrides())
+
+    assert recover_run.main([str(tmp_path), "--merge"]) == 0
+    merged = pd.read_parquet(tmp_path / "series" / "run.parquet")
+    assert len(merged) == 4
+    assert merged["time"].is_monotonic_increasing
+
+
+def test_final_summary_marked_complete(tmp_path: Path, monkeypatch) -> None:
+    monkeypatch.setenv("FORCE_STREAMING_ON", "1")
+    monkeypatch.setenv("FORCE_STREAMING_OFF", "0")
+    summary, _, outdir = run_zero_d_case(tmp_path, OVERRIDES)
+    assert summary["summary_status"] == "complete"
+    assert not (outdir / "summary.partial.json").exists()
+    assert recovery.inspect_run(outdir).status == recovery.SUMMARY_COMPLETE
+
+
+def _resume_overrides(flush_streaming: bool) -> list[str]:
+    return [
+        *OVERRIDES[:-1],
+        "numerics.t_end_orbits=0.1",
+        "io.streaming.step_flush_interval=3",
+        "numerics.checkpoint.interval_years=3.0e-6",
+        "io.step_diagnostics.enable=true",
+        f"numerics.checkpoint.flush_streaming={'true' if flush_streaming else 'false'}",
+    ]
+
+
+def _assert_matches_reference(summary, resumed_df, outdir: Path, reference, reference_df, ref_dir: Path) -> None:
+    assert summary["summary_status"] == "complete"
+    assert recovery.inspect_run(outdir).sweep_action == "skip"
+    float_cols = [col for col in reference_df.columns if reference_df[col].dtype.kind == "f"]
+    pd.testing.assert_frame_equal(
+        resumed_df[float_cols].reset_index(drop=True),
+        reference_df[float_cols].reset_index(drop=True),
+        rtol=1e-9,
+    )
+    for rel in ("checks/mass_budget.csv", "series/step_diagnostics.csv"):
+        resumed = pd.read_csv(outdir / rel)
+        expected = pd.read_csv(ref_dir / rel)
+        pd.testing.assert_series_equal(resumed["time"], expected["time"], rtol=1e-9)
+    assert summary["M_loss"] == pytest.approx(reference["M_loss"], rel=1e-9)
+
+
+@pytest.mark.parametrize("flush_streaming", [False, True])
+def test_resume_from_checkpoint_reproduces_uninterrupted_run(
+    tmp_path: Path, monkeypatch, flush_streaming: bool
+) -> None:
+    monkeypatch.setenv("FORCE_STREAMING_ON", "1")
+    monkeypatch.setenv("FORCE_STREAMING_OFF", "0")
+    overrides = _resume_overrides(flush_streaming)
+    reference, reference_df, _ = run_zero_d_case(tmp_path / "ref", overrides)
+
+    original = StreamingState.write_partial_summary
+    calls = {"n": 0}
+
+    def _write_then_die(self, payload):
+        original(self, payload)
+        calls["n"] += 1
+        if calls["n"] == 2:
+            raise _Killed()
+
+    with monkeypatch.context() as patch:
+        patch.setattr(StreamingState, "write_partial_summary", _write_then_die)
+        patch.setattr(run_zero_d_mod.weakref, "finalize", lambda *args, **kwargs: None)
+        patch.setattr(run_zero_d_mod.atexit, "register", lambda *args, **kwargs: None)
+        with pytest.raises(_Killed):
+            run_zero_d_case(tmp_path / "cut", overrides)
+
+    info = recovery.inspect_run(tmp_path / "cut")
+    assert info.sweep_action == "resume"
+    assert 0.0 < info.remaining_fraction < 1.0
+    summary, resumed_df, outdir = run_zero_d_case(tmp_path / "cut", overrides + info.resume_overrides())
+    _assert_matches_reference(summary, resumed_df, outdir, reference, reference_df, tmp_path / "ref")
+
+
+_INTERRUPT_SCRIPT = """
+import sys
+from pathlib import Path
+
+from marsdisk.io.streaming import StreamingState
+from one_d_helpers import run_zero_d_case
+
+original = StreamingState.write_partial_summary
+calls = {"n": 0}
+
+
+def _write_then_interrupt(self, payload):
+    original(self, payload)
+    calls["n"] += 1
+    if calls["n"] == 2:
+        raise KeyboardInterrupt
+
+
+StreamingState.write_partial_summary = _write_then_interrupt
+run_zero_d_case(Path(sys.argv[1]), sys.argv[2:])
+"""
+
+
+def test_resume_after_shutdown_hooks_merged_the_chunks(tmp_path: Path, monkeypatch) -> None:
+    monkeypatch.setenv("FORCE_STREAMING_ON", "1")
+    monkeypatch.setenv("FORCE_STREAMING_OFF", "0")
+    overrides = _resume_overrides(False)
+    reference, reference_df, _ = run_zero_d_case(tmp_path / "ref", overrides)
+
+    # Ctrl-C in a separate interpreter: its shutdown hooks merge and remove the chunks.
+    env = dict(os.environ, PYTHONPATH=os.pathsep.join(filter(None, [str(REPO_ROOT), os.environ.get("PYTHONPATH")])))
+    result = subprocess.run(
+        [sys.executable, "-c", _INTERRUPT_SCRIPT, str(tmp_path / "cut"), *overrides],
+        cwd=REPO_ROOT,
+        env=env,
+        capture_output=True,
+        text=True,
+    )
+    assert result.returncode != 0
+    assert "KeyboardInterrupt" in result.stderr
+    cut = tmp_path / "cut"
+    assert (cut / "series" / "run.parquet").exists()
+    assert not list((cut / "series").glob("run_chunk_*.parquet"))
+    assert not (cut / "summary.json").exists()
+
+    info = recovery.inspect_run(cut)
+    assert info.sweep_action == "resume"
+    summary, resumed_df, outdir = run_zero_d_case(cut, overrides + info.resume_overrides())
+    _assert_matches_reference(summary, resumed_df, outdir, reference, reference_df, tmp_path / "ref")
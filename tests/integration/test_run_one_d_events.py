@@ -0,0 +1,92 @@
+"""1D cell retirement through the event engine."""
+
+from __future__ import annotations
+
+import dataclasses
+from pathlib import Path
+
+import pytest
+
+from marsdisk.physics import collisions_smol
+from one_d_helpers import run_one_d_case
+
+
+def test_tau_exceeded_retires_all_cells_and_stops(tmp_path: Path) -> None:
+    overrides = [
+        "geometry.mode=1D",
+        "geometry.Nr=2",
+        "numerics.t_end_orbits=0.05",
+        "numerics.t_end_years=null",
+        "numerics.dt_init=50.0",
+        "phase.enabled=false",
+        "optical_depth.tau_stop=0.5",
+    ]
+    summary, run_df, _ = run_one_d_case(tmp_path, overrides)
+
+    assert summary["early_stop_reason"] == "tau_exceeded_all_cells"
+    assert summary["cells_stopped"] == 2
+    assert summary["cells_retired_inert"] == 0
+
+    events = summary["stop_events"]
+    assert events["hit_counts"]["tau_exceeded"] == 2
+    assert events["subjects_active"] == 0
+    assert sorted(hit["subject"] for hit in events["hits"]) == [0, 1]
+    for hit in events["hits"]:
+        assert hit["value"] > hit["threshold"]
+        assert hit["t_cross"] <= hit["time"]
+
+    assert not run_df["cell_active"].any()
+    assert set(run_df["cell_stop_reason"]) == {"tau_exceeded"}
+
+
+def test_drained_cells_retire_inert_and_stop(tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    real_step = collisions_smol.step_collisions
+    calls: dict[float, int] = {}
+    drain_after = {0: 1, 1: 4}
+
+    def _drain_step(ctx, psd_state):
+        # Blow out the remaining surface once a cell has taken its quota of
+        # steps, so the inner cell empties well before the outer one.
+        res = real_step(ctx, psd_state)
+        r_key = ctx.time_orbit.r
+        calls[r_key] = calls.get(r_key, 0) + 1
+        rank = sorted(calls).index(r_key)
+        if calls[r_key] < drain_after[rank]:
+            return res
+        dt = ctx.time_orbit.dt
+        return dataclasses.replace(
+            res,
+            sigma_after=0.0,
+            dSigma_dt_blowout=res.dSigma_dt_blowout + res.sigma_after / dt,
+        )
+
+    monkeypatch.setattr(collisions_smol, "step_collisions", _drain_step)
+    overrides = [
+        "geometry.mode=1D",
+        "geometry.Nr=2",
+        "numerics.t_end_orbits=0.05",
+        "numerics.t_end_years=null",
+        "numerics.dt_init=50.0",
+        "phase.enabled=false",
+        "supply.enabled=false",
+    ]
+    summary, run_df, _ = run_one_d_case(tmp_path, overrides)
+
+    assert summary["early_stop_reason"] == "all_cells_retired"
+    assert summary["cells_retired_inert"] == 2
+    assert summary["stop_events"]["subjects_active"] == 0
+    assert summary["run_stop_events"]["hits"] == []
+    assert summary["mass_budget_max_error_percent"] < 0.5
+    assert summary["M_loss"] > 0.0
+
+    inner = run_df[run_df["cell_index"] == 0].sort_values("time")
+    outer = run_df[run_df["cell_index"] == 1].sort_values("time")
+    assert len(inner) == len(outer) == 4
+    # The inner cell is frozen at Σ=0 while the outer cell keeps evolving.
+    assert not inner["cell_active"].any()
+    assert (inner["Sigma_surf"] == 0.0).all()
+    assert inner["M_loss_cum"].nunique() == 1
+    assert outer["cell_active"].iloc[:-1].all()
+    assert (outer["Sigma_surf"].iloc[:-1] > 0.0).all()
+    assert outer["Sigma_surf"].iloc[-1] == 0.0
+    assert set(run_df["cell_stop_reason"].dropna()) == {"inert"}
@@ -0,0 +1,56 @@
+"""1D runs on log, user-edged and adaptive radial grids."""
+
+from __future__ import annotations
+
+from pathlib import Path
+
+import numpy as np
+import pytest
+
+from marsdisk import constants
+from one_d_helpers import run_one_d_case
+
+BASE_OVERRIDES = [
+    "geometry.mode=1D",
+    "numerics.t_end_orbits=0.05",
+    "numerics.t_end_years=null",
+    "numerics.dt_init=50.0",
+    "phase.enabled=false",
+]
+
+
+def test_edges_spacing_uses_configured_cells(tmp_path: Path) -> None:
+    summary, run_df, _ = run_one_d_case(
+        tmp_path,
+        BASE_OVERRIDES + ["geometry.spacing=edges", "geometry.edges_RM=[2.2,2.3,2.5,2.7]"],
+    )
+    geometry = summary["geometry"]
+    assert geometry["spacing"] == "edges"
+    assert geometry["Nr"] == 3
+    np.testing.assert_allclose(
+        np.asarray(geometry["edges_m"]) / constants.R_MARS, [2.2, 2.3, 2.5, 2.7]
+    )
+    r_rm = run_df.groupby("cell_index")["r_RM"].first().to_numpy()
+    np.testing.assert_allclose(r_rm, [2.25, 2.4, 2.6])
+
+
+def test_adaptive_spacing_reads_pilot_layout(tmp_path: Path) -> None:
+    pilot_dir = tmp_path / "pilot"
+    pilot_summary, _, _ = run_one_d_case(
+        pilot_dir, BASE_OVERRIDES + ["geometry.Nr=6", "geometry.spacing=log"]
+    )
+    assert pilot_summary["geometry"]["spacing"] == "log"
+
+    summary, run_df, _ = run_one_d_case(
+        tmp_path / "adaptive",
+        BASE_OVERRIDES
+        + ["geometry.Nr=2", "geometry.spacing=adaptive", f"geometry.adapt_from={pilot_dir.as_posix()}"],
+    )
+    geometry = summary["geometry"]
+    assert geometry["spacing"] == "adaptive"
+    assert geometry["pilot_cells"] == 6
+    assert 2 <= geometry["Nr"] <= 24
+    assert run_df["cell_index"].nunique() == geometry["Nr"]
+    edges = np.asarray(geometry["edges_m"])
+    assert edges[0] == pytest.approx(pilot_summary["geometry"]["r_in_m"])
+    assert edges[-1] == pytest.approx(pilot_summary["geometry"]["r_out_m"])
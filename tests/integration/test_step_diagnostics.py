@@ -1,5 +1,6 @@
 from __future__ import annotations
 
+import json
 from pathlib import Path
 
 import numpy as np
@@ -9,7 +10,13 @@ import pytest
 from marsdisk import run, schema
 
 
-def _build_config(outdir: Path, fmt: str) -> schema.Config:
+def _build_config(
+    outdir: Path,
+    fmt: str,
+    *,
+    t_end_years: float = 1.0e-7,
+    **step_diag_kwargs,
+) -> schema.Config:
     cfg = schema.Config(
         geometry=schema.Geometry(mode="0D"),
         disk=schema.Disk(
@@ -33,7 +40,7 @@ def _build_config(outdir: Path, fmt: str) -> schema.Config:
         ),
         psd=schema.PSD(alpha=1.7, wavy_strength=0.0),
         qstar=schema.QStar(Qs=1.0e5, a_s=0.1, B=0.3, b_g=1.36, v_ref_kms=[1.0, 2.0]),
-        numerics=schema.Numerics(t_end_years=1.0e-7, dt_init=20.0),
+        numerics=schema.Numerics(t_end_years=t_end_years, dt_init=20.0),
         supply=schema.Supply(
             mode="const",
             const=schema.SupplyConst(prod_area_rate_kg_m2_s=5.0e-9),
@@ -41,7 +48,9 @@ def _build_config(outdir: Path, fmt: str) -> schema.Config:
         ),
         io=schema.IO(
             outdir=outdir,
-            step_diagnostics=schema.StepDiagnostics(enable=True, format=fmt),
+            step_diagnostics=schema.StepDiagnostics(
+                enable=True, format=fmt, **step_diag_kwargs
+            ),
         ),
     )
     cfg.sinks.mode = "sublimation"
@@ -51,21 +60,25 @@ def _build_config(outdir: Path, fmt: str) -> schema.Config:
     return cfg
 
 
+def _read_diagnostics(path: Path) -> pd.DataFrame:
+    if path.suffix == ".csv":
+        return pd.read_csv(path)
+    if path.suffix == ".parquet":
+        return pd.read_parquet(path)
+    return pd.read_json(path, lines=True)
+
+
 @pytest.mark.filterwarnings("ignore:Q_pr table not found")
-@pytest.mark.parametrize("fmt", ["csv", "jsonl"])
+@pytest.mark.parametrize("fmt", ["csv", "jsonl", "parquet"])
 def test_step_diagnostics_file_and_mass_budget(tmp_path: Path, fmt: str) -> None:
     outdir = tmp_path / f"step_diag_{fmt}"
     cfg = _build_config(outdir, fmt)
 
     run.run_zero_d(cfg)
 
-    ext = "jsonl" if fmt == "jsonl" else "csv"
-    diag_path = outdir / "series" / f"step_diagnostics.{ext}"
+    diag_path = outdir / "series" / f"step_diagnostics.{fmt}"
     assert diag_path.exists(), f"Expected diagnostics file {diag_path} to be created"
-    if fmt == "csv":
-        df = pd.read_csv(diag_path)
-    else:
-        df = pd.read_json(diag_path, lines=True)
+    df = _read_diagnostics(diag_path)
     assert not df.empty, "Diagnostics file should contain at least one row"
 
     required_cols = [
@@ -99,3 +112,63 @@ def test_step_diagnostics_file_and_mass_budget(tmp_path: Path, fmt: str) -> None
         rtol=0.0,
         atol=1.0e-12,
     ), "Per-step mass accounting should conserve the initial mass"
+
+
+@pytest.mark.filterwarnings("ignore:Q_pr table not found")
+def test_step_diagnostics_adaptive_sampling_thins_rows(tmp_path: Path) -> None:
+    outdir = tmp_path / "step_diag_adaptive"
+    cfg = _build_config(
+        outdir,
+        "parquet",
+        t_end_years=2.0e-5,
+        sampling="adaptive",
+        sparse_stride=10,
+        window_steps=4,
+        post_event_steps=2,
+    )
+
+    run.run_zero_d(cfg)
+
+    df = _read_diagnostics(outdir / "series" / "step_diagnostics.parquet")
+    assert "sample_reason" in df.columns
+    assert not df.empty
+    assert np.all(np.diff(df["time"].to_numpy()) > 0.0), "Sampled rows must stay in time order"
+
+    run_df = pd.read_parquet(outdir / "series" / "run.parquet")
+    assert len(df) < len(run_df), "Adaptive sampling should write fewer rows than steps"
+    assert df["sample_reason"].iloc[-1] in {"final", "sparse", "post_event", "window"} or str(
+        df["sample_reason"].iloc[-1]
+    ).startswith("event:")
+    assert np.isclose(df["time"].iloc[-1], run_df["time"].iloc[-1])
+
+    summary = json.loads((outdir / "summary.json").read_text())
+    stats = summary["step_diagnostics_sampling"]
+    assert stats["sampling"] == "adaptive"
+    assert stats["rows_written"] == len(df)
+    assert stats["rows_seen"] == len(run_df)
+
+
+@pytest.mark.filterwarnings("ignore:Q_pr table not found")
+def test_parquet_step_diagnostics_keep_rows_on_resume(tmp_path: Path, monkeypatch) -> None:
+    monkeypatch.setenv("FORCE_STREAMING_ON", "1")
+    monkeypatch.setenv("FORCE_STREAMING_OFF", "0")
+    outdir = tmp_path / "resume"
+    diag_path = outdir / "series" / "step_diagnostics.parquet"
+
+    def _config(t_end_years: float) -> schema.Config:
+        cfg = _build_config(outdir, "parquet", t_end_years=t_end_years)
+        cfg.io.streaming = schema.Streaming(enable=True, step_flush_interval=2)
+        cfg.numerics.checkpoint = schema.Checkpoint(enabled=True, interval_years=1.0e-5, keep_last_n=0)
+        return cfg
+
+    run.run_zero_d(_config(1.0e-5))
+    first = _read_diagnostics(diag_path)
+    checkpoint = sorted((outdir / "checkpoints").glob("ckpt_step_*"))[-1]
+
+    cfg = _config(2.0e-5)
+    cfg.numerics.resume = schema.Resume(enabled=True, from_path=checkpoint)
+    run.run_zero_d(cfg)
+    resumed = _read_diagnostics(diag_path)
+
+    assert len(resumed) > len(first)
+    np.testing.assert_allclose(resumed["time"].to_numpy()[: len(first)], first["time"].to_numpy())
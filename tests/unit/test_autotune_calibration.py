@@ -0,0 +1,94 @@
+from __future__ import annotations
+
+import json
+from pathlib import Path
+
+import pytest
+
+from marsdisk.runtime import autotune
+
+
+def _fast_calibration(**kwargs):
+    kwargs.setdefault("repeats", 1)
+    kwargs.setdefault("max_bench_cells", 2)
+    kwargs.setdefault("time_budget_s", 5.0)
+    return kwargs
+
+
+def test_calibrate_smol_kernels_reports_best_trial() -> None:
+    result = autotune.calibrate_smol_kernels(
+        n_bins=6,
+        n_cells=4,
+        thread_candidates=[1],
+        job_candidates=[1, 2],
+        **_fast_calibration(),
+    )
+    assert result.trials, "calibration should time at least one candidate"
+    best = min(trial["seconds_per_cell_step"] for trial in result.trials)
+    assert result.seconds_per_cell_step == pytest.approx(best)
+    assert result.numba_threads == 1
+    assert result.cell_jobs in {1, 2}
+    assert 1 <= result.cell_chunk_size <= 4
+
+
+def test_resolve_calibration_uses_cache(tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    cache = tmp_path / "calib.json"
+    first = autotune.resolve_calibration(
+        n_bins=5,
+        n_cells=1,
+        backend="numpy",
+        cache_path=cache,
+        thread_candidates=[1],
+        **_fast_calibration(),
+    )
+    assert not first.cached
+    payload = json.loads(cache.read_text())
+    assert first.key in payload["entries"]
+    assert "backend=numpy" in first.key and "n_bins=5" in first.key and "Nr=1" in first.key
+
+    def _fail(**_kwargs):
+        raise AssertionError("cached calibration must not re-measure")
+
+    monkeypatch.setattr(autotune, "calibrate_smol_kernels", _fail)
+    second = autotune.resolve_calibration(n_bins=5, n_cells=1, backend="numpy", cache_path=cache)
+    assert second.cached
+    assert second.numba_threads == first.numba_threads
+
+
+def test_apply_auto_tune_calibrate_exports_cell_settings(
+    tmp_path: Path, monkeypatch: pytest.MonkeyPatch
+) -> None:
+    def _fake(**_kwargs):
+        return autotune.CalibrationResult(
+            key="",
+            numba_threads=1,
+            cell_jobs=3,
+            cell_chunk_size=5,
+            seconds_per_cell_step=1.0e-4,
+            baseline_seconds_per_cell_step=2.0e-4,
+        )
+
+    monkeypatch.setattr(autotune, "calibrate_smol_kernels", _fake)
+    env: dict = {"MARSDISK_CELL_CHUNK_SIZE": "7"}
+    report = autotune.apply_auto_tune(
+        profile="calibrate",
+        env=env,
+        n_bins=8,
+        n_cells=12,
+        backend="numpy",
+        cache_path=tmp_path / "calib.json",
+    )
+    decision = report["decision"]
+    assert decision["profile_resolved"] == "calibrate"
+    assert decision["numba_thread_source"] == "calibrated"
+    assert decision["cell_jobs"] == 3
+    assert decision["cell_chunk_size"] == 7
+    assert env["NUMBA_NUM_THREADS"] == "1"
+    assert env["MARSDISK_CELL_JOBS"] == "3"
+    assert env["MARSDISK_CELL_CHUNK_SIZE"] == "7"
+    assert report["calibration"]["key"].endswith("|n_bins=8|Nr=12|backend=numpy")
+
+
+def test_apply_auto_tune_calibrate_requires_n_bins() -> None:
+    with pytest.raises(ValueError):
+        autotune.apply_auto_tune(profile="calibrate", env={})
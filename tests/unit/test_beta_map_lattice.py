@@ -0,0 +1,66 @@
+from __future__ import annotations
+
+import logging
+
+import numpy as np
+import pytest
+
+from marsdisk.io import tables
+from tools.diagnostics import beta_map
+
+
+FIELDS = (
+    "beta_raw",
+    "beta_eff",
+    "qpr_used",
+    "tau_final",
+    "phi_used",
+    "a_blow_final",
+    "sigma_tau1_final",
+    "dt_ratio",
+)
+
+
+@pytest.fixture(scope="module")
+def lattice_ctx():
+    spec = {
+        "config": "configs/base.yml",
+        "qpr_table": str(tables.DATA_DIR / "qpr_planck.csv"),
+        "phi_table": None,
+        "rho_p": None,
+        "s_min": None,
+        "n_step": 20,
+        "beta_thr": 0.5,
+    }
+    return spec, beta_map.build_context(spec, logging.getLogger("test_beta_map_lattice"))
+
+
+@pytest.mark.filterwarnings("ignore:surface_ode solver is deprecated")
+def test_lattice_matches_scalar_cells(lattice_ctx) -> None:
+    _, ctx = lattice_ctx
+    r_values = np.linspace(1.0, 3.0, 4)
+    T_values = np.linspace(2000.0, 6000.0, 3)
+    maps = beta_map.evaluate_lattice(r_values, T_values, ctx)
+
+    for key in FIELDS:
+        assert maps[key].shape == (T_values.size, r_values.size)
+    for j, T_M in enumerate(T_values):
+        for i, r_RM in enumerate(r_values):
+            cell = beta_map.evaluate_cell(float(r_RM), float(T_M), ctx)
+            for key in FIELDS:
+                assert maps[key][j, i] == pytest.approx(getattr(cell, key), rel=1e-12, abs=0.0)
+
+
+@pytest.mark.filterwarnings("ignore:surface_ode solver is deprecated")
+def test_worker_task_reports_its_qpr_lookups(lattice_ctx) -> None:
+    spec, ctx = lattice_ctx
+    r_values = np.linspace(1.0, 3.0, 4)
+    T_chunk = [2500.0, 4500.0]
+    before = ctx.qpr_lookup.calls
+    serial = beta_map.evaluate_lattice(r_values, np.asarray(T_chunk), ctx)
+    serial_calls = ctx.qpr_lookup.calls - before
+
+    rows, calls, failures = beta_map._evaluate_rows_task(spec, T_chunk, r_values)
+    assert calls == serial_calls > 0
+    assert failures == 0
+    np.testing.assert_array_equal(np.vstack([row["beta_raw"] for row in rows]), serial["beta_raw"])
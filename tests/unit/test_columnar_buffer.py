@@ -1,4 +1,7 @@
-from marsdisk.runtime.history import ColumnarBuffer
+import numpy as np
+import pytest
+
+from marsdisk.runtime.history import ArrayColumnarBuffer, ColumnarBuffer
 
 
 def test_columnar_buffer_basic():
@@ -25,3 +28,72 @@ def test_columnar_buffer_extend():
     table = buf_left.to_table(ensure_columns=["a", "b"])
     assert table.column("a").to_pylist() == [1, 2]
     assert table.column("b").to_pylist() == [None, 3]
+
+
+def test_array_buffer_matches_columnar_table():
+    rows = [
+        {"time": 1.0, "n": 1, "flag": True, "label": "a", "maybe": None},
+        {"time": 2.0, "n": 2.5, "flag": False, "label": None, "maybe": 3.0},
+    ]
+    ref = ColumnarBuffer()
+    ref.extend_rows(rows)
+    buf = ArrayColumnarBuffer(capacity=1)
+    buf.extend_rows(rows)
+    assert buf.capacity >= 2
+    expected = ref.to_table(ensure_columns=["time", "missing"])
+    table = buf.to_table(ensure_columns=["time", "missing"])
+    assert table.column_names == expected.column_names
+    assert table.to_pylist() == expected.to_pylist()
+    assert buf.to_records() == ref.to_records()
+
+
+def test_array_buffer_zero_copy_and_ring_reuse():
+    buf = ArrayColumnarBuffer(capacity=8)
+    start = buf.reserve_rows(3)
+    buf.write_column("x", start, np.array([1.0, 2.0, 3.0]))
+    buf.write_row(start + 1, {"y": 5})
+    buf.set_column_range("c", start, start + 3, None)
+    table = buf.to_table()
+    x_buffer = table.column("x").chunk(0).buffers()[1]
+    assert x_buffer.address == buf._data["x"].ctypes.data
+    assert table.column("y").to_pylist() == [None, 5, None]
+    assert table.column("c").null_count == 3
+
+    storage = buf._data["x"]
+    buf.clear()
+    assert len(buf) == 0
+    buf.append_row({"x": 9.0})
+    assert buf._data["x"] is storage
+    assert buf.to_table().column("y").to_pylist() == [None]
+
+
+def test_array_buffer_extend_mixed_buffers():
+    left = ArrayColumnarBuffer()
+    left.append_row({"a": 1})
+    right = ArrayColumnarBuffer()
+    right.append_row({"a": 2, "b": "s"})
+    left.extend_buffer(right)
+    plain = ColumnarBuffer()
+    plain.append_row({"a": 3})
+    left.extend_buffer(plain)
+    plain.extend_buffer(right)
+    assert left.to_table().column("a").to_pylist() == [1, 2, 3]
+    assert left.to_table().column("b").to_pylist() == [None, "s", None]
+    assert plain.to_table().column("b").to_pylist() == [None, "s"]
+
+
+def test_array_buffer_write_rows_matches_row_writes():
+    records = [
+        {"t": 0.0, "n": 1, "flag": True, "mode": "a", "opt": None, "mixed": 1.0},
+        {"t": 1.0, "n": 2, "flag": False, "mode": None, "opt": 3.5, "mixed": True},
+        {"t": 2.0, "flag": True, "mode": "b", "extra": 7},
+    ]
+    ref = ArrayColumnarBuffer()
+    ref_start = ref.reserve_rows(len(records))
+    for offset, record in enumerate(records):
+        ref.write_row(ref_start + offset, record)
+    buf = ArrayColumnarBuffer()
+    buf.write_rows(buf.reserve_rows(len(records)), records)
+    assert buf.to_table().equals(ref.to_table())
+    with pytest.raises(IndexError):
+        buf.write_rows(2, records)
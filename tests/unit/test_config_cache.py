@@ -0,0 +1,65 @@
+from __future__ import annotations
+
+import os
+from pathlib import Path
+
+import pytest
+
+from marsdisk import config_utils
+from marsdisk.run_zero_d import load_config
+
+BASE_CONFIG = Path(__file__).resolve().parents[2] / "configs" / "base.yml"
+
+
+@pytest.fixture(autouse=True)
+def _fresh_cache():
+    config_utils.clear_config_cache()
+    yield
+    config_utils.clear_config_cache()
+
+
+def test_yaml_payload_cache_returns_private_copies(tmp_path: Path) -> None:
+    path = tmp_path / "cfg.yml"
+    path.write_text("a:\n  b: [1, 2]\n", encoding="utf-8")
+    first = config_utils.load_yaml_payload(path)
+    first["a"]["b"].append(3)
+    assert config_utils.load_yaml_payload(path) == {"a": {"b": [1, 2]}}
+
+
+def test_yaml_payload_cache_invalidates_on_change(tmp_path: Path) -> None:
+    path = tmp_path / "cfg.yml"
+    path.write_text("x: 1\n", encoding="utf-8")
+    assert config_utils.load_yaml_payload(path) == {"x": 1}
+    path.write_text("x: 22\n", encoding="utf-8")
+    stat = path.stat()
+    os.utime(path, ns=(stat.st_atime_ns, stat.st_mtime_ns + 1_000_000))
+    assert config_utils.load_yaml_payload(path) == {"x": 22}
+
+
+def test_override_forms_are_equivalent() -> None:
+    strings = ["radiation.TM_K=2100", 'io.float32_columns=["*"]', "physics.numerics.dt_init=30"]
+    mapping = {"radiation.TM_K": 2100, "io.float32_columns": ["*"], "numerics.dt_init": 30}
+    deltas = config_utils.parse_overrides(strings)
+    assert [d.path for d in deltas] == [
+        ("radiation", "TM_K"),
+        ("io", "float32_columns"),
+        ("numerics", "dt_init"),
+    ]
+    from_strings = load_config(BASE_CONFIG, overrides=strings)
+    from_mapping = load_config(BASE_CONFIG, overrides=mapping)
+    from_deltas = load_config(BASE_CONFIG, overrides=deltas)
+    for cfg in (from_mapping, from_deltas):
+        assert cfg.model_dump() == from_strings.model_dump()
+
+
+def test_cached_override_values_are_not_shared() -> None:
+    overrides = ['io.float32_columns=["*"]']
+    cfg_a = load_config(BASE_CONFIG, overrides=overrides)
+    cfg_a.io.float32_columns.append("tau")
+    cfg_b = load_config(BASE_CONFIG, overrides=overrides)
+    assert cfg_b.io.float32_columns == ["*"]
+
+
+def test_invalid_override_still_rejected() -> None:
+    with pytest.raises(config_utils.ConfigurationError):
+        config_utils.parse_overrides(["radiation.TM_K"])
@@ -0,0 +1,59 @@
+from __future__ import annotations
+
+import numpy as np
+import pytest
+
+from marsdisk import run_zero_d
+from marsdisk.analysis import ensemble
+from marsdisk.errors import ConfigurationError
+from marsdisk.physics import collisions_smol
+
+
+def test_draw_samples_respects_bounds_and_seed() -> None:
+    specs = [
+        ensemble.parse_parameter_spec("material.rho=uniform:2500:3500"),
+        ensemble.parse_parameter_spec("qstar.coeff_scale=loguniform:0.1:10"),
+        ensemble.parse_parameter_spec("qstar.coeff_units=choice:si,ba99_cgs"),
+    ]
+    samples = ensemble.draw_samples(specs, 20, seed=3)
+    assert list(samples.columns) == ["material.rho", "qstar.coeff_scale", "qstar.coeff_units"]
+    assert samples["material.rho"].between(2500.0, 3500.0).all()
+    assert samples["qstar.coeff_scale"].between(0.1, 10.0).all()
+    assert set(samples["qstar.coeff_units"]) == {"si", "ba99_cgs"}
+    # Latin hypercube: one draw per stratum of each parameter.
+    strata = np.floor((samples["material.rho"] - 2500.0) / 1000.0 * 20).astype(int)
+    assert sorted(strata) == list(range(20))
+    assert samples.equals(ensemble.draw_samples(specs, 20, seed=3))
+
+    normal = ensemble.draw_samples([ensemble.parse_parameter_spec("a=lognormal:2:0.1")], 200, seed=0, method="random")
+    assert np.median(normal["a"]) == pytest.approx(2.0, rel=0.05)
+
+
+@pytest.mark.parametrize(
+    "text",
+    ["material.rho", "material.rho=gamma:1:2", "material.rho=uniform:3:1", "x=loguniform:0:1", "x=normal:1"],
+)
+def test_parse_parameter_spec_rejects_invalid(text: str) -> None:
+    with pytest.raises(ConfigurationError):
+        ensemble.parse_parameter_spec(text)
+
+
+def test_partial_reset_keeps_size_only_caches() -> None:
+    collisions_smol.reset_collision_caches()
+    weights = collisions_smol._get_thread_cache("weights_cache")
+    qstar_cache = collisions_smol._get_thread_cache("qstar_cache")
+    try:
+        assert run_zero_d._reset_collision_runtime_state(persist=True, signature="a", size_signature="grid") == "reset"
+        weights["w"] = np.ones(2)
+        qstar_cache["q"] = np.ones(2)
+        assert run_zero_d._reset_collision_runtime_state(persist=True, signature="a", size_signature="grid") == "reuse"
+        assert "q" in qstar_cache
+
+        assert run_zero_d._reset_collision_runtime_state(persist=True, signature="b", size_signature="grid") == "size_only"
+        assert "w" in weights and "q" not in qstar_cache
+
+        assert run_zero_d._reset_collision_runtime_state(persist=True, signature="c", size_signature="other") == "reset"
+        assert "w" not in weights
+        assert run_zero_d._reset_collision_runtime_state(persist=False, signature=None) == "off"
+    finally:
+        run_zero_d._reset_collision_runtime_state(persist=False, signature=None)
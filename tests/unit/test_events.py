@@ -0,0 +1,60 @@
+from __future__ import annotations
+
+import pytest
+
+from marsdisk.runtime.events import EventEngine
+
+
+def test_above_event_is_strict_and_locates_crossing() -> None:
+    engine = EventEngine(2)
+    engine.register("tau_exceeded", threshold=1.0, direction="above")
+
+    assert engine.observe("tau_exceeded", 0.0, 0.5, subject=1) is None
+    assert engine.observe("tau_exceeded", 10.0, 1.0, subject=1) is None
+    hit = engine.observe("tau_exceeded", 20.0, 3.0, subject=1)
+
+    assert hit is not None
+    assert hit.time == 20.0
+    assert hit.t_cross == pytest.approx(10.0)
+    assert engine.active.tolist() == [True, False]
+    assert engine.retire_reason == [None, "tau_exceeded"]
+    assert not engine.all_retired
+
+
+def test_below_event_fires_on_threshold_and_ignores_nan() -> None:
+    engine = EventEngine()
+    engine.register("loss_rate_below_threshold", threshold=1.0e-3, direction="below", terminal=False)
+
+    assert engine.observe("loss_rate_below_threshold", 1.0, float("nan")) is None
+    assert engine.observe("loss_rate_below_threshold", 2.0, 3.0e-3) is None
+    hit = engine.observe("loss_rate_below_threshold", 4.0, 1.0e-3)
+
+    assert hit is not None
+    assert hit.t_cross == pytest.approx(4.0)
+    assert engine.active.tolist() == [True]
+    report = engine.report()
+    assert report["hit_counts"] == {"loss_rate_below_threshold": 1}
+    assert report["hits"][0]["time"] == 4.0
+
+
+def test_first_sample_hit_uses_step_time_and_unregistered_is_noop() -> None:
+    engine = EventEngine(3)
+    engine.register("a_blow_below_s_min_config", threshold=1.0e-6, direction="below")
+
+    assert engine.observe("tau_exceeded", 0.0, 10.0) is None
+    hit = engine.observe("a_blow_below_s_min_config", 5.0, 5.0e-7, subject=2)
+    assert hit is not None and hit.t_cross == 5.0
+
+    engine.retire(0, "inert")
+    engine.retire(1, "inert")
+    assert engine.all_retired
+    assert engine.retired_by("inert") == 2
+    assert "a_blow_below_s_min_config" in engine
+
+
+def test_register_rejects_bad_direction() -> None:
+    engine = EventEngine()
+    with pytest.raises(ValueError):
+        engine.register("x", threshold=1.0, direction="sideways")
+    with pytest.raises(ValueError):
+        engine.register("x", threshold=float("nan"))
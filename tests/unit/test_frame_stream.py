@@ -0,0 +1,104 @@
+from __future__ import annotations
+
+import json
+from pathlib import Path
+
+import numpy as np
+import pytest
+
+from tools.plotting import frame_stream, make_beta_movie
+
+
+class _ListEncoder(frame_stream.FrameEncoder):
+    def __init__(self) -> None:
+        super().__init__(Path("unused"))
+        self.images: list[np.ndarray] = []
+
+    def _append(self, rgb: np.ndarray) -> None:
+        self.images.append(rgb)
+
+
+def _render_index(payload: int) -> np.ndarray:
+    return np.full((4, 6, 3), payload, dtype=np.uint8)
+
+
+@pytest.mark.parametrize("jobs", [1, 2])
+def test_stream_frames_keeps_order_and_bounds_in_flight(jobs: int) -> None:
+    encoder = _ListEncoder()
+    pulled = []
+    lag = []
+
+    def payloads():
+        for idx in range(12):
+            pulled.append(idx)
+            lag.append(len(pulled) - encoder.frames)
+            yield idx
+
+    count = frame_stream.stream_frames(payloads(), _render_index, encoder, jobs=jobs, max_in_flight=2)
+
+    assert count == 12
+    assert [int(img[0, 0, 0]) for img in encoder.images] == list(range(12))
+    # queue slots + submitted window + the item the loader is holding
+    assert max(lag) <= 2 * 2 + 1
+
+
+def test_loader_errors_reach_the_caller() -> None:
+    def payloads():
+        yield 0
+        raise ValueError("broken cube")
+
+    with pytest.raises(ValueError, match="broken cube"):
+        frame_stream.stream_frames(payloads(), _render_index, _ListEncoder())
+
+
+def test_pillow_gif_encoder_writes_all_frames(tmp_path: Path) -> None:
+    pytest.importorskip("PIL")
+    from PIL import Image
+
+    gif_path = tmp_path / "anim.gif"
+    with frame_stream.PillowGifEncoder(gif_path, duration_ms=50) as encoder:
+        for idx in range(3):
+            encoder.append(_render_index(80 * idx))
+    with Image.open(gif_path) as img:
+        assert img.n_frames == 3
+
+
+def _write_zarr_cube(path: Path, cube: np.ndarray) -> None:
+    path.mkdir(parents=True)
+    meta = {"dtype": cube.dtype.str, "shape": list(cube.shape), "order": "C"}
+    (path / ".zarray").write_text(json.dumps(meta), encoding="utf-8")
+    (path / "0.0.0").write_bytes(np.ascontiguousarray(cube).tobytes())
+
+
+def test_beta_movie_streams_memmapped_cube(tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    cube = np.random.default_rng(3).random((5, 4, 3))
+    cube_path = tmp_path / "beta_cube.zarr"
+    _write_zarr_cube(cube_path, cube)
+    mapped = make_beta_movie._read_zarr_array(cube_path, mmap=True)
+    assert isinstance(mapped, np.memmap)
+    np.testing.assert_array_equal(mapped, make_beta_movie._read_zarr_array(cube_path))
+
+    encoder = _ListEncoder()
+    monkeypatch.setattr(make_beta_movie, "open_movie_encoder", lambda path, fps: encoder)
+    frames_dir = tmp_path / "frames"
+    count = make_beta_movie.render_movie(
+        mapped,
+        np.linspace(1.0, 3.0, 5),
+        np.linspace(2000.0, 6000.0, 4),
+        [0.0, 0.5, 1.0],
+        tmp_path / "beta.mp4",
+        frames_dir=frames_dir,
+        fps=5,
+        dt_ratio_median=0.1,
+        qpr_table="qpr_planck.csv",
+        vmax=None,
+    )
+
+    assert count == 3
+    assert sorted(p.name for p in frames_dir.glob("step_*.png")) == [
+        "step_000.png",
+        "step_001.png",
+        "step_002.png",
+    ]
+    shapes = {img.shape for img in encoder.images}
+    assert shapes == {(640, 960, 3)}
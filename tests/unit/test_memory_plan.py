@@ -0,0 +1,159 @@
+from __future__ import annotations
+
+from pathlib import Path
+
+import pytest
+
+from marsdisk.physics import collisions_smol
+from marsdisk.runtime import memory_plan
+from marsdisk.runtime.memory_plan import MemoryRequest, MemoryWatchdog, plan_memory
+
+
+GiB = 1024.0**3
+
+
+def _request(**kwargs) -> MemoryRequest:
+    base = dict(n_steps=200_000, n_bins=40, cache_scale=3.0, step_flush_interval=10_000)
+    base.update(kwargs)
+    return MemoryRequest(**base)
+
+
+def test_generous_budget_keeps_requested_settings() -> None:
+    req = _request()
+    plan = plan_memory(req, 64 * GiB, baseline_bytes=0.0)
+    assert plan.fits
+    assert plan.cache_scale == pytest.approx(3.0)
+    assert plan.step_flush_interval == 10_000
+    assert plan.psd_history_stride == 1
+    assert plan.memory_limit_gb == pytest.approx(10.0)
+
+
+def test_tight_budget_lowers_flush_interval_within_limit() -> None:
+    req = _request()
+    plan = plan_memory(req, 0.25 * GiB, baseline_bytes=50e6)
+    assert plan.fits
+    assert plan.step_flush_interval < 10_000
+    assert plan.total_bytes <= plan.limit_bytes
+    per_step = memory_plan.buffer_bytes_per_step(req, plan.psd_history_stride)
+    assert plan.memory_limit_gb * GiB >= plan.step_flush_interval * per_step
+
+
+def test_budget_shrinks_caches_then_workers() -> None:
+    req = _request(n_bins=120, cell_jobs=8, n_cells=16)
+    plan = plan_memory(req, 0.5 * GiB, baseline_bytes=0.0, min_cache_scale=0.25)
+    assert plan.cache_scale == pytest.approx(0.25)
+    assert plan.cell_jobs < 8
+    assert plan.cache_bytes + plan.worker_bytes <= plan.limit_bytes * memory_plan.FIXED_SHARE
+    assert any(item.startswith("cell_jobs") for item in plan.adjustments)
+
+    fixed = plan_memory(req, 0.5 * GiB, baseline_bytes=0.0, min_cache_scale=0.25, adjust_cell_jobs=False)
+    assert fixed.cell_jobs == 8
+    assert not any(item.startswith("cell_jobs") for item in fixed.adjustments)
+
+
+def test_rss_falls_back_without_proc_and_resource(monkeypatch) -> None:
+    import builtins
+
+    real_import = builtins.__import__
+
+    def _no_resource(name, *args, **kwargs):
+        if name in {"resource", "psutil"}:
+            raise ImportError(name)
+        return real_import(name, *args, **kwargs)
+
+    monkeypatch.setattr(memory_plan, "_read_text", lambda path: None)
+    monkeypatch.setattr(builtins, "__import__", _no_resource)
+    assert memory_plan.current_rss_bytes() == 0
+
+
+def test_psd_stride_raised_when_flush_interval_would_collapse() -> None:
+    req = _request(n_bins=200, n_cells=32, cache_scale=0.25)
+    plan = plan_memory(
+        req,
+        0.3 * GiB,
+        baseline_bytes=0.0,
+        min_flush_interval=64,
+        max_psd_history_stride=16,
+    )
+    assert plan.psd_history_stride > 1
+    assert plan.psd_history_stride <= 16
+
+
+def test_without_streaming_stride_bounds_whole_history() -> None:
+    req = _request(streaming_enabled=False, n_steps=200_000, n_bins=60)
+    plan = plan_memory(req, 2.0 * GiB, baseline_bytes=0.0, max_psd_history_stride=256)
+    assert plan.psd_history_stride > 1
+    assert plan.fits
+    assert plan.buffer_bytes == pytest.approx(
+        200_000 * memory_plan.buffer_bytes_per_step(req, plan.psd_history_stride)
+    )
+
+
+def test_cache_footprint_scales_with_limits() -> None:
+    small = collisions_smol.collision_cache_footprint(40, scale=1.0, threads=1)
+    large = collisions_smol.collision_cache_footprint(40, scale=2.0, threads=1)
+    more_threads = collisions_smol.collision_cache_footprint(40, scale=1.0, threads=4)
+    assert large == pytest.approx(2.0 * small)
+    assert more_threads > small
+
+
+def test_detect_memory_limit_reads_cgroup_v2(tmp_path: Path, monkeypatch) -> None:
+    (tmp_path / "memory.max").write_text("1073741824\n")
+    monkeypatch.setattr(memory_plan, "_read_text", _reader_without_proc(memory_plan._read_text))
+    limit, source = memory_plan.detect_memory_limit(tmp_path)
+    assert (limit, source) == (1073741824, "cgroup")
+
+
+def test_detect_memory_limit_ignores_unlimited_cgroup(tmp_path: Path, monkeypatch) -> None:
+    (tmp_path / "memory.max").write_text("max\n")
+    monkeypatch.setattr(memory_plan, "_read_text", _reader_without_proc(memory_plan._read_text))
+    _, source = memory_plan.detect_memory_limit(tmp_path)
+    assert source in {"physical", "unknown"}
+
+
+def _reader_without_proc(original):
+    def _read(path: Path):
+        if str(path) == "/proc/self/cgroup":
+            return None
+        return original(path)
+
+    return _read
+
+
+def test_watchdog_escalates_flush_shrink_stride() -> None:
+    rss = [2.0 * GiB]
+    applied: list[float] = []
+    watchdog = MemoryWatchdog(
+        1.0 * GiB,
+        interval_steps=10,
+        cache_scale=1.0,
+        min_cache_scale=0.5,
+        psd_history_stride=1,
+        max_psd_history_stride=2,
+        rss_reader=lambda: rss[0],
+        apply_cache=applied.append,
+    )
+    assert watchdog.check(5) == ()
+    assert watchdog.check(10) == ("flush",)
+    assert watchdog.check(20) == ("flush", "shrink_caches")
+    assert applied == [0.5]
+    assert watchdog.check(30) == ("flush", "raise_stride")
+    assert watchdog.psd_history_stride == 2
+    assert watchdog.check(40) == ("flush",)
+
+    rss[0] = 0.5 * GiB
+    assert watchdog.check(50) == ()
+    stats = watchdog.stats()
+    assert stats["checks"] == 5
+    assert stats["peak_rss_bytes"] == int(2.0 * GiB)
+    assert [entry["step_no"] for entry in stats["actions"]] == [10, 20, 30, 40]
+
+
+def test_watchdog_single_excursion_only_flushes() -> None:
+    rss = [2.0 * GiB]
+    watchdog = MemoryWatchdog(1.0 * GiB, interval_steps=1, rss_reader=lambda: rss[0], apply_cache=lambda _: None)
+    assert watchdog.check(1) == ("flush",)
+    rss[0] = 0.1 * GiB
+    assert watchdog.check(2) == ()
+    rss[0] = 2.0 * GiB
+    assert watchdog.check(3) == ("flush",)
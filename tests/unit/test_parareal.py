@@ -0,0 +1,121 @@
+from __future__ import annotations
+
+from pathlib import Path
+
+import numpy as np
+import pytest
+
+from marsdisk import grid
+from marsdisk.config_utils import resolve_reference_radius
+from marsdisk.run import load_config
+from marsdisk.runtime import parareal
+
+
+def _problem(n_bins: int = 6, t_end: float = 6.0e4) -> parareal.PararealProblem:
+    sizes = np.logspace(-6, -4, n_bins)
+    m = 4.0 / 3.0 * np.pi * 3000.0 * sizes**3
+    # Fragments of an (i, j) collision are spread evenly over bins ≤ min(i, j).
+    Y = np.zeros((n_bins, n_bins, n_bins))
+    for i in range(n_bins):
+        for j in range(n_bins):
+            k = min(i, j)
+            Y[: k + 1, i, j] = 1.0 / (k + 1)
+    # Blow-out/sublimation sinks strengthen as the (tabulated) temperature rises.
+    sink_rates = np.zeros((2, n_bins))
+    sink_rates[0, :1] = 1.0e-5
+    sink_rates[1, :2] = 5.0e-5
+    source = np.zeros(n_bins)
+    source[-1] = 1.0e-22 / m[-1]
+    operators = parareal.TabulatedSmolOperators(
+        sizes=sizes,
+        H=np.full(n_bins, 1.0e3),
+        v_rel=100.0,
+        Y=Y,
+        source=source,
+        sink_times=np.array([0.0, t_end]),
+        sink_rates=sink_rates,
+    )
+    return parareal.PararealProblem(m=m, N0=1.0e-10 / m / n_bins, t0=0.0, t_end=t_end, operators=operators)
+
+
+def _mass_distance(problem: parareal.PararealProblem, a: np.ndarray, b: np.ndarray) -> float:
+    weights = np.concatenate([problem.m, [1.0, 1.0]])
+    return float(np.abs(a - b) @ weights / problem.mass(problem.initial_state()))
+
+
+def test_all_iterations_reproduce_serial_fine_solution() -> None:
+    problem = _problem()
+    reference = parareal.run_serial(problem, 100.0)
+    result = parareal.run_parareal(problem, n_windows=4, dt_fine=100.0, tol=0.0)
+
+    assert result.iterations == 4
+    assert result.converged
+    np.testing.assert_allclose(result.final_state, reference, rtol=1e-12, atol=0.0)
+    assert [entry["fine_windows"] for entry in result.history] == [4, 3, 2, 1]
+
+
+def test_parareal_converges_before_last_window() -> None:
+    problem = _problem()
+    reference = parareal.run_serial(problem, 100.0)
+    result = parareal.run_parareal(problem, n_windows=6, dt_fine=100.0, coarse_steps=16, tol=1e-4)
+
+    assert result.converged
+    assert result.iterations < 6
+    assert _mass_distance(problem, result.final_state, reference) < 1e-4
+    changes = [entry["max_change"] for entry in result.history]
+    assert changes[-1] <= 1e-4 < changes[0]
+
+    mass0 = problem.mass(problem.initial_state())
+    budget = abs(problem.mass(reference) + reference[-2] - reference[-1] - mass0) / mass0 * 100.0
+    final_budget = parareal._budget_error_percent(problem, result.final_state, mass0)
+    assert abs(final_budget - budget) < 1e-2
+    assert reference[-1] > 0.0 and reference[-2] > 0.0
+
+
+def test_worker_pool_matches_in_process_windows() -> None:
+    problem = _problem(t_end=3.0e4)
+    serial = parareal.run_parareal(problem, n_windows=3, dt_fine=100.0, coarse_steps=4, tol=1e-6)
+    pooled = parareal.run_parareal(problem, n_windows=3, dt_fine=100.0, coarse_steps=4, tol=1e-6, jobs=2)
+
+    assert pooled.iterations == serial.iterations
+    np.testing.assert_allclose(pooled.states, serial.states, rtol=1e-12, atol=0.0)
+    assert serial.pool["executor"] == "serial"
+    assert pooled.pool["executor"] == "process"
+    assert pooled.pool["thread_budget"]["dynamic"]
+    assert "placement" in pooled.pool
+
+
+def test_process_executor_rejects_closure_operators() -> None:
+    base = _problem(t_end=3.0e4)
+    problem = parareal.PararealProblem(
+        m=base.m, N0=base.N0, t0=base.t0, t_end=base.t_end, operators=lambda t, N: base.operators(t, N)
+    )
+    with pytest.raises(ValueError, match="executor='thread'"):
+        parareal.run_parareal(problem, n_windows=3, dt_fine=100.0, coarse_steps=4, jobs=2)
+
+    threaded = parareal.run_parareal(problem, n_windows=3, dt_fine=100.0, coarse_steps=4, jobs=2, executor="thread")
+    reference = parareal.run_parareal(base, n_windows=3, dt_fine=100.0, coarse_steps=4)
+    np.testing.assert_allclose(threaded.states, reference.states, rtol=1e-12, atol=0.0)
+
+
+def test_problem_from_config_uses_runner_setup() -> None:
+    cfg = load_config(
+        Path("configs/innerdisk_base.yml"),
+        overrides=["sizes.n_bins=8", "sizes.s_max=1.0e-3", "dynamics.e_profile.mode=off"],
+    )
+    problem = parareal.problem_from_config(cfg, sigma_surf=1.0e-6, t_end=1.0e3, sink_samples=5)
+    operators = problem.operators
+
+    assert problem.mass(problem.initial_state()) == pytest.approx(1.0e-6, rel=1e-12)
+    assert operators.sizes.size == problem.m.size == 8
+    assert operators.sink_rates.shape == (5, 8)
+    # Only the bin whose lower edge sits on the blow-out size drains, at 1/t_blow.
+    r, _, _ = resolve_reference_radius(cfg)
+    t_blow = min(max(float(cfg.chi_blow), 0.5), 2.0) / grid.omega_kepler(r)
+    np.testing.assert_allclose(operators.sink_rates[:, 0], 1.0 / t_blow)
+    assert not operators.sink_rates[:, 1:].any()
+
+    state = parareal.run_serial(problem, 50.0)
+    mass0 = problem.mass(problem.initial_state())
+    assert state[-2] > 0.0
+    assert parareal._budget_error_percent(problem, state, mass0) < 1.0
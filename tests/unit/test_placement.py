@@ -0,0 +1,56 @@
+from __future__ import annotations
+
+import os
+import threading
+from pathlib import Path
+
+import pytest
+
+from marsdisk.runtime import autotune, placement
+
+
+def test_parse_cpulist_ranges() -> None:
+    assert autotune.parse_cpulist("0-3,8,10-11\n") == [0, 1, 2, 3, 8, 10, 11]
+    assert autotune.parse_cpulist("") == []
+
+
+def test_detect_numa_nodes_from_sysfs(tmp_path: Path) -> None:
+    for idx, cpulist in enumerate(["0-1", "2-3"]):
+        node = tmp_path / f"node{idx}"
+        node.mkdir()
+        (node / "cpulist").write_text(cpulist)
+    (tmp_path / "online").write_text("0-1")
+    assert autotune._detect_numa_nodes(tmp_path) == [[0, 1], [2, 3]]
+    assert autotune._detect_numa_nodes(tmp_path / "missing") is None
+
+
+def test_plan_placement_spreads_over_nodes() -> None:
+    plan = placement.plan_placement(4, threads_per_worker=2, nodes=[[0, 1, 2, 3], [4, 5, 6, 7]])
+    assert [slot.node for slot in plan] == [0, 1, 0, 1]
+    assert [slot.cpus for slot in plan] == [[0, 1], [4, 5], [2, 3], [6, 7]]
+    assert placement.plan_placement(0, nodes=[[0]]) == []
+
+
+def test_process_pool_options_opt_in() -> None:
+    kwargs, report = placement.process_pool_options(2, env={})
+    assert kwargs == {}
+    assert report == {"enabled": False, "reason": "not_requested"}
+
+
+@pytest.mark.skipif(not hasattr(os, "sched_setaffinity"), reason="Linux affinity API required")
+def test_pinned_worker_pool_is_sticky_and_pinned() -> None:
+    cpus = sorted(os.sched_getaffinity(0))
+    plan = placement.plan_placement(2, nodes=[cpus])
+    pool = placement.PinnedWorkerPool(plan)
+    try:
+        first = pool.map(lambda _: threading.get_ident(), range(4))
+        second = pool.map(lambda _: threading.get_ident(), range(4))
+        affinity = pool.map(lambda _: sorted(os.sched_getaffinity(0)), range(2))
+    finally:
+        pool.shutdown()
+    assert first == second
+    assert first[0] == first[2] and first[1] == first[3]
+    assert affinity == [slot.cpus for slot in plan]
+    report = pool.report()
+    assert report["enabled"] and all(worker["pinned"] for worker in report["workers"])
+    assert sorted(os.sched_getaffinity(0)) == cpus, "pinning must not leak to the caller"
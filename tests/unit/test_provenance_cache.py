@@ -0,0 +1,90 @@
+from __future__ import annotations
+
+import hashlib
+import json
+import os
+from pathlib import Path
+
+import pytest
+
+from marsdisk import provenance
+
+
+@pytest.fixture(autouse=True)
+def _fresh_cache(monkeypatch: pytest.MonkeyPatch):
+    monkeypatch.delenv(provenance.SNAPSHOT_ENV, raising=False)
+    provenance.clear_provenance_cache()
+    yield
+    provenance.clear_provenance_cache()
+
+
+def _write(path: Path, payload: bytes) -> Path:
+    path.write_bytes(payload)
+    return path
+
+
+def test_digest_memoised_until_file_changes(tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    table = _write(tmp_path / "qpr.csv", b"a,b\n1,2\n")
+    calls = []
+    real_hash = provenance._hash_file
+    monkeypatch.setattr(
+        provenance, "_hash_file", lambda path, chunk: calls.append(path) or real_hash(path, chunk)
+    )
+    first = provenance.gather_runtime_provenance(external_files=[table])["external_files"][0]
+    again = provenance.gather_runtime_provenance(external_files=[table])["external_files"][0]
+    assert first["sha256"] == again["sha256"] == hashlib.sha256(b"a,b\n1,2\n").hexdigest()
+    assert len(calls) == 1
+
+    _write(table, b"a,b\n1,3\n")
+    stat = table.stat()
+    os.utime(table, ns=(stat.st_atime_ns, stat.st_mtime_ns + 1_000_000))
+    changed = provenance.gather_runtime_provenance(external_files=[table])["external_files"][0]
+    assert changed["sha256"] == hashlib.sha256(b"a,b\n1,3\n").hexdigest()
+    assert len(calls) == 2
+
+
+def test_hash_files_parallel_matches_serial(tmp_path: Path) -> None:
+    paths = [_write(tmp_path / f"t{i}.bin", bytes([i]) * (1000 + i)) for i in range(6)]
+    digests = provenance.hash_files(paths + [None, paths[0]], max_workers=3)
+    assert len(digests) == 6
+    for path in paths:
+        assert digests[str(path.resolve())] == hashlib.sha256(path.read_bytes()).hexdigest()
+
+
+def test_git_info_resolved_once(monkeypatch: pytest.MonkeyPatch) -> None:
+    calls = []
+    monkeypatch.setattr(
+        provenance,
+        "_resolve_git_info",
+        lambda root: calls.append(root) or {"commit": "abc", "branch": "main", "dirty": False},
+    )
+    assert provenance.git_info()["commit"] == "abc"
+    assert provenance._safe_git_commit() == "abc"
+    assert len(calls) == 1
+
+
+def test_published_snapshot_is_reused_by_workers(tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    table = _write(tmp_path / "qpr.csv", b"payload")
+    monkeypatch.setattr(
+        provenance, "_resolve_git_info", lambda root: {"commit": "feed", "branch": "b", "dirty": True}
+    )
+    snap_path = provenance.publish_snapshot(external_files=[table], path=tmp_path / "snap.json")
+    assert os.environ[provenance.SNAPSHOT_ENV] == str(snap_path)
+    payload = json.loads(snap_path.read_text())
+    assert payload["digests"][0]["sha256"] == hashlib.sha256(b"payload").hexdigest()
+
+    # Simulate a fresh worker process: empty caches, no git, no hashing.
+    provenance.clear_provenance_cache()
+    monkeypatch.setattr(provenance, "_resolve_git_info", lambda root: pytest.fail("git re-run"))
+    monkeypatch.setattr(provenance, "_hash_file", lambda path, chunk: pytest.fail("re-hashed"))
+    row = provenance.gather_runtime_provenance(external_files=[table])
+    assert row["git_commit"] == "feed"
+    assert row["external_files"][0]["sha256"] == hashlib.sha256(b"payload").hexdigest()
+
+
+def test_shared_snapshot_restores_environment(tmp_path: Path) -> None:
+    with provenance.shared_snapshot(external_files=[]) as snap:
+        assert snap is not None and snap.exists()
+        assert os.environ[provenance.SNAPSHOT_ENV] == str(snap)
+    assert provenance.SNAPSHOT_ENV not in os.environ
+    assert not snap.exists()
@@ -0,0 +1,88 @@
+from __future__ import annotations
+
+from pathlib import Path
+
+import numpy as np
+import pytest
+
+from marsdisk import grid
+from marsdisk.errors import ConfigurationError
+from marsdisk.run import load_config
+
+
+def _annulus_areas(edges: np.ndarray) -> np.ndarray:
+    return np.pi * (edges[1:] ** 2 - edges[:-1] ** 2)
+
+
+def test_logarithmic_grid_is_finer_inside() -> None:
+    g = grid.RadialGrid.logarithmic(1.0, 4.0, 8)
+    dr = np.diff(g.edges)
+    assert g.edges[0] == 1.0 and g.edges[-1] == 4.0
+    assert np.all(np.diff(dr) > 0.0)
+    np.testing.assert_allclose(g.edges[1:] / g.edges[:-1], 4.0 ** (1.0 / 8.0))
+    with pytest.raises(ValueError):
+        grid.RadialGrid.logarithmic(0.0, 1.0, 4)
+
+
+def test_remap_conservative_preserves_mass_for_psd_arrays() -> None:
+    rng = np.random.default_rng(3)
+    src = np.sort(np.concatenate(([1.0, 3.0], rng.uniform(1.0, 3.0, 9))))
+    dst = np.geomspace(1.0, 3.0, 5)
+    sigma = rng.uniform(0.1, 2.0, src.size - 1)
+    psd = rng.uniform(0.0, 1.0, (src.size - 1, 6))
+
+    sigma_dst = grid.remap_conservative(src, dst, sigma)
+    psd_dst = grid.remap_conservative(src, dst, psd)
+
+    assert sigma_dst.shape == (4,)
+    assert psd_dst.shape == (4, 6)
+    assert np.sum(sigma_dst * _annulus_areas(dst)) == pytest.approx(np.sum(sigma * _annulus_areas(src)))
+    np.testing.assert_allclose(
+        psd_dst.T @ _annulus_areas(dst), psd.T @ _annulus_areas(src), rtol=1.0e-12
+    )
+    # A uniform field stays uniform.
+    np.testing.assert_allclose(grid.remap_conservative(src, dst, np.full(src.size - 1, 2.5)), 2.5)
+
+
+def test_adapt_edges_splits_at_gradients_and_merges_flat_regions() -> None:
+    edges = np.linspace(1.0, 2.0, 17)
+    r = 0.5 * (edges[1:] + edges[:-1])
+    sigma = np.where(r < 1.5, 10.0, 1.0)
+    tau = np.ones_like(r)
+
+    new_edges, stats = grid.adapt_edges(edges, [sigma, tau], split_tol=0.2, merge_tol=0.02, n_min=4)
+
+    assert new_edges[0] == 1.0 and new_edges[-1] == 2.0
+    assert np.all(np.diff(new_edges) > 0.0)
+    assert stats["splits"] > 0 and stats["merges"] > 0
+    dr = np.diff(new_edges)
+    centres = 0.5 * (new_edges[1:] + new_edges[:-1])
+    # Cells next to the jump end up finer than the flat outer cells.
+    assert dr[np.argmin(np.abs(centres - 1.5))] < dr[-1]
+    assert stats["n_cells"] == new_edges.size - 1 >= 4
+
+
+def test_adapt_edges_respects_cell_bounds() -> None:
+    edges = np.linspace(1.0, 2.0, 9)
+    flat, stats = grid.adapt_edges(edges, [np.ones(8)], n_min=3)
+    assert flat.size - 1 >= 3
+
+    steep = np.geomspace(1.0, 1.0e6, 8)
+    fine, _ = grid.adapt_edges(edges, [steep], n_max=12)
+    assert fine.size - 1 <= 12
+
+
+def test_geometry_edges_spacing_sets_nr_and_validates() -> None:
+    cfg = load_config(
+        Path("configs/base.yml"),
+        overrides=["geometry.mode=1D", "geometry.spacing=edges", "geometry.edges_RM=[2.2,2.3,2.7]"],
+    )
+    assert cfg.geometry.Nr == 2
+
+    with pytest.raises((ConfigurationError, ValueError)):
+        load_config(
+            Path("configs/base.yml"),
+            overrides=["geometry.mode=1D", "geometry.spacing=edges", "geometry.edges_RM=[2.2,2.1]"],
+        )
+    with pytest.raises((ConfigurationError, ValueError)):
+        load_config(Path("configs/base.yml"), overrides=["geometry.mode=1D", "geometry.spacing=adaptive"])
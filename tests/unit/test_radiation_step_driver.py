@@ -0,0 +1,54 @@
+import numpy as np
+import pytest
+
+from marsdisk import physics_step
+from marsdisk.physics import radiation
+
+
+radiation.load_qpr_table("data/qpr_table.csv")
+
+
+@pytest.fixture(autouse=True)
+def _compiled_radiation(monkeypatch):
+    # Other tests reload the radiation module with Numba disabled.
+    radiation.load_qpr_table("data/qpr_table.csv")
+    monkeypatch.setattr(radiation, "_USE_NUMBA_RADIATION", radiation._NUMBA_RADIATION_AVAILABLE)
+    monkeypatch.setattr(radiation, "_USE_NUMBA_TABLES", radiation._NUMBA_TABLES_AVAILABLE)
+
+
+@pytest.mark.parametrize("T_M", [2000.0, 2437.5, 3999.0, 6200.0])
+def test_driver_matches_compute_radiation_parameters(T_M: float) -> None:
+    rho = 3000.0
+    driver = physics_step.RadiationStepDriver(rho)
+    if not driver.compiled:
+        pytest.skip("compiled radiation kernels unavailable")
+    s_min, initial = 1.0e-6, 2.0e-6
+
+    a_blow, qpr_blow = driver.blowout(s_min, T_M, initial=initial)
+    ref = physics_step.compute_radiation_parameters(s_min, rho, T_M, initial=initial)
+    assert a_blow == ref.a_blow
+    assert qpr_blow == radiation.qpr_lookup(max(ref.a_blow, 1.0e-12), T_M)
+
+    rad = driver.at_smin(s_min, T_M, a_blow=a_blow)
+    ref_step = physics_step.compute_radiation_parameters(s_min, rho, T_M, a_blow_override=a_blow)
+    assert rad.qpr_mean == ref_step.qpr_mean
+    assert rad.beta == ref_step.beta
+    assert driver.stats() == {"compiled": True, "compiled_steps": 1, "python_steps": 0}
+
+
+def test_driver_falls_back_outside_table_and_with_override() -> None:
+    driver = physics_step.RadiationStepDriver(3000.0)
+    if not driver.compiled:
+        pytest.skip("compiled radiation kernels unavailable")
+    s_vals, _, _ = radiation.compiled_qpr_table()
+    huge = float(np.max(s_vals)) * 10.0
+    a_blow, _ = driver.blowout(huge, 2000.0, initial=huge)
+    ref = physics_step.compute_radiation_parameters(huge, 3000.0, 2000.0, initial=huge)
+    assert a_blow == ref.a_blow
+
+    fixed = physics_step.RadiationStepDriver(3000.0, qpr_override=1.0)
+    assert not fixed.compiled
+    a_fixed, q_fixed = fixed.blowout(1.0e-6, 2000.0)
+    assert q_fixed == 1.0
+    assert a_fixed == radiation.blowout_radius(3000.0, 2000.0, Q_pr=1.0)
+    assert fixed.stats()["python_steps"] == 1
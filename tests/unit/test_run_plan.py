@@ -0,0 +1,42 @@
+from __future__ import annotations
+
+import dataclasses
+from pathlib import Path
+
+import pytest
+
+from marsdisk.orchestrator import PhysicsFlags, resolve_physics_flags, resolve_run_plan
+from marsdisk.run import load_config
+
+
+def test_run_plan_freezes_loop_invariant_config() -> None:
+    cfg = load_config(
+        Path("configs/base.yml"),
+        overrides=[
+            "numerics.stop_on_blowout_below_smin=true",
+            "dynamics.eps_restitution=0.3",
+            "surface.freeze_sigma=true",
+        ],
+    )
+    plan = resolve_run_plan(cfg, "default")
+
+    assert isinstance(plan, PhysicsFlags)
+    flags = resolve_physics_flags(cfg, "default")
+    for field in dataclasses.fields(PhysicsFlags):
+        assert getattr(plan, field.name) == getattr(flags, field.name)
+    assert plan.stop_on_blowout_below_smin is True
+    assert plan.eps_restitution == pytest.approx(0.3)
+    assert plan.freeze_sigma is True
+    assert plan.sinks_mode == cfg.sinks.mode
+    assert plan.mass_total == pytest.approx(cfg.initial.mass_total)
+
+    with pytest.raises(dataclasses.FrozenInstanceError):
+        plan.eps_restitution = 0.9  # type: ignore[misc]
+
+
+def test_run_plan_applies_physics_mode() -> None:
+    cfg = load_config(Path("configs/base.yml"))
+    plan = resolve_run_plan(cfg, "sublimation_only")
+    assert plan.physics_mode == "sublimation_only"
+    assert plan.collisions_active is False
+    assert plan.blowout_enabled is False
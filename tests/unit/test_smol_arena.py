@@ -0,0 +1,95 @@
+from __future__ import annotations
+
+import numpy as np
+import pytest
+
+from marsdisk.physics import smol
+
+
+def _problem(n: int = 24, seed: int = 7):
+    rng = np.random.default_rng(seed)
+    m = np.logspace(-15, -6, n)
+    N = rng.uniform(1.0, 10.0, n) * 1.0e5
+    C = rng.uniform(0.0, 1.0e-9, (n, n))
+    C = 0.5 * (C + C.T)
+    C[np.diag_indices(n)] *= 0.5
+    Y = rng.uniform(0.0, 1.0, (n, n, n))
+    Y /= Y.sum(axis=0, keepdims=True)
+    S = rng.uniform(0.0, 1.0e-6, n)
+    source = rng.uniform(0.0, 1.0, n)
+    return N, C, Y, S, m, source
+
+
+def _step(N, C, Y, S, m, source, workspace):
+    diag: dict = {}
+    N_new, dt_eff, mass_err = smol.step_imex_bdf1_C3(
+        N,
+        C,
+        Y,
+        S,
+        m,
+        prod_subblow_mass_rate=None,
+        dt=50.0,
+        source_k=source,
+        S_sublimation_k=0.5 * S,
+        diag_out=diag,
+        workspace=workspace,
+    )
+    return np.array(N_new, copy=True), dt_eff, mass_err, diag
+
+
+@pytest.mark.parametrize("use_numba", [False, True])
+def test_arena_step_matches_allocating_step(monkeypatch, use_numba: bool) -> None:
+    if use_numba and not smol._NUMBA_AVAILABLE:
+        pytest.skip("numba unavailable")
+    monkeypatch.setattr(smol, "_USE_NUMBA", use_numba)
+    N, C, Y, S, m, source = _problem()
+
+    ref = _step(N, C, Y, S, m, source, None)
+    workspace = smol.ImexWorkspace(gain=np.zeros_like(N), loss=np.zeros_like(N), arena=smol.SmolStepArena())
+    got = _step(N, C, Y, S, m, source, workspace)
+
+    np.testing.assert_allclose(got[0], ref[0], rtol=1.0e-13, atol=0.0)
+    assert got[1] == ref[1]
+    assert got[2] == pytest.approx(ref[2], rel=1.0e-10, abs=1.0e-15)
+    for key, value in ref[3].items():
+        assert got[3][key] == pytest.approx(value, rel=1.0e-12)
+
+
+def test_arena_allocations_stop_after_first_step(monkeypatch) -> None:
+    monkeypatch.setattr(smol, "_USE_NUMBA", False)
+    N, C, Y, S, m, source = _problem()
+    arena = smol.SmolStepArena()
+    workspace = smol.ImexWorkspace(gain=np.zeros_like(N), loss=np.zeros_like(N), arena=arena)
+
+    _step(N, C, Y, S, m, source, workspace)
+    warm = arena.allocations
+    global_warm = smol.arena_stats()["allocations"]
+    assert warm > 0
+    for _ in range(5):
+        _step(N, C, Y, S, m, source, workspace)
+    assert arena.allocations == warm
+    assert smol.arena_stats()["allocations"] == global_warm
+    assert arena.steps == 6
+
+    # A different bin count re-sizes the buffers instead of reusing them.
+    N2, C2, Y2, S2, m2, source2 = _problem(n=12)
+    workspace2 = smol.ImexWorkspace(gain=np.zeros_like(N2), loss=np.zeros_like(N2), arena=arena)
+    _step(N2, C2, Y2, S2, m2, source2, workspace2)
+    assert arena.allocations > warm
+
+
+def test_psd_state_to_number_density_arena_matches() -> None:
+    sizes = np.logspace(-6, -3, 16)
+    psd_state = {
+        "sizes": sizes,
+        "widths": np.gradient(sizes),
+        "number": sizes**-3.5,
+        "rho": 3000.0,
+    }
+    ref = smol.psd_state_to_number_density(dict(psd_state), 10.0)
+    arena = smol.SmolStepArena()
+    got = smol.psd_state_to_number_density(dict(psd_state), 10.0, arena=arena)
+    np.testing.assert_array_equal(got[3], ref[3])
+    assert got[4] == ref[4]
+    assert got[3] is arena.buffer("psd_N_k", sizes.shape)
@@ -0,0 +1,86 @@
+from __future__ import annotations
+
+import pytest
+
+from marsdisk.runtime.step_sampler import SAMPLE_REASON_KEY, StepDiagnosticsSampler
+
+
+def _row(step: int, phase: str = "solid") -> dict:
+    return {"step": step, "time": float(step), "phase_state_step": phase}
+
+
+def test_all_mode_writes_every_row_untagged() -> None:
+    sink: list = []
+    sampler = StepDiagnosticsSampler(sink, mode="all")
+    for step in range(5):
+        assert sampler.offer(step, _row(step))
+    sampler.finalize(anomaly="early_stop")
+    assert [row["step"] for row in sink] == list(range(5))
+    assert all(SAMPLE_REASON_KEY not in row for row in sink)
+
+
+def test_adaptive_sparse_and_final_rows() -> None:
+    sink: list = []
+    sampler = StepDiagnosticsSampler(sink, mode="adaptive", sparse_stride=5, window_steps=3)
+    for step in range(13):
+        sampler.offer(step, _row(step), dt_eff=1.0, error_percent=0.0)
+    sampler.finalize()
+    assert [row["step"] for row in sink] == [0, 5, 10, 12]
+    assert [row[SAMPLE_REASON_KEY] for row in sink] == ["sparse", "sparse", "sparse", "final"]
+    assert sampler.stats()["rows_seen"] == 13
+
+
+def test_adaptive_phase_change_dumps_window_and_densifies() -> None:
+    sink: list = []
+    sampler = StepDiagnosticsSampler(
+        sink, mode="adaptive", sparse_stride=100, window_steps=2, post_event_steps=2
+    )
+    for step in range(1, 11):
+        phase = "solid" if step < 6 else "liquid"
+        sampler.offer(step, _row(step, phase))
+    sampler.finalize()
+    reasons = {row["step"]: row[SAMPLE_REASON_KEY] for row in sink}
+    assert reasons[4] == "window" and reasons[5] == "window"
+    assert 3 not in reasons
+    assert reasons[6] == "event:phase_transition"
+    assert reasons[7] == "post_event" and reasons[8] == "post_event"
+    assert reasons[10] == "final"
+    assert [row["step"] for row in sink] == sorted(reasons)
+
+
+@pytest.mark.parametrize(
+    "kwargs, expected",
+    [
+        ({"dt_eff": 1.0e-3, "error_percent": 0.0}, "dt_collapse"),
+        ({"dt_eff": 1.0, "error_percent": 5.0}, "mass_budget_excursion"),
+    ],
+)
+def test_adaptive_numeric_triggers(kwargs: dict, expected: str) -> None:
+    sink: list = []
+    sampler = StepDiagnosticsSampler(sink, mode="adaptive", sparse_stride=100)
+    sampler.offer(1, _row(1), dt_eff=1.0, error_percent=0.0)
+    assert sampler.offer(2, _row(2), **kwargs)
+    assert sink[-1][SAMPLE_REASON_KEY] == f"event:{expected}"
+    assert sampler.stats()["events"][0]["events"] == [expected]
+
+
+def test_finalize_anomaly_dumps_lead_up() -> None:
+    sink: list = []
+    sampler = StepDiagnosticsSampler(sink, mode="adaptive", sparse_stride=100, window_steps=3)
+    for step in range(1, 8):
+        sampler.offer(step, _row(step))
+    sampler.finalize(anomaly="mass_budget_violation")
+    assert [row["step"] for row in sink] == [5, 6, 7]
+    assert all(row[SAMPLE_REASON_KEY] == "window" for row in sink)
+    assert sampler.stats()["event_count"] == 1
+
+
+def test_finalize_anomaly_without_window_still_writes_final_row() -> None:
+    sink: list = []
+    sampler = StepDiagnosticsSampler(sink, mode="adaptive", sparse_stride=5, window_steps=0)
+    for step in range(1, 8):
+        sampler.offer(step, _row(step))
+    sampler.finalize(anomaly="early_stop")
+    assert [row["step"] for row in sink] == [5, 7]
+    assert [row[SAMPLE_REASON_KEY] for row in sink] == ["sparse", "final"]
+    assert sampler.stats()["events"][-1]["events"] == ["early_stop"]
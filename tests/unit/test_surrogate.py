@@ -0,0 +1,143 @@
+from __future__ import annotations
+
+from pathlib import Path
+
+import numpy as np
+import pandas as pd
+import pytest
+
+pytest.importorskip("sklearn")
+
+from marsdisk.analysis import surrogate
+
+
+def _truth(points: pd.DataFrame) -> pd.DataFrame:
+    """Smooth stand-in for the simulator: loss_frac spans several decades."""
+
+    out = points.loc[:, ["r_RM", "T_M"]].copy()
+    log_loss = (
+        -6.0
+        + 2.0 * np.tanh((out["T_M"] - 3000.0) / 600.0)
+        - 1.5 * (out["r_RM"] - 1.5)
+        + 0.3 * np.sin(3.0 * out["r_RM"])
+    )
+    out["loss_frac"] = np.power(10.0, log_loss)
+    out["case_status"] = np.where(out["T_M"] >= 3000.0, "blowout", "no_blowout")
+    return out
+
+
+def _grid(n_r: int, n_T: int) -> pd.DataFrame:
+    return surrogate.candidate_grid({"r_RM": np.linspace(1.5, 3.0, n_r), "T_M": np.linspace(1500.0, 4500.0, n_T)})
+
+
+@pytest.mark.parametrize("method", ["gp", "gbt"])
+def test_surrogate_predicts_held_out_points(method: str) -> None:
+    train = _truth(_grid(7, 9))
+    model = surrogate.MassLossSurrogate(method=method).fit(train)
+    assert model.method_used == method
+
+    test_points = pd.DataFrame({"r_RM": [1.8, 2.4, 2.9], "T_M": [1800.0, 2600.0, 4100.0]})
+    pred = model.predict(test_points)
+    truth = _truth(test_points)
+    log_err = np.abs(np.log10(pred["loss_frac_pred"]) - np.log10(truth["loss_frac"]))
+    tol = 0.05 if method == "gp" else 0.6
+    assert (log_err < tol).all()
+    assert (pred["loss_frac_lo"] <= pred["loss_frac_hi"]).all()
+    assert list(pred["case_status_pred"]) == list(truth["case_status"])
+    assert ((pred["case_status_prob"] > 0.5) & (pred["case_status_prob"] <= 1.0)).all()
+
+
+def test_gp_uncertainty_grows_away_from_data(tmp_path: Path) -> None:
+    train = _truth(_grid(5, 5))
+    train = train[train["r_RM"] <= 2.2]
+    model = surrogate.MassLossSurrogate(method="gp").fit(train)
+
+    near = model.uncertainty(model.predict(pd.DataFrame({"r_RM": [1.875], "T_M": [2250.0]})))
+    far = model.uncertainty(model.predict(pd.DataFrame({"r_RM": [3.0], "T_M": [2250.0]})))
+    assert far[0] > 5.0 * near[0]
+
+    path = model.save(tmp_path / "model.pkl")
+    restored = surrogate.MassLossSurrogate.load(path)
+    points = _grid(3, 3)
+    pd.testing.assert_frame_equal(restored.predict(points), model.predict(points))
+
+
+def test_fit_requires_finite_targets() -> None:
+    frame = pd.DataFrame({"r_RM": [2.0, 2.5], "T_M": [2000.0, 2500.0], "loss_frac": [np.nan, 1e-3]})
+    with pytest.raises(ValueError):
+        surrogate.MassLossSurrogate().fit(frame)
+
+
+def test_active_learning_runs_fewer_simulations_than_the_grid() -> None:
+    candidates = _grid(12, 12)
+    calls: list[int] = []
+
+    def evaluate(points: pd.DataFrame) -> pd.DataFrame:
+        calls.append(len(points))
+        return _truth(points)
+
+    result = surrogate.run_active_learning(
+        evaluate,
+        candidates,
+        surrogate_factory=lambda: surrogate.MassLossSurrogate(method="gp"),
+        n_initial=6,
+        batch_size=4,
+        max_iterations=8,
+        sigma_tol=0.05,
+        status_prob_tol=0.0,
+    )
+    assert calls[0] == 6
+    assert sum(calls) == len(result.samples) < len(candidates)
+    assert result.history[-1]["sigma_max"] < result.history[0]["sigma_max"]
+    assert result.converged
+
+    pred = result.surrogate.predict(candidates)
+    log_err = np.abs(np.log10(pred["loss_frac_pred"]) - np.log10(_truth(candidates)["loss_frac"]))
+    assert float(log_err.max()) < 0.1
+
+
+def test_propose_points_skips_evaluated_neighbourhood() -> None:
+    train = _truth(_grid(4, 4))
+    model = surrogate.MassLossSurrogate(method="gp").fit(train)
+    batch = surrogate.propose_points(model, _grid(10, 10), 5, evaluated=train, min_separation=0.3)
+    assert 0 < len(batch) <= 5
+    chosen = model.transform(batch)
+    seen = model.transform(train)
+    dist = np.linalg.norm(chosen[:, None, :] - seen[None, :, :], axis=2)
+    assert dist.min() >= 0.3
+
+
+def test_active_evaluator_maps_extra_features_to_overrides(monkeypatch) -> None:
+    from marsdisk.analysis import massloss_sampler
+
+    calls: list[list[str]] = []
+
+    def fake_sample(r_RM, T_M, base_yaml, qpr_table, *, overrides=None):
+        calls.append(list(overrides or []))
+        return {"r_RM": r_RM, "T_M": T_M, "mass_loss_frac_per_orbit": 1.0e-6}
+
+    monkeypatch.setattr(massloss_sampler, "sample_mass_loss_one_orbit", fake_sample)
+    argv = [
+        "active",
+        "--base-config", "base.yml",
+        "--qpr-table", "qpr.csv",
+        "--override", "numerics.dt_init=10.0",
+        "--axis", "r_RM=1.5:2.0:2",
+        "--axis", "T_M=2000:3000:2",
+        "--axis", "supply_rate=1e-10:1e-8:2:log",
+        "--features", "r_RM", "T_M", "supply_rate",
+        "--outdir", "out",
+    ]
+    with pytest.raises(ValueError, match="--axis-path supply_rate="):
+        surrogate._massloss_evaluator(surrogate._parse_args(argv))
+
+    args = surrogate._parse_args(argv + ["--axis-path", "supply_rate=supply.const.prod_area_rate_kg_m2_s"])
+    evaluate = surrogate._massloss_evaluator(args)
+    points = surrogate.candidate_grid(dict(args.axis)).iloc[:2]
+    results = evaluate(points)
+
+    assert calls[0] == ["numerics.dt_init=10.0", "supply.const.prod_area_rate_kg_m2_s=1e-10"]
+    np.testing.assert_allclose(results["supply_rate"], points["supply_rate"])
+    surrogate.MassLossSurrogate(features=("r_RM", "T_M", "supply_rate"), method="gbt").fit(
+        pd.concat([results, results.assign(T_M=results["T_M"] + 500.0)], ignore_index=True)
+    )
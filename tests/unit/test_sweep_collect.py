@@ -0,0 +1,137 @@
+from __future__ import annotations
+
+import json
+import shutil
+from pathlib import Path
+
+import numpy as np
+import pandas as pd
+import pyarrow as pa
+import pyarrow.parquet as pq
+import pytest
+
+from marsdisk.io import sweep_collect
+
+
+def _make_run(root: Path, name: str, scale: float) -> Path:
+    run_dir = root / "case" / name
+    (run_dir / "series").mkdir(parents=True)
+    (run_dir / "checks").mkdir()
+    time = np.linspace(0.0, 10.0, 40)
+    series = pd.DataFrame({"time": time, "tau": scale * np.sin(time), "extra": np.arange(40)})
+    # Two row groups so statistics are merged and only the last one is read.
+    pq.write_table(pa.Table.from_pandas(series, preserve_index=False), run_dir / "series" / "run.parquet", row_group_size=25)
+    pd.DataFrame({"time": time, "mass_lost": time, "error_percent": -scale * time / 10.0}).to_csv(
+        run_dir / "checks" / "mass_budget.csv", index=False
+    )
+    (run_dir / "summary.json").write_text(
+        json.dumps({"M_loss": scale, "case_status": "ok", "stopped": False}), encoding="utf-8"
+    )
+    return run_dir
+
+
+def test_collect_run_reads_footer_statistics(tmp_path: Path) -> None:
+    run_dir = _make_run(tmp_path, "run_a", 2.0)
+    record = sweep_collect.collect_run(run_dir, series_columns=("time", "tau", "missing"))
+    series = pd.read_parquet(run_dir / "series" / "run.parquet")
+
+    assert record["series_rows"] == 40
+    assert record["series.time.max"] == pytest.approx(10.0)
+    assert record["series.tau.min"] == pytest.approx(series["tau"].min())
+    assert record["series.tau.last"] == pytest.approx(series["tau"].iloc[-1])
+    assert "series.missing.min" not in record
+    assert record["budget.error_percent.max_abs"] == pytest.approx(2.0)
+    assert record["summary.M_loss"] == 2.0
+    assert record["summary.stopped"] == 0.0
+    assert "summary.case_status" not in record
+    assert json.loads(record["summary_json"])["case_status"] == "ok"
+
+
+def test_collect_run_reads_parquet_mass_budget(tmp_path: Path) -> None:
+    run_dir = _make_run(tmp_path, "run_pq", 3.0)
+    csv_path = run_dir / "checks" / "mass_budget.csv"
+    budget = pd.read_csv(csv_path)
+    csv_path.unlink()
+    pq.write_table(
+        pa.Table.from_pandas(budget, preserve_index=False),
+        run_dir / "checks" / "mass_budget.parquet",
+        row_group_size=16,
+    )
+
+    record = sweep_collect.collect_run(run_dir)
+    assert record["budget_rows"] == 40
+    assert record["budget.error_percent.max_abs"] == pytest.approx(3.0)
+
+    # Appending to the Parquet log changes the fingerprint, so caches re-read the run.
+    before = sweep_collect.run_fingerprint(run_dir)
+    pq.write_table(
+        pa.Table.from_pandas(budget.iloc[:5], preserve_index=False),
+        run_dir / "checks" / "mass_budget.parquet",
+    )
+    assert sweep_collect.run_fingerprint(run_dir) != before
+
+
+def test_collect_run_skips_partial_runs(tmp_path: Path) -> None:
+    legacy = _make_run(tmp_path, "legacy", 1.0)
+    (legacy / "summary.json").write_text(
+        json.dumps({"M_loss": 0.5, "summary_status": "partial"}), encoding="utf-8"
+    )
+    running = _make_run(tmp_path, "running", 1.0)
+    (running / "summary.json").rename(running / "summary.partial.json")
+    done = _make_run(tmp_path, "done", 1.0)
+
+    for run_dir in (legacy, running):
+        record = sweep_collect.collect_run(run_dir)
+        assert record["summary_status"] == "partial"
+        assert record["summary_json"] is None
+        assert "summary.M_loss" not in record
+        assert "series_rows" not in record
+    assert sweep_collect.collect_run(done)["summary_status"] == "complete"
+
+
+def test_collect_runs_updates_cache_incrementally(tmp_path: Path) -> None:
+    runs = [_make_run(tmp_path, f"run_{idx}", float(idx + 1)) for idx in range(3)]
+    cache = tmp_path / "collect.arrow"
+
+    frame, report = sweep_collect.collect_runs(runs, cache_path=cache, jobs=4)
+    assert report == {"collected": 3, "reused": 0, "dropped": 0}
+    assert list(frame["run_dir"]) == [str(p) for p in runs]
+    assert list(frame["summary.M_loss"]) == [1.0, 2.0, 3.0]
+
+    _, report = sweep_collect.collect_runs(runs, cache_path=cache, jobs=4)
+    assert report == {"collected": 0, "reused": 3, "dropped": 0}
+
+    (runs[1] / "summary.json").write_text(json.dumps({"M_loss": 20.0}), encoding="utf-8")
+    new_run = _make_run(tmp_path, "run_new", 5.0)
+    shutil.rmtree(runs[0])
+    current = [runs[1], runs[2], new_run]
+    frame, report = sweep_collect.collect_runs(current, cache_path=cache, jobs=4)
+    assert report == {"collected": 2, "reused": 1, "dropped": 1}
+    assert list(frame["summary.M_loss"]) == [20.0, 3.0, 5.0]
+    assert frame["series_rows"].tolist() == [40, 40, 40]
+
+
+def test_collect_series_reuses_unchanged_runs(tmp_path: Path) -> None:
+    runs = [_make_run(tmp_path, f"run_{idx}", float(idx + 1)) for idx in range(2)]
+    paths = [run / "series" / "run.parquet" for run in runs]
+    out = tmp_path / "combined.parquet"
+
+    report = sweep_collect.collect_series(paths, out, columns=["time", "tau"], jobs=2)
+    assert report == {"runs": 2, "read": 2, "reused": 0}
+    combined = pd.read_parquet(out)
+    assert set(combined.columns) == {"time", "tau", "case_id", "outdir"}
+    assert len(combined) == 80
+
+    assert sweep_collect.collect_series(paths, out, columns=["time", "tau"])["reused"] == 2
+
+    series = pd.read_parquet(paths[0])
+    series["tau"] = 7.0
+    series.to_parquet(paths[0], index=False)
+    report = sweep_collect.collect_series(paths, out, columns=["time", "tau"])
+    assert report == {"runs": 2, "read": 1, "reused": 1}
+    combined = pd.read_parquet(out)
+    assert len(combined) == 80
+    assert (combined.loc[combined["outdir"] == str(runs[0]), "tau"] == 7.0).all()
+
+    # A different column selection invalidates the previous output.
+    assert sweep_collect.collect_series(paths, out, columns=["time"])["read"] == 2
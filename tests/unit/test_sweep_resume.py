@@ -0,0 +1,138 @@
+from __future__ import annotations
+
+import importlib.util
+import json
+import os
+from pathlib import Path
+
+from marsdisk.io import recovery
+
+REPO_ROOT = Path(__file__).resolve().parents[2]
+
+
+def _load_worker():
+    path = REPO_ROOT / "scripts/runsets/common/run_sweep_worker.py"
+    spec = importlib.util.spec_from_file_location("run_sweep_worker_under_test", path)
+    assert spec and spec.loader
+    module = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(module)
+    return module
+
+
+def test_remaining_fraction_and_sweep_action(tmp_path: Path) -> None:
+    fresh = recovery.RecoveryInfo(run_dir=tmp_path, status=recovery.SUMMARY_MISSING)
+    assert (fresh.sweep_action, fresh.remaining_fraction) == ("fresh", 1.0)
+
+    done = recovery.RecoveryInfo(run_dir=tmp_path, status=recovery.SUMMARY_COMPLETE)
+    assert (done.sweep_action, done.remaining_fraction) == ("skip", 0.0)
+
+    no_ckpt = recovery.RecoveryInfo(run_dir=tmp_path, status=recovery.SUMMARY_PARTIAL, time_s=30.0, t_end=100.0)
+    assert (no_ckpt.sweep_action, no_ckpt.remaining_fraction) == ("fresh", 1.0)
+
+    partial = recovery.RecoveryInfo(
+        run_dir=tmp_path,
+        status=recovery.SUMMARY_PARTIAL,
+        time_s=30.0,
+        t_end=100.0,
+        latest_checkpoint=tmp_path / "checkpoints" / "ckpt_step_000000010.pkl",
+    )
+    assert partial.sweep_action == "resume"
+    assert abs(partial.remaining_fraction - 0.7) < 1e-12
+
+
+def test_clear_partial_outputs_keeps_complete_summary(tmp_path: Path) -> None:
+    (tmp_path / "series").mkdir()
+    (tmp_path / "checkpoints").mkdir()
+    chunk = tmp_path / "series" / "run_chunk_000000000_000000009.parquet"
+    ckpt = tmp_path / "checkpoints" / "ckpt_step_000000009.pkl"
+    merged = tmp_path / "series" / "run.parquet"
+    for path in (chunk, ckpt, merged):
+        path.write_bytes(b"")
+    partial = tmp_path / "summary.partial.json"
+    partial.write_text(json.dumps({"summary_status": "partial"}), encoding="utf-8")
+    assert recovery.inspect_run(tmp_path).status == recovery.SUMMARY_PARTIAL
+
+    removed = recovery.clear_partial_outputs(tmp_path)
+    assert set(removed) == {chunk, ckpt, partial}
+    assert merged.exists()
+
+    (tmp_path / "summary.json").write_text(json.dumps({"summary_status": "complete"}), encoding="utf-8")
+    assert recovery.clear_partial_outputs(tmp_path) == []
+    assert (tmp_path / "summary.json").exists()
+
+
+def test_schedule_cases_orders_by_remaining_cost() -> None:
+    worker = _load_worker()
+    cases = [
+        {"index": 0, "remaining": 1.0},
+        {"index": 1, "remaining": 0.0},
+        {"index": 2, "remaining": 0.4},
+        {"index": 3, "remaining": 1.0},
+        {"index": 4, "remaining": 1.0},
+    ]
+    static = worker._schedule_cases(cases, part_index=1, part_count=2, mode="static")
+    assert [case["index"] for case in static] == [0, 4, 2]
+
+    claimed = worker._schedule_cases(cases, part_index=2, part_count=2, mode="claim")
+    assert [case["index"] for case in claimed] == [3, 0, 4, 2]
+
+
+def test_case_claim_is_exclusive_until_stale(tmp_path: Path) -> None:
+    worker = _load_worker()
+    first = worker._CaseClaim(tmp_path, "a", stale_seconds=60.0)
+    second = worker._CaseClaim(tmp_path, "b", stale_seconds=60.0)
+    assert first.acquire()
+    try:
+        assert not second.acquire()
+    finally:
+        first.release()
+    assert not (tmp_path / worker.CLAIM_NAME).exists()
+
+    # A claim left behind by a process that no longer exists is taken over.
+    (tmp_path / worker.CLAIM_NAME).write_text(
+        json.dumps({"owner": "dead", "host": worker.socket.gethostname(), "pid": 2**22 + 1}),
+        encoding="utf-8",
+    )
+    assert second.acquire()
+    try:
+        holder = json.loads((tmp_path / worker.CLAIM_NAME).read_text(encoding="utf-8"))
+        assert holder["owner"] == "b" and holder["pid"] == os.getpid()
+    finally:
+        second.release()
+
+
+def test_claim_cases_repolls_until_holder_finishes_or_dies(tmp_path: Path) -> None:
+    worker = _load_worker()
+    cases = [{"index": idx, "outdir": tmp_path / f"case_{idx}"} for idx in range(3)]
+    holders = []
+    for case in cases[1:]:
+        holder = worker._CaseClaim(case["outdir"].resolve(), "other", stale_seconds=60.0)
+        case["outdir"].mkdir()
+        assert holder.acquire()
+        holders.append(holder)
+    polls = {"n": 0}
+
+    def is_done(case: dict) -> bool:
+        polls["n"] += 1
+        if polls["n"] == 3:
+            # Several polls in, the holder of case 1 is preempted ...
+            holders[0]._stop.set()
+            (cases[1]["outdir"] / worker.CLAIM_NAME).write_text(
+                json.dumps({"owner": "other", "host": worker.socket.gethostname(), "pid": 2**22 + 1}),
+                encoding="utf-8",
+            )
+        # ... while the holder of case 2 finishes it.
+        return case["index"] == 2 and polls["n"] >= 4
+
+    claimed = []
+    try:
+        for case, claim in worker._claim_cases(
+            cases, owner="me", stale_seconds=60.0, is_done=is_done, poll_seconds=0.01
+        ):
+            claimed.append(case["index"])
+            claim.release()
+    finally:
+        for holder in holders:
+            holder.release()
+    assert claimed == [0, 1]
+    assert polls["n"] >= 4
@@ -0,0 +1,78 @@
+from __future__ import annotations
+
+import multiprocessing
+
+import pytest
+
+from marsdisk.runtime import thread_budget
+
+
+def test_budget_from_env_sources() -> None:
+    assert thread_budget.ThreadBudget.from_env({"MARSDISK_THREAD_BUDGET": "6"}).total == 6
+    budget = thread_budget.ThreadBudget.from_env(
+        {"CELL_CPU_LOGICAL": "16", "CELL_CPU_FRACTION": "0.5"}
+    )
+    assert (budget.total, budget.source) == (8, "cpu_logical_env")
+
+
+def test_partition_splits_processes_and_cell_workers() -> None:
+    plan = thread_budget.ThreadBudget(total=16).partition(processes=2, cell_workers=4)
+    assert plan.numba_threads == plan.blas_threads == 2
+    env = plan.env()
+    assert env["NUMBA_NUM_THREADS"] == "2" and env["OPENBLAS_NUM_THREADS"] == "2"
+    assert thread_budget.ThreadBudget(total=2).partition(processes=8).numba_threads == 1
+
+
+@pytest.mark.parametrize("logical, jobs", [(16, 3), (10, 3), (7, 2), (1, 4)])
+def test_cell_thread_limit_matches_runset_formula(logical: int, jobs: int) -> None:
+    env = {"CELL_CPU_LOGICAL": str(logical), "MARSDISK_CELL_JOBS": str(jobs)}
+    expected = max(int(logical * 0.7 / jobs), 1)
+    assert thread_budget.cell_thread_limit(env) == expected
+
+
+def test_apply_thread_guard_respects_opt_out() -> None:
+    env = {"MARSDISK_THREAD_GUARD": "0"}
+    assert thread_budget.apply_thread_guard(env) is None
+    assert env == {"MARSDISK_THREAD_GUARD": "0"}
+    env = {"MARSDISK_THREAD_BUDGET": "4", "OMP_NUM_THREADS": "3"}
+    thread_budget.apply_thread_guard(env)
+    assert env["OMP_NUM_THREADS"] == "3"
+    assert env["OPENBLAS_NUM_THREADS"] == "1"
+    assert env["NUMBA_NUM_THREADS"] == "4"
+
+
+def test_lease_gives_tail_cases_released_cores(monkeypatch: pytest.MonkeyPatch) -> None:
+    free = multiprocessing.Value("i", 4)
+    started = multiprocessing.Value("i", 0)
+    monkeypatch.setattr(thread_budget, "_POOL_STATE", None)
+    thread_budget._install_pool_state(free, started, 4, 2, 3)
+    try:
+        with thread_budget.lease(apply=False) as first:
+            with thread_budget.lease(apply=False) as second:
+                assert (first.numba_threads, second.numba_threads) == (2, 2)
+                assert free.value == 0
+        assert free.value == 4
+        with thread_budget.lease(apply=False) as tail:
+            assert tail.numba_threads == 4
+            assert tail.env()["MKL_NUM_THREADS"] == "4"
+        assert free.value == 4
+    finally:
+        monkeypatch.setattr(thread_budget, "_POOL_STATE", None)
+
+
+def test_pool_options_chains_extra_initializer() -> None:
+    calls = []
+    kwargs, report = thread_budget.pool_options(
+        3,
+        5,
+        budget=thread_budget.ThreadBudget(total=6),
+        extra={"initializer": calls.append, "initargs": ("placed",)},
+    )
+    assert report["base_plan"]["numba_threads"] == 2
+    saved = thread_budget._POOL_STATE
+    try:
+        kwargs["initializer"](*kwargs["initargs"])
+        assert calls == ["placed"]
+        assert thread_budget._POOL_STATE[2:] == (6, 3, 5)
+    finally:
+        thread_budget._POOL_STATE = saved
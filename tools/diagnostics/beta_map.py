@@ -21,6 +21,7 @@ Usage example
 from __future__ import annotations
 
 import argparse
+import concurrent.futures
 import logging
 import math
 from dataclasses import dataclass
@@ -48,6 +49,7 @@ from marsdisk import grid
 from marsdisk.io import tables
 from marsdisk.physics import initfields, psd, radiation, sinks, sizes, surface
 from marsdisk.physics.sublimation import SublimationParams, grain_temperature_graybody
+from marsdisk.runtime import placement, thread_budget
 from marsdisk.schema import Config
 
 TAU_FLOOR = 1.0e-12
@@ -181,6 +183,18 @@ def parse_args() -> argparse.Namespace:
         default=Path("_logs/04_beta_map.log"),
         help="Path to the diagnostic log file.",
     )
+    parser.add_argument(
+        "--engine",
+        choices=("lattice", "cell"),
+        default="lattice",
+        help="'lattice' evaluates whole T_M rows as arrays; 'cell' is the scalar per-cell reference.",
+    )
+    parser.add_argument(
+        "--jobs",
+        type=int,
+        default=1,
+        help="Worker processes for the lattice engine (T_M rows are split across them).",
+    )
     parser.add_argument(
         "--beta-thr",
         type=float,
@@ -457,6 +471,329 @@ def evaluate_cell(
     )
 
 
+def _phi_batch(ctx: RuntimeContext) -> Callable[[np.ndarray], np.ndarray]:
+    """Return an array version of the Φ(τ) lookup used by :func:`evaluate_cell`."""
+
+    table = getattr(ctx.phi_fn, "tau_phi_table", None)
+    if table is not None:
+        tau_vals, phi_vals = table
+
+        def phi_arr(tau: np.ndarray) -> np.ndarray:
+            values = np.interp(tau, tau_vals, phi_vals, left=phi_vals[0], right=phi_vals[-1])
+            return np.clip(values, 0.0, 1.0)
+
+        return phi_arr
+
+    if ctx.phi_fn is not None:
+        scalar = ctx.phi_fn
+    else:
+        def scalar(tau: float) -> float:
+            return tables.interp_phi(float(tau), 0.0, 0.0)
+
+    def phi_vec(tau: np.ndarray) -> np.ndarray:
+        values = np.fromiter((scalar(float(t)) for t in tau.ravel()), dtype=float, count=tau.size)
+        return np.clip(values.reshape(tau.shape), 0.0, 1.0)
+
+    return phi_vec
+
+
+def _kappa_rows(sizes: np.ndarray, widths: np.ndarray, number: np.ndarray, rho: float) -> np.ndarray:
+    """Row-wise :func:`psd.compute_kappa` for a stack of PSDs."""
+
+    number = np.where(np.isfinite(number) & (number > 0.0), number, 0.0)
+    max_val = np.max(number, axis=1, keepdims=True)
+    scale = np.where((max_val > 0.0) & np.isfinite(max_val), max_val, 1.0)
+    number = number / scale
+    area = np.sum(np.pi * sizes**2 * number * widths, axis=1)
+    mass = np.sum((4.0 / 3.0) * np.pi * rho * sizes**3 * number * widths, axis=1)
+    ok = np.isfinite(area) & np.isfinite(mass) & (mass > 0.0)
+    return np.where(ok, area / np.where(ok, mass, 1.0), 0.0)
+
+
+def _normalise_rows(sizes: np.ndarray, widths: np.ndarray, number: np.ndarray) -> np.ndarray:
+    """Row-wise ``psd.sanitize_and_normalize_number(normalize=True)``."""
+
+    number = np.clip(np.where(np.isfinite(number) & (number > 0.0), number, 0.0), 0.0, 1e200)
+    weight = np.sum(number * (sizes**3) * widths, axis=1)
+    reset = ~np.isfinite(weight) | (weight <= 0.0)
+    if np.any(reset):
+        number[reset] = 1.0
+        weight[reset] = np.sum(sizes[reset] ** 3 * widths, axis=1)
+        weight[~np.isfinite(weight) | (weight <= 0.0)] = 1.0
+    return number / weight[:, None]
+
+
+def _drift_rows(
+    sizes: np.ndarray,
+    number: np.ndarray,
+    widths: np.ndarray,
+    edges: np.ndarray,
+    ds_step: np.ndarray,
+    floor: float,
+    sigma: np.ndarray,
+) -> None:
+    """Batched :func:`psd.apply_uniform_size_drift`; updates the arrays in place.
+
+    Every row shares ``widths``/``edges`` (one T_M slice of the lattice), so
+    the rebinning is a single ``bincount`` over ``row * n_bins + target``.
+    """
+
+    n_rows, n_bins = number.shape
+    number_orig = number.copy()
+    clean = np.clip(np.where(np.isfinite(number) & (number > 0.0), number, 0.0), 0.0, 1e200)
+    counts = clean * widths
+    s_new = sizes + ds_step[:, None]
+    s_new = np.where(np.isfinite(s_new), s_new, np.nan)
+    s_new = np.where(s_new < floor, floor, s_new)
+    valid = (counts > 0.0) & np.isfinite(counts) & np.isfinite(s_new)
+    targets = np.clip(np.searchsorted(edges, np.where(valid, s_new, edges[0]), side="right") - 1, 0, n_bins - 1)
+    flat = (np.arange(n_rows)[:, None] * n_bins + targets)[valid]
+    new_counts = np.bincount(flat, weights=counts[valid], minlength=n_rows * n_bins).reshape(n_rows, n_bins)
+    accum = np.bincount(flat, weights=(counts * s_new)[valid], minlength=n_rows * n_bins).reshape(n_rows, n_bins)
+
+    # Rows whose rebin vanished keep their previous (sanitised) PSD and Σ.
+    zeroed = np.all(np.abs(new_counts) <= 1.0e-8, axis=1)
+
+    moved = new_counts > 0.0
+    new_sizes = np.where(moved, accum / np.where(moved, new_counts, 1.0), sizes)
+    new_sizes = np.maximum(new_sizes, floor)
+    width_ok = moved & (widths > 0.0)
+    new_number = np.where(width_ok, new_counts / np.where(widths > 0.0, widths, 1.0), 0.0)
+    new_number = np.clip(np.where(np.isfinite(new_number) & (new_number > 0.0), new_number, 0.0), 0.0, 1e200)
+    rollback = ~zeroed & (~np.all(np.isfinite(new_number), axis=1) | (np.sum(new_number, axis=1) == 0.0))
+    accept = ~zeroed & ~rollback
+
+    old_weight = np.sum(clean * (sizes**3) * widths, axis=1)
+    new_weight = np.sum(new_number * (new_sizes**3) * widths, axis=1)
+    scale_ok = accept & (old_weight > 0.0) & (sigma > 0.0)
+    ratio = np.where(scale_ok, new_weight / np.where(scale_ok, old_weight, 1.0), 1.0)
+    ratio = np.where(np.isfinite(ratio) & (ratio >= 0.0), ratio, 0.0)
+    sigma[scale_ok] = sigma[scale_ok] * ratio[scale_ok]
+
+    number[zeroed] = clean[zeroed]
+    if np.any(rollback):
+        number[rollback] = _normalise_rows(sizes[rollback], widths, number_orig[rollback])
+    if np.any(accept):
+        sizes[accept] = new_sizes[accept]
+        number[accept] = _normalise_rows(new_sizes[accept], widths, new_number[accept])
+
+
+def evaluate_row(
+    T_M: float,
+    r_values: np.ndarray,
+    ctx: RuntimeContext,
+    *,
+    sigma_mid: Optional[np.ndarray] = None,
+) -> dict[str, np.ndarray]:
+    """Evaluate one T_M slice of the lattice for every radius at once.
+
+    Reproduces :func:`evaluate_cell` cell by cell: β_raw, Q_pr and the
+    blow-out size depend on T_M only, the sink time-scale and ds/dt are
+    fixed per cell over the orbit, and the Σ_surf/τ/Φ recursion plus the
+    PSD size drift advance as arrays over radius.
+    """
+
+    r_values = np.asarray(r_values, dtype=float)
+    n_r = r_values.size
+    r_m = r_values * constants.R_MARS
+    Omega = np.sqrt(constants.G * constants.M_MARS / r_m**3)
+    if not np.all(np.isfinite(Omega) & (Omega > 0.0)):
+        raise ValueError("Invalid Keplerian frequency on the radial lattice")
+    t_orb = 2.0 * math.pi / Omega
+    dt = t_orb / ctx.n_steps
+    t_blow = 1.0 / Omega
+    dt_limit = 0.05 * t_blow
+    dt_ratio = np.where(dt_limit > 0.0, dt / np.where(dt_limit > 0.0, dt_limit, 1.0), np.inf)
+    if sigma_mid is None:
+        sigma_mid = lattice_sigma_mid(r_values, ctx)
+
+    qpr_val = ctx.qpr_lookup(ctx.s_ref, T_M)
+    a_blow = compute_a_blow(qpr_val, ctx.rho_p, T_M, ctx.beta_threshold)
+    s_min_effective = max(ctx.s_min_config, a_blow)
+    beta_raw = radiation.beta(ctx.s_ref, ctx.rho_p, T_M, Q_pr=qpr_val)
+
+    psd_state = psd.update_psd_state(
+        s_min=s_min_effective,
+        s_max=ctx.s_max,
+        alpha=ctx.alpha,
+        wavy_strength=ctx.wavy_strength,
+        n_bins=ctx.n_bins,
+        rho=ctx.rho_p,
+    )
+    kappa0 = psd.compute_kappa(psd_state)
+    widths = np.asarray(psd_state["widths"], dtype=float)
+    edges = np.asarray(psd_state["edges"], dtype=float)
+    bin_sizes = np.tile(np.asarray(psd_state["sizes"], dtype=float), (n_r, 1))
+    number = np.tile(np.asarray(psd_state["number"], dtype=float), (n_r, 1))
+    kappa = np.full(n_r, kappa0)
+    phi_arr = _phi_batch(ctx)
+
+    # Per-cell constants: sink time-scale and sublimation ds/dt.
+    t_sink = np.full(n_r, np.nan)
+    ds_dt = np.zeros(n_r)
+    sublimating = ctx.enable_sublimation and ctx.sink_mode != "none"
+    T_grain = T_M * np.sqrt(constants.R_MARS / (2.0 * r_m))
+    for i in range(n_r):
+        sub_params = copy_sublimation_params(ctx.sub_params_template)
+        setattr(sub_params, "runtime_orbital_radius_m", float(r_m[i]))
+        setattr(sub_params, "runtime_t_orb_s", float(t_orb[i]))
+        setattr(sub_params, "runtime_Omega", float(Omega[i]))
+        sink_opts = sinks.SinkOptions(
+            enable_sublimation=sublimating,
+            sub_params=sub_params,
+            enable_gas_drag=ctx.enable_gas_drag,
+            rho_g=ctx.rho_gas,
+        )
+        if sublimating:
+            try:
+                ds_dt[i] = sizes.eval_ds_dt_sublimation(float(T_grain[i]), ctx.rho_p, sub_params)
+            except Exception as exc:
+                ctx.logger.warning(
+                    "ds/dt evaluation failed at r/R_M=%.3f T=%.0f K: %s", r_values[i], T_M, exc
+                )
+                ds_dt[i] = 0.0
+        result = sinks.total_sink_timescale(T_M, ctx.rho_p, float(Omega[i]), sink_opts, s_ref=ctx.s_ref)
+        if result.t_sink:
+            t_sink[i] = result.t_sink
+    sink_on = np.isfinite(t_sink) & (t_sink > 0.0)
+    inv_t_sink = np.where(sink_on, 1.0 / np.where(sink_on, t_sink, 1.0), 0.0)
+    ds_step = ds_dt * dt
+    drifting = np.isfinite(ds_dt) & (ds_dt != 0.0) & (dt > 0.0)
+
+    tau_mid = kappa0 * sigma_mid
+    phi_mid = phi_arr(tau_mid)
+    kappa_eff_init = phi_mid * kappa0
+    sigma_tau1_init = np.where(kappa_eff_init > 0.0, 1.0 / np.where(kappa_eff_init > 0.0, kappa_eff_init, 1.0), np.inf)
+    sigma_surf = np.array(
+        [
+            initfields.surf_sigma_init(
+                float(sigma_mid[i]),
+                float(kappa_eff_init[i]) if math.isfinite(kappa_eff_init[i]) and kappa_eff_init[i] > 0.0 else None,
+                ctx.cfg.surface.init_policy,
+                sigma_override=ctx.cfg.surface.sigma_surf_init_override,
+            )
+            for i in range(n_r)
+        ],
+        dtype=float,
+    )
+    sigma_surf = np.where(np.isfinite(sigma_tau1_init), np.minimum(sigma_surf, sigma_tau1_init), sigma_surf)
+
+    phi_val = phi_mid
+    tau_val = tau_mid
+    inv_t_blow = 1.0 / t_blow
+    for _ in range(ctx.n_steps):
+        if np.any(drifting):
+            rows = np.flatnonzero(drifting)
+            sizes_d, number_d, sigma_d = bin_sizes[rows], number[rows], sigma_surf[rows]
+            _drift_rows(sizes_d, number_d, widths, edges, ds_step[rows], s_min_effective, sigma_d)
+            bin_sizes[rows], number[rows], sigma_surf[rows] = sizes_d, number_d, sigma_d
+            kappa[rows] = _kappa_rows(sizes_d, widths, number_d, ctx.rho_p)
+
+        tau_val = kappa * sigma_surf
+        tau_val = np.where(tau_val < TAU_FLOOR, 0.0, tau_val)
+        phi_val = phi_arr(tau_val)
+        kappa_eff = phi_val * kappa
+        sigma_tau1 = np.where(kappa_eff > 0.0, 1.0 / np.where(kappa_eff > 0.0, kappa_eff, 1.0), np.inf)
+        sigma_target = np.where(np.isfinite(sigma_tau1), np.minimum(sigma_mid, sigma_tau1), sigma_mid)
+
+        inv_t_coll = np.zeros(n_r)
+        if ctx.use_tcoll:
+            colliding = tau_val > TAU_FLOOR
+            t_coll = 1.0 / (Omega * np.where(colliding, tau_val, 1.0))
+            inv_t_coll = np.where(colliding, 1.0 / t_coll, 0.0)
+        loss_rate = Omega + inv_t_coll + inv_t_sink
+        prod_rate = np.where(loss_rate > 0.0, sigma_target * loss_rate, 0.0)
+        loss_step = inv_t_blow + inv_t_coll + inv_t_sink
+        sigma_surf = (sigma_surf + dt * prod_rate) / (1.0 + dt * loss_step)
+
+    kappa_phi = phi_val * kappa
+    sigma_tau1_final = np.where(
+        (kappa > 0.0) & (phi_val > 0.0), 1.0 / np.where(kappa_phi > 0.0, kappa_phi, 1.0), np.inf
+    )
+    return {
+        "beta_raw": np.full(n_r, float(beta_raw)),
+        "beta_eff": beta_raw * phi_val,
+        "qpr_used": np.full(n_r, float(qpr_val)),
+        "tau_final": np.asarray(tau_val, dtype=float),
+        "phi_used": np.asarray(phi_val, dtype=float),
+        "a_blow_final": np.full(n_r, float(a_blow)),
+        "sigma_tau1_final": sigma_tau1_final,
+        "dt_ratio": dt_ratio,
+    }
+
+
+def lattice_sigma_mid(r_values: np.ndarray, ctx: RuntimeContext) -> np.ndarray:
+    """Mid-plane Σ per radius (zero outside the configured disk)."""
+
+    sigma_mid = np.zeros(np.asarray(r_values).size, dtype=float)
+    if ctx.sigma_func is None:
+        return sigma_mid
+    r_in = ctx.cfg.disk.geometry.r_in_RM if ctx.cfg.disk else None
+    r_out = ctx.cfg.disk.geometry.r_out_RM if ctx.cfg.disk else None
+    for i, r_RM in enumerate(np.asarray(r_values, dtype=float)):
+        if r_in is not None and r_out is not None and not (r_in <= r_RM <= r_out):
+            continue
+        sigma_mid[i] = float(max(ctx.sigma_func(r_RM * constants.R_MARS), 0.0))
+    return sigma_mid
+
+
+_WORKER_CONTEXT: dict[tuple, RuntimeContext] = {}
+
+
+def _evaluate_rows_task(
+    spec: dict, T_chunk: list[float], r_values: np.ndarray
+) -> tuple[list[dict[str, np.ndarray]], int, int]:
+    """Evaluate ``T_chunk`` in a worker; also returns this chunk's Q_pr calls/failures."""
+
+    key = tuple(sorted((k, str(v)) for k, v in spec.items()))
+    ctx = _WORKER_CONTEXT.get(key)
+    if ctx is None:
+        ctx = build_context(spec, logging.getLogger("beta_map"))
+        _WORKER_CONTEXT.clear()
+        _WORKER_CONTEXT[key] = ctx
+    calls_before = ctx.qpr_lookup.calls
+    failures_before = ctx.qpr_lookup.failures
+    sigma_mid = lattice_sigma_mid(r_values, ctx)
+    rows = [evaluate_row(T_val, r_values, ctx, sigma_mid=sigma_mid) for T_val in T_chunk]
+    return rows, ctx.qpr_lookup.calls - calls_before, ctx.qpr_lookup.failures - failures_before
+
+
+def evaluate_lattice(
+    r_values: np.ndarray,
+    T_values: np.ndarray,
+    ctx: RuntimeContext,
+    *,
+    jobs: int = 1,
+    spec: Optional[dict] = None,
+) -> dict[str, np.ndarray]:
+    """Evaluate the whole (T_M, r) lattice; returns ``(len(T), len(r))`` maps.
+
+    ``jobs > 1`` farms contiguous T_M chunks out to worker processes, which
+    rebuild the context from ``spec`` (see :func:`context_spec`).
+    """
+
+    r_values = np.asarray(r_values, dtype=float)
+    T_values = np.asarray(T_values, dtype=float)
+    rows: list[dict[str, np.ndarray]] = []
+    if jobs <= 1 or spec is None or T_values.size <= 1:
+        sigma_mid = lattice_sigma_mid(r_values, ctx)
+        rows = [evaluate_row(float(T_val), r_values, ctx, sigma_mid=sigma_mid) for T_val in T_values]
+    else:
+        n_chunks = min(T_values.size, int(jobs) * 4)
+        chunks = [chunk.tolist() for chunk in np.array_split(T_values, n_chunks) if chunk.size]
+        placement_kwargs, _ = placement.process_pool_options(int(jobs))
+        pool_kwargs, _ = thread_budget.pool_options(int(jobs), len(chunks), extra=placement_kwargs)
+        with concurrent.futures.ProcessPoolExecutor(max_workers=int(jobs), **pool_kwargs) as pool:
+            for chunk_rows, calls, failures in pool.map(
+                _evaluate_rows_task, [spec] * len(chunks), chunks, [r_values] * len(chunks)
+            ):
+                rows.extend(chunk_rows)
+                # Lookups happened in the workers; fold their counts into the parent counter.
+                ctx.qpr_lookup.calls += int(calls)
+                ctx.qpr_lookup.failures += int(failures)
+    return {key: np.vstack([row[key] for row in rows]) for key in rows[0]}
+
+
 def build_heatmap(
     data: np.ndarray,
     r_values: np.ndarray,
@@ -578,30 +915,37 @@ def write_readme(
         fh.writelines(line if line.endswith("\n") else f"{line}\n" for line in lines)
 
 
-def main() -> None:
-    args = parse_args()
-    logger = setup_logger(args.log_path)
-    cfg = load_config(args.config)
+def context_spec(args: argparse.Namespace) -> dict:
+    """Picklable inputs from which :func:`build_context` rebuilds the context."""
 
-    qpr_table = _resolve_table_path(args.qpr_table).resolve()
+    return {
+        "config": str(args.config),
+        "qpr_table": str(args.qpr_table),
+        "phi_table": str(args.phi_table) if args.phi_table is not None else None,
+        "rho_p": args.rho_p,
+        "s_min": args.s_min,
+        "n_step": int(args.n_step),
+        "beta_thr": float(args.beta_thr),
+    }
+
+
+def build_context(spec: dict, logger: logging.Logger) -> RuntimeContext:
+    cfg = load_config(Path(spec["config"]))
+
+    qpr_table = _resolve_table_path(Path(spec["qpr_table"])).resolve()
     if not qpr_table.exists():
         raise FileNotFoundError(f"Q_pr table not found: {qpr_table}")
     qpr_lookup_fn = tables.load_qpr_table(qpr_table)
     qpr_counter = QPrCounter(qpr_lookup_fn)
 
-    phi_fn, phi_origin = resolve_phi_function(args.phi_table)
-
-    rho_p = float(args.rho_p if args.rho_p is not None else cfg.material.rho)
-    s_min_config = float(args.s_min if args.s_min is not None else cfg.sizes.s_min)
-    s_max = float(cfg.sizes.s_max)
-    n_bins = int(cfg.sizes.n_bins)
-    alpha = float(cfg.psd.alpha)
-    wavy_strength = float(cfg.psd.wavy_strength)
-    s_ref = s_min_config
+    phi_table = Path(spec["phi_table"]) if spec.get("phi_table") else None
+    phi_fn, phi_origin = resolve_phi_function(phi_table)
 
+    rho_p = float(spec["rho_p"] if spec.get("rho_p") is not None else cfg.material.rho)
+    s_min_config = float(spec["s_min"] if spec.get("s_min") is not None else cfg.sizes.s_min)
     sub_params_template = SublimationParams(**cfg.sinks.sub_params.model_dump())
 
-    ctx = RuntimeContext(
+    return RuntimeContext(
         cfg=cfg,
         qpr_lookup=qpr_counter,
         phi_fn=phi_fn,
@@ -609,13 +953,13 @@ def main() -> None:
         sigma_func=resolve_sigma_function(cfg),
         rho_p=rho_p,
         s_min_config=s_min_config,
-        s_max=s_max,
-        n_bins=n_bins,
-        alpha=alpha,
-        wavy_strength=wavy_strength,
-        n_steps=int(args.n_step),
-        s_ref=s_ref,
-        beta_threshold=float(args.beta_thr),
+        s_max=float(cfg.sizes.s_max),
+        n_bins=int(cfg.sizes.n_bins),
+        alpha=float(cfg.psd.alpha),
+        wavy_strength=float(cfg.psd.wavy_strength),
+        n_steps=int(spec["n_step"]),
+        s_ref=s_min_config,
+        beta_threshold=float(spec["beta_thr"]),
         sink_mode=cfg.sinks.mode,
         enable_sublimation=cfg.sinks.enable_sublimation,
         enable_gas_drag=cfg.sinks.enable_gas_drag,
@@ -625,39 +969,44 @@ def main() -> None:
         logger=logger,
     )
 
+
+def main() -> None:
+    args = parse_args()
+    logger = setup_logger(args.log_path)
+    spec = context_spec(args)
+    ctx = build_context(spec, logger)
+    qpr_counter = ctx.qpr_lookup
+    phi_origin = ctx.phi_origin
+    qpr_table = _resolve_table_path(args.qpr_table).resolve()
+
     r_values = np.linspace(args.rmin, args.rmax, args.rnum)
     T_values = np.linspace(args.tmin, args.tmax, args.tnum)
-    beta_raw_map = np.zeros((len(T_values), len(r_values)))
-    beta_eff_map = np.zeros_like(beta_raw_map)
-
-    results: list[BetaCellResult] = []
-    dt_warning_cells = 0
 
     logger.info("Config: %s", args.config.resolve())
     logger.info("Q_pr table: %s", qpr_table)
     logger.info("Φ source: %s", phi_origin)
     logger.info("Grid: r=[%.2f, %.2f] N=%d; T=[%.0f, %.0f] N=%d", r_values[0], r_values[-1], len(r_values), T_values[0], T_values[-1], len(T_values))
 
-    for j, T_val in enumerate(T_values):
-        for i, r_val in enumerate(r_values):
-            cell = evaluate_cell(r_val, T_val, ctx)
-            results.append(cell)
-            beta_raw_map[j, i] = cell.beta_raw
-            beta_eff_map[j, i] = cell.beta_eff
-            if cell.dt_ratio > 1.0:
-                dt_warning_cells += 1
-                logger.warning(
-                    "dt/t_blow exceeds 0.05 at r/R_M=%.3f T=%.0f K (ratio=%.2f)",
-                    r_val,
-                    T_val,
-                    cell.dt_ratio,
-                )
-
-    outdir = args.outdir.resolve()
-    outdir.mkdir(parents=True, exist_ok=True)
-
-    df = pd.DataFrame(
-        {
+    if args.engine == "cell":
+        beta_raw_map = np.zeros((len(T_values), len(r_values)))
+        beta_eff_map = np.zeros_like(beta_raw_map)
+        results: list[BetaCellResult] = []
+        dt_warning_cells = 0
+        for j, T_val in enumerate(T_values):
+            for i, r_val in enumerate(r_values):
+                cell = evaluate_cell(r_val, T_val, ctx)
+                results.append(cell)
+                beta_raw_map[j, i] = cell.beta_raw
+                beta_eff_map[j, i] = cell.beta_eff
+                if cell.dt_ratio > 1.0:
+                    dt_warning_cells += 1
+                    logger.warning(
+                        "dt/t_blow exceeds 0.05 at r/R_M=%.3f T=%.0f K (ratio=%.2f)",
+                        r_val,
+                        T_val,
+                        cell.dt_ratio,
+                    )
+        columns = {
             "r_RM": [row.r_RM for row in results],
             "T_M": [row.T_M for row in results],
             "beta_raw": [row.beta_raw for row in results],
@@ -668,7 +1017,35 @@ def main() -> None:
             "s_min_config": [row.s_min_config for row in results],
             "a_blow_final": [row.a_blow_final for row in results],
         }
-    )
+    else:
+        maps = evaluate_lattice(r_values, T_values, ctx, jobs=max(int(args.jobs), 1), spec=spec)
+        beta_raw_map = maps["beta_raw"]
+        beta_eff_map = maps["beta_eff"]
+        dt_warning_cells = int(np.count_nonzero(maps["dt_ratio"] > 1.0))
+        if dt_warning_cells:
+            logger.warning(
+                "dt/t_blow exceeds 0.05 in %d cells (max ratio=%.2f)",
+                dt_warning_cells,
+                float(np.max(maps["dt_ratio"])),
+            )
+        R, T = np.meshgrid(r_values, T_values)
+        columns = {
+            "r_RM": R.ravel(),
+            "T_M": T.ravel(),
+            "beta_raw": beta_raw_map.ravel(),
+            "beta_eff": beta_eff_map.ravel(),
+            "qpr_used": maps["qpr_used"].ravel(),
+            "tau_final": maps["tau_final"].ravel(),
+            "phi_used": maps["phi_used"].ravel(),
+            "s_min_config": np.full(R.size, float(ctx.s_min_config)),
+            "a_blow_final": maps["a_blow_final"].ravel(),
+        }
+    total_cells = len(T_values) * len(r_values)
+
+    outdir = args.outdir.resolve()
+    outdir.mkdir(parents=True, exist_ok=True)
+
+    df = pd.DataFrame(columns)
     df.to_csv(outdir / "beta_map.csv", index=False)
     logger.info("Wrote CSV to %s", outdir / "beta_map.csv")
 
@@ -703,7 +1080,7 @@ def main() -> None:
         r_values,
         T_values,
         dt_warning_cells,
-        len(results),
+        total_cells,
         qpr_counter,
     )
     logger.info("Readme written to %s", outdir / "README.md")
@@ -6,7 +6,6 @@ from __future__ import annotations
 from pathlib import Path
 from typing import Iterable, Sequence
 
-import imageio.v2 as imageio
 import matplotlib
 
 matplotlib.use("Agg", force=True)
@@ -172,6 +171,8 @@ def save_gif(frame_paths: Sequence[Path], gif_path: Path, fps: int = 8) -> None:
 
     if not frame_paths:
         return
+    import imageio.v2 as imageio
+
     images = [imageio.imread(path) for path in frame_paths]
     imageio.mimsave(gif_path, images, fps=fps)
 
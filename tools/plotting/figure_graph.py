@@ -0,0 +1,305 @@
+"""Content-hashed, parallel build graph for figures.
+
+Each :class:`FigureNode` names its input files, its outputs and a top-level
+builder called as ``builder(**kwargs)``.  The node key is a SHA-256 over
+the input digests (:func:`marsdisk.provenance.hash_files`), the builder's
+source file and its kwargs.  A node is rebuilt only when its key differs
+from the one recorded in the manifest or one of its outputs is missing.
+
+Nodes that share a table input (CSV/Parquet), or that consume another
+node's output, form one group.  A group runs in order inside one worker, so :data:`DATASET_CACHE`
+reads each table once for all of the group's figures.  Independent groups
+run in parallel worker processes (``jobs > 1``) or threads (``executor="thread"``,
+for builders that only launch subprocesses).
+"""
+from __future__ import annotations
+
+import collections
+import concurrent.futures
+import hashlib
+import inspect
+import json
+import multiprocessing
+import threading
+import traceback
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Any, Callable, Dict, List, Mapping, Optional, Sequence, Tuple
+
+import pandas as pd
+
+from marsdisk import provenance
+
+MANIFEST_VERSION = 1
+TABLE_SUFFIXES = {".csv", ".parquet", ".pq"}
+
+
+class DatasetCache:
+    """Process-local LRU of tables keyed by ``(path, size, mtime_ns)``.
+
+    ``read`` returns a shallow copy, so callers may add columns without
+    touching the cached frame.
+    """
+
+    def __init__(self, max_entries: int = 16) -> None:
+        self.max_entries = max(int(max_entries), 1)
+        self._frames: "collections.OrderedDict[Tuple[str, int, int], pd.DataFrame]" = collections.OrderedDict()
+        self._lock = threading.Lock()
+        self.hits = 0
+        self.misses = 0
+
+    def read(self, path: Path, reader: Callable[[Path], pd.DataFrame]) -> pd.DataFrame:
+        resolved = Path(path).resolve()
+        stat = resolved.stat()
+        key = (str(resolved), int(stat.st_size), int(stat.st_mtime_ns))
+        with self._lock:
+            frame = self._frames.get(key)
+            if frame is not None:
+                self._frames.move_to_end(key)
+                self.hits += 1
+                return frame.copy(deep=False)
+        frame = reader(resolved)
+        with self._lock:
+            self.misses += 1
+            self._frames[key] = frame
+            while len(self._frames) > self.max_entries:
+                self._frames.popitem(last=False)
+        return frame.copy(deep=False)
+
+    def clear(self) -> None:
+        with self._lock:
+            self._frames.clear()
+            self.hits = 0
+            self.misses = 0
+
+    def stats(self) -> Dict[str, int]:
+        with self._lock:
+            return {"hits": self.hits, "misses": self.misses, "entries": len(self._frames)}
+
+
+DATASET_CACHE = DatasetCache()
+
+
+@dataclass(frozen=True)
+class FigureNode:
+    fig_id: str
+    builder: Callable[..., Any]
+    inputs: Tuple[Path, ...]
+    outputs: Tuple[Path, ...]
+    kwargs: Mapping[str, Any] = field(default_factory=dict)
+
+
+def _builder_source(builder: Callable[..., Any]) -> Optional[str]:
+    try:
+        return inspect.getsourcefile(builder)
+    except TypeError:
+        return None
+
+
+def node_key(node: FigureNode) -> str:
+    """SHA-256 over input contents, builder source and kwargs."""
+
+    source = _builder_source(node.builder)
+    paths = [*node.inputs, *([source] if source else [])]
+    digests = provenance.hash_files(paths)
+    hasher = hashlib.sha256()
+    hasher.update(node.fig_id.encode("utf-8"))
+    hasher.update(getattr(node.builder, "__qualname__", repr(node.builder)).encode("utf-8"))
+    for path in sorted(digests):
+        hasher.update(path.encode("utf-8"))
+        hasher.update(str(digests[path]).encode("utf-8"))
+    missing = sorted(str(Path(p)) for p in node.inputs if not Path(p).exists())
+    hasher.update(json.dumps(missing).encode("utf-8"))
+    hasher.update(json.dumps(dict(node.kwargs), sort_keys=True, default=str).encode("utf-8"))
+    return hasher.hexdigest()
+
+
+def _resolved(path: Path) -> str:
+    return str(Path(path).expanduser().resolve())
+
+
+def group_nodes(nodes: Sequence[FigureNode]) -> List[List[FigureNode]]:
+    """Split nodes into groups linked by shared tables or output→input edges.
+
+    Shared configs or summaries do not join groups; only tables are worth
+    reading once per worker.
+
+    Within a group, producers come before the nodes that read their outputs;
+    otherwise registration order is kept.
+    """
+
+    parent = list(range(len(nodes)))
+
+    def find(i: int) -> int:
+        while parent[i] != i:
+            parent[i] = parent[parent[i]]
+            i = parent[i]
+        return i
+
+    producers = {_resolved(out): idx for idx, node in enumerate(nodes) for out in node.outputs}
+    owner: Dict[str, int] = {}
+    for idx, node in enumerate(nodes):
+        linked = [
+            path
+            for path in node.inputs
+            if Path(path).suffix.lower() in TABLE_SUFFIXES or _resolved(path) in producers
+        ]
+        for path in (*linked, *node.outputs):
+            key = _resolved(path)
+            if key in owner:
+                parent[find(idx)] = find(owner[key])
+            else:
+                owner[key] = idx
+
+    groups: Dict[int, List[int]] = {}
+    for idx in range(len(nodes)):
+        groups.setdefault(find(idx), []).append(idx)
+
+    ordered: List[List[FigureNode]] = []
+    for members in groups.values():
+        done: set[int] = set()
+        sequence: List[int] = []
+
+        def visit(i: int, stack: Tuple[int, ...] = ()) -> None:
+            if i in done:
+                return
+            if i in stack:
+                raise ValueError(f"Figure graph has a cycle through {nodes[i].fig_id!r}")
+            for path in nodes[i].inputs:
+                producer = producers.get(_resolved(path))
+                if producer is not None and producer != i:
+                    visit(producer, stack + (i,))
+            done.add(i)
+            sequence.append(i)
+
+        for idx in members:
+            visit(idx)
+        ordered.append([nodes[i] for i in sequence])
+    return ordered
+
+
+def _run_group(
+    group: Sequence[FigureNode],
+    recorded: Mapping[str, str],
+    force: bool,
+) -> List[Dict[str, Any]]:
+    results: List[Dict[str, Any]] = []
+    for node in group:
+        key = node_key(node)
+        outputs_present = all(Path(out).exists() for out in node.outputs)
+        if not force and outputs_present and recorded.get(node.fig_id) == key:
+            results.append({"fig_id": node.fig_id, "status": "cached", "key": key})
+            continue
+        try:
+            node.builder(**dict(node.kwargs))
+        except Exception as exc:
+            results.append(
+                {
+                    "fig_id": node.fig_id,
+                    "status": "failed",
+                    "key": None,
+                    "error": f"{type(exc).__name__}: {exc}",
+                    "traceback": traceback.format_exc(),
+                }
+            )
+            continue
+        results.append({"fig_id": node.fig_id, "status": "built", "key": key})
+    return results
+
+
+def _process_context() -> multiprocessing.context.BaseContext:
+    # The parent has usually read Parquet already; forking after Arrow's thread
+    # pool started can hang the interpreter at exit.
+    methods = multiprocessing.get_all_start_methods()
+    return multiprocessing.get_context("forkserver" if "forkserver" in methods else "spawn")
+
+
+class FigureGraph:
+    """Register :class:`FigureNode` objects, then :meth:`run` the stale ones."""
+
+    def __init__(self, manifest_path: Optional[Path] = None) -> None:
+        self.manifest_path = Path(manifest_path) if manifest_path is not None else None
+        self.nodes: List[FigureNode] = []
+
+    def add(
+        self,
+        fig_id: str,
+        builder: Callable[..., Any],
+        *,
+        inputs: Sequence[Path],
+        outputs: Sequence[Path],
+        **kwargs: Any,
+    ) -> FigureNode:
+        if any(node.fig_id == fig_id for node in self.nodes):
+            raise ValueError(f"Duplicate figure id: {fig_id}")
+        node = FigureNode(
+            fig_id=str(fig_id),
+            builder=builder,
+            inputs=tuple(Path(p) for p in inputs),
+            outputs=tuple(Path(p) for p in outputs),
+            kwargs=dict(kwargs),
+        )
+        self.nodes.append(node)
+        return node
+
+    def _load_manifest(self) -> Dict[str, str]:
+        if self.manifest_path is None or not self.manifest_path.exists():
+            return {}
+        try:
+            payload = json.loads(self.manifest_path.read_text(encoding="utf-8"))
+        except (OSError, ValueError):
+            return {}
+        if payload.get("version") != MANIFEST_VERSION:
+            return {}
+        return {str(k): str(v) for k, v in (payload.get("keys") or {}).items()}
+
+    def _write_manifest(self, keys: Mapping[str, str]) -> None:
+        if self.manifest_path is None:
+            return
+        self.manifest_path.parent.mkdir(parents=True, exist_ok=True)
+        payload = {"version": MANIFEST_VERSION, "keys": dict(sorted(keys.items()))}
+        tmp_path = self.manifest_path.with_suffix(self.manifest_path.suffix + ".tmp")
+        tmp_path.write_text(json.dumps(payload, indent=2), encoding="utf-8")
+        tmp_path.replace(self.manifest_path)
+
+    def run(self, *, jobs: int = 1, force: bool = False, executor: str = "process") -> Dict[str, Any]:
+        """Build stale nodes; return ``{"figures": {fig_id: status}, ...}``."""
+
+        if executor not in {"process", "thread"}:
+            raise ValueError(f"Unknown executor: {executor!r}")
+        recorded = self._load_manifest()
+        groups = group_nodes(self.nodes)
+        jobs = max(min(int(jobs), len(groups)), 1)
+        results: List[Dict[str, Any]] = []
+        if jobs == 1:
+            for group in groups:
+                results.extend(_run_group(group, recorded, force))
+        elif executor == "thread":
+            with concurrent.futures.ThreadPoolExecutor(max_workers=jobs) as pool:
+                for chunk in pool.map(_run_group, groups, [recorded] * len(groups), [force] * len(groups)):
+                    results.extend(chunk)
+        else:
+            with concurrent.futures.ProcessPoolExecutor(max_workers=jobs, mp_context=_process_context()) as pool:
+                for chunk in pool.map(_run_group, groups, [recorded] * len(groups), [force] * len(groups)):
+                    results.extend(chunk)
+
+        keys = dict(recorded)
+        for entry in results:
+            if entry["status"] == "failed":
+                keys.pop(entry["fig_id"], None)
+            else:
+                keys[entry["fig_id"]] = entry["key"]
+        self._write_manifest(keys)
+        statuses = {entry["fig_id"]: entry["status"] for entry in results}
+        counts = collections.Counter(statuses.values())
+        return {
+            "figures": statuses,
+            "built": counts.get("built", 0),
+            "cached": counts.get("cached", 0),
+            "failed": [entry for entry in results if entry["status"] == "failed"],
+            "groups": len(groups),
+            "jobs": jobs,
+        }
+
+
+__all__ = ["DATASET_CACHE", "DatasetCache", "FigureGraph", "FigureNode", "group_nodes", "node_key"]
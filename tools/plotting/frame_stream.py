@@ -0,0 +1,298 @@
+"""Streaming frame pipeline for movie/GIF builders.
+
+Movie builders used to render every frame to PNG and then read the whole
+frame set back into memory for the encoder.  :func:`stream_frames` connects
+the three stages with bounded queues instead:
+
+* a loader thread pulls frame payloads from an iterator (e.g. time slices
+  of a memory-mapped cube) into a queue of ``max_in_flight`` slots;
+* each payload is rasterised to an RGB array, inline (``jobs=1``) or in a
+  ``ProcessPoolExecutor`` with at most ``max_in_flight`` frames submitted;
+* finished frames are handed to an incremental encoder in frame order.
+
+Peak memory is therefore ``O(max_in_flight)`` frames rather than
+``O(n_frames)``.  Render workers use the ``forkserver`` (or ``spawn``)
+start method, so ``render`` must be an importable top-level callable when
+``jobs > 1``.
+
+Encoders stream when a streaming backend exists: MP4 pipes raw RGB into
+``ffmpeg`` (falling back to ``imageio``), GIF uses ``imageio``'s writer.  The
+Pillow GIF fallback has to hold every frame until ``close`` (Pillow writes
+multi-frame GIFs in one call); frames are kept palette-quantised, i.e. one
+byte per pixel.
+"""
+from __future__ import annotations
+
+import collections
+import concurrent.futures
+import multiprocessing
+import queue
+import shutil
+import subprocess
+import threading
+from pathlib import Path
+from typing import Any, Callable, Iterable, Iterator, List, Optional
+
+import numpy as np
+
+_END = object()
+
+
+def figure_to_rgb(fig: Any) -> np.ndarray:
+    """Draw ``fig`` on its Agg canvas and return an ``(H, W, 3)`` uint8 copy."""
+
+    fig.canvas.draw()
+    rgba = np.asarray(fig.canvas.buffer_rgba())
+    return np.ascontiguousarray(rgba[..., :3])
+
+
+def write_png(path: Path, rgb: np.ndarray) -> None:
+    """Write an RGB frame that was already rasterised (no second draw)."""
+
+    from matplotlib import image as mpl_image
+
+    path.parent.mkdir(parents=True, exist_ok=True)
+    mpl_image.imsave(path, rgb)
+
+
+class FrameEncoder:
+    """Incremental encoder: ``append`` one RGB frame at a time, then ``close``."""
+
+    def __init__(self, path: Path) -> None:
+        self.path = Path(path)
+        self.frames = 0
+
+    def append(self, rgb: np.ndarray) -> None:
+        self._append(rgb)
+        self.frames += 1
+
+    def _append(self, rgb: np.ndarray) -> None:  # pragma: no cover - abstract
+        raise NotImplementedError
+
+    def close(self) -> None:
+        pass
+
+    def __enter__(self) -> "FrameEncoder":
+        return self
+
+    def __exit__(self, *exc: Any) -> None:
+        self.close()
+
+
+class FFmpegEncoder(FrameEncoder):
+    """Pipe raw RGB frames into an ``ffmpeg`` libx264 process."""
+
+    def __init__(self, path: Path, fps: int) -> None:
+        super().__init__(path)
+        self.fps = int(fps)
+        self._proc: Optional[subprocess.Popen] = None
+
+    def _start(self, height: int, width: int) -> subprocess.Popen:
+        cmd = [
+            "ffmpeg",
+            "-y",
+            "-loglevel",
+            "error",
+            "-f",
+            "rawvideo",
+            "-pix_fmt",
+            "rgb24",
+            "-s",
+            f"{width}x{height}",
+            "-framerate",
+            str(self.fps),
+            "-i",
+            "-",
+            "-c:v",
+            "libx264",
+            "-pix_fmt",
+            "yuv420p",
+            "-crf",
+            "18",
+            str(self.path),
+        ]
+        return subprocess.Popen(cmd, stdin=subprocess.PIPE)
+
+    def _append(self, rgb: np.ndarray) -> None:
+        if self._proc is None:
+            self._proc = self._start(rgb.shape[0], rgb.shape[1])
+        assert self._proc.stdin is not None
+        self._proc.stdin.write(np.ascontiguousarray(rgb, dtype=np.uint8).tobytes())
+
+    def close(self) -> None:
+        if self._proc is None:
+            return
+        proc, self._proc = self._proc, None
+        assert proc.stdin is not None
+        proc.stdin.close()
+        if proc.wait() != 0:
+            raise subprocess.CalledProcessError(proc.returncode, "ffmpeg")
+
+
+class ImageioEncoder(FrameEncoder):
+    """Wrap ``imageio.get_writer`` (streams for both GIF and MP4)."""
+
+    def __init__(self, path: Path, **writer_kwargs: Any) -> None:
+        import imageio.v2 as imageio
+
+        super().__init__(path)
+        self._writer = imageio.get_writer(self.path, **writer_kwargs)
+
+    def _append(self, rgb: np.ndarray) -> None:
+        self._writer.append_data(rgb)
+
+    def close(self) -> None:
+        if self._writer is not None:
+            self._writer.close()
+            self._writer = None
+
+
+class PillowGifEncoder(FrameEncoder):
+    """Pillow GIF fallback; keeps palette frames until ``close``."""
+
+    def __init__(self, path: Path, duration_ms: int) -> None:
+        super().__init__(path)
+        self.duration_ms = int(duration_ms)
+        self._frames: List[Any] = []
+
+    def _append(self, rgb: np.ndarray) -> None:
+        from PIL import Image
+
+        self._frames.append(Image.fromarray(rgb, mode="RGB").quantize())
+
+    def close(self) -> None:
+        if not self._frames:
+            return
+        frames, self._frames = self._frames, []
+        frames[0].save(
+            self.path,
+            save_all=True,
+            append_images=frames[1:],
+            duration=self.duration_ms,
+            loop=0,
+        )
+
+
+def _has_module(name: str) -> bool:
+    import importlib.util
+
+    return importlib.util.find_spec(name) is not None
+
+
+def open_movie_encoder(path: Path, fps: int) -> FrameEncoder:
+    """MP4 encoder: ``ffmpeg`` pipe when available, otherwise ``imageio``."""
+
+    Path(path).parent.mkdir(parents=True, exist_ok=True)
+    if shutil.which("ffmpeg") is not None:
+        return FFmpegEncoder(path, fps)
+    if _has_module("imageio"):
+        return ImageioEncoder(path, fps=fps, codec="libx264", quality=8, macro_block_size=None)
+    raise RuntimeError(
+        "ffmpeg executable not found and imageio is unavailable; install either ffmpeg or imageio[ffmpeg]."
+    )
+
+
+def open_gif_encoder(path: Path, duration_ms: int) -> FrameEncoder:
+    """GIF encoder: streaming ``imageio`` writer, otherwise Pillow."""
+
+    Path(path).parent.mkdir(parents=True, exist_ok=True)
+    if _has_module("imageio"):
+        return ImageioEncoder(path, mode="I", duration=duration_ms / 1000.0)
+    if _has_module("PIL"):
+        return PillowGifEncoder(path, duration_ms)
+    raise RuntimeError("Neither imageio nor Pillow is available for GIF creation.")
+
+
+def _prefetch(payloads: Iterable[Any], maxsize: int) -> Iterator[Any]:
+    """Yield ``payloads`` produced by a loader thread through a bounded queue."""
+
+    slots: "queue.Queue[Any]" = queue.Queue(maxsize=max(int(maxsize), 1))
+    stop = threading.Event()
+
+    def _put(item: Any) -> bool:
+        while not stop.is_set():
+            try:
+                slots.put(item, timeout=0.1)
+                return True
+            except queue.Full:
+                continue
+        return False
+
+    def _load() -> None:
+        try:
+            for item in payloads:
+                if not _put(item):
+                    return
+            _put(_END)
+        except BaseException as exc:  # propagate loader failures to the consumer
+            _put(exc)
+
+    loader = threading.Thread(target=_load, name="frame-loader", daemon=True)
+    loader.start()
+    try:
+        while True:
+            item = slots.get()
+            if item is _END:
+                return
+            if isinstance(item, BaseException):
+                raise item
+            yield item
+    finally:
+        stop.set()
+        loader.join(timeout=1.0)
+
+
+def _render_context() -> multiprocessing.context.BaseContext:
+    # Workers are started while the loader thread runs; do not fork a threaded parent.
+    methods = multiprocessing.get_all_start_methods()
+    return multiprocessing.get_context("forkserver" if "forkserver" in methods else "spawn")
+
+
+def stream_frames(
+    payloads: Iterable[Any],
+    render: Callable[[Any], np.ndarray],
+    encoder: FrameEncoder,
+    *,
+    jobs: int = 1,
+    max_in_flight: Optional[int] = None,
+) -> int:
+    """Render ``payloads`` in order into ``encoder``; return the frame count.
+
+    ``max_in_flight`` bounds both the loader queue and the number of frames
+    submitted to worker processes (default ``2 * jobs``).
+    """
+
+    jobs = max(int(jobs), 1)
+    window = max(int(max_in_flight or 2 * jobs), 1)
+    count = 0
+    source = _prefetch(payloads, window)
+    if jobs == 1:
+        for payload in source:
+            encoder.append(render(payload))
+            count += 1
+        return count
+
+    pending: "collections.deque[concurrent.futures.Future]" = collections.deque()
+    with concurrent.futures.ProcessPoolExecutor(max_workers=jobs, mp_context=_render_context()) as pool:
+        for payload in source:
+            pending.append(pool.submit(render, payload))
+            if len(pending) >= window:
+                encoder.append(pending.popleft().result())
+                count += 1
+        while pending:
+            encoder.append(pending.popleft().result())
+            count += 1
+    return count
+
+
+__all__ = [
+    "FFmpegEncoder",
+    "FrameEncoder",
+    "ImageioEncoder",
+    "PillowGifEncoder",
+    "figure_to_rgb",
+    "open_gif_encoder",
+    "open_movie_encoder",
+    "stream_frames",
+    "write_png",
+]
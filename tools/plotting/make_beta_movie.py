@@ -1,12 +1,18 @@
-"""Render β(r/R_M, T_M, t) frames and assemble an MP4 movie."""
+"""Render β(r/R_M, T_M, t) frames and assemble an MP4 movie.
+
+Frames are streamed: time slices are read from the memory-mapped cube one
+at a time, rasterised in ``--jobs`` worker processes and appended to the
+encoder in order (see :mod:`tools.plotting.frame_stream`).
+"""
 from __future__ import annotations
 
 import argparse
 import json
 import math
-import subprocess
+import sys
+from dataclasses import dataclass
 from pathlib import Path
-from typing import Sequence
+from typing import Iterator, Optional, Sequence, Tuple
 
 import matplotlib
 
@@ -14,8 +20,16 @@ matplotlib.use("Agg")
 import matplotlib.pyplot as plt
 import numpy as np
 
+REPO_ROOT = Path(__file__).resolve().parents[2]
+if str(REPO_ROOT) not in sys.path:
+    sys.path.insert(0, str(REPO_ROOT))
+
+from tools.plotting.frame_stream import figure_to_rgb, open_movie_encoder, stream_frames, write_png
+
+
+def _read_zarr_array(path: Path, *, mmap: bool = False) -> np.ndarray:
+    """Read a single-chunk Zarr array; ``mmap`` maps the chunk instead of loading it."""
 
-def _read_zarr_array(path: Path) -> np.ndarray:
     meta_path = path / ".zarray"
     if not meta_path.exists():
         raise FileNotFoundError(f"Zarr metadata not found: {meta_path}")
@@ -28,6 +42,8 @@ def _read_zarr_array(path: Path) -> np.ndarray:
     chunk_path = path / chunk_name
     if not chunk_path.exists():
         raise FileNotFoundError(f"Zarr chunk missing: {chunk_path}")
+    if mmap:
+        return np.memmap(chunk_path, dtype=dtype, mode="r", shape=shape, order=order)
     data = np.frombuffer(chunk_path.read_bytes(), dtype=dtype)
     return np.reshape(data, shape, order=order)
 
@@ -54,128 +70,139 @@ def _format_time_label(index: int, times: Sequence[float]) -> str:
     return f"t = {fraction:.3f} orbit"
 
 
-def _render_frames(
+@dataclass(frozen=True)
+class FrameStyle:
+    """Per-movie constants shipped with every frame payload."""
+
+    extent: Tuple[float, float, float, float]
+    vmin: float
+    vmax: float
+    dt_ratio_median: float
+    qpr_name: str
+    dpi: int = 160
+
+
+def _render_frame(payload: Tuple[int, str, np.ndarray, Optional[Path], FrameStyle]) -> np.ndarray:
+    """Rasterise one β slice; writes the PNG when a path is given."""
+
+    _, label, frame, frame_path, style = payload
+    fig, ax = plt.subplots(figsize=(6, 4), dpi=style.dpi)
+    im = ax.imshow(
+        frame.T,
+        origin="lower",
+        extent=style.extent,
+        aspect="auto",
+        vmin=style.vmin,
+        vmax=style.vmax,
+        cmap="viridis",
+    )
+    ax.set_xlabel("r / R_M")
+    ax.set_ylabel("T_M [K]")
+    ax.set_title("β at s_min_effective")
+    cbar = fig.colorbar(im, ax=ax)
+    cbar.set_label("β")
+    legend_text = "\n".join(
+        [
+            label,
+            f"median(dt/t_blow) = {style.dt_ratio_median:.3f}",
+            style.qpr_name,
+        ]
+    )
+    ax.text(
+        0.98,
+        0.98,
+        legend_text,
+        transform=ax.transAxes,
+        ha="right",
+        va="top",
+        fontsize=9,
+        bbox=dict(boxstyle="round,pad=0.3", facecolor="white", alpha=0.8),
+    )
+    fig.tight_layout()
+    rgb = figure_to_rgb(fig)
+    plt.close(fig)
+    if frame_path is not None:
+        write_png(frame_path, rgb)
+    return rgb
+
+
+def _frame_payloads(
+    beta_cube: np.ndarray,
+    times: Sequence[float],
+    frames_dir: Optional[Path],
+    style: FrameStyle,
+) -> Iterator[Tuple[int, str, np.ndarray, Optional[Path], FrameStyle]]:
+    """Yield one time slice at a time; only that slice is read from the cube."""
+
+    n_frames = beta_cube.shape[2]
+    width = max(3, len(str(max(n_frames - 1, 0))))
+    for k in range(n_frames):
+        frame = np.array(beta_cube[:, :, k])
+        frame_path = frames_dir / f"step_{k:0{width}d}.png" if frames_dir is not None else None
+        yield k, _format_time_label(k, times), frame, frame_path, style
+
+
+def render_movie(
     beta_cube: np.ndarray,
     r_vals: Sequence[float],
     T_vals: Sequence[float],
     times: Sequence[float],
-    outdir: Path,
+    movie_path: Path,
     *,
+    frames_dir: Optional[Path],
+    fps: int,
     dt_ratio_median: float,
     qpr_table: str,
     vmax: float | None,
-) -> None:
-    outdir.mkdir(parents=True, exist_ok=True)
-    n_frames = beta_cube.shape[2]
-    width = max(3, len(str(max(n_frames - 1, 0))))
-    extent = (
-        float(r_vals[0]),
-        float(r_vals[-1]),
-        float(T_vals[0]),
-        float(T_vals[-1]),
-    )
+    jobs: int = 1,
+    max_in_flight: Optional[int] = None,
+) -> int:
+    """Stream β frames through the render pool into the movie encoder."""
+
+    if beta_cube.shape[2] == 0:
+        raise RuntimeError("beta cube has no time slices; cannot assemble movie.")
+    if frames_dir is not None:
+        frames_dir.mkdir(parents=True, exist_ok=True)
     vmin = float(np.nanmin(beta_cube))
     vmax_val = float(np.nanmax(beta_cube)) if vmax is None else float(vmax)
-    for k in range(n_frames):
-        fig, ax = plt.subplots(figsize=(6, 4))
-        im = ax.imshow(
-            beta_cube[:, :, k].T,
-            origin="lower",
-            extent=extent,
-            aspect="auto",
-            vmin=vmin,
-            vmax=vmax_val,
-            cmap="viridis",
-        )
-        ax.set_xlabel("r / R_M")
-        ax.set_ylabel("T_M [K]")
-        ax.set_title("β at s_min_effective")
-        cbar = fig.colorbar(im, ax=ax)
-        cbar.set_label("β")
-        legend_text = "\n".join(
-            [
-                _format_time_label(k, times),
-                f"median(dt/t_blow) = {dt_ratio_median:.3f}",
-                Path(qpr_table).name,
-            ]
-        )
-        ax.text(
-            0.98,
-            0.98,
-            legend_text,
-            transform=ax.transAxes,
-            ha="right",
-            va="top",
-            fontsize=9,
-            bbox=dict(boxstyle="round,pad=0.3", facecolor="white", alpha=0.8),
-        )
-        frame_path = outdir / f"step_{k:0{width}d}.png"
-        fig.tight_layout()
-        fig.savefig(frame_path, dpi=160)
-        plt.close(fig)
-
-    return width
-
-
-def _build_movie(frames_dir: Path, movie_path: Path, fps: int, width: int) -> None:
-    import shutil
-
-    frame_files = sorted(frames_dir.glob("step_*.png"))
-    if not frame_files:
-        raise RuntimeError("No PNG frames generated; cannot assemble movie.")
-    movie_path.parent.mkdir(parents=True, exist_ok=True)
-    if shutil.which("ffmpeg") is not None:
-        pattern = frames_dir / f"step_%0{width}d.png"
-        cmd = [
-            "ffmpeg",
-            "-y",
-            "-framerate",
-            str(fps),
-            "-i",
-            str(pattern),
-            "-c:v",
-            "libx264",
-            "-pix_fmt",
-            "yuv420p",
-            "-crf",
-            "18",
-            str(movie_path),
-        ]
-        subprocess.run(cmd, check=True)
-        return
-
-    try:
-        import imageio.v2 as imageio
-    except ImportError as exc:  # pragma: no cover - fallback guard
-        raise RuntimeError(
-            "ffmpeg executable not found and imageio is unavailable; install either ffmpeg or imageio[ffmpeg]."
-        ) from exc
-
-    frames = [imageio.imread(path) for path in frame_files]
-    imageio.mimwrite(
-        movie_path,
-        frames,
-        fps=fps,
-        codec="libx264",
-        quality=8,
-        macro_block_size=None,
+    style = FrameStyle(
+        extent=(float(r_vals[0]), float(r_vals[-1]), float(T_vals[0]), float(T_vals[-1])),
+        vmin=vmin,
+        vmax=vmax_val,
+        dt_ratio_median=dt_ratio_median,
+        qpr_name=Path(qpr_table).name,
     )
+    with open_movie_encoder(movie_path, fps) as encoder:
+        return stream_frames(
+            _frame_payloads(beta_cube, times, frames_dir, style),
+            _render_frame,
+            encoder,
+            jobs=jobs,
+            max_in_flight=max_in_flight,
+        )
 
 
 def parse_args() -> argparse.Namespace:
     parser = argparse.ArgumentParser(description="Render β movie frames from a Zarr cube.")
     parser.add_argument("--cube", type=Path, required=True, help="Path to beta_cube.zarr directory.")
     parser.add_argument("--spec", type=Path, required=True, help="map_spec.json produced by sweep_beta_map.")
-    parser.add_argument("--frames", type=Path, required=True, help="Directory to store PNG frames.")
+    parser.add_argument("--frames", type=Path, default=None, help="Optional directory to store PNG frames.")
     parser.add_argument("--movie", type=Path, required=True, help="Output MP4 path.")
     parser.add_argument("--fps", type=int, default=15, help="Movie frame rate.")
     parser.add_argument("--vmax", type=float, default=None, help="Optional colour scale upper bound.")
+    parser.add_argument("--jobs", type=int, default=1, help="Frame rendering worker processes.")
+    parser.add_argument(
+        "--max-in-flight",
+        type=int,
+        default=None,
+        help="Frames held between loader, renderers and encoder (default: 2 x jobs).",
+    )
     return parser.parse_args()
 
 
 def main() -> None:
     args = parse_args()
-    beta_cube = _read_zarr_array(args.cube)
+    beta_cube = _read_zarr_array(args.cube, mmap=True)
     spec = _load_map_spec(args.spec)
     r_vals = np.asarray(spec["r_RM_values"], dtype=float)
     T_vals = np.asarray(spec["T_M_values"], dtype=float)
@@ -183,17 +210,20 @@ def main() -> None:
     dt_ratio_median = float(spec.get("dt_over_t_blow_median", math.nan))
     qpr_table = spec.get("qpr_table_path", "unknown")
 
-    width = _render_frames(
+    render_movie(
         beta_cube,
         r_vals,
         T_vals,
         times,
-        args.frames,
+        args.movie,
+        frames_dir=args.frames,
+        fps=args.fps,
         dt_ratio_median=dt_ratio_median,
         qpr_table=qpr_table,
         vmax=args.vmax,
+        jobs=args.jobs,
+        max_in_flight=args.max_in_flight,
     )
-    _build_movie(args.frames, args.movie, args.fps, width)
 
 
 if __name__ == "__main__":
@@ -7,6 +7,10 @@ The script produces:
 3. Mass-budget timelines for the same runs.
 
 No new simulations are launched; the tool only reads artefacts already on disk.
+Figures are registered in a :class:`tools.plotting.figure_graph.FigureGraph`:
+only figures whose input contents changed are redrawn, figures of the same
+run share one in-memory copy of its series, and independent runs are drawn
+in parallel with ``--jobs``.
 """
 from __future__ import annotations
 
@@ -52,6 +56,10 @@ try:
 except Exception as exc:  # pragma: no cover - repository import required
     raise RuntimeError("Could not import marsdisk.physics.psd; run from repository root") from exc
 
+from tools.plotting.figure_graph import DATASET_CACHE, FigureGraph
+
+DEFAULT_CACHE_MANIFEST = REPO_ROOT / ".cache" / "figures" / "make_figs.json"
+
 
 # --------------------------------------------------------------------------- #
 # Utility helpers
@@ -110,24 +118,32 @@ def _resolve_table_path(path: Path) -> Path:
     return path
 
 
-def read_csv(path: Path) -> pd.DataFrame:
-    path = _resolve_table_path(path)
-    if not path.exists():
-        raise FileNotFoundError(f"CSV not found: {path}")
+def _read_table(path: Path) -> pd.DataFrame:
     if path.suffix.lower() in {".parquet", ".pq"}:
         return pd.read_parquet(path)
     return pd.read_csv(path)
 
 
-def read_parquet(path: Path) -> pd.DataFrame:
-    if not path.exists():
-        raise FileNotFoundError(f"Parquet file not found: {path}")
+def _read_parquet_checked(path: Path) -> pd.DataFrame:
     try:
         return pd.read_parquet(path)
     except Exception as exc:  # pragma: no cover - detailed diagnostics
         raise RuntimeError(f"Failed to read parquet: {path}") from exc
 
 
+def read_csv(path: Path) -> pd.DataFrame:
+    path = _resolve_table_path(path)
+    if not path.exists():
+        raise FileNotFoundError(f"CSV not found: {path}")
+    return DATASET_CACHE.read(path, _read_table)
+
+
+def read_parquet(path: Path) -> pd.DataFrame:
+    if not path.exists():
+        raise FileNotFoundError(f"Parquet file not found: {path}")
+    return DATASET_CACHE.read(path, _read_parquet_checked)
+
+
 def select_axes(df: pd.DataFrame) -> Tuple[str, str]:
     """Infer the x/y axes for the sweep heatmap."""
 
@@ -560,18 +576,32 @@ def parse_args(argv: Optional[Sequence[str]] = None) -> argparse.Namespace:
         default=Path("simulation_results/_configs"),
         help="Directory containing run configuration YAML files",
     )
+    parser.add_argument("--jobs", type=int, default=1, help="Worker processes for independent figures")
+    parser.add_argument("--force", action="store_true", help="Redraw every figure regardless of the cache")
+    parser.add_argument(
+        "--cache-manifest",
+        type=Path,
+        default=DEFAULT_CACHE_MANIFEST,
+        help="JSON file recording the input hash of each built figure",
+    )
     return parser.parse_args(list(argv) if argv is not None else None)
 
 
-def main(argv: Optional[Sequence[str]] = None) -> None:
-    args = parse_args(argv)
+def build_graph(args: argparse.Namespace) -> FigureGraph:
+    """Register every requested figure with its inputs and outputs."""
+
+    graph = FigureGraph(args.cache_manifest)
 
     if args.map1 is not None:
         map_csv = Path(args.map1)
         if not map_csv.exists():
             raise FileNotFoundError(f"Map-1 CSV not found: {map_csv}")
         map_output = Path(args.map1_output) if args.map1_output is not None else map_csv.parent.parent / "fig_map1_regime.png"
-        plot_regime_map(
+        graph.add(
+            "map1_regime",
+            plot_regime_map,
+            inputs=[_resolve_table_path(map_csv)],
+            outputs=[map_output],
             csv_path=map_csv,
             out_path=map_output,
             metric=args.map1_metric,
@@ -587,16 +617,42 @@ def main(argv: Optional[Sequence[str]] = None) -> None:
         summary_path = run_path / "summary.json"
         if not summary_path.exists():
             raise FileNotFoundError(f"summary.json missing for run: {run_path}")
-        plot_contrib_by_size(
+        series_path = run_path / "series" / "run.parquet"
+        contrib_out = run_path / "fig_contrib_by_size.png"
+        graph.add(
+            f"{run_path}:contrib_by_size",
+            plot_contrib_by_size,
+            inputs=[series_path, config_path, summary_path],
+            outputs=[contrib_out],
             run_dir=run_path,
             config_path=config_path,
-            out_path=run_path / "fig_contrib_by_size.png",
+            out_path=contrib_out,
             summary_path=summary_path,
         )
-        plot_mass_budget(
+        budget_out = run_path / "fig_mass_budget_timeline.png"
+        graph.add(
+            f"{run_path}:mass_budget",
+            plot_mass_budget,
+            inputs=[_resolve_table_path(run_path / "checks" / "mass_budget.csv"), series_path],
+            outputs=[budget_out],
             run_dir=run_path,
-            out_path=run_path / "fig_mass_budget_timeline.png",
+            out_path=budget_out,
         )
+    return graph
+
+
+def main(argv: Optional[Sequence[str]] = None) -> Dict[str, Any]:
+    args = parse_args(argv)
+    graph = build_graph(args)
+    report = graph.run(jobs=args.jobs, force=args.force)
+    print(
+        f"[make_figs] built={report['built']} cached={report['cached']} "
+        f"failed={len(report['failed'])} groups={report['groups']} jobs={report['jobs']}"
+    )
+    if report["failed"]:
+        first = report["failed"][0]
+        raise RuntimeError(f"Figure {first['fig_id']} failed: {first['error']}\n{first['traceback']}")
+    return report
 
 
 if __name__ == "__main__":  # pragma: no cover - CLI entry point
@@ -7,6 +7,9 @@ Usage:
 
 Reads summary.json from each run subdirectory and produces:
 - sweep_summary.csv: Aggregated metrics for all cases
+- sweep_summary.arrow: per-run record cache (summary fields, series footer
+  statistics, mass-budget maxima); only new or changed runs are re-read
+  (see marsdisk.io.sweep_collect)
 - fig_sweep_mloss.png: M_loss heatmap (T × eps, tau panels)
 - fig_sweep_clip.png: supply_clip_time_fraction heatmap
 """
@@ -15,6 +18,7 @@ from __future__ import annotations
 import argparse
 import json
 import re
+import sys
 from dataclasses import dataclass, field
 from pathlib import Path
 from typing import Any, Dict, List, Optional, Sequence
@@ -26,6 +30,14 @@ import matplotlib.pyplot as plt
 import numpy as np
 import pandas as pd
 
+REPO_ROOT = Path(__file__).resolve().parents[2]
+if str(REPO_ROOT) not in sys.path:
+    sys.path.insert(0, str(REPO_ROOT))
+
+from marsdisk.io import sweep_collect
+
+CACHE_NAME = "sweep_summary.arrow"
+
 
 @dataclass
 class SweepCase:
@@ -67,21 +79,17 @@ def parse_dir_name(name: str) -> Optional[tuple[float, float, float]]:
         return None
 
 
-def load_case(run_dir: Path) -> Optional[SweepCase]:
-    """Load summary.json and construct a SweepCase."""
+def case_from_summary(run_dir: Path, summary: Optional[Dict[str, Any]]) -> Optional[SweepCase]:
+    """Construct a SweepCase from an already parsed summary.json (or None)."""
     parsed = parse_dir_name(run_dir.name)
     if parsed is None:
         return None
     T_M, epsilon_mix, tau0 = parsed
-
-    summary_path = run_dir / "summary.json"
-    if not summary_path.exists():
-        return SweepCase(run_dir=run_dir, T_M=T_M, epsilon_mix=epsilon_mix, tau0=tau0)
-
-    try:
-        summary = json.loads(summary_path.read_text())
-    except Exception:
+    if not isinstance(summary, dict):
         return SweepCase(run_dir=run_dir, T_M=T_M, epsilon_mix=epsilon_mix, tau0=tau0)
+    if summary.get("summary_status") == "partial":
+        # Progress snapshot of a run that has not finished yet.
+        return None
 
     # Extract supply clipping info (may be nested)
     clip_frac = summary.get("supply_clip_time_fraction")
@@ -115,13 +123,63 @@ def load_case(run_dir: Path) -> Optional[SweepCase]:
     )
 
 
-def discover_cases(batch_dir: Path) -> List[SweepCase]:
-    """Walk batch directory and load all valid cases."""
+def load_case(run_dir: Path) -> Optional[SweepCase]:
+    """Load summary.json and construct a SweepCase."""
+    if parse_dir_name(run_dir.name) is None:
+        return None
+    summary_path = run_dir / "summary.json"
+    summary = None
+    if summary_path.exists():
+        try:
+            summary = json.loads(summary_path.read_text())
+        except Exception:
+            summary = None
+    return case_from_summary(run_dir, summary)
+
+
+def _case_from_record(run_dir: Path, record: pd.Series) -> Optional[SweepCase]:
+    if record.get("summary_status") == "partial":
+        return None
+    text = record.get("summary_json")
+    summary = None
+    if isinstance(text, str):
+        try:
+            summary = json.loads(text)
+        except ValueError:
+            summary = None
+    case = case_from_summary(run_dir, summary)
+    if case is None:
+        return None
+    budget_max = record.get("budget.error_percent.max_abs")
+    if not np.isfinite(case.mass_budget_max_error_percent) and budget_max is not None and np.isfinite(budget_max):
+        case.mass_budget_max_error_percent = float(budget_max)
+    for key, column in (("series_rows", "series_rows"), ("time_end_s", "series.time.max")):
+        value = record.get(column)
+        if value is not None and np.isfinite(value):
+            case.extra[key] = float(value)
+    return case
+
+
+def discover_cases(
+    batch_dir: Path,
+    *,
+    cache_path: Optional[Path] = None,
+    jobs: int = sweep_collect.DEFAULT_IO_WORKERS,
+) -> List[SweepCase]:
+    """Walk batch directory and load all valid cases.
+
+    Run directories are read in parallel; with ``cache_path`` only runs whose
+    inputs changed since the cached collection are re-read.
+    """
+    run_dirs = [
+        entry
+        for entry in sorted(batch_dir.iterdir())
+        if entry.is_dir() and parse_dir_name(entry.name) is not None
+    ]
+    records, _ = sweep_collect.collect_runs(run_dirs, cache_path=cache_path, jobs=jobs)
     cases: List[SweepCase] = []
-    for entry in sorted(batch_dir.iterdir()):
-        if not entry.is_dir():
-            continue
-        case = load_case(entry)
+    for run_dir, (_, record) in zip(run_dirs, records.iterrows()):
+        case = _case_from_record(run_dir, record)
         if case is not None:
             cases.append(case)
     return cases
@@ -145,6 +203,7 @@ def cases_to_dataframe(cases: Sequence[SweepCase]) -> pd.DataFrame:
                 "orbits_completed": c.orbits_completed,
                 "effective_prod_rate_kg_m2_s": c.effective_prod_rate_kg_m2_s,
                 "tau_los_median": c.tau_los_median,
+                **c.extra,
             }
         )
     return pd.DataFrame(records)
@@ -308,6 +367,17 @@ def parse_args(argv: Optional[Sequence[str]] = None) -> argparse.Namespace:
         default=None,
         help="Output CSV path (default: <batch-dir>/sweep_summary.csv).",
     )
+    parser.add_argument(
+        "--jobs",
+        type=int,
+        default=sweep_collect.DEFAULT_IO_WORKERS,
+        help="Reader threads for summary/series/mass-budget files.",
+    )
+    parser.add_argument(
+        "--no-cache",
+        action="store_true",
+        help=f"Re-read every run instead of updating <batch-dir>/{CACHE_NAME}.",
+    )
     parser.add_argument(
         "--no-plots",
         action="store_true",
@@ -324,7 +394,8 @@ def main(argv: Optional[Sequence[str]] = None) -> int:
         print(f"[error] Batch directory not found: {batch_dir}")
         return 1
 
-    cases = discover_cases(batch_dir)
+    cache_path = None if args.no_cache else batch_dir / CACHE_NAME
+    cases = discover_cases(batch_dir, cache_path=cache_path, jobs=args.jobs)
     if not cases:
         print(f"[warn] No valid sweep cases found in {batch_dir}")
         return 0
@@ -1,3 +1,3 @@
 """Miscellaneous utility helpers."""
 
-__all__ = ["memory_probe"]
+__all__ = ["mass_budget_export", "memory_probe", "recover_run"]
@@ -0,0 +1,84 @@
+"""Export Parquet mass-budget logs to the legacy CSV layout.
+
+`io.mass_budget_format=parquet` で書かれた `checks/mass_budget.parquet` /
+`checks/mass_budget_cells.parquet` を従来の CSV 形式へ変換する。
+既存の可視化スクリプトやスプレッドシートで確認したい場合に使う。
+"""
+from __future__ import annotations
+
+import argparse
+import logging
+from pathlib import Path
+from typing import Iterable, List
+
+from marsdisk.io import mass_budget
+
+logger = logging.getLogger(__name__)
+
+LOG_STEMS = ("mass_budget", "mass_budget_cells")
+
+
+def _detect_logs(paths: Iterable[Path]) -> List[Path]:
+    """Return Parquet mass-budget logs under the given files or run directories."""
+
+    logs: List[Path] = []
+    for raw in paths:
+        p = raw.resolve()
+        if p.is_file() and p.suffix == ".parquet":
+            logs.append(p)
+            continue
+        if not p.is_dir():
+            logger.warning("Path does not exist, skipping: %s", p)
+            continue
+        for stem in LOG_STEMS:
+            logs.extend(sorted(p.rglob(f"checks/{stem}.parquet")))
+    seen = set()
+    unique: List[Path] = []
+    for path in logs:
+        if path not in seen:
+            unique.append(path)
+            seen.add(path)
+    return unique
+
+
+def main(argv: Iterable[str] | None = None) -> int:
+    parser = argparse.ArgumentParser(description="Convert mass_budget*.parquet logs to CSV.")
+    parser.add_argument(
+        "paths",
+        nargs="*",
+        type=Path,
+        default=[Path("out")],
+        help="Parquet ログ、または run ディレクトリ（再帰探索）。",
+    )
+    parser.add_argument(
+        "--force",
+        action="store_true",
+        help="既存の CSV を上書きする。",
+    )
+    parser.add_argument(
+        "--check",
+        action="store_true",
+        help="変換に加えて最大 error_percent を表示する（行グループ統計のみ参照）。",
+    )
+    args = parser.parse_args(list(argv) if argv is not None else None)
+    logging.basicConfig(level=logging.INFO, format="%(message)s")
+
+    logs = _detect_logs(args.paths)
+    if not logs:
+        logger.info("mass_budget*.parquet が見つかりませんでした。")
+        return 1
+    for path in logs:
+        dest = path.with_suffix(".csv")
+        if dest.exists() and not args.force:
+            logger.info("[skip] exists: %s", dest)
+        else:
+            mass_budget.export_csv(path, dest)
+            logger.info("[ok] %s -> %s", path, dest.name)
+        if args.check:
+            max_err = mass_budget.max_error_percent(path)
+            logger.info("  max error_percent: %s", "n/a" if max_err is None else f"{max_err:.3e}")
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
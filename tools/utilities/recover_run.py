@@ -0,0 +1,110 @@
+"""Report the recovery state of interrupted runs and salvage their outputs.
+
+ストリーミング実行は chunk flush ごとに `summary.partial.json` を
+`summary_status="partial"` で原子的に更新する（`summary.json` は完了時のみ書かれる）。
+強制終了した run について、到達時刻・累積損失・最新 chunk・最新 checkpoint を表示し、再開用の
+`--override` 引数を出力する。`--merge` を付けると残っている chunk を
+`series/*.parquet` にまとめ（chunk は削除しない）、途中結果を解析に使えるようにする。
+"""
+from __future__ import annotations
+
+import argparse
+import json
+import logging
+from pathlib import Path
+from typing import Iterable, List
+
+from marsdisk.io import recovery
+
+logger = logging.getLogger(__name__)
+
+
+def _find_run_dirs(paths: Iterable[Path]) -> List[Path]:
+    """Return run directories (containing a final/partial summary or chunks) under ``paths``."""
+
+    found: List[Path] = []
+    for raw in paths:
+        root = raw.resolve()
+        if not root.is_dir():
+            logger.warning("Path does not exist, skipping: %s", root)
+            continue
+        has_summary = (root / "summary.json").exists() or (root / recovery.PARTIAL_SUMMARY_NAME).exists()
+        if has_summary or (root / "series").is_dir():
+            found.append(root)
+            continue
+        parents = {summary.parent for summary in root.rglob("summary.json")}
+        parents.update(summary.parent for summary in root.rglob(recovery.PARTIAL_SUMMARY_NAME))
+        found.extend(sorted(parents))
+    return found
+
+
+def main(argv: Iterable[str] | None = None) -> int:
+    parser = argparse.ArgumentParser(description="Inspect partial summaries and prepare resumes.")
+    parser.add_argument(
+        "paths",
+        nargs="*",
+        type=Path,
+        default=[Path("out")],
+        help="run ディレクトリ、またはその親（再帰探索）。",
+    )
+    parser.add_argument(
+        "--merge",
+        action="store_true",
+        help="partial な run の chunk を series/*.parquet にマージする（chunk は残す）。",
+    )
+    parser.add_argument(
+        "--json",
+        action="store_true",
+        help="結果を JSON Lines で出力する。",
+    )
+    parser.add_argument(
+        "--all",
+        action="store_true",
+        help="complete な run も表示する。",
+    )
+    args = parser.parse_args(list(argv) if argv is not None else None)
+    logging.basicConfig(level=logging.INFO, format="%(message)s")
+
+    run_dirs = _find_run_dirs(args.paths)
+    if not run_dirs:
+        logger.info("run ディレクトリが見つかりませんでした。")
+        return 1
+    n_partial = 0
+    for run_dir in run_dirs:
+        info = recovery.inspect_run(run_dir)
+        if info.status == recovery.SUMMARY_COMPLETE and not args.all:
+            continue
+        if info.status != recovery.SUMMARY_COMPLETE:
+            n_partial += 1
+        merged: List[Path] = []
+        if args.merge and info.status != recovery.SUMMARY_COMPLETE:
+            merged = recovery.merge_partial_outputs(run_dir)
+        if args.json:
+            payload = info.as_dict()
+            payload["merged"] = [str(p) for p in merged]
+            print(json.dumps(payload, sort_keys=True))
+            continue
+        logger.info("[%s] %s", info.status, run_dir)
+        if info.status == recovery.SUMMARY_MISSING:
+            continue
+        logger.info(
+            "  t=%s s step=%s/%s M_loss=%s",
+            info.time_s,
+            info.step_no,
+            info.n_steps,
+            info.M_loss,
+        )
+        if info.latest_chunk is not None:
+            logger.info("  latest chunk: %s (step_end=%s)", info.latest_chunk.name, info.latest_chunk_step_end)
+        if info.resumable:
+            logger.info("  resume: %s", " ".join(f"--override {item}" for item in info.resume_overrides()))
+        elif info.status == recovery.SUMMARY_PARTIAL:
+            logger.info("  resume: checkpoint なし（checkpoint.enabled=true で再実行が必要）")
+        for path in merged:
+            logger.info("  merged: %s", path)
+    logger.info("partial/missing runs: %d / %d", n_partial, len(run_dirs))
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())